@@ -30,6 +30,7 @@ public:
                                                 const QwtScaleMap &yMap, const QRectF &canvRect, int from, int to) const;
 
     void setNAValue(double x) { naValue_=x; }
+    double gapValue() const { return gapValue_; }
 
 private:
 	/// Value that denotes missed Y data at point
@@ -481,6 +481,7 @@ public:
     enum EntryType { Directory, File, Symlink };
 
     void addEntry(EntryType type, const QString &fileName, const QByteArray &contents);
+    void addEntry(EntryType type, const QString &fileName, const ZipWriter::Compressed &entry);
 };
 
 LocalFileHeader CentralFileHeader::toLocalHeader() const
@@ -598,59 +599,78 @@ void ZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const Q
     ZDEBUG() << "adding" << entryTypes[type] <<":" << fileName.toUtf8().data() << (type == 2 ? QByteArray(" -> " + contents).constData() : "");
 #endif
 
-    if (! (device->isOpen() || device->open(QIODevice::WriteOnly))) {
-        status = ZipWriter::FileOpenError;
-        return;
-    }
-    device->seek(start_of_directory);
+    addEntry(type, fileName, ZipWriter::compress(contents, compressionPolicy));
+}
 
+ZipWriter::Compressed ZipWriter::compress(const QByteArray &contents, CompressionPolicy policy)
+{
     // don't compress small files
-    ZipWriter::CompressionPolicy compression = compressionPolicy;
-    if (compressionPolicy == ZipWriter::AutoCompress) {
+    CompressionPolicy compression = policy;
+    if (policy == AutoCompress) {
         if (contents.length() < 64)
-            compression = ZipWriter::NeverCompress;
+            compression = NeverCompress;
         else
-            compression = ZipWriter::AlwaysCompress;
+            compression = AlwaysCompress;
     }
 
-    FileHeader header;
-    memset(&header.h, 0, sizeof(CentralFileHeader));
-    writeUInt(header.h.signature, 0x02014b50);
-
-    writeUShort(header.h.version_needed, 0x14);
-    writeUInt(header.h.uncompressed_size, contents.length());
-    writeMSDosDate(header.h.last_mod_file, QDateTime::currentDateTime());
-    QByteArray data = contents;
-    if (compression == ZipWriter::AlwaysCompress) {
-        writeUShort(header.h.compression_method, 8);
+    Compressed entry;
+    entry.size = contents.length();
+    entry.deflated = false;
+    entry.data = contents;
+    if (compression == AlwaysCompress) {
+        entry.deflated = true;
 
        ulong len = contents.length();
         // shamelessly copied form zlib
         len += (len >> 12) + (len >> 14) + 11;
         int res;
         do {
-            data.resize(len);
-            res = deflate((uchar*)data.data(), &len, (const uchar*)contents.constData(), contents.length());
+            entry.data.resize(len);
+            res = deflate((uchar*)entry.data.data(), &len, (const uchar*)contents.constData(), contents.length());
 
             switch (res) {
             case Z_OK:
-                data.resize(len);
+                entry.data.resize(len);
                 break;
             case Z_MEM_ERROR:
                 qWarning("QZip: Z_MEM_ERROR: Not enough memory to compress file, skipping");
-                data.resize(0);
+                entry.data.resize(0);
                 break;
             case Z_BUF_ERROR:
                 len *= 2;
                 break;
             }
         } while (res == Z_BUF_ERROR);
+
+        // already compressed (images, video), store it as it is
+        if (policy == AutoCompress && entry.data.length() >= contents.length()) {
+            entry.deflated = false;
+            entry.data = contents;
+        }
     }
-// TODO add a check if data.length() > contents.length().  Then try to store the original and revert the compression method to be uncompressed
-    writeUInt(header.h.compressed_size, data.length());
-    uint crc_32 = ::crc32(0, 0, 0);
-    crc_32 = ::crc32(crc_32, (const uchar *)contents.constData(), contents.length());
-    writeUInt(header.h.crc_32, crc_32);
+    entry.crc32 = ::crc32(0, 0, 0);
+    entry.crc32 = ::crc32(entry.crc32, (const uchar *)contents.constData(), contents.length());
+    return entry;
+}
+
+void ZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const ZipWriter::Compressed &entry)
+{
+    if (! (device->isOpen() || device->open(QIODevice::WriteOnly))) {
+        status = ZipWriter::FileOpenError;
+        return;
+    }
+    device->seek(start_of_directory);
+
+    FileHeader header;
+    memset(&header.h, 0, sizeof(CentralFileHeader));
+    writeUInt(header.h.signature, 0x02014b50);
+
+    writeUShort(header.h.version_needed, 0x14);
+    writeUInt(header.h.uncompressed_size, entry.size);
+    writeMSDosDate(header.h.last_mod_file, QDateTime::currentDateTime());
+    if (entry.deflated) writeUShort(header.h.compression_method, 8);
+    writeUInt(header.h.compressed_size, entry.data.length());
+    writeUInt(header.h.crc_32, entry.crc32);
 
     header.file_name = fileName.toLocal8Bit();
     if (header.file_name.size() > 0xffff) {
@@ -678,7 +698,7 @@ void ZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const Q
     LocalFileHeader h = header.h.toLocalHeader();
     device->write((const char *)&h, sizeof(LocalFileHeader));
     device->write(header.file_name);
-    device->write(data);
+    device->write(entry.data);
     start_of_directory = device->pos();
     dirtyFileTree = true;
 }
@@ -1183,6 +1203,11 @@ void ZipWriter::addFile(const QString &fileName, const QByteArray &data)
     The file will be stored in the archive using the \a fileName which
     includes the full path in the archive.
 */
+void ZipWriter::addCompressedFile(const QString &fileName, const Compressed &entry)
+{
+    d->addEntry(ZipWriterPrivate::File, QDir::fromNativeSeparators(fileName), entry);
+}
+
 void ZipWriter::addFile(const QString &fileName, QIODevice *device)
 {
     Q_ASSERT(device);
@@ -99,6 +99,18 @@ public:
 
     void addFile(const QString &fileName, QIODevice *device);
 
+    // file contents compressed ahead of time, compress() is safe to call
+    // from any thread so entries can be compressed in parallel and then
+    // added in order with addCompressedFile()
+    struct Compressed {
+        QByteArray data;
+        quint32 crc32;
+        quint32 size;           // uncompressed
+        bool deflated;
+    };
+    static Compressed compress(const QByteArray &contents, CompressionPolicy policy = AlwaysCompress);
+    void addCompressedFile(const QString &fileName, const Compressed &entry);
+
     void addDirectory(const QString &dirName);
 
     void addSymLink(const QString &fileName, const QString &destination);
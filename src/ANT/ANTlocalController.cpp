@@ -163,13 +163,7 @@ ANTlocalController::getRealtimeData(RealtimeData &rtData)
 {
     if(!myANTlocal->isRunning())
     {
-        QMessageBox msgBox;
-        msgBox.setText(tr("Cannot open ANT+ device"));
-        msgBox.setIcon(QMessageBox::Critical);
-        msgBox.exec();
-        parent->Stop(1);
-        parent->Disconnect();
-        logger->close();
+        if (failed(1, true, tr("Cannot open ANT+ device"))) logger->close();
         return;
     }
     // get latest telemetry
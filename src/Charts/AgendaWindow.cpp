@@ -68,25 +68,21 @@ AgendaWindow::AgendaWindow(Context *context)
     connect(context, &Context::rideChanged, this, &AgendaWindow::updateActivitiesIfInRange);
     connect(context, &Context::configChanged, this, &AgendaWindow::configChanged);
     connect(agendaView, &AgendaView::showInTrainMode, this, [context](const AgendaEntry &activity) {
-        for (RideItem *rideItem : context->athlete->rideCache->rides()) {
-            if (rideItem != nullptr && rideItem->fileName == activity.reference) {
-                QString filter = buildWorkoutFilter(rideItem);
-                if (! filter.isEmpty()) {
-                    context->mainWindow->fillinWorkoutFilterBox(filter);
-                    context->mainWindow->selectTrain();
-                    context->notifySelectWorkout(0);
-                }
-                break;
+        RideItem *rideItem = context->athlete->rideCache->getRide(activity.reference);
+        if (rideItem != nullptr) {
+            QString filter = buildWorkoutFilter(rideItem);
+            if (! filter.isEmpty()) {
+                context->mainWindow->fillinWorkoutFilterBox(filter);
+                context->mainWindow->selectTrain();
+                context->notifySelectWorkout(0);
             }
         }
     });
     connect(agendaView, &AgendaView::viewActivity, this, [context](const AgendaEntry &activity) {
-        for (RideItem *rideItem : context->athlete->rideCache->rides()) {
-            if (rideItem != nullptr && rideItem->fileName == activity.reference) {
-                context->notifyRideSelected(rideItem);
-                context->mainWindow->selectAnalysis();
-                break;
-            }
+        RideItem *rideItem = context->athlete->rideCache->getRide(activity.reference);
+        if (rideItem != nullptr) {
+            context->notifyRideSelected(rideItem);
+            context->mainWindow->selectAnalysis();
         }
     });
     connect(agendaView, &AgendaView::editPhaseEntry, this, &AgendaWindow::editPhaseEntry);
@@ -521,7 +517,7 @@ AgendaWindow::getActivities
     if (! context || ! context->athlete || ! context->athlete->rideCache) {
         return activities;
     }
-    const QList<RideItem*> rides = context->athlete->rideCache->rides();
+    const QVector<RideItem*> rides = context->athlete->rideCache->ridesBetween(firstDay, lastDay, true);
     if (rides.isEmpty()) {
         return activities;
     }
@@ -546,15 +542,8 @@ AgendaWindow::getActivities
 
     int showTertiaryFor = getShowTertiaryFor();
     for (RideItem *rideItem : rides) {
-        if (   rideItem == nullptr
-            || ! rideItem->dateTime.isValid()) {
-            continue;
-        }
         QDate rideDate = rideItem->dateTime.date();
-        if (   ! rideItem->planned
-            || rideDate < firstDay
-            || rideDate > lastDay
-            || rideItem->hasLinkedActivity()) {
+        if (rideItem->hasLinkedActivity()) {
             continue;
         }
         if (   (context->isfiltered && ! context->filters.contains(rideItem->fileName))
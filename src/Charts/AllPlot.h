@@ -46,6 +46,7 @@
 
 #include "UserData.h"
 #include "RideFile.h"
+#include "MinMaxPyramid.h"
 
 class QwtPlotCurve;
 class QwtPlotGappedCurve;
@@ -542,6 +543,34 @@ class AllPlotObject : public QObject
     double maxSECS, maxKM;
 };
 
+// curve data that only hands qwt a couple of points per pixel for the
+// visible range, peaks are kept exactly via a min/max pyramid that is
+// built once when the data is set, so zoom and scroll stay quick on long rides
+class AllPlotDecimatedData : public QwtSeriesData<QPointF>
+{
+    public:
+        AllPlotDecimatedData(QwtPlot *plot, const double *x, const double *y, int count, double maxspan=0);
+        AllPlotDecimatedData(QwtPlot *plot, const QVector<QPointF> &points, double maxspan=0);
+
+        virtual size_t size() const { return visible.count(); }
+        virtual QPointF sample(size_t i) const { return visible[i]; }
+        virtual QRectF boundingRect() const { return pyramid.boundingRect(); }
+        virtual void setRectOfInterest(const QRectF &rect);
+
+        // all of the data, not just what is visible
+        QVector<QPointF> samples() const { return pyramid.samples(); }
+        int count() const { return pyramid.count(); }
+
+    private:
+        void decimate();
+
+        QwtPlot *plot;
+        double maxspan;
+        MinMaxPyramid pyramid;
+        QRectF interest;
+        QVector<QPointF> visible;
+};
+
 class AllPlot : public QwtPlot
 {
     Q_OBJECT
@@ -568,6 +597,11 @@ class AllPlot : public QwtPlot
                                                                            // reference is for settings et al
         void setMatchLabels(AllPlotObject *object); // set labels from object
 
+        // set curve data decimated to the visible range, and get all of it back when cloning
+        void setDecimatedSamples(QwtPlotCurve *curve, const double *x, const double *y, int count);
+        void setDecimatedSamples(QwtPlotCurve *curve, const QVector<QPointF> &points);
+        static QVector<QPointF> curveSamples(const QwtPlotCurve *curve);
+
         // convert from time/distance to index in *smoothed* datapoints
         int timeIndex(double) const;
         int distanceIndex(double) const;
@@ -1812,6 +1812,16 @@ AllPlotWindow::rideSelected()
     // clear any previous selections
     clearSelection();
 
+    // work out the derived series we draw before looking at what
+    // is present, the costly rolling ones only when they're shown
+    int derived = RideFile::DeriveDeltas | RideFile::DeriveSlope | RideFile::DeriveGear |
+                  RideFile::DeriveHb | RideFile::DeriveCoreTemp;
+    if (showNP->isChecked()) derived |= RideFile::DeriveNP;
+    if (showXP->isChecked()) derived |= RideFile::DeriveXP;
+    if (showAP->isChecked()) derived |= RideFile::DeriveAPower;
+    if (showATISS->isChecked() || showANTISS->isChecked()) derived |= RideFile::DeriveTISS;
+    ride->ride()->derive(derived);
+
     // setup the control widgets, dependant on
     // data present in this ride, needs to happen
     // before we set the plots below...
@@ -2530,8 +2540,8 @@ AllPlotWindow::setShowNP(int value)
 
     bool checked = ( ( value == Qt::Checked ) && showNP->isEnabled()) ? true : false;
 
-    // recalc only does it if it needs to
-    if (value && current && current->ride()) current->ride()->recalculateDerivedSeries();
+    // only worked out when shown, so read the ride again if it wasn't
+    if (value && current && current->ride() && current->ride()->deriveSeries(RideFile::IsoPower)) forceReplot();
 
     allPlot->setShowNP(checked);
     foreach (AllPlot *plot, allPlots)
@@ -2553,8 +2563,8 @@ AllPlotWindow::setShowANTISS(int value)
 
     bool checked = ( ( value == Qt::Checked ) && showANTISS->isEnabled()) ? true : false;
 
-    // recalc only does it if it needs to
-    if (value && current && current->ride()) current->ride()->recalculateDerivedSeries();
+    // only worked out when shown, so read the ride again if it wasn't
+    if (value && current && current->ride() && current->ride()->deriveSeries(RideFile::anTISS)) forceReplot();
 
     allPlot->setShowANTISS(checked);
     foreach (AllPlot *plot, allPlots)
@@ -2576,8 +2586,8 @@ AllPlotWindow::setShowATISS(int value)
 
     bool checked = ( ( value == Qt::Checked ) && showATISS->isEnabled()) ? true : false;
 
-    // recalc only does it if it needs to
-    if (value && current && current->ride()) current->ride()->recalculateDerivedSeries();
+    // only worked out when shown, so read the ride again if it wasn't
+    if (value && current && current->ride() && current->ride()->deriveSeries(RideFile::aTISS)) forceReplot();
 
     allPlot->setShowATISS(checked);
     foreach (AllPlot *plot, allPlots)
@@ -2599,8 +2609,8 @@ AllPlotWindow::setShowXP(int value)
 
     bool checked = ( ( value == Qt::Checked ) && showXP->isEnabled()) ? true : false;
 
-    // recalc only does it if it needs to
-    if (value && current && current->ride()) current->ride()->recalculateDerivedSeries();
+    // only worked out when shown, so read the ride again if it wasn't
+    if (value && current && current->ride() && current->ride()->deriveSeries(RideFile::xPower)) forceReplot();
 
     allPlot->setShowXP(checked);
     foreach (AllPlot *plot, allPlots)
@@ -2622,8 +2632,8 @@ AllPlotWindow::setShowAP(int value)
 
     bool checked = ( ( value == Qt::Checked ) && showAP->isEnabled()) ? true : false;
 
-    // recalc only does it if it needs to
-    if (value && current && current->ride()) current->ride()->recalculateDerivedSeries();
+    // only worked out when shown, so read the ride again if it wasn't
+    if (value && current && current->ride() && current->ride()->deriveSeries(RideFile::aPower)) forceReplot();
 
     allPlot->setShowAP(checked);
     foreach (AllPlot *plot, allPlots)
@@ -337,12 +337,10 @@ CalendarWindow::CalendarWindow(Context *context)
         }
     });
     connect(calendar, &Calendar::filterSimilar, this, [this](CalendarEntry activity) {
-        for (RideItem *rideItem : this->context->athlete->rideCache->rides()) {
-            if (rideItem != nullptr && rideItem->fileName == activity.reference) {
-                FilterSimilarDialog dlg(this->context, rideItem, this);
-                dlg.exec();
-                break;
-            }
+        RideItem *rideItem = this->context->athlete->rideCache->getRide(activity.reference);
+        if (rideItem != nullptr) {
+            FilterSimilarDialog dlg(this->context, rideItem, this);
+            dlg.exec();
         }
     });
     connect(calendar, &Calendar::linkActivity, this, &CalendarWindow::linkActivities);
@@ -1016,7 +1014,7 @@ CalendarWindow::getActivities
     if (! context || ! context->athlete || ! context->athlete->rideCache) {
         return activities;
     }
-    const QList<RideItem*> rides = context->athlete->rideCache->rides();
+    const QVector<RideItem*> rides = context->athlete->rideCache->ridesBetween(firstDay, lastDay);
     if (rides.isEmpty()) {
         return activities;
     }
@@ -1039,15 +1037,7 @@ CalendarWindow::getActivities
     }
 
     for (RideItem *rideItem : rides) {
-        if (   rideItem == nullptr
-            || ! rideItem->dateTime.isValid()) {
-            continue;
-        }
         QDate rideDate = rideItem->dateTime.date();
-        if (   rideDate < firstDay
-            || rideDate > lastDay) {
-            continue;
-        }
         if (   (context->isfiltered && ! context->filters.contains(rideItem->fileName))
             || (context->ishomefiltered && ! context->homeFilters.contains(rideItem->fileName))) {
             continue;
@@ -1255,20 +1245,11 @@ CalendarWindow::getRideItem
 (const CalendarEntry &entry, bool linked)
 {
     bool thisIsPlanned = (entry.type == ENTRY_TYPE_PLANNED_ACTIVITY);
-    for (RideItem *rideItem : this->context->athlete->rideCache->rides()) {
-        if (rideItem == nullptr || rideItem->fileName.isEmpty()) {
-            continue;
-        }
-        if (   (   linked
-                && rideItem->fileName == entry.linkedReference
-                && rideItem->planned != thisIsPlanned)
-            || (   ! linked
-                && rideItem->fileName == entry.reference
-                && rideItem->planned == thisIsPlanned)) {
-            return rideItem;
-        }
+    const QString &reference = linked ? entry.linkedReference : entry.reference;
+    if (reference.isEmpty()) {
+        return nullptr;
     }
-    return nullptr;
+    return this->context->athlete->rideCache->getRide(reference, linked ? ! thisIsPlanned : thisIsPlanned);
 }
 
 
@@ -1301,10 +1282,8 @@ CalendarWindow::findFreeSlot
     }
     QList<std::pair<QTime, int>> busySlots;
     busySlots.append(std::make_pair(QTime(0, 0), getStartHour() * 60 * 60));
-    for (RideItem *rideItem : context->athlete->rideCache->rides()) {
-        if (rideItem != nullptr && rideItem->planned == sourceItem->planned && rideItem->dateTime.date() == newDate) {
-            busySlots.append(std::make_pair(rideItem->dateTime.time(), static_cast<int>(rideItem->getForSymbol("workout_time"))));
-        }
+    for (RideItem *rideItem : context->athlete->rideCache->ridesBetween(newDate, newDate, sourceItem->planned)) {
+        busySlots.append(std::make_pair(rideItem->dateTime.time(), static_cast<int>(rideItem->getForSymbol("workout_time"))));
     }
     busySlots.append(std::make_pair(QTime(getEndHour(), 0), (24 - getEndHour()) * 60 * 60 - 1));
     if (! targetTime.isValid()) {
@@ -1607,11 +1586,8 @@ CalendarWindow::linkActivities
         }
         double rideMetricValue = rideItem->getForSymbol(getSecondaryMetric(), GlobalContext::context()->useMetricUnits);
         QList<LinkEntry> candidates;
-        for (RideItem *candidateItem : context->athlete->rideCache->rides()) {
-            if (   candidateItem->dateTime.date() >= minDate
-                && candidateItem->dateTime.date() <= maxDate
-                && candidateItem->planned != linkEntry.planned
-                && candidateItem->sport == rideItem->sport
+        for (RideItem *candidateItem : context->athlete->rideCache->ridesBetween(minDate, maxDate, ! linkEntry.planned)) {
+            if (   candidateItem->sport == rideItem->sport
                 && candidateItem->getLinkedFileName().isEmpty()) {
                 LinkEntry candidate;
                 candidate.reference = candidateItem->fileName;
@@ -1718,13 +1694,7 @@ CalendarWindow::pastePlannedActivity
         QString reference;
         stream >> primary >> reference;
 
-        RideItem *sourceItem = nullptr;
-        for (RideItem *rideItem : context->athlete->rideCache->rides()) {
-            if (rideItem != nullptr && rideItem->planned && rideItem->fileName == reference) {
-                sourceItem = rideItem;
-                break;
-            }
-        }
+        RideItem *sourceItem = context->athlete->rideCache->getRide(reference, true);
         time = findFreeSlot(sourceItem, day, time);
         RideCache::OperationPreCheck check = context->athlete->rideCache->checkCopyPlannedActivity(sourceItem, day, time);
         if (check.canProceed) {
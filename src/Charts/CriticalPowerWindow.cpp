@@ -1821,7 +1821,7 @@ CriticalPowerWindow::dateRangeChanged(DateRange dateRange)
         cto = dateRange.to;
 
         FilterSet fs;
-        fs.addFilter(searchBox->isFiltered(), SearchFilterBox::matches(context, filter()));
+        fs.addFilter(searchBox->isFiltered(), SearchFilterBox::filterMatches(context, filter()));
         fs.addFilter(context->isfiltered, context->filters);
         fs.addFilter(context->ishomefiltered, context->homeFilters);
         if (myPerspective) fs.addFilter(myPerspective->isFiltered(), myPerspective->filterlist(dateRange));
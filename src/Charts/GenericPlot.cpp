@@ -33,11 +33,17 @@
 
 #include "gsl/gsl_fit.h"
 #include <limits>
+#include <cmath>
+#include <QScreen>
+#include <QGuiApplication>
 
 // used to format dates/times on axes
 QString GenericPlot::gl_dateformat = QString("dd MMM yy");
 QString GenericPlot::gl_timeformat = QString("hh:mm:ss");
 
+// series with more points than this are thinned to the screen resolution
+static const int gl_thinpoints = 20000;
+
 GenericPlot::GenericPlot(QWidget *parent, Context *context, QGraphicsItem *item) : QWidget(parent), context(context), item(item)
 {
     setAutoFillBackground(true);
@@ -116,6 +122,11 @@ GenericPlot::GenericPlot(QWidget *parent, Context *context, QGraphicsItem *item)
     configChanged(0);
 }
 
+GenericPlot::~GenericPlot()
+{
+    foreach(CachedQuadtree cached, treecache) delete cached.tree;
+}
+
 void
 GenericPlot::seriesClicked(QAbstractSeries*series, GPointF point)
 {
@@ -449,8 +460,11 @@ GenericPlot::initialiseChart(QString title, int type, bool animate, int legpos,
     foreach(QLabel *label, labels) delete label;
     labels.clear();
 
-    foreach(Quadtree *tree, quadtrees) delete tree;
+    // quadtrees are cached by series name, unused ones
+    // are deleted in finaliseChart
     quadtrees.clear();
+    for(auto it=treecache.begin(); it != treecache.end(); ++it) it->used = false;
+    sourcepoints.clear();
 
     foreach(GenericAxisInfo *axisinfo, axisinfos) delete axisinfo;
     axisinfos.clear();
@@ -539,6 +553,8 @@ GenericPlot::addCurve(QString name, QVector<double> xseries, QVector<double> yse
         QAbstractSeries *existing = curves.value(name);
         if (existing) {
             qchart->removeSeries(existing);
+            quadtrees.remove(existing);
+            sourcepoints.remove(existing);
             delete existing;
             curves.remove(name);
 
@@ -607,14 +623,21 @@ GenericPlot::addCurve(QString name, QVector<double> xseries, QVector<double> yse
             add->setPen(pen);
             add->setOpacity(double(opacity) / 100.0); // 0-100% to 0.0-1.0 values
 
-            // data
+            // data, thinned out when there is lots of it
+            bool thinned = false;
+            QVector<QPointF> samples = lineSamples(xseries, yseries, thinned);
+            add->replace(samples);
+            QVector<QPointF> source;
+            if (thinned) source.reserve(xseries.size());
             for (int i=0; i<xseries.size() && i<yseries.size(); i++) {
-                add->append(xseries.at(i), yseries.at(i));
 
                 // tell axis about the data
                 xaxis->point(xseries.at(i), yseries.at(i));
                 yaxis->point(xseries.at(i), yseries.at(i));
+
+                if (thinned) source << QPointF(xseries.at(i), yseries.at(i));
             }
+            if (thinned) sourcepoints.insert(add, source);
 
             // hardware support?
             chartview->setRenderHint(QPainter::Antialiasing);
@@ -650,6 +673,7 @@ GenericPlot::addCurve(QString name, QVector<double> xseries, QVector<double> yse
 
                 qchart->addSeries(area);
                 curves.insert(name,area);
+                if (thinned) sourcepoints.insert(area, source);
                 xaxis->series.append(area);
                 yaxis->series.append(area);
 
@@ -671,8 +695,7 @@ GenericPlot::addCurve(QString name, QVector<double> xseries, QVector<double> yse
                 dec->setName(dname);
 
                 // data
-                for (int i=0; i<xseries.size() && i<yseries.size(); i++)
-                    dec->append(xseries.at(i), yseries.at(i));
+                dec->replace(samples);
 
                 // if no line, but we still want labels then show
                 // for our data points
@@ -727,19 +750,25 @@ GenericPlot::addCurve(QString name, QVector<double> xseries, QVector<double> yse
             add->setPen(Qt::NoPen);
             add->setOpacity(double(opacity) / 100.0); // 0-100% to 0.0-1.0 values
 
-            // data
-            GenericCalculator calc; // watching as we add
+            // data, thinned out when there is lots of it
+            QVector<int> keep = scatterSamples(xseries, yseries, size*scale_);
+            QVector<QPointF> samples;
+            samples.reserve(keep.count());
+            foreach(int i, keep) samples << QPointF(xseries.at(i), yseries.at(i));
+            add->replace(samples);
+
+            bool thinned = keep.count() < qMin(xseries.size(), yseries.size());
+            QVector<QPointF> source;
+            if (thinned) source.reserve(xseries.size());
             for (int i=0; i<xseries.size() && i<yseries.size(); i++) {
-                add->append(xseries.at(i), yseries.at(i));
 
                 // tell axis about the data
                 xaxis->point(xseries.at(i), yseries.at(i));
                 yaxis->point(xseries.at(i), yseries.at(i));
 
-                // calculate stuff
-                calc.addPoint(QPointF(xseries.at(i), yseries.at(i)));
-
+                if (thinned) source << QPointF(xseries.at(i), yseries.at(i));
             }
+            if (thinned) sourcepoints.insert(add, source);
 
             if (datalabels) {
                 add->setPointLabelsFont(labelsfont);
@@ -748,12 +777,9 @@ GenericPlot::addCurve(QString name, QVector<double> xseries, QVector<double> yse
                 add->setPointLabelsFormat("@yPoint");
             }
 
-            // set the quadtree up - now we know the ranges...
-            Quadtree *tree = new Quadtree(QPointF(calc.x.min, calc.y.min), QPointF(calc.x.max, calc.y.max));
-            for (int i=0; i<xseries.size() && i<yseries.size(); i++)
-                if (xseries.at(i) != 0 && yseries.at(i) != 0) // 0,0 is common and lets ignore (usually means no data)
-                    tree->insert(GPointF(xseries.at(i), yseries.at(i), i));
-
+            // quadtree for hovering over the points we draw, reused
+            // from last time if the data hasn't changed
+            Quadtree *tree = cachedQuadtree(name, xseries, yseries, keep);
             if (tree->nodes.count() || tree->root->contents.count()) quadtrees.insert(add, tree);
 
             // hardware support?
@@ -782,8 +808,8 @@ GenericPlot::addCurve(QString name, QVector<double> xseries, QVector<double> yse
                 dec->setOpacity(double(opacity) / 100.0); // 0-100% to 0.0-1.0 values
 
                 // data
-                for (int i=0; i<xseries.size() && i<yseries.size(); i++)
-                    dec->append(xseries.at(i), yseries.at(i));
+                bool decthinned = false;
+                dec->replace(lineSamples(xseries, yseries, decthinned));
 
                 // hardware support?
                 chartview->setRenderHint(QPainter::Antialiasing);
@@ -903,12 +929,124 @@ GenericPlot::addCurve(QString name, QVector<double> xseries, QVector<double> yse
     return true;
 }
 
+// screen size bounds how much detail can be seen
+static QSize screenPixels()
+{
+    QScreen *screen = QGuiApplication::primaryScreen();
+    if (screen) return screen->size();
+    return QSize(1920, 1080);
+}
+
+// line data, min/max decimated when x is in order and there is lots of it
+QVector<QPointF>
+GenericPlot::lineSamples(const QVector<double> &xseries, const QVector<double> &yseries, bool &thinned) const
+{
+    const int n = qMin(xseries.size(), yseries.size());
+    QVector<QPointF> returning;
+    thinned = false;
+
+    bool ordered = n > gl_thinpoints;
+    for (int i=1; ordered && i<n; i++) if (!(xseries.at(i) >= xseries.at(i-1))) ordered = false;
+
+    if (ordered) {
+        MinMaxPyramid pyramid;
+        pyramid.build(xseries.constData(), yseries.constData(), n);
+        pyramid.decimate(xseries.at(0), xseries.at(n-1), screenPixels().width(), returning);
+        thinned = true;
+    } else {
+        returning.resize(n);
+        for (int i=0; i<n; i++) returning[i] = QPointF(xseries.at(i), yseries.at(i));
+    }
+    return returning;
+}
+
+// scatter data, binned to a quarter of the marker size when there is lots of it
+QVector<int>
+GenericPlot::scatterSamples(const QVector<double> &xseries, const QVector<double> &yseries, double markersize) const
+{
+    const int n = qMin(xseries.size(), yseries.size());
+    if (n > gl_thinpoints) {
+
+        // axes are fitted to the data
+        double minx=0, maxx=0, miny=0, maxy=0;
+        bool first=true;
+        for (int i=0; i<n; i++) {
+            double x = xseries.at(i), y = yseries.at(i);
+            if (!std::isfinite(x) || !std::isfinite(y)) continue;
+            if (first || x < minx) minx = x;
+            if (first || x > maxx) maxx = x;
+            if (first || y < miny) miny = y;
+            if (first || y > maxy) maxy = y;
+            first = false;
+        }
+        return HexBinner::thin(xseries, yseries, QRectF(QPointF(minx,miny), QPointF(maxx,maxy)),
+                               screenPixels(), qMax(1.0, markersize / 4.0));
+    }
+
+    QVector<int> returning(n);
+    for (int i=0; i<n; i++) returning[i] = i;
+    return returning;
+}
+
+Quadtree *
+GenericPlot::cachedQuadtree(QString name, const QVector<double> &xseries, const QVector<double> &yseries, const QVector<int> &indexes)
+{
+    // same data and same points kept
+    const int n = qMin(xseries.size(), yseries.size());
+    uint fingerprint = uint(qHashBits(xseries.constData(), n * sizeof(double)))
+                     ^ uint(qHashBits(yseries.constData(), n * sizeof(double), 0x9e3779b9))
+                     ^ uint(qHashBits(indexes.constData(), indexes.size() * sizeof(int), 0x85ebca6b));
+
+    auto it = treecache.find(name);
+    if (it != treecache.end()) {
+        if (it->fingerprint == fingerprint && !it->used) {
+            it->used = true;
+            return it->tree;
+        }
+        delete it->tree;
+        treecache.erase(it);
+    }
+
+    // set the quadtree up - now we know the ranges...
+    double minx=0, maxx=0, miny=0, maxy=0;
+    bool first=true;
+    foreach(int i, indexes) {
+        double x = xseries.at(i), y = yseries.at(i);
+        if (!std::isfinite(x) || !std::isfinite(y)) continue;
+        if (first || x < minx) minx = x;
+        if (first || x > maxx) maxx = x;
+        if (first || y < miny) miny = y;
+        if (first || y > maxy) maxy = y;
+        first = false;
+    }
+    Quadtree *tree = new Quadtree(QPointF(minx, miny), QPointF(maxx, maxy));
+    foreach(int i, indexes)
+        if (xseries.at(i) != 0 && yseries.at(i) != 0) // 0,0 is common and lets ignore (usually means no data)
+            tree->insert(GPointF(xseries.at(i), yseries.at(i), i));
+
+    CachedQuadtree cached;
+    cached.fingerprint = fingerprint;
+    cached.tree = tree;
+    cached.used = true;
+    treecache.insert(name, cached);
+    return tree;
+}
+
 // once python script has run polish the chart, fixup axes/ranges and so on.
 void
 GenericPlot::finaliseChart()
 {
     if (!qchart) return;
 
+    // drop quadtrees for series that have gone
+    for(auto it=treecache.begin(); it != treecache.end();) {
+        if (it->used) ++it;
+        else {
+            delete it->tree;
+            it = treecache.erase(it);
+        }
+    }
+
     // clear ALL axes
     foreach(QAbstractAxis *axis, qchart->axes(Qt::Vertical)) {
         qchart->removeAxis(axis);
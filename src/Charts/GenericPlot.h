@@ -34,6 +34,8 @@
 #include <QGraphicsItem>
 #include <QFontMetrics>
 #include "Quadtree.h"
+#include "MinMaxPyramid.h"
+#include "HexBinner.h"
 
 #include "GoldenCheetah.h"
 #include "Settings.h"
@@ -82,6 +84,7 @@ class GenericPlot : public QWidget {
         friend class GenericLegend;
 
         GenericPlot(QWidget *parent, Context *context, QGraphicsItem *item);
+        ~GenericPlot();
 
         // some helper functions
         static QColor seriesColor(QAbstractSeries* series);
@@ -160,6 +163,17 @@ class GenericPlot : public QWidget {
         // quadtrees
         QMap<QAbstractSeries*, Quadtree*> quadtrees;
 
+        // quadtrees by series name, kept across redraws whilst the data is the same
+        struct CachedQuadtree { uint fingerprint; Quadtree *tree; bool used; };
+        QMap<QString, CachedQuadtree> treecache;
+        Quadtree *cachedQuadtree(QString name, const QVector<double> &xseries, const QVector<double> &yseries, const QVector<int> &indexes);
+
+        // big series are thinned to the screen resolution before being added
+        // to the chart, the full data is kept here for calculating stats
+        QMap<QAbstractSeries*, QVector<QPointF> > sourcepoints;
+        QVector<QPointF> lineSamples(const QVector<double> &xseries, const QVector<double> &yseries, bool &thinned) const;
+        QVector<int> scatterSamples(const QVector<double> &xseries, const QVector<double> &yseries, double markersize) const;
+
         // annotations
         GenericAnnotationController *annotationController;
 
@@ -1047,13 +1047,20 @@ GenericSelectTool::updateScene()
                     calc.xaxis = xaxis;
                     calc.yaxis = yaxis;
                     calc.series = line;
+                    const QVector<QPointF> *source = host->sourcepoints.contains(x) ? &host->sourcepoints[x] : NULL;
                     for(int i=0; i<line->count(); i++) {
                         QPointF point = line->at(i); // avoid deep copy
                         if (point.x() >= minx && point.x() <= maxx) {
                             if (!points.contains(point)) points << point; // avoid dupes
-                            calc.addPoint(point);
+                            if (!source) calc.addPoint(point);
                         }
                     }
+
+                    // line was thinned for drawing, stats use all the data
+                    if (source) {
+                        foreach(const QPointF &point, *source)
+                            if (point.x() >= minx && point.x() <= maxx) calc.addPoint(point);
+                    }
                     calc.finalise();
                     stats.insert(line, calc);
 
@@ -1126,14 +1133,22 @@ GenericSelectTool::updateScene()
                     calc.xaxis = xaxis;
                     calc.yaxis = yaxis;
                     calc.series = scatter;
+                    const QVector<QPointF> *source = host->sourcepoints.contains(x) ? &host->sourcepoints[x] : NULL;
                     for(int i=0; i<scatter->count(); i++) {
                         QPointF point = scatter->at(i); // avoid deep copy
                         if (point.y() >= miny && point.y() <= maxy &&
                             point.x() >= minx && point.x() <= maxx) {
                             if (!points.contains(point)) points << point; // avoid dupes
-                            calc.addPoint(point);
+                            if (!source) calc.addPoint(point);
                         }
                     }
+
+                    // points were binned for drawing, stats use all the data
+                    if (source) {
+                        foreach(const QPointF &point, *source)
+                            if (point.y() >= miny && point.y() <= maxy &&
+                                point.x() >= minx && point.x() <= maxx) calc.addPoint(point);
+                    }
                     calc.finalise();
                     stats.insert(scatter, calc);
 
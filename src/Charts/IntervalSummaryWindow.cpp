@@ -141,6 +141,10 @@ QString IntervalSummaryWindow::summary(QList<IntervalItem*> intervals, QString &
     RideFile f(const_cast<RideFile*>(ride));
     RideFile notf(const_cast<RideFile*>(ride));
 
+    // the derived series are copied across below
+    if (ride) const_cast<RideFile*>(ride)->derive(RideFile::DeriveNP | RideFile::DeriveXP | RideFile::DeriveAPower |
+                                                  RideFile::DeriveSlope | RideFile::DeriveCoreTemp);
+
     // for concatenating intervals
     RideFilePoint *last = NULL;
     double timeOff=0;
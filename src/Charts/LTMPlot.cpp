@@ -2551,7 +2551,7 @@ LTMPlot::createTODCurveData(Context *context, LTMSettings *settings, MetricDetai
     // curve specific filter
     Specification spec = settings->specification;
     if (!SearchFilterBox::isNull(metricDetail.datafilter))
-        spec.addMatches(SearchFilterBox::matches(context, metricDetail.datafilter));
+        spec.addMatches(SearchFilterBox::filterMatches(context, metricDetail.datafilter));
 
     foreach (RideItem *ride, context->athlete->rideCache->rides()) {
 
@@ -2674,7 +2674,7 @@ LTMPlot::createMetricData(Context *context, LTMSettings *settings, MetricDetail
     // curve specific filter
     Specification spec = settings->specification;
     if (!SearchFilterBox::isNull(metricDetail.datafilter))
-        spec.addMatches(SearchFilterBox::matches(context, metricDetail.datafilter));
+        spec.addMatches(SearchFilterBox::filterMatches(context, metricDetail.datafilter));
 
     //
     double ymean_prev=0.0;
@@ -2838,7 +2838,7 @@ LTMPlot::createFormulaData(Context *context, LTMSettings *settings, MetricDetail
     // curve specific filter
     Specification spec = settings->specification;
     if (!SearchFilterBox::isNull(metricDetail.datafilter))
-        spec.addMatches(SearchFilterBox::matches(context, metricDetail.datafilter));
+        spec.addMatches(SearchFilterBox::filterMatches(context, metricDetail.datafilter));
 
     foreach (RideItem *ride, context->athlete->rideCache->rides()) { 
 
@@ -2967,7 +2967,7 @@ LTMPlot::createBestsData(Context *, LTMSettings *settings, MetricDetail metricDe
 
         // add the curve filters to the specification to use
         Specification spec = settings->specification;
-        spec.addMatches(SearchFilterBox::matches(context, metricDetail.datafilter));
+        spec.addMatches(SearchFilterBox::filterMatches(context, metricDetail.datafilter));
         bestresults = RideFileCache::getAllBestsFor(context, settings->metrics, spec);
 
     } else {
@@ -3068,7 +3068,7 @@ LTMPlot::createEstimateData(Context *context, LTMSettings *settings, MetricDetai
     // curve specific filter, used to figure out if all activities are from the same sport
     Specification spec = settings->specification;
     if (!SearchFilterBox::isNull(metricDetail.datafilter))
-        spec.addMatches(SearchFilterBox::matches(context, metricDetail.datafilter));
+        spec.addMatches(SearchFilterBox::filterMatches(context, metricDetail.datafilter));
     int nActivities, nRides, nRuns, nSwims;
     QString sport;
     context->athlete->rideCache->getRideTypeCounts(spec, nActivities, nRides, nRuns, nSwims, sport);
@@ -3429,7 +3429,7 @@ LTMPlot::createPMCData(Context *context, LTMSettings *settings, MetricDetail met
 
         // curve specific filter
         if (!SearchFilterBox::isNull(metricDetail.datafilter))
-            allDates.addMatches(SearchFilterBox::matches(context, metricDetail.datafilter));
+            allDates.addMatches(SearchFilterBox::filterMatches(context, metricDetail.datafilter));
 
         allDates.setDateRange(DateRange(QDate(),QDate()));
         localPMC = new PMCData(context, allDates, scoreType);
@@ -3750,7 +3750,7 @@ LTMPlot::createPerformanceData(Context *context, LTMSettings *settings, MetricDe
     // curve specific filter, used to figure out if all activities are from the same sport
     Specification spec = settings->specification;
     if (!SearchFilterBox::isNull(metricDetail.datafilter))
-        spec.addMatches(SearchFilterBox::matches(context, metricDetail.datafilter));
+        spec.addMatches(SearchFilterBox::filterMatches(context, metricDetail.datafilter));
     int nActivities, nRides, nRuns, nSwims;
     QString sport;
     context->athlete->rideCache->getRideTypeCounts(spec, nActivities, nRides, nRuns, nSwims, sport);
@@ -88,7 +88,7 @@ static void setFilter(ChartSpaceItem *item, Specification &spec)
             fs.addFilter(item->parent->window->myPerspective->isFiltered(), item->parent->window->myPerspective->filterlist(item->parent->myDateRange));
 
         // local filter
-        fs.addFilter(item->datafilter != "", SearchFilterBox::matches(item->parent->context, item->datafilter));
+        fs.addFilter(item->datafilter != "", SearchFilterBox::filterMatches(item->parent->context, item->datafilter));
         spec.setFilterSet(fs);
     }
     return;
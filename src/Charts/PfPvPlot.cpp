@@ -536,6 +536,8 @@ PfPvPlot::setData(RideItem *_rideItem)
         // quickly erase old data
         mainCurvesSetVisible(false);
 
+        // gear ratios are derived
+        ride->deriveSeries(RideFile::gear);
 
         // due to the discrete power and cadence values returned by the
         // power meter, there will very likely be many duplicate values.
@@ -49,15 +49,10 @@ PlanAdherenceWindow::PlanAdherenceWindow(Context *context)
 
     connect(adherenceView, &PlanAdherenceView::monthChanged, this, &PlanAdherenceWindow::updateActivities);
     connect(adherenceView, &PlanAdherenceView::viewActivity, this, [this](QString reference, bool planned) {
-        for (RideItem *rideItem : this->context->athlete->rideCache->rides()) {
-            if (rideItem == nullptr || rideItem->fileName.isEmpty()) {
-                continue;
-            }
-            if (rideItem->fileName == reference && rideItem->planned == planned) {
-                this->context->notifyRideSelected(rideItem);
-                this->context->mainWindow->selectAnalysis();
-                break;
-            }
+        RideItem *rideItem = this->context->athlete->rideCache->getRide(reference, planned);
+        if (rideItem != nullptr) {
+            this->context->notifyRideSelected(rideItem);
+            this->context->mainWindow->selectAnalysis();
         }
     });
     connect(context->athlete->rideCache, QOverload<RideItem*>::of(&RideCache::itemChanged), this, &PlanAdherenceWindow::updateActivitiesIfInRange);
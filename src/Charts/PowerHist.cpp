@@ -1834,6 +1834,9 @@ PowerHist::setData(RideItem *_rideItem, bool force)
 
     RideFile *ride = rideItem->ride();
 
+    // the aPower and gear histograms are of derived series
+    ride->derive(RideFile::DeriveAPower | RideFile::DeriveGear);
+
     bool hasData = ((series == RideFile::watts || series == RideFile::wattsKg) && ride->areDataPresent()->watts) ||
                    (series == RideFile::nm && ride->areDataPresent()->nm) ||
                    (series == RideFile::kph && ride->areDataPresent()->kph) ||
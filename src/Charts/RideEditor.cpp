@@ -1758,6 +1758,19 @@ RideEditor::endCommand(bool undo, RideCommand *cmd)
 
             break;
         }
+        case RideCommand::SetPointValues:
+        {
+            SetPointValuesCommand *spv = (SetPointValuesCommand*)cmd;
+
+            // highlight all the cells updated with a single selection change
+            int column = model->columnFor(spv->series);
+            QItemSelection highlight;
+            foreach(int row, spv->rows) highlight.select(model->index(row, column), model->index(row, column));
+
+            if (!inLUW) table->selectionModel()->clearSelection();
+            table->selectionModel()->select(highlight, QItemSelectionModel::Select);
+            break;
+        }
         case RideCommand::InsertPoint:
         {
             InsertPointCommand *ip = (InsertPointCommand *)cmd;
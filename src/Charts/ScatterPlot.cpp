@@ -299,6 +299,9 @@ void ScatterPlot::setData (ScatterSettings *settings)
     // get application settings
     cranklength = appsettings->cvalue(context->athlete->cyclist, GC_CRANKLENGTH, 175.00).toDouble() / 1000.0;
 
+    // slope, gear and haemoglobin may need deriving
+    settings->ride->ride()->derive(RideFile::DeriveSlope | RideFile::DeriveGear | RideFile::DeriveHb);
+
     // how many curves do we need ?
     if (xseries == MODEL_TE || xseries == MODEL_PS ||
         yseries == MODEL_TE || yseries == MODEL_PS) {
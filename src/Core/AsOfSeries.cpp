@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "AsOfSeries.h"
+
+#include <algorithm>
+
+void
+AsOfSeries::clear()
+{
+    fields = 0;
+    dates.clear();
+    values.clear();
+    first = QDate();
+    dayIndex.clear();
+    daily.clear();
+}
+
+void
+AsOfSeries::build(const QVector<QDate> &dates, const QVector<double> &values, int fields)
+{
+    clear();
+    if (dates.isEmpty() || !dates.first().isValid() || fields <= 0 || values.count() < dates.count() * fields) return;
+
+    this->fields = fields;
+    this->dates = dates;
+    this->values = values;
+
+    // every day from the first reading to the last
+    first = dates.first();
+    const int days = first.daysTo(dates.last()) + 1;
+    dayIndex.resize(days);
+    daily.resize(fields);
+    for (int f=0; f<fields; f++) daily[f].resize(days);
+
+    int reading = 0;
+    for (int d=0; d<days; d++) {
+        const QDate date = first.addDays(d);
+        while (reading+1 < dates.count() && dates[reading+1] <= date) reading++;
+        dayIndex[d] = reading;
+        for (int f=0; f<fields; f++) daily[f][d] = values[reading * fields + f];
+    }
+}
+
+int
+AsOfSeries::indexAsOf(QDate date) const
+{
+    if (dates.isEmpty() || date < first) return -1;
+    if (date >= dates.last()) return dates.count() - 1;
+    return dayIndex[day(date)];
+}
+
+int
+AsOfSeries::indexOn(QDate date) const
+{
+    int index = indexAsOf(date);
+    return (index >= 0 && dates[index] == date) ? index : -1;
+}
+
+double
+AsOfSeries::valueAsOf(QDate date, int field) const
+{
+    if (field < 0 || field >= fields || date < first) return 0;
+    if (date >= dates.last()) return values[(dates.count() - 1) * fields + field];
+    return daily[field][day(date)];
+}
+
+double
+AsOfSeries::valueOn(QDate date, int field) const
+{
+    if (field < 0 || field >= fields) return 0;
+    int index = indexOn(date);
+    return index >= 0 ? values[index * fields + field] : 0;
+}
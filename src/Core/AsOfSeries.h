@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _GC_AsOfSeries_h
+#define _GC_AsOfSeries_h 1
+
+#include <QDate>
+#include <QVector>
+
+//
+// Readings of a few fields taken on dates, e.g. body weight, looked up by
+// the reading in force on a date rather than walking them all each time.
+//
+// The reading on or before each day between the first and last is worked
+// out when built, along with the value of each field it gives, so a lookup
+// is just an offset into them. Rebuild it whenever the readings change.
+//
+class AsOfSeries
+{
+    public:
+
+        AsOfSeries() : fields(0) {}
+
+        // dates in order, values holds fields for each reading one after
+        // another; nothing is kept if any date isn't valid
+        void build(const QVector<QDate> &dates, const QVector<double> &values, int fields);
+        void clear();
+
+        int count() const { return dates.count(); }
+
+        // index of the last reading on or before date, -1 if none
+        int indexAsOf(QDate date) const;
+
+        // index of the last reading on date, -1 if none
+        int indexOn(QDate date) const;
+
+        // the field from the last reading on or before / on the date, 0 if none
+        double valueAsOf(QDate date, int field) const;
+        double valueOn(QDate date, int field) const;
+
+    private:
+
+        int day(QDate date) const { return first.daysTo(date); }
+
+        int fields;
+        QVector<QDate> dates;
+        QVector<double> values;
+
+        // for each day first..last
+        QDate first;
+        QVector<int> dayIndex;              // reading as-of the day
+        QVector<QVector<double> > daily;    // its value for each field
+};
+
+#endif
@@ -266,21 +266,29 @@ Athlete::~Athlete()
 
 }
 
-void Athlete::selectRideFile(QString fileName)
+void Athlete::selectRideFile(QString fileName, bool background)
 {
-    // it already is ...
-    if (context->ride && context->ride->fileName == fileName) return;
+    // it already is, but the user may have clicked on another that
+    // is still loading on the way back here, so forget that one
+    if (context->ride && context->ride->fileName == fileName) {
+        rideCache->residency()->cancelSelection();
+        return;
+    }
 
     // lets find it
     foreach (RideItem *rideItem, rideCache->rides()) {
 
-        context->ride = (RideItem*) rideItem;
-        if (context->ride->fileName == fileName)  {
-            // lets open it before we let folks know
-            context->ride->ride();
-            break;
+        if (rideItem->fileName == fileName)  {
+            // lets open it before we let folks know, the activity list
+            // asks for it in the background so we don't hang whilst it's
+            // read, everyone else expects it selected when we return
+            rideCache->residency()->select(rideItem, !background);
+            return;
         }
     }
+
+    // not there, as we always have fall back to the last one
+    if (rideCache->rides().count()) context->ride = rideCache->rides().last();
     context->notifyRideSelected(context->ride);
 }
 
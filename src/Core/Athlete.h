@@ -143,7 +143,7 @@ class Athlete : public QObject
         Context *context;
 
         // ride collection
-        void selectRideFile(QString);
+        void selectRideFile(QString, bool background=false);
         void addRide(QString name, bool signal, bool select=true, bool useTempActivities=false, bool planned=false);
         void removeCurrentRide();
 
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "ColumnCodec.h"
+
+#include <QByteArray>
+#include <cstring>
+
+void
+ColumnCodec::write(QDataStream &out, const QVector<double> &values)
+{
+    const int n = values.count();
+
+    // all the same ? (bitwise, so NaN and -0 come back as they went in)
+    bool constant = true;
+    for (int i=1; i<n && constant; i++)
+        constant = std::memcmp(&values[i], &values[0], sizeof(double)) == 0;
+
+    if (constant) {
+        out << quint8(Constant) << (n ? values[0] : 0.0);
+        return;
+    }
+
+    // xor with previous, leaves mostly zero bytes for a slowly changing series
+    QByteArray delta(n * int(sizeof(quint64)), Qt::Uninitialized);
+    quint64 *bits = reinterpret_cast<quint64*>(delta.data());
+    quint64 last = 0;
+    for (int i=0; i<n; i++) {
+        quint64 v;
+        std::memcpy(&v, &values[i], sizeof(v));
+        bits[i] = v ^ last;
+        last = v;
+    }
+
+    QByteArray packed = qCompress(delta, 1);
+    if (packed.size() < delta.size() * 3 / 4) {
+        out << quint8(Packed) << packed;
+    } else {
+        out << quint8(Raw);
+        out.writeRawData(reinterpret_cast<const char*>(values.constData()), n * int(sizeof(double)));
+    }
+}
+
+bool
+ColumnCodec::read(QDataStream &in, QVector<double> &values, int count)
+{
+    quint8 encoding;
+    in >> encoding;
+    if (in.status() != QDataStream::Ok || count < 0) return false;
+
+    values.resize(count);
+    const int bytes = count * int(sizeof(double));
+
+    switch (encoding) {
+
+    case Constant:
+        {
+            double value;
+            in >> value;
+            values.fill(value);
+        }
+        break;
+
+    case Raw:
+        if (in.readRawData(reinterpret_cast<char*>(values.data()), bytes) != bytes) return false;
+        break;
+
+    case Packed:
+        {
+            QByteArray packed;
+            in >> packed;
+            QByteArray delta = qUncompress(packed);
+            if (delta.size() != bytes) return false;
+
+            const quint64 *bits = reinterpret_cast<const quint64*>(delta.constData());
+            quint64 last = 0;
+            for (int i=0; i<count; i++) {
+                last ^= bits[i];
+                std::memcpy(&values[i], &last, sizeof(last));
+            }
+        }
+        break;
+
+    default:
+        return false;
+    }
+    return in.status() == QDataStream::Ok;
+}
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _GC_ColumnCodec_h
+#define _GC_ColumnCodec_h 1
+
+#include <QVector>
+#include <QDataStream>
+
+//
+// Lossless storage for a column of doubles, as used by the binary ride
+// file sidecar. Each column is stored one of three ways:
+//
+//  - constant: a single value, most series in most rides are all zero
+//  - packed:   each value xor'd with the one before and zlib compressed,
+//              slowly changing series (time, distance, altitude) leave
+//              long runs of zero bytes after the xor and pack well
+//  - raw:      the values as they are, when packing doesn't pay
+//
+// Values are stored in host byte order, the stream header records which
+// so a file moved to a different architecture is simply rebuilt.
+//
+class ColumnCodec
+{
+    public:
+
+        enum Encoding { Constant=0, Raw=1, Packed=2 };
+
+        static void write(QDataStream &out, const QVector<double> &values);
+
+        // count comes from the caller, false if the stream is short or corrupt
+        static bool read(QDataStream &in, QVector<double> &values, int count);
+
+        // marker written alongside the columns
+        static quint32 byteOrder() { return 0x01020304; }
+};
+
+#endif
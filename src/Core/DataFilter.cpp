@@ -159,7 +159,7 @@ static struct {
                         // the last parameter defines if duration (secs) or power (watts) values are returned
 
     // banister function
-    { "banister", 3 }, // banister(load_metric, perf_metric, nte|pte|perf|cp)
+    { "banister", 3 }, // banister(load_metric, perf_metric, nte|pte|perf|cp|date|t1|t2)
 
     // working with vectors
 
@@ -569,7 +569,7 @@ DataFilter::builtins(Context *context)
 
         } else if (i == 44) {
             // banister
-            returning << "banister(load_metric, perf_metric, nte|pte|perf|cp|date)";
+            returning << "banister(load_metric, perf_metric, nte|pte|perf|cp|date|t1|t2)";
 
         } else if (i == 45) {
 
@@ -2949,7 +2949,7 @@ void Leaf::validateFilter(Context *context, DataFilterRuntime *df, Leaf *leaf)
                     // 3 parameters
                     if (leaf->fparms.count() != 3) {
                         leaf->inerror = true;
-                        DataFiltererrors << QString(tr("should be banister(load_metric, perf_metric, nte|pte|perf|cp|date)"));
+                        DataFiltererrors << QString(tr("should be banister(load_metric, perf_metric, nte|pte|perf|cp|date|t1|t2)"));
                     } else {
 
                         Leaf *first=leaf->fparms[0];
@@ -2974,10 +2974,10 @@ void Leaf::validateFilter(Context *context, DataFilterRuntime *df, Leaf *leaf)
 
                         // check value
                         QString value = third->signature();
-                        QRegExp banSymbols("^(nte|pte|perf|cp|date)$", Qt::CaseInsensitive);
+                        QRegExp banSymbols("^(nte|pte|perf|cp|date|t1|t2)$", Qt::CaseInsensitive);
                         if (!banSymbols.exactMatch(value)) {
                             leaf->inerror = true;
-                            DataFiltererrors << QString("unknown %1, should be nte,pte,perf or cp.").arg(value);
+                            DataFiltererrors << QString("unknown %1, should be nte,pte,perf,cp,date,t1 or t2.").arg(value);
                         }
                     }
 
@@ -3398,7 +3398,7 @@ Result DataFilter::evaluate(DateRange dr, QString filter)
 
     Specification spec;
     spec.setDateRange(dr);
-    if (filter != "")  spec.addMatches(SearchFilterBox::matches(context, filter));
+    if (filter != "")  spec.addMatches(SearchFilterBox::filterMatches(context, filter));
 
     return evaluate(spec, dr);
 }
@@ -4939,6 +4939,7 @@ Result Leaf::eval(DataFilterRuntime *df, Leaf *leaf, const Result &x, long it, R
                     if (!s.isEmpty(m->ride())) {
 
                         // spec may limit to an interval
+                        m->ride()->deriveSeries(leaf->seriesType);
                         RideFileIterator it(m->ride(), s);
                         while(it.hasNext()) {
                             struct RideFilePoint *p = it.next();
@@ -6766,6 +6767,13 @@ Result Leaf::eval(DataFilterRuntime *df, Leaf *leaf, const Result &x, long it, R
             Result returning(0);
             int  si=0;
 
+            // the best fitting decays for the athlete, rather than a series
+            if (value == "t1" || value == "t2") {
+                double t1, t2;
+                if (banister->fitDecay(t1, t2)) returning.number() = value == "t1" ? t1 : t2;
+                return returning;
+            }
+
             for(QDate date=banister->start; date < banister->stop; date=date.addDays(1)) {
                 // index
                 if (date >= d.from && date <= d.to) {
@@ -7928,6 +7936,7 @@ Result Leaf::eval(DataFilterRuntime *df, Leaf *leaf, const Result &x, long it, R
 
             RideFile::SeriesType type = RideFile::seriesForSymbol((*(leaf->lvalue.n)));
             if (type == RideFile::index) return Result(m->ride()->dataPoints().indexOf(p));
+            m->ride()->deriveSeries(type);
             return Result(p->value(type));
         }
 
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _GC_DateIndex_h
+#define _GC_DateIndex_h 1
+
+#include <QDate>
+#include <QDateTime>
+#include <QString>
+#include <QVector>
+#include <QMap>
+#include <QHash>
+#include <algorithm>
+
+//
+// Items by the day they fall on, e.g. the activities in RideCache, so the
+// calendar and plan views can take just the days they show and look an
+// item up by its file name, rather than walking every item for each.
+//
+// Actual and planned items are kept apart in buckets for each day, sorted
+// by time within the day. Items are added, moved and removed one at a time
+// as they change; the date and file name they were filed under are kept so
+// an item can be moved or removed without knowing where it was.
+//
+template <typename T>
+class DateIndex
+{
+    public:
+
+        void clear() {
+            for (int i=0; i<2; i++) {
+                days[i].clear();
+                files[i].clear();
+            }
+            keys.clear();
+        }
+
+        int count() const { return keys.count(); }
+        bool contains(T item) const { return keys.contains(item); }
+
+        // file an item, or move it if it is already here
+        void insert(T item, const QDateTime &when, const QString &fileName, bool planned) {
+            remove(item);
+
+            Key key = { when, fileName, planned };
+            keys.insert(item, key);
+
+            Entry entry = { when, item };
+            QVector<Entry> &day = days[planned][when.date()];
+            day.insert(std::upper_bound(day.begin(), day.end(), entry) - day.begin(), entry);
+
+            files[planned].insert(fileName, item);
+        }
+
+        void remove(T item) {
+            typename QHash<T, Key>::iterator k = keys.find(item);
+            if (k == keys.end()) return;
+            const Key &key = k.value();
+
+            typename QMap<QDate, QVector<Entry> >::iterator d = days[key.planned].find(key.when.date());
+            if (d != days[key.planned].end()) {
+                for (int i=0; i<d.value().count(); i++) {
+                    if (d.value().at(i).item == item) {
+                        d.value().remove(i);
+                        break;
+                    }
+                }
+                if (d.value().isEmpty()) days[key.planned].erase(d);
+            }
+
+            // another item may have taken the name since
+            typename QHash<QString, T>::iterator f = files[key.planned].find(key.fileName);
+            if (f != files[key.planned].end() && f.value() == item) files[key.planned].erase(f);
+
+            keys.erase(k);
+        }
+
+        // by file name, actual before planned when not saying which
+        T find(const QString &fileName, bool planned) const { return files[planned].value(fileName, T()); }
+        T find(const QString &fileName) const {
+            T item = files[0].value(fileName, T());
+            return item ? item : files[1].value(fileName, T());
+        }
+
+        // items on days from..to inclusive, in date and time order; an
+        // invalid to has no end
+        QVector<T> between(QDate from, QDate to, bool planned) const {
+            QVector<T> returning;
+            QVector<Entry> entries = range(from, to, planned);
+            returning.reserve(entries.count());
+            foreach(const Entry &entry, entries) returning << entry.item;
+            return returning;
+        }
+
+        // both actual and planned, actual first at the same time
+        QVector<T> between(QDate from, QDate to) const {
+            QVector<Entry> actual = range(from, to, false);
+            QVector<Entry> planned = range(from, to, true);
+            QVector<Entry> merged(actual.count() + planned.count());
+            std::merge(actual.begin(), actual.end(), planned.begin(), planned.end(), merged.begin());
+
+            QVector<T> returning;
+            returning.reserve(merged.count());
+            foreach(const Entry &entry, merged) returning << entry.item;
+            return returning;
+        }
+
+        // days with any items from..to
+        QVector<QDate> daysBetween(QDate from, QDate to, bool planned) const {
+            QVector<QDate> returning;
+            typename QMap<QDate, QVector<Entry> >::const_iterator d = days[planned].lowerBound(from);
+            for (; d != days[planned].constEnd() && (!to.isValid() || d.key() <= to); ++d) returning << d.key();
+            return returning;
+        }
+
+    private:
+
+        struct Key {
+            QDateTime when;
+            QString fileName;
+            bool planned;
+        };
+
+        struct Entry {
+            QDateTime when;
+            T item;
+            bool operator<(const Entry &right) const { return when < right.when; }
+        };
+
+        QVector<Entry> range(QDate from, QDate to, bool planned) const {
+            QVector<Entry> returning;
+            typename QMap<QDate, QVector<Entry> >::const_iterator d = days[planned].lowerBound(from);
+            for (; d != days[planned].constEnd() && (!to.isValid() || d.key() <= to); ++d) returning << d.value();
+            return returning;
+        }
+
+        QMap<QDate, QVector<Entry> > days[2];     // actual, planned
+        QHash<QString, T> files[2];
+        QHash<T, Key> keys;
+};
+
+#endif
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "DemTiles.h"
+
+#include <QFile>
+#include <QDir>
+#include <QtEndian>
+#include <QMutexLocker>
+#include <algorithm>
+#include <cmath>
+
+#define DEM_VOID (-32768)
+
+const double DemTiles::NoData = DEM_VOID;
+
+// tiles in the cache are keyed on their corner
+static inline int tileKey(int lat, int lon) { return (lat + 90) * 360 + (lon + 180); }
+
+DemTile::DemTile(const QString &filename) : file(new QFile(filename)), data(NULL), size(0), south(0), west(0)
+{
+    // which tile is it
+    QString name = QFileInfo(filename).baseName().toUpper();
+    if (name.length() != 7) return;
+    south = name.mid(1,2).toInt() * (name[0] == 'S' ? -1 : 1);
+    west = name.mid(4,3).toInt() * (name[3] == 'W' ? -1 : 1);
+
+    if (!file->open(QFile::ReadOnly)) return;
+
+    // the resolution is in the size, 3" or 1"
+    qint64 bytes = file->size();
+    if (bytes == 1201 * 1201 * 2) size = 1201;
+    else if (bytes == 3601 * 3601 * 2) size = 3601;
+    else return;
+
+    data = file->map(0, bytes);
+}
+
+DemTile::~DemTile()
+{
+    delete file; // unmaps
+}
+
+double
+DemTile::elevation(double lat, double lon) const
+{
+    // fractional post, north row first
+    const double y = (south + 1 - lat) * (size - 1);
+    const double x = (lon - west) * (size - 1);
+
+    const int r = std::min(std::max(int(y), 0), size - 2);
+    const int c = std::min(std::max(int(x), 0), size - 2);
+    const double fy = std::min(std::max(y - r, 0.0), 1.0);
+    const double fx = std::min(std::max(x - c, 0.0), 1.0);
+
+    const qint16 *posts = reinterpret_cast<const qint16*>(data);
+    const double v[4] = { double(qFromBigEndian(posts[r * size + c])),
+                          double(qFromBigEndian(posts[r * size + c + 1])),
+                          double(qFromBigEndian(posts[(r+1) * size + c])),
+                          double(qFromBigEndian(posts[(r+1) * size + c + 1])) };
+    const double w[4] = { (1-fx) * (1-fy), fx * (1-fy), (1-fx) * fy, fx * fy };
+
+    // voids are left out and the rest reweighted
+    double sum = 0, weight = 0;
+    for (int i=0; i<4; i++) {
+        if (v[i] == DEM_VOID) continue;
+        sum += v[i] * w[i];
+        weight += w[i];
+    }
+    if (weight > 0) return sum / weight;
+
+    // on a post next to a void, use it
+    for (int i=0; i<4; i++) if (v[i] != DEM_VOID) return v[i];
+    return DEM_VOID;
+}
+
+DemTiles::DemTiles(int maxTiles) : tiles(std::max(maxTiles, 1))
+{
+}
+
+void
+DemTiles::setDirectory(const QString &directory)
+{
+    QMutexLocker locker(&mutex);
+    if (directory == dir) return;
+    dir = directory;
+    tiles.clear();
+}
+
+QString
+DemTiles::directory() const
+{
+    QMutexLocker locker(&mutex);
+    return dir;
+}
+
+bool
+DemTiles::isValid() const
+{
+    QMutexLocker locker(&mutex);
+    if (dir == "") return false;
+    return !QDir(dir).entryList(QStringList() << "*.hgt" << "*.HGT", QDir::Files).isEmpty();
+}
+
+QString
+DemTiles::tileName(int lat, int lon)
+{
+    return QString("%1%2%3%4.hgt")
+           .arg(QChar(lat < 0 ? 'S' : 'N')).arg(qAbs(lat), 2, 10, QChar('0'))
+           .arg(QChar(lon < 0 ? 'W' : 'E')).arg(qAbs(lon), 3, 10, QChar('0'));
+}
+
+DemTile *
+DemTiles::tile(int lat, int lon)
+{
+    int key = tileKey(lat, lon);
+    DemTile *returning = tiles.object(key);
+    if (returning) return returning;
+
+    // missing tiles are cached too, so we only look for them once
+    QString filename = QDir(dir).absoluteFilePath(tileName(lat, lon));
+    if (!QFile::exists(filename)) filename = QDir(dir).absoluteFilePath(tileName(lat, lon).toLower());
+    returning = new DemTile(filename);
+    tiles.insert(key, returning);
+    return returning;
+}
+
+QVector<double>
+DemTiles::elevation(const QVector<double> &lat, const QVector<double> &lon)
+{
+    const int n = std::min(lat.count(), lon.count());
+    QVector<double> returning(n, NoData);
+
+    // order the points by tile, a track rarely crosses more than a few
+    // but can wander back and forth across an edge
+    QVector<int> keys(n), order(n);
+    for (int i=0; i<n; i++) {
+        order[i] = i;
+        if (std::isfinite(lat[i]) && std::isfinite(lon[i]) && lat[i] >= -90 && lat[i] < 90 && lon[i] >= -180 && lon[i] < 180)
+            keys[i] = tileKey(int(std::floor(lat[i])), int(std::floor(lon[i])));
+        else
+            keys[i] = -1;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return keys[a] < keys[b]; });
+
+    QMutexLocker locker(&mutex);
+    if (dir == "") return returning;
+
+    for (int i=0; i<n;) {
+        const int key = keys[order[i]];
+        int j = i;
+        while (j < n && keys[order[j]] == key) j++;
+
+        if (key >= 0) {
+            DemTile *t = tile(key / 360 - 90, key % 360 - 180);
+            if (t->isValid())
+                for (int k=i; k<j; k++) returning[order[k]] = t->elevation(lat[order[k]], lon[order[k]]);
+        }
+        i = j;
+    }
+    return returning;
+}
+
+double
+DemTiles::elevation(double lat, double lon)
+{
+    return elevation(QVector<double>() << lat, QVector<double>() << lon)[0];
+}
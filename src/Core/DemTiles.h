@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _GC_DemTiles_h
+#define _GC_DemTiles_h 1
+
+#include <QString>
+#include <QVector>
+#include <QCache>
+#include <QMutex>
+
+class QFile;
+
+//
+// Elevation from a local directory of SRTM .hgt tiles, for when there is
+// no network or we don't want to send a track off to a web service.
+//
+// Tiles are one degree square, named for their south west corner as
+// N45E006.hgt, and hold 1201x1201 (3") or 3601x3601 (1") big endian
+// signed 16 bit heights in metres, north row first. They are memory
+// mapped as they are needed and the most recently used are kept mapped.
+//
+class DemTile
+{
+    public:
+        DemTile(const QString &filename);
+        ~DemTile();
+
+        bool isValid() const { return data != NULL; }
+
+        // bilinear between the four posts around lat/lon, which must be
+        // within the tile, NoData if they are all voids
+        double elevation(double lat, double lon) const;
+
+    private:
+        QFile *file;
+        const uchar *data;
+        int size;           // posts per side
+        int south, west;    // corner, degrees
+};
+
+class DemTiles
+{
+    public:
+
+        static const double NoData; // -32768, as a void in the tiles
+
+        DemTiles(int maxTiles = 16);
+
+        // changing directory drops any mapped tiles
+        void setDirectory(const QString &directory);
+        QString directory() const;
+
+        // is there at least one tile to use?
+        bool isValid() const;
+
+        // elevations for a whole track in one call, points are taken
+        // a tile at a time so each is looked up once. Outside any tile
+        // or where it is void gets NoData
+        QVector<double> elevation(const QVector<double> &lat, const QVector<double> &lon);
+
+        // convenience for a single point
+        double elevation(double lat, double lon);
+
+        // tile names use the corner, floor(lat) and floor(lon)
+        static QString tileName(int lat, int lon);
+
+    private:
+
+        DemTile *tile(int lat, int lon); // with mutex held
+
+        mutable QMutex mutex;
+        QString dir;
+        QCache<int, DemTile> tiles; // least recently used are unmapped
+};
+
+#endif
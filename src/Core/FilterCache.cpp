@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "FilterCache.h"
+#include "Context.h"
+#include "Athlete.h"
+#include "RideCache.h"
+#include "RideItem.h"
+#include "DataFilter.h"
+#include "FreeSearch.h"
+
+QStringList
+FilterMatches::toStringList() const
+{
+    QStringList returning;
+    if (!rides) return returning;
+    for (int i=0; i<bits.size(); i++)
+        if (bits.testBit(i)) returning << rides->fileNames[i];
+    return returning;
+}
+
+FilterCache::FilterCache(Context *context, QObject *parent) : QObject(parent), context(context), hits_(0), misses_(0)
+{
+    // anything that could change what a filter matches
+    connect(context, SIGNAL(rideAdded(RideItem*)), this, SLOT(itemChanged(RideItem*)));
+    connect(context, SIGNAL(rideDeleted(RideItem*)), this, SLOT(itemChanged(RideItem*)));
+    connect(context, SIGNAL(rideChanged(RideItem*)), this, SLOT(itemChanged(RideItem*)));
+    connect(context, SIGNAL(rideSaved(RideItem*)), this, SLOT(itemChanged(RideItem*)));
+    connect(context, SIGNAL(metadataFlush()), this, SLOT(invalidate()));
+    connect(context, SIGNAL(refreshUpdate(QDate)), this, SLOT(invalidate()));
+    connect(context, SIGNAL(refreshEnd()), this, SLOT(invalidate()));
+    connect(context, SIGNAL(userMetricsChanged()), this, SLOT(recompile()));
+    connect(context, SIGNAL(configChanged(qint32)), this, SLOT(configChanged(qint32)));
+}
+
+FilterCache::~FilterCache()
+{
+    qDeleteAll(compiled);
+}
+
+void
+FilterCache::invalidate()
+{
+    QMutexLocker locker(&mutex);
+    results.clear();
+    rides.clear();
+}
+
+void
+FilterCache::recompile()
+{
+    // metrics and metadata fields may have come or gone, so filters
+    // need compiling again as well
+    QMutexLocker locker(&mutex);
+    results.clear();
+    rides.clear();
+    qDeleteAll(compiled);
+    compiled.clear();
+}
+
+FilterMatches
+FilterCache::matches(const QString &filter)
+{
+    QMutexLocker locker(&mutex);
+
+    QHash<QString, FilterMatches>::const_iterator found = results.constFind(filter);
+    if (found != results.constEnd()) {
+        hits_++;
+        return found.value();
+    }
+    misses_++;
+
+    const QVector<RideItem*> &items = context->athlete->rideCache->rides();
+
+    // a bit for each filename, shared by everything evaluated until
+    // the rides change
+    if (!rides) {
+        FilterMatches::Rides *add = new FilterMatches::Rides;
+        add->bit.reserve(items.count());
+        foreach(RideItem *item, items) {
+            if (add->bit.contains(item->fileName)) continue;
+            add->bit.insert(item->fileName, add->fileNames.count());
+            add->fileNames << item->fileName;
+        }
+        rides = QSharedPointer<const FilterMatches::Rides>(add);
+    }
+
+    FilterMatches returning;
+    returning.rides = rides;
+    returning.bits.resize(rides->fileNames.count());
+
+    // what kind of matching are we going to perform ?
+    bool search = true;
+    QString spec;
+    if (filter.startsWith("search:")) {
+        spec = (filter.mid(7, filter.length()-7));
+    } else if (filter.startsWith("filter")) {
+        search = false;
+        spec = (filter.mid(7, filter.length()-7));
+    } else {
+        // whatever we were passed
+        spec = filter;
+    }
+
+    if (spec == "") {
+
+        // no spec/filter just return all
+        returning.bits.fill(true);
+
+    } else if (search) {
+
+        FreeSearch fs;
+        foreach(const QString &fileName, fs.search(context, spec)) {
+            QHash<QString, int>::const_iterator it = rides->bit.constFind(fileName);
+            if (it != rides->bit.constEnd()) returning.bits.setBit(it.value());
+        }
+
+    } else {
+
+        DataFilter *df = compiled.value(spec, NULL);
+        if (df == NULL) {
+            df = new DataFilter(NULL, context, spec);
+            compiled.insert(spec, df);
+        }
+        foreach(RideItem *item, items) {
+            Result res = df->evaluate(item, NULL);
+            if (res.isNumber && res.number()) returning.bits.setBit(rides->bit.value(item->fileName));
+        }
+    }
+
+    results.insert(filter, returning);
+    return returning;
+}
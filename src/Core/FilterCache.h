@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _GC_FilterCache_h
+#define _GC_FilterCache_h 1
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QBitArray>
+#include <QSharedPointer>
+#include <QRecursiveMutex>
+
+class Context;
+class DataFilter;
+class RideItem;
+
+// the rides a filter or search matched, a bit for each ride
+class FilterMatches
+{
+    public:
+
+        FilterMatches() {}
+
+        bool contains(const QString &fileName) const {
+            if (!rides) return false;
+            QHash<QString, int>::const_iterator it = rides->bit.constFind(fileName);
+            return it != rides->bit.constEnd() && bits.testBit(it.value());
+        }
+        int count() const { return bits.count(true); }
+        QStringList toStringList() const;
+
+    private:
+
+        friend class FilterCache;
+
+        // the rides as they were when the filter was evaluated, shared
+        // by all the filters evaluated against the same rides
+        struct Rides {
+            QHash<QString, int> bit;
+            QStringList fileNames;
+        };
+        QSharedPointer<const Rides> rides;
+        QBitArray bits;
+};
+
+//
+// Filters and searches (as "filter:..." or "search:..." from the
+// SearchFilterBox) are evaluated over every ride once and kept until a
+// ride, its metrics or the metadata config change, so every chart and
+// curve with the same filter shares the result.
+//
+class FilterCache : public QObject
+{
+    Q_OBJECT
+
+    public:
+
+        FilterCache(Context *context, QObject *parent = NULL);
+        ~FilterCache();
+
+        FilterMatches matches(const QString &filter);
+
+        // how often the answer was to hand
+        int hits() const { return hits_; }
+        int misses() const { return misses_; }
+
+    public slots:
+
+        void invalidate();
+        void recompile();
+        void itemChanged(RideItem *) { invalidate(); }
+        void configChanged(qint32) { recompile(); }
+
+    private:
+
+        Context *context;
+
+        QRecursiveMutex mutex;      // filters can use filters
+        QSharedPointer<const FilterMatches::Rides> rides;
+        QHash<QString, FilterMatches> results;
+        QHash<QString, DataFilter*> compiled;
+        int hits_, misses_;
+};
+
+#endif
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "HexBinner.h"
+
+#include <QSet>
+#include <cmath>
+
+// axial co-ordinates of the pointy-top hexagon containing px,py
+static inline qint64 hexcell(double px, double py, double radius)
+{
+    static const double sqrt3 = std::sqrt(3.0);
+
+    double q = (sqrt3/3.0 * px - py/3.0) / radius;
+    double r = (2.0/3.0 * py) / radius;
+
+    // cube rounding, fix up whichever co-ord moved the most
+    double s = -q - r;
+    double rq = std::round(q), rr = std::round(r), rs = std::round(s);
+    double dq = std::fabs(rq - q), dr = std::fabs(rr - r), ds = std::fabs(rs - s);
+    if (dq > dr && dq > ds) rq = -rr - rs;
+    else if (dr > ds) rr = -rq - rs;
+
+    return (qint64(rq) << 32) ^ qint64(quint32(qint32(rr)));
+}
+
+QVector<int>
+HexBinner::thin(const QVector<double> &x, const QVector<double> &y, QRectF range, QSizeF pixels, double radius)
+{
+    const int n = qMin(x.count(), y.count());
+    QVector<int> returning;
+    if (n == 0) return returning;
+    if (radius <= 0) radius = 1;
+
+    // value to pixel scaling, a flat range all lands in one column/row
+    double sx = range.width() > 0 ? pixels.width() / range.width() : 0;
+    double sy = range.height() > 0 ? pixels.height() / range.height() : 0;
+
+    QVector<bool> keep(n, false);
+
+    // extremes always kept
+    int minx=-1, maxx=-1, miny=-1, maxy=-1;
+
+    QSet<qint64> cells;
+    cells.reserve(qMin(n, int(pixels.width() * pixels.height() / (radius * radius)) + 1));
+
+    for (int i=0; i<n; i++) {
+        const double xi = x[i], yi = y[i];
+
+        // can't bin what we can't place, let the chart deal with it
+        if (!std::isfinite(xi) || !std::isfinite(yi)) {
+            keep[i] = true;
+            continue;
+        }
+
+        if (minx < 0 || xi < x[minx]) minx = i;
+        if (maxx < 0 || xi > x[maxx]) maxx = i;
+        if (miny < 0 || yi < y[miny]) miny = i;
+        if (maxy < 0 || yi > y[maxy]) maxy = i;
+
+        qint64 cell = hexcell((xi - range.left()) * sx, (yi - range.top()) * sy, radius);
+        if (!cells.contains(cell)) {
+            cells.insert(cell);
+            keep[i] = true;
+        }
+    }
+    if (minx >= 0) keep[minx] = keep[maxx] = keep[miny] = keep[maxy] = true;
+
+    returning.reserve(cells.count() + 4);
+    for (int i=0; i<n; i++) if (keep[i]) returning << i;
+    return returning;
+}
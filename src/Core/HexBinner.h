@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _GC_HexBinner_h
+#define _GC_HexBinner_h 1
+
+#include <QVector>
+#include <QRectF>
+#include <QSizeF>
+
+//
+// Thins out a scatter series so there is no more than one point per
+// hexagonal cell on screen. The data range is mapped onto a pixel area and
+// points are binned into hexagons of the given radius (in pixels), the first
+// point to land in each cell is kept. Sparse areas and outliers come through
+// untouched, dense clouds collapse to one point per cell, so drawing costs
+// are bounded by the pixels rather than the number of points.
+//
+// The points at the extremes of x and y are always kept so autoscaled axes
+// come out the same as for the raw data.
+//
+class HexBinner
+{
+    public:
+
+        // indexes of the points to keep, in their original order
+        static QVector<int> thin(const QVector<double> &x, const QVector<double> &y,
+                                 QRectF range, QSizeF pixels, double radius);
+};
+
+#endif
@@ -94,7 +94,7 @@ IntervalItem::setValues(QString name, double duration1, double duration2,
 }
 
 void
-IntervalItem::refresh()
+IntervalItem::refresh(const RidePrefix *prefix)
 {
     // metrics
     const RideMetricFactory &factory = RideMetricFactory::instance();
@@ -109,7 +109,9 @@ IntervalItem::refresh()
 
 
     // ok, lets collect the metrics
-    QHash<QString,RideMetricPtr> computed=RideMetric::computeMetrics(rideItem_, Specification(this, f->recIntSecs()), factory.allMetrics());
+    Specification spec(this, f->recIntSecs());
+    spec.setPrefix(prefix);
+    QHash<QString,RideMetricPtr> computed=RideMetric::computeMetrics(rideItem_, spec, factory.allMetrics());
     // take a deep copy, quick before the thread exits.
     //XXXcomputed.detach();
 
@@ -26,6 +26,8 @@
 #include <QLabel>
 #include <QLineEdit>
 
+class RidePrefix;
+
 class IntervalItem
 {
 
@@ -72,8 +74,9 @@ class IntervalItem
         // order to show on plot
         void setDisplaySequence(int seq) { displaySequence = seq; }
 
-        // precomputed metrics
-        void refresh();
+        // precomputed metrics, prefix when refreshing many intervals
+        // of the same ride, see RidePrefix
+        void refresh(const RidePrefix *prefix = NULL);
         QVector<double> metrics_;
         QVector<double> count_;
         QMap <int, double>stdmean_;
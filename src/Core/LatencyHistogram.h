@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _GC_LatencyHistogram_h
+#define _GC_LatencyHistogram_h 1
+
+#include <QString>
+#include <QtGlobal>
+#include <atomic>
+#include <memory>
+
+//
+// Counts of timings in microseconds, in fixed width buckets with anything
+// past the last bucket counted as overflow. One thread adds, any other can
+// read at the same time (the figures may be a sample or two apart).
+//
+class LatencyHistogram
+{
+    public:
+
+        LatencyHistogram(int width = 100, int buckets = 500) :
+            width(qMax(1, width)), buckets(qMax(1, buckets)),
+            counts(new std::atomic<quint32>[qMax(1, buckets) + 1]) { clear(); }
+
+        void clear() {
+            for (int i=0; i<=buckets; i++) counts[i].store(0, std::memory_order_relaxed);
+            n.store(0, std::memory_order_relaxed);
+            sum.store(0, std::memory_order_relaxed);
+            maximum.store(0, std::memory_order_relaxed);
+        }
+
+        void add(qint64 usecs) {
+            if (usecs < 0) usecs = 0;
+            int bucket = usecs / width;
+            if (bucket > buckets) bucket = buckets;
+            counts[bucket].fetch_add(1, std::memory_order_relaxed);
+            sum.fetch_add(usecs, std::memory_order_relaxed);
+            if (usecs > maximum.load(std::memory_order_relaxed)) maximum.store(usecs, std::memory_order_relaxed);
+            n.fetch_add(1, std::memory_order_release);
+        }
+
+        quint64 count() const { return n.load(std::memory_order_acquire); }
+        qint64 max() const { return maximum.load(std::memory_order_relaxed); }
+        double mean() const { quint64 c = count(); return c ? double(sum.load(std::memory_order_relaxed)) / c : 0; }
+        quint64 overflow() const { return counts[buckets].load(std::memory_order_relaxed); }
+
+        // upper edge of the bucket the pth percentile (0-100) falls in,
+        // the maximum when it's in the overflow
+        qint64 percentile(double p) const {
+            quint64 total = 0;
+            for (int i=0; i<=buckets; i++) total += counts[i].load(std::memory_order_relaxed);
+            if (total == 0) return 0;
+
+            quint64 want = quint64(qBound(0.0, p, 100.0) / 100.0 * total + 0.5);
+            if (want == 0) want = 1;
+            quint64 seen = 0;
+            for (int i=0; i<buckets; i++) {
+                seen += counts[i].load(std::memory_order_relaxed);
+                if (seen >= want) return qint64(i + 1) * width;
+            }
+            return max();
+        }
+
+        QString toString() const {
+            return QString("n=%1 mean=%2us p50=%3us p90=%4us p99=%5us p99.9=%6us max=%7us")
+                   .arg(count()).arg(mean(), 0, 'f', 0)
+                   .arg(percentile(50)).arg(percentile(90)).arg(percentile(99)).arg(percentile(99.9))
+                   .arg(max());
+        }
+
+    private:
+
+        LatencyHistogram(const LatencyHistogram &);
+        LatencyHistogram &operator=(const LatencyHistogram &);
+
+        const int width, buckets;
+        std::unique_ptr<std::atomic<quint32>[]> counts;
+        std::atomic<quint64> n, sum;
+        std::atomic<qint64> maximum;
+};
+
+#endif
@@ -97,6 +97,17 @@ MeasuresGroup::setMeasures(QList<Measure>&x)
 {
     measures_ = x;
     std::sort(measures_.begin(), measures_.end()); // date order
+
+    // index them by date, lookups are made for every ride on refresh
+    QVector<QDate> dates;
+    QVector<double> values;
+    dates.reserve(measures_.count());
+    values.reserve(measures_.count() * MAX_MEASURES);
+    foreach(const Measure &m, measures_) {
+        dates << m.when.date();
+        for (int i=0; i<MAX_MEASURES; i++) values << m.values[i];
+    }
+    index.build(dates, values, MAX_MEASURES);
 }
 
 QDate
@@ -123,29 +134,39 @@ MeasuresGroup::getMeasure(QDate date, Measure &here) const
     // always set to not found before searching
     here = Measure();
 
-    // loop
-    foreach(Measure x, measures_) {
-
-        if (symbol == "Body" && x.when.date() < date) here = x;//TODO generalize
-        if (x.when.date() == date) here = x;
-        if (x.when.date() > date) break;
+    // fall back to a walk if they couldn't be indexed
+    if (index.count() != measures_.count()) {
+        for(int i=0; i<measures_.count(); i++) {
+            const Measure &x = measures_.at(i);
+            if (asOf() && x.when.date() < date) here = x;
+            if (x.when.date() == date) here = x;
+            if (x.when.date() > date) break;
+        }
+        return;
     }
 
+    int i = asOf() ? index.indexAsOf(date) : index.indexOn(date);
+
     // will be empty if none found
-    return;
+    if (i >= 0) here = measures_.at(i);
 }
 
 double
 MeasuresGroup::getFieldValue(QDate date, int field, bool useMetricUnits) const
 {
-    Measure measure;
-    getMeasure(date, measure);
+    if (field < 0 || field >= MAX_MEASURES) return 0.0;
+
+    double value;
+    if (index.count() != measures_.count()) {
+        Measure measure;
+        getMeasure(date, measure);
+        value = measure.values[field];
+    } else {
+        value = asOf() ? index.valueAsOf(date, field) : index.valueOn(date, field);
+    }
 
     // return what was asked for!
-    if (field >= 0 && field < MAX_MEASURES)
-        return measure.values[field]*(useMetricUnits ? 1.0 : unitsFactors[field]);
-    else
-        return 0.0;
+    return value*(useMetricUnits ? 1.0 : unitsFactors[field]);
 }
 
 bool
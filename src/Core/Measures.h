@@ -20,6 +20,7 @@
 #define _Gc_Measures_h
 
 #include "GoldenCheetah.h"
+#include "AsOfSeries.h"
 
 #include <QDate>
 #include <QDir>
@@ -91,8 +92,9 @@ public:
     MeasuresGroup(QDir dir=QDir(), bool withData=false) : dir(dir), withData(withData) {}
     ~MeasuresGroup() {}
     void write();
-    QList<Measure>& measures() { return measures_; }
-    void setMeasures(QList<Measure>&x);
+    const QList<Measure>& measures() const { return measures_; }
+    void setMeasures(QList<Measure>&x); // also rebuilds the index
+
     void getMeasure(QDate date, Measure&) const;
 
     // Common access to Measures
@@ -129,6 +131,10 @@ private:
     QList<QStringList> headers;
     QList<Measure> measures_;
 
+    // measures_ by date, body measures as-of a date, the rest on it
+    AsOfSeries index;
+    bool asOf() const { return symbol == "Body"; } //TODO generalize
+
     bool serialize(QString, QList<Measure> &);
     bool unserialize(QFile &, QList<Measure> &);
 };
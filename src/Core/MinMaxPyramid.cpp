@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "MinMaxPyramid.h"
+
+#include <algorithm>
+#include <string.h>
+
+void
+MinMaxPyramid::clear()
+{
+    xdata.clear();
+    ydata.clear();
+    levels.clear();
+    bounds = QRectF();
+}
+
+void
+MinMaxPyramid::build(const QVector<QPointF> &points)
+{
+    QVector<double> x(points.count()), y(points.count());
+    for(int i=0; i<points.count(); i++) {
+        x[i] = points[i].x();
+        y[i] = points[i].y();
+    }
+    build(x.constData(), y.constData(), x.count());
+}
+
+void
+MinMaxPyramid::build(const double *x, const double *y, int count)
+{
+    clear();
+    if (count <= 0 || x == NULL || y == NULL) return;
+
+    xdata.resize(count);
+    ydata.resize(count);
+    memcpy(xdata.data(), x, count * sizeof(double));
+    memcpy(ydata.data(), y, count * sizeof(double));
+
+    // overall bounds
+    double miny = ydata[0], maxy = ydata[0];
+    for(int i=1; i<count; i++) {
+        if (ydata[i] < miny) miny = ydata[i];
+        if (ydata[i] > maxy) maxy = ydata[i];
+    }
+    bounds = QRectF(xdata.first(), miny, xdata.last() - xdata.first(), maxy - miny);
+
+    // first level pairs up raw samples, each level above that
+    // pairs up the blocks of the level below until one block is left
+    int blocks = (count + 1) / 2;
+    Level level;
+    level.blocksize = 2;
+    level.minIndex.resize(blocks);
+    level.maxIndex.resize(blocks);
+    for(int k=0; k<blocks; k++) {
+        int i = k*2;
+        int j = qMin(i+1, count-1);
+        level.minIndex[k] = ydata[j] < ydata[i] ? j : i;
+        level.maxIndex[k] = ydata[j] > ydata[i] ? j : i;
+    }
+    levels << level;
+
+    while (blocks > 1) {
+
+        const Level &below = levels.last();
+        int belowblocks = blocks;
+        blocks = (belowblocks + 1) / 2;
+
+        Level next;
+        next.blocksize = below.blocksize * 2;
+        next.minIndex.resize(blocks);
+        next.maxIndex.resize(blocks);
+        for(int k=0; k<blocks; k++) {
+            int i = k*2;
+            int j = qMin(i+1, belowblocks-1);
+            int mi = below.minIndex[i], mj = below.minIndex[j];
+            int xi = below.maxIndex[i], xj = below.maxIndex[j];
+            next.minIndex[k] = ydata[mj] < ydata[mi] ? mj : mi;
+            next.maxIndex[k] = ydata[xj] > ydata[xi] ? xj : xi;
+        }
+        levels << next;
+    }
+}
+
+void
+MinMaxPyramid::addRaw(int from, int to, QVector<QPointF> &here) const
+{
+    for(int i=from; i<=to; i++) here << QPointF(xdata[i], ydata[i]);
+}
+
+void
+MinMaxPyramid::addBlock(int minIndex, int maxIndex, QVector<QPointF> &here) const
+{
+    // keep them in x order so the line is drawn through both
+    if (minIndex == maxIndex) {
+        here << QPointF(xdata[minIndex], ydata[minIndex]);
+    } else if (minIndex < maxIndex) {
+        here << QPointF(xdata[minIndex], ydata[minIndex]);
+        here << QPointF(xdata[maxIndex], ydata[maxIndex]);
+    } else {
+        here << QPointF(xdata[maxIndex], ydata[maxIndex]);
+        here << QPointF(xdata[minIndex], ydata[minIndex]);
+    }
+}
+
+void
+MinMaxPyramid::decimate(double from, double to, int buckets, QVector<QPointF> &here, double maxspan) const
+{
+    here.resize(0);
+
+    const int n = xdata.count();
+    if (n == 0 || to < from) return;
+    if (buckets < 1) buckets = 1;
+
+    // visible range plus one point either side so lines run off the edge
+    int i0 = std::lower_bound(xdata.constBegin(), xdata.constEnd(), from) - xdata.constBegin();
+    int i1 = std::upper_bound(xdata.constBegin(), xdata.constEnd(), to) - xdata.constBegin();
+    if (i0 > 0) i0--;
+    if (i1 > n-1) i1 = n-1;
+
+    // few enough to just use them all
+    int span = i1 - i0 + 1;
+    if (span <= 2 * buckets) {
+        addRaw(i0, i1, here);
+        return;
+    }
+
+    // smallest level that gets us down to one block per bucket
+    int needed = (span + buckets - 1) / buckets;
+    int l = 0;
+    while (l < levels.count()-1 && levels[l].blocksize < needed) l++;
+
+    // but don't use blocks so wide they look like gaps, points from
+    // neighbouring blocks can be up to two blocks apart
+    if (maxspan > 0 && n > 1) {
+        double avgdx = (xdata[n-1] - xdata[0]) / double(n-1);
+        while (l >= 0 && 3 * levels[l].blocksize * avgdx > maxspan) l--;
+        if (l < 0) {
+            addRaw(i0, i1, here);
+            return;
+        }
+    }
+
+    const Level &level = levels[l];
+    const int b = level.blocksize;
+    here.reserve(2 * (span / b) + 2 * b);
+
+    // partial block at the start
+    int k = (i0 + b - 1) / b;
+    addRaw(i0, qMin(k * b - 1, i1), here);
+
+    // whole blocks
+    for(; (k+1) * b - 1 <= i1; k++) {
+        int start = k * b;
+        int stop = start + b - 1;
+        if (maxspan > 0 && 3 * (xdata[stop] - xdata[start]) > maxspan) addRaw(start, stop, here);
+        else addBlock(level.minIndex[k], level.maxIndex[k], here);
+    }
+
+    // partial block at the end
+    if (k * b <= i1) addRaw(qMax(k * b, i0), i1, here);
+}
+
+QVector<QPointF>
+MinMaxPyramid::samples() const
+{
+    QVector<QPointF> returning;
+    returning.reserve(xdata.count());
+    addRaw(0, xdata.count()-1, returning);
+    return returning;
+}
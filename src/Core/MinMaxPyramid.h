@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _GC_MinMaxPyramid_h
+#define _GC_MinMaxPyramid_h 1
+
+#include <QVector>
+#include <QPointF>
+#include <QRectF>
+
+//
+// Multi-resolution min/max summary of an x/y series where x is monotonic
+// (time or distance). Level n summarises blocks of 2^n samples with the
+// index of the min and max sample in each block, so any visible range can
+// be decimated to a couple of points per pixel whilst keeping the peaks
+// exactly where they were in the raw data.
+//
+// It is built once when the data is set and costs about 2 ints per sample.
+//
+class MinMaxPyramid
+{
+    public:
+
+        MinMaxPyramid() {}
+
+        // copies the data and builds the levels
+        void build(const double *x, const double *y, int count);
+        void build(const QVector<QPointF> &points);
+        void clear();
+
+        int count() const { return xdata.count(); }
+        const QVector<double> &xValues() const { return xdata; }
+        const QVector<double> &yValues() const { return ydata; }
+
+        // bounds of all the data
+        QRectF boundingRect() const { return bounds; }
+
+        // decimate samples with x in [from, to] into at most 2 points per bucket
+        // (plus the two points either side so lines reach the plot edge). Where
+        // a block spans more than maxspan on the x-axis the raw samples are used
+        // instead so gap detection in the curve still works.
+        void decimate(double from, double to, int buckets, QVector<QPointF> &here, double maxspan=0) const;
+
+        // the samples that would be returned for the whole series
+        QVector<QPointF> samples() const;
+
+    private:
+
+        struct Level {
+            int blocksize;
+            QVector<int> minIndex, maxIndex;
+        };
+
+        void addRaw(int from, int to, QVector<QPointF> &here) const;
+        void addBlock(int minIndex, int maxIndex, QVector<QPointF> &here) const;
+
+        QVector<double> xdata, ydata;
+        QVector<Level> levels;
+        QRectF bounds;
+};
+
+#endif
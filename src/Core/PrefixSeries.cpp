@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "PrefixSeries.h"
+
+#include <limits>
+
+int
+PrefixSeries::log2(int x)
+{
+    int k = 0;
+    while ((2 << k) <= x) k++;
+    return k;
+}
+
+void
+PrefixSeries::clear()
+{
+    total.clear();
+    n.clear();
+    nz.clear();
+    maxima.clear();
+    minima.clear();
+}
+
+void
+PrefixSeries::build(const QVector<double> &values)
+{
+    clear();
+
+    const int count = values.count();
+    total.resize(count+1);
+    n.resize(count+1);
+    nz.resize(count+1);
+    total[0] = 0;
+    n[0] = nz[0] = 0;
+    for (int i=0; i<count; i++) {
+        const double v = values[i];
+        total[i+1] = total[i] + (v > 0 ? v : 0);
+        n[i+1] = n[i] + (v > 0 ? 1 : 0);
+        nz[i+1] = nz[i] + (v >= 0 ? 1 : 0);
+    }
+    if (count == 0) return;
+
+    // runs of 1 sample, the minimum only of positive values
+    const double none = std::numeric_limits<double>::max();
+    maxima << values;
+    QVector<double> lowest(count);
+    for (int i=0; i<count; i++) lowest[i] = values[i] > 0 ? values[i] : none;
+    minima << lowest;
+
+    // each level from two runs of the level below
+    for (int k=1, width=2; width <= count; k++, width *= 2) {
+        const QVector<double> &mx = maxima[k-1], &mn = minima[k-1];
+        const int runs = count - width + 1;
+        QVector<double> upper(runs), lower(runs);
+        for (int i=0; i<runs; i++) {
+            upper[i] = qMax(mx[i], mx[i + width/2]);
+            lower[i] = qMin(mn[i], mn[i + width/2]);
+        }
+        maxima << upper;
+        minima << lower;
+    }
+}
+
+double
+PrefixSeries::max(int first, int last) const
+{
+    const int k = log2(last - first + 1);
+    return qMax(maxima[k][first], maxima[k][last - (1 << k) + 1]);
+}
+
+double
+PrefixSeries::minPositive(int first, int last) const
+{
+    const int k = log2(last - first + 1);
+    double min = qMin(minima[k][first], minima[k][last - (1 << k) + 1]);
+    return min == std::numeric_limits<double>::max() ? 0 : min;
+}
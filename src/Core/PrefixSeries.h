@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _GC_PrefixSeries_h
+#define _GC_PrefixSeries_h 1
+
+#include <QVector>
+
+//
+// Answers sums, counts and extremes of a series over any run of samples
+// first..last in constant time, for metrics that only need those across
+// many intervals of the same ride.
+//
+// Running totals give the sums and counts, and sparse tables (the extreme
+// of every run of 2^k samples starting at each one) give the extremes as
+// the better of two overlapping runs. Zero and negative values are left out
+// of the sums and the minimum as the metrics have always done.
+//
+// It is built once and costs about 2 log2(n) doubles per sample.
+//
+class PrefixSeries
+{
+    public:
+
+        PrefixSeries() {}
+
+        void build(const QVector<double> &values);
+        void clear();
+
+        int count() const { return n.count() ? n.count() - 1 : 0; }
+
+        // over samples first..last inclusive
+        double sum(int first, int last) const { return total[last+1] - total[first]; }      // of values > 0
+        int positive(int first, int last) const { return n[last+1] - n[first]; }          // values > 0
+        int nonNegative(int first, int last) const { return nz[last+1] - nz[first]; }     // values >= 0
+        double max(int first, int last) const;
+        double minPositive(int first, int last) const;                                      // 0 if none
+
+    private:
+
+        static int log2(int x);
+
+        QVector<double> total;
+        QVector<int> n, nz;
+        QVector<QVector<double> > maxima, minima;
+};
+
+#endif
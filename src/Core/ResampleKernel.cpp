@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "ResampleKernel.h"
+
+void
+ResampleKernel::plan(const QVector<double> &secs, double recIntSecs, double interval, Method method)
+{
+    this->interval = interval;
+    n = 0;
+    taps.clear();
+    weights.clear();
+    if (interval <= 0 || recIntSecs <= 0) return;
+
+    // the spline averages over each new interval when there are fewer new
+    // samples than old, as RideFile always has, so we don't alias
+    const int points = (method == Spline && interval > recIntSecs) ? 5 : 1;
+    const int each = method == Hold ? 1 : (method == Linear ? 2 : 4);
+    width = each * points;
+
+    // cleaned times and the sample each came from, -1 for the zeroes
+    // filling gaps in recording
+    QVector<double> x;
+    QVector<int> from;
+    x.reserve(secs.count());
+    from.reserve(secs.count());
+
+    double offset = 0;
+    int lp = -1;
+    for (int i=0; i<secs.count(); i++) {
+
+        // yuck! nasty data -- ignore it
+        if (secs[i] > (25*60*60)) continue;
+
+        // always start at 0 seconds
+        if (lp < 0) offset = secs[i];
+
+        // fill gaps in recording with zeroes
+        if (lp >= 0) {
+            for (double t=secs[lp]+recIntSecs; (t + recIntSecs) < secs[i]; t += recIntSecs) {
+                x << t - offset;
+                from << -1;
+            }
+        }
+
+        // lets not go backwards -- or two samples at the same time
+        if (lp < 0 || secs[i] > secs[lp]) {
+            x << secs[i] - offset;
+            from << i;
+        }
+        lp = i;
+    }
+    const int m = x.count();
+    if (m < 2) return;
+
+    // zeroes take a real sample with no weight, so applying never
+    // needs to check
+    const int zero = from[0];
+
+    n = int(x[m-1] / interval + 1e-9) + 1;
+    taps.resize(n * width);
+    weights.resize(n * width);
+
+    // the trapezoid rule over the new interval, 5 points a quarter apart
+    static const double trapezoid[5] = { 0.125, 0.25, 0.25, 0.25, 0.125 };
+
+    int j = 0;
+    for (int k=0; k<n; k++) {
+        for (int q=0; q<points; q++) {
+
+            // times only go forward, so carry on from where we were
+            const double t = k * interval + (points > 1 ? q * interval / 4 : 0);
+            const double scale = points > 1 ? trapezoid[q] : 1;
+            while (j < m-2 && x[j+1] <= t) j++;
+
+            double f = (t - x[j]) / (x[j+1] - x[j]);
+            if (f > 1) f = 1;
+
+            // sample and weight for each tap, neighbours past either end are
+            // taken as the end
+            int s[4];
+            double w[4];
+            int used;
+            if (method == Hold) {
+                s[0] = f < 1 ? j : j+1;
+                w[0] = 1;
+                used = 1;
+            } else if (method == Linear || (j > 0 && from[j-1] < 0) || from[j] < 0 ||
+                       from[j+1] < 0 || (j+2 < m && from[j+2] < 0)) {
+                // a spline would overshoot into and out of a gap
+                s[0] = j; w[0] = 1 - f;
+                s[1] = j+1; w[1] = f;
+                s[2] = s[3] = j; w[2] = w[3] = 0;
+                used = each;
+            } else {
+                const double f2 = f * f, f3 = f2 * f;
+                s[0] = j > 0 ? j-1 : j;     w[0] = 0.5 * (-f3 + 2*f2 - f);
+                s[1] = j;                   w[1] = 0.5 * (3*f3 - 5*f2 + 2);
+                s[2] = j+1;                 w[2] = 0.5 * (-3*f3 + 4*f2 + f);
+                s[3] = j+2 < m ? j+2 : j+1; w[3] = 0.5 * (f3 - f2);
+                used = 4;
+            }
+
+            int *tap = taps.data() + k * width + q * each;
+            double *weight = weights.data() + k * width + q * each;
+            for (int i=0; i<used; i++) {
+                tap[i] = from[s[i]] < 0 ? zero : from[s[i]];
+                weight[i] = from[s[i]] < 0 ? 0 : w[i] * scale;
+            }
+        }
+    }
+}
+
+void
+ResampleKernel::apply(const double *in, double *out, int first, int last) const
+{
+    const int *tap = taps.constData() + first * width;
+    const double *weight = weights.constData() + first * width;
+
+    switch (width) {
+    case 1:
+        for (int k=first; k<last; k++, tap++, weight++) out[k] = weight[0] * in[tap[0]];
+        break;
+    case 2:
+        for (int k=first; k<last; k++, tap += 2, weight += 2)
+            out[k] = weight[0] * in[tap[0]] + weight[1] * in[tap[1]];
+        break;
+    case 4:
+        for (int k=first; k<last; k++, tap += 4, weight += 4)
+            out[k] = (weight[0] * in[tap[0]] + weight[1] * in[tap[1]]) +
+                     (weight[2] * in[tap[2]] + weight[3] * in[tap[3]]);
+        break;
+    default:
+        for (int k=first; k<last; k++) {
+            double sum = 0;
+            for (int i=0; i<width; i++, tap++, weight++) sum += weight[0] * in[tap[0]];
+            out[k] = sum;
+        }
+        break;
+    }
+}
+
+void
+ResampleKernel::apply(const double *in, double *out) const
+{
+    apply(in, out, 0, n);
+}
+
+QVector<double>
+ResampleKernel::apply(const QVector<double> &in) const
+{
+    QVector<double> out(n);
+    if (n) apply(in.constData(), out.data(), 0, n);
+    return out;
+}
+
+void
+ResampleKernel::apply(const QVector<const double *> &in, const QVector<double *> &out) const
+{
+    // a block of new samples at a time for every series, so the plan for
+    // the block is still in cache for the next series
+    const int block = 512;
+    for (int first=0; first<n; first += block) {
+        const int last = qMin(n, first + block);
+        for (int c=0; c<in.count(); c++) apply(in[c], out[c], first, last);
+    }
+}
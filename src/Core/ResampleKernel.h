@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _GC_ResampleKernel_h
+#define _GC_ResampleKernel_h 1
+
+#include <QVector>
+
+//
+// Resamples series recorded at the same times onto a new, regular
+// interval. The times are worked through once to plan which samples and
+// weights make up each new one, then every series is done from that plan
+// straight from its own contiguous array.
+//
+// The times are cleaned as RideFile always has: samples more than a day
+// in, or not after the one before, are dropped, the first is taken as
+// zero seconds and gaps in recording (more than twice the recording
+// interval) are zero, ramping down and up over a recording interval.
+//
+class ResampleKernel
+{
+    public:
+
+        enum Method {
+            Linear,     // between the samples either side
+            Hold,       // the last sample at or before
+            Spline      // Catmull-Rom through the samples either side and the next ones out,
+                        // averaged over each new interval when downsampling
+        };
+
+        ResampleKernel() : interval(1), width(0), n(0) {}
+
+        // samples taken at secs every recIntSecs, to every interval secs
+        // up to the last sample
+        void plan(const QVector<double> &secs, double recIntSecs, double interval, Method method = Linear);
+
+        // new samples, interval secs apart from 0
+        int count() const { return n; }
+        double secsAt(int i) const { return i * interval; }
+
+        // a series with a value for each of the secs planned, out must
+        // have room for count()
+        void apply(const double *in, double *out) const;
+        QVector<double> apply(const QVector<double> &in) const;
+
+        // all of them in one pass
+        void apply(const QVector<const double *> &in, const QVector<double *> &out) const;
+
+    private:
+
+        void apply(const double *in, double *out, int first, int last) const;
+
+        double interval;
+        int width;                  // taps for each new sample
+        int n;
+        QVector<int> taps;          // n * width indexes into the series
+        QVector<double> weights;    // and what each contributes
+};
+
+#endif
@@ -71,6 +71,8 @@ RideCache::RideCache(Context *context) : context(context)
     progress_ = 100;
     exiting = false;
     estimator = new Estimator(context);
+    filterCache_ = new FilterCache(context, this);
+    residency_ = new RideResidency(context, this);
 
     // initial load of user defined metrics - do once we have an initial context
     // but before we refresh or check metrics for the first time
@@ -140,6 +142,7 @@ RideCache::RideCache(Context *context) : context(context)
 
     // now sort it - we need to use find on it
     std::sort(rides_.begin(), rides_.end(), rideCacheLessThan);
+    foreach(RideItem *item, rides_) indexRide(item);
 
     // load the store - will unstale once cache restored
     RideCacheLoader *rideCacheLoader = new RideCacheLoader(this);
@@ -159,10 +162,17 @@ RideCache::postLoad()
     // set model once we have the basics
     model_ = new RideCacheModel(context, this);
 
+    // the dates may have been corrected from the store
+    index_.clear();
+    foreach(RideItem *item, rides_) indexRide(item);
+
     // after the first ridecache refresh we set initial pd estimates
     first= true;
     connect(context, SIGNAL(refreshEnd()), this, SLOT(initEstimates()));
 
+    // what the files looked like when last clean
+    journal.load(QString("%1/%2").arg(context->athlete->home->cache().canonicalPath()).arg("rideDB.journal"));
+
     // now refresh just in case.
     refresh();
 
@@ -203,6 +213,10 @@ RideCache::~RideCache()
     // cancel any refresh that may be running
     cancel();
 
+    // and any rides still being read ahead
+    delete residency_;
+    residency_ = NULL;
+
     saveThread_->quit();
     saveThread_->wait();
     delete saveWorker_;
@@ -269,6 +283,7 @@ RideCache::itemChanged()
 
     // the model is particularly interested in ANY item that changes
     emit itemChanged(item);
+    filterCache_->itemChanged(item);
 
     // current ride changed is more relevant for the charts lets notify
     // them the ride they're showing has changed
@@ -304,6 +319,7 @@ RideCache::addRide(QString name, bool dosignal, bool select, bool useTempActivit
     bool added = false;
     for (int index=0; index < rides_.count(); index++) {
         if (rides_[index]->fileName == last->fileName) {
+            index_.remove(rides_[index]);
             rides_[index] = last;
             added = true;
             break;
@@ -317,6 +333,7 @@ RideCache::addRide(QString name, bool dosignal, bool select, bool useTempActivit
         std::sort(rides_.begin(), rides_.end(), rideCacheLessThan);
         model_->endReset();
     }
+    indexRide(last);
 
     // refresh metrics for *this ride only*
     last->refresh();
@@ -409,6 +426,7 @@ RideCache::removeRide(const QString& filenameToDelete) {
     // but model needs to know about this!
     model_->startRemove(index);
     rides_.remove(index, 1);
+    index_.remove(todelete);
     delete_<<todelete;
     model_->endRemove(index);
 
@@ -519,6 +537,7 @@ RideCache::removeRides
 
         model_->startRemove(index);
         rides_.remove(index, 1);
+        index_.remove(todelete);
         delete_ << todelete;
         model_->endRemove(index);
 
@@ -670,8 +689,10 @@ RideCache::threadCompleted(RideCacheRefreshThread*thread)
         //fprintf(stderr,"refresh ended\n"); fflush(stderr);
         context->notifyRefreshEnd();
         garbageCollect();
-        QMetaObject::invokeMethod(saveWorker_, [this]() {
+        QVector<RideItem*> items = rides_;
+        QMetaObject::invokeMethod(saveWorker_, [this, items]() {
             save();
+            saveJournal(items);
         }, Qt::QueuedConnection);
     }
 }
@@ -724,11 +745,32 @@ RideCache::refresh()
     // how many need refreshing ?
     int staleCount = 0;
 
-    foreach(RideItem *item, rides_) {
+    // stat all the activity and .cpx files in one go, rides whose files
+    // are as they were when last clean don't need them opened and read
+    QVector<RideCacheJournal::Source> sources = journalSources(rides_);
+    QVector<RideJournalEntry> now = RideCacheJournal::stat(sources);
+
+    journalMutex.lock();
+    for (int i=0; i<rides_.count(); i++) {
+        RideItem *item = rides_[i];
+
+        RideJournalEntry known;
+        bool untouched = journal.find(sources[i].key, known) && known.sameFiles(now[i]) &&
+                         known.crc == item->crc && known.cpxversion == RideFileCacheVersion;
+
         // ok set stale so we refresh
-        if (item->checkStale())
+        if (item->checkStale(untouched ? &known : NULL)) {
             staleCount++;
+        } else if (!untouched) {
+            // checked the slow way and its fine, remember that
+            RideJournalEntry entry = now[i];
+            entry.crc = item->crc;
+            entry.cpxversion = RideFileCacheVersion;
+            entry.cpxweight = item->getWeight();
+            journal.record(sources[i].key, entry);
+        }
     }
+    journalMutex.unlock();
 
     // start if there is work to do
     // and future watcher can notify of updates
@@ -760,12 +802,76 @@ RideCache::refresh()
 
     } else {
 
+        // nothing to do, but keep what we learned for next time
+        QVector<RideItem*> items = rides_;
+        QMetaObject::invokeMethod(saveWorker_, [this, items]() {
+            saveJournal(items);
+        }, Qt::QueuedConnection);
 
         // wait five seconds, so mainwindow can get up and running...
         QTimer::singleShot(5000, context, SLOT(notifyRefreshEnd()));
     }
 }
 
+QVector<RideCacheJournal::Source>
+RideCache::journalSources(const QVector<RideItem*> &items) const
+{
+    QString activities = directory.canonicalPath() + "/";
+    QString planned = plannedDirectory.canonicalPath() + "/";
+    QString cache = context->athlete->home->cache().canonicalPath() + "/";
+
+    QVector<RideCacheJournal::Source> returning(items.count());
+    for (int i=0; i<items.count(); i++) {
+        const RideItem *item = items[i];
+        RideCacheJournal::Source &source = returning[i];
+
+        // same names RideFileCache uses
+        QString prefix = item->planned ? "planned/" : "";
+        source.key = prefix + item->fileName;
+        source.path = (item->planned ? planned : activities) + item->fileName;
+        source.cpx = cache + prefix + QFileInfo(item->fileName).baseName() + ".cpx";
+    }
+    return returning;
+}
+
+// runs on the save thread once the rides are all up to date
+void
+RideCache::saveJournal(QVector<RideItem*> items)
+{
+    QVector<RideCacheJournal::Source> sources = journalSources(items);
+    QVector<RideJournalEntry> now = RideCacheJournal::stat(sources);
+
+    QMutexLocker locker(&journalMutex);
+
+    QSet<QString> keys;
+    for (int i=0; i<items.count(); i++) {
+        const RideItem *item = items[i];
+        keys.insert(sources[i].key);
+
+        RideJournalEntry known;
+        if (item->isstale) {
+            journal.forget(sources[i].key);
+
+        } else if (journal.find(sources[i].key, known) && known.sameFiles(now[i])) {
+            // still as it was
+
+        } else if (now[i].size >= 0 && now[i].mtime / 1000 <= qint64(item->timestamp)) {
+            // refreshed since the file was last written
+            RideJournalEntry entry = now[i];
+            entry.crc = item->crc;
+            entry.cpxversion = RideFileCacheVersion;
+            entry.cpxweight = item->weight;
+            journal.record(sources[i].key, entry);
+
+        } else {
+            // changed under our feet, check it properly next time
+            journal.forget(sources[i].key);
+        }
+    }
+    journal.retain(keys);
+    journal.save(QString("%1/%2").arg(context->athlete->home->cache().canonicalPath()).arg("rideDB.journal"));
+}
+
 QString
 RideCache::getAggregate(QString name, Specification spec, bool useMetricUnits, bool nofmt)
 {
@@ -930,10 +1036,7 @@ RideCache::getAllFilenames()
 RideItem *
 RideCache::getRide(QString filename)
 {
-    foreach(RideItem *item, rides())
-        if (item->fileName == filename)
-            return item;
-    return NULL;
+    return index_.find(filename);
 }
 
 
@@ -941,24 +1044,26 @@ RideItem*
 RideCache::getRide
 (const QString &filename, bool planned)
 {
-    for (RideItem *rideItem : rides()) {
-        if (rideItem != nullptr && rideItem->planned == planned && rideItem->fileName == filename) {
-            return rideItem;
-        }
-    }
-    return nullptr;
+    return index_.find(filename, planned);
 }
 
 
 RideItem *
 RideCache::getRide(QDateTime dateTime)
 {
-    foreach(RideItem *item, rides())
+    foreach(RideItem *item, ridesBetween(dateTime.date(), dateTime.date()))
         if (item->dateTime == dateTime)
             return item;
     return NULL;
 }
 
+void
+RideCache::reindex(RideItem *item)
+{
+    // only those we already hold, not copies and temporaries
+    if (index_.contains(item)) indexRide(item);
+}
+
 
 
 QHash<QString,int>
@@ -1349,6 +1454,7 @@ RideCache::moveActivity
     if (! renameRideFiles(oldFileName, newFileName, item->planned, renameError)) {
         item->dateTime = oldDateTime;
         item->fileName = oldFileName;
+        reindex(item);
         result.error = tr("Failed to rename files: %1").arg(renameError);
         item->close();
         return result;
@@ -1360,6 +1466,7 @@ RideCache::moveActivity
         renameRideFiles(newFileName, oldFileName, item->planned, renameError);
         item->dateTime = oldDateTime;
         item->fileName = oldFileName;
+        reindex(item);
         result.error = tr("Failed to save activity file after rename");
         item->close();
         return result;
@@ -1466,6 +1573,7 @@ RideCache::copyPlannedActivity
     rides_ << newItem;
     std::sort(rides_.begin(), rides_.end(), rideCacheLessThan);
     model_->endReset();
+    indexRide(newItem);
 
     refresh();
     estimator->refresh();
@@ -1553,6 +1661,7 @@ RideCache::copyPlannedActivities
         rides_ << newItems;
         std::sort(rides_.begin(), rides_.end(), rideCacheLessThan);
         model_->endReset();
+        foreach(RideItem *item, newItems) indexRide(item);
         refresh();
         estimator->refresh();
     }
@@ -1857,20 +1966,15 @@ RideCache::findSuggestion
 (RideItem *rideItem)
 {
     RideItem *closest = nullptr;
-    for (RideItem *o: this->context->athlete->rideCache->rides()) {
-        if (   o != nullptr
-            && o->planned == ! rideItem->planned
-            && o->dateTime.date() == rideItem->dateTime.date()
-            && o->sport == rideItem->sport) {
+    const QDate date = rideItem->dateTime.date();
+    for (RideItem *o: ridesBetween(date, date, ! rideItem->planned)) {
+        if (o->sport == rideItem->sport) {
             if (closest == nullptr) {
                 closest = o;
             } else if (std::abs(rideItem->dateTime.time().secsTo(o->dateTime.time())) < std::abs(rideItem->dateTime.time().secsTo(closest->dateTime.time()))) {
                 closest = o;
             }
         }
-        if (o->dateTime.date() > rideItem->dateTime.date()) {
-            break;
-        }
     }
     return closest;
 }
@@ -1951,13 +2055,9 @@ RideCache::updateFromWorkoutAfter
     cancel();
 
     QList<RideItem*> changedItems;
-    for (RideItem *item : rides()) {
-        if (   item
-            && item->planned
-            && item->dateTime.date() >= when) {
-            if (updateFromWorkout(item, false)) {
-                changedItems << item;
-            }
+    for (RideItem *item : ridesBetween(when, QDate(), true)) {
+        if (updateFromWorkout(item, false)) {
+            changedItems << item;
         }
     }
 
@@ -24,6 +24,10 @@
 #include "RideFile.h"
 #include "RideItem.h"
 #include "PDModel.h"
+#include "RideCacheJournal.h"
+#include "DateIndex.h"
+#include "FilterCache.h"
+#include "RideResidency.h"
 
 #include <QVector>
 #include <QThread>
@@ -54,11 +58,26 @@ class RideCache : public QObject
         // table models
         RideCacheModel *model() { return model_; }
 
+        // what the filters and searches in use match
+        FilterCache *filterCache() { return filterCache_; }
+
+        // which rides are kept open
+        RideResidency *residency() { return residency_; }
+
         // query the cache
         int count() const { return rides_.count(); }
         RideItem *getRide(QString filename);
         RideItem *getRide(const QString &filename, bool planned);
         RideItem *getRide(QDateTime dateTime);
+
+        // rides on the days from..to inclusive in date order (no end if to
+        // is invalid), all or just the planned / actual ones; indexed by day
+        // so the calendar, agenda and plan views only look at the days they show
+        QVector<RideItem*> ridesBetween(QDate from, QDate to) const { return index_.between(from, to); }
+        QVector<RideItem*> ridesBetween(QDate from, QDate to, bool planned) const { return index_.between(from, to, planned); }
+
+        // an item's date or filename changed, see RideItem::setStartTime
+        void reindex(RideItem *item);
 	    QList<QDateTime> getAllDates();
         QStringList getAllFilenames();
 
@@ -202,7 +221,7 @@ class RideCache : public QObject
         friend class ::LTMPlot; // get weekly performances
         friend class ::Banister; // get weekly performances
         friend class ::Leaf; // get weekly performances
-        friend class ::RideItem; // adds to deletelist in destructor
+        friend class ::RideItem; // adds to deletelist and leaves index_ in destructor
         friend class ::NavigationModel; // checks deletelist during redo/undo
         friend class ::RideCacheRefreshThread;
 
@@ -213,6 +232,11 @@ class RideCache : public QObject
         // delete_ is a list of items to garbage collect (delete later)
         // deletelist is a list of items that no longer exist (deleted)
         QVector<RideItem*> rides_, reverse_, delete_, deletelist;
+
+        // rides_ by day and filename, kept in step with it
+        DateIndex<RideItem*> index_;
+        FilterCache *filterCache_;
+        RideResidency *residency_;
         RideCacheModel *model_;
         bool exiting;
 	    double progress_; // percent
@@ -223,10 +247,17 @@ class RideCache : public QObject
         bool first; // updated when estimates are marked stale
 
     private:
+        void indexRide(RideItem *item) { index_.insert(item, item->dateTime, item->fileName, item->planned); }
         bool renameRideFiles(const QString& oldFileName, const QString& newFileName, bool isPlanned, QString &error);
         bool isValidLink(RideItem *item1, RideItem *item2, QString &error);
         RideItem* copyPlannedRideFile(RideItem *sourceItem, const QDate &newDate, const QTime &newTime, QString &error);
 
+        // file change journal for quick stale checks at startup
+        QVector<RideCacheJournal::Source> journalSources(const QVector<RideItem*> &items) const;
+        void saveJournal(QVector<RideItem*> items);
+        QMutex journalMutex;
+        RideCacheJournal journal;
+
         bool isCancelled = false;
         QThread *saveThread_ = nullptr;
         QObject *saveWorker_ = nullptr;
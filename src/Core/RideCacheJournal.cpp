@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "RideCacheJournal.h"
+
+#include <QFile>
+#include <QSaveFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QDataStream>
+#include <QtConcurrent>
+
+#define JOURNAL_MAGIC   0x47434a4e  // "GCJN"
+#define JOURNAL_VERSION 1
+
+bool
+RideCacheJournal::load(QString filename)
+{
+    entries.clear();
+
+    QFile file(filename);
+    if (!file.open(QFile::ReadOnly)) return false;
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_0);
+
+    quint32 magic, version, n;
+    in >> magic >> version >> n;
+    if (in.status() != QDataStream::Ok || magic != JOURNAL_MAGIC || version != JOURNAL_VERSION) return false;
+
+    entries.reserve(n);
+    for (quint32 i=0; i<n; i++) {
+        QString key;
+        RideJournalEntry e;
+        in >> key >> e.size >> e.mtime >> e.cpxsize >> e.cpxmtime >> e.crc >> e.cpxversion >> e.cpxweight;
+        if (in.status() != QDataStream::Ok) {
+            // truncated, trust none of it
+            entries.clear();
+            return false;
+        }
+        entries.insert(key, e);
+    }
+    return true;
+}
+
+bool
+RideCacheJournal::save(QString filename) const
+{
+    // written aside and renamed so a crash never leaves half a journal
+    QSaveFile file(filename);
+    if (!file.open(QFile::WriteOnly)) return false;
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_0);
+
+    out << quint32(JOURNAL_MAGIC) << quint32(JOURNAL_VERSION) << quint32(entries.count());
+    QHashIterator<QString, RideJournalEntry> i(entries);
+    while (i.hasNext()) {
+        i.next();
+        const RideJournalEntry &e = i.value();
+        out << i.key() << e.size << e.mtime << e.cpxsize << e.cpxmtime << e.crc << e.cpxversion << e.cpxweight;
+    }
+    return out.status() == QDataStream::Ok && file.commit();
+}
+
+RideJournalEntry
+RideCacheJournal::stat(const Source &source)
+{
+    RideJournalEntry e;
+
+    QFileInfo ride(source.path);
+    if (ride.exists()) {
+        e.size = ride.size();
+        e.mtime = ride.lastModified().toMSecsSinceEpoch();
+    }
+    QFileInfo cpx(source.cpx);
+    if (cpx.exists()) {
+        e.cpxsize = cpx.size();
+        e.cpxmtime = cpx.lastModified().toMSecsSinceEpoch();
+    }
+    return e;
+}
+
+QVector<RideJournalEntry>
+RideCacheJournal::stat(const QVector<Source> &sources)
+{
+    // thousands of stats on a network or cloud synced folder take a
+    // while, so keep a few of them in flight at once
+    QVector<RideJournalEntry> returning(sources.count());
+    QVector<int> index(sources.count());
+    for (int i=0; i<index.count(); i++) index[i] = i;
+
+    QtConcurrent::blockingMap(index, [&returning, &sources](int i) {
+        returning[i] = stat(sources[i]);
+    });
+    return returning;
+}
+
+bool
+RideCacheJournal::find(const QString &key, RideJournalEntry &entry) const
+{
+    QHash<QString, RideJournalEntry>::const_iterator it = entries.constFind(key);
+    if (it == entries.constEnd()) return false;
+    entry = it.value();
+    return true;
+}
+
+void
+RideCacheJournal::retain(const QSet<QString> &keys)
+{
+    QMutableHashIterator<QString, RideJournalEntry> i(entries);
+    while (i.hasNext()) {
+        i.next();
+        if (!keys.contains(i.key())) i.remove();
+    }
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _GC_RideCacheJournal_h
+#define _GC_RideCacheJournal_h 1
+
+#include <QString>
+#include <QVector>
+#include <QHash>
+#include <QSet>
+
+// what the activity file and its .cpx looked like when the ride was last clean
+struct RideJournalEntry
+{
+    RideJournalEntry() : size(-1), mtime(0), cpxsize(-1), cpxmtime(0), crc(0), cpxversion(0), cpxweight(0) {}
+
+    qint64 size, mtime;         // activity file, mtime in msecs
+    qint64 cpxsize, cpxmtime;   // its .cpx
+    quint32 crc;                // activity file crc as held in rideDB.json
+    quint32 cpxversion;         // RideFileCacheVersion that wrote the .cpx
+    double cpxweight;           // athlete weight the .cpx was computed with
+
+    // neither file has been touched
+    bool sameFiles(const RideJournalEntry &other) const {
+        return size >= 0 && cpxsize >= 0 &&
+               size == other.size && mtime == other.mtime &&
+               cpxsize == other.cpxsize && cpxmtime == other.cpxmtime;
+    }
+};
+
+//
+// Persisted journal of the activity files (and their .cpx) as they were when
+// the ride was last found to be up to date. At startup RideCache stats all the
+// files in one parallel pass and only rides whose files differ from the journal
+// need their contents checked (crc, .cpx header), everything else is settled
+// with the in-memory checks alone.
+//
+// A missing or unreadable journal just means everything is checked the slow
+// way, as before, so it is safe to delete.
+//
+class RideCacheJournal
+{
+    public:
+
+        // a ride to stat, key is unique across activities and planned
+        struct Source {
+            QString key, path, cpx;
+        };
+
+        bool load(QString filename);
+        bool save(QString filename) const;
+
+        // size and mtime of the files, sizes are -1 if missing
+        static RideJournalEntry stat(const Source &source);
+        static QVector<RideJournalEntry> stat(const QVector<Source> &sources);
+
+        bool find(const QString &key, RideJournalEntry &entry) const;
+        void record(const QString &key, const RideJournalEntry &entry) { entries.insert(key, entry); }
+        void forget(const QString &key) { entries.remove(key); }
+
+        // drop entries for rides that have gone
+        void retain(const QSet<QString> &keys);
+
+        int count() const { return entries.count(); }
+        void clear() { entries.clear(); }
+
+    private:
+
+        QHash<QString, RideJournalEntry> entries;
+};
+
+#endif
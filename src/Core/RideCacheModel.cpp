@@ -26,6 +26,9 @@
 
 #include "RideCacheModel.h"
 
+#include <QRegularExpression>
+#include <algorithm>
+
 
 static constexpr int highestFixed = 6;
 
@@ -43,6 +46,11 @@ RideCacheModel::RideCacheModel(Context *context, RideCache *cache) : QAbstractTa
     connect(rideCache, SIGNAL(itemChanged(RideItem*)), this, SLOT(itemChanged(RideItem*)));
 }
 
+RideCacheModel::~RideCacheModel()
+{
+    clearFormatters();
+}
+
 // must reimplement these
 int 
 RideCacheModel::rowCount(const QModelIndex &parent) const
@@ -67,13 +75,14 @@ RideCacheModel::flags(const QModelIndex &index) const
 QVariant 
 RideCacheModel::data(const QModelIndex &index, int role) const
 {
-    Q_UNUSED(role);
-
     if (!index.isValid() || index.row() < 0 || index.row() >= rideCache->count() ||
         index.column() < 0 || index.column() >= columns_) return QVariant();
 
     const RideItem *item = rideCache->rides().at(index.row());
 
+    if (role == RankRole) return ranks(index.column()).value(index.row(), 0);
+    if (role == SortRole) return sortValue(item, index.column());
+
     switch (index.column()) {
         case 0 : return item->path;
         case 1 : return item->fileName;
@@ -94,7 +103,7 @@ RideCacheModel::data(const QModelIndex &index, int role) const
 
                 // unpack metric value into ridemetric and use it to get a stringified
                 // version using the right metric/imperial conversion
-                RideMetric *m = const_cast<RideMetric*>(factory->rideMetric(factory->metricName(i)));
+                RideMetric *m = formatter(i);
 
                 // bit of a kludge, but will return times as QTime,
                 // stuff with no decimal places as a number,
@@ -128,9 +137,126 @@ RideCacheModel::data(const QModelIndex &index, int role) const
     }
 }
 
+QVariant
+RideCacheModel::sortValue(const RideItem *item, int column) const
+{
+    switch (column) {
+        case 0 : return item->path;
+        case 1 : return item->fileName;
+        case 2 : return item->dateTime;
+        case 3 : return item->present;
+        case 4 : return item->color.name();
+        case 5 : return item->planned;
+        case 6 : return item->isdirty;
+
+        default:
+        {
+            // metrics as computed, not as formatted for display
+            if (column - highestFixed < factory->metricCount()) {
+                const RideMetric *m = factory->rideMetric(factory->metricName(column - highestFixed));
+                return item->metrics_.value(m->index(), 0);
+            }
+
+            // metadata, numbers as numbers
+            const FieldDefinition &field = metadata[column - highestFixed - factory->metricCount()];
+            QString text = item->getText(field.name, "");
+            if (field.type == GcFieldType::FIELD_INTEGER || field.type == GcFieldType::FIELD_DOUBLE ||
+                field.type == GcFieldType::FIELD_CHECKBOX)
+                return text.toDouble();
+            return text;
+        }
+    }
+}
+
+namespace {
+    struct SortKey {
+        int row;
+        bool number;
+        double value;
+        QString text;
+    };
+
+    // as the navigator always sorted, text unless both are numbers
+    bool sortKeyLessThan(const SortKey &left, const SortKey &right)
+    {
+        if (!left.number || !right.number) return QString::localeAwareCompare(left.text, right.text) < 0;
+        return left.value < right.value;
+    }
+}
+
+const QVector<int> &
+RideCacheModel::ranks(int column) const
+{
+    QHash<int, QVector<int> >::const_iterator cached = ranks_.constFind(column);
+    if (cached != ranks_.constEnd()) return cached.value();
+
+    static const QRegularExpression alpha("[^0-9.,]");
+
+    // work out each key once, rather than for every comparison
+    const QVector<RideItem*> &rides = rideCache->rides();
+    QVector<SortKey> keys(rides.count());
+    for (int row=0; row<rides.count(); row++) {
+        QVariant value = sortValue(rides.at(row), column);
+        SortKey &key = keys[row];
+        key.row = row;
+        switch (value.metaType().id()) {
+            case QMetaType::Double:
+            case QMetaType::Bool:
+                key.number = true;
+                key.value = value.toDouble();
+                break;
+            case QMetaType::QDateTime:
+                key.number = true;
+                key.value = value.toDateTime().toMSecsSinceEpoch();
+                break;
+            default:
+                key.text = value.toString();
+                key.number = !key.text.contains(alpha);
+                key.value = key.text.toDouble();
+                break;
+        }
+    }
+    std::stable_sort(keys.begin(), keys.end(), sortKeyLessThan);
+
+    // ties share a rank so they keep their order either way round
+    QVector<int> &returning = ranks_[column];
+    returning.resize(keys.count());
+    int rank = 0;
+    for (int i=0; i<keys.count(); i++) {
+        if (i > 0 && sortKeyLessThan(keys[i-1], keys[i])) rank++;
+        returning[keys[i].row] = rank;
+    }
+    return returning;
+}
+
+RideMetric *
+RideCacheModel::formatter(int i) const
+{
+    if (formatters_.count() != factory->metricCount()) {
+        clearFormatters();
+        formatters_.fill(NULL, factory->metricCount());
+    }
+
+    const RideMetric *m = factory->rideMetric(factory->metricName(i));
+    if (formatters_[i] == NULL) formatters_[i] = m->clone();
+
+    // can't be copied, share it as we always did
+    if (formatters_[i] == NULL) return const_cast<RideMetric*>(m);
+    return formatters_[i];
+}
+
+void
+RideCacheModel::clearFormatters() const
+{
+    foreach(RideMetric *m, formatters_) delete m;
+    formatters_.clear();
+}
+
 void
 RideCacheModel::itemChanged(RideItem *item)
 {
+    invalidateRanks();
+
     // ok so lets signal that
     int row = rideCache->rides().indexOf(item);
     if (row >= 0 && row <= rideCache->count()) {
@@ -140,15 +266,15 @@ RideCacheModel::itemChanged(RideItem *item)
     context->tab->view(1)->sidebar()->update();
 }
 
-void RideCacheModel::beginReset() { beginResetModel(); }
-void RideCacheModel::endReset() { endResetModel(); }
+void RideCacheModel::beginReset() { beginResetModel(); invalidateRanks(); }
+void RideCacheModel::endReset() { invalidateRanks(); endResetModel(); }
 
 void 
 RideCacheModel::itemAdded(RideItem*)
 {
-    // nothing to do now as the cache
-    // told us to begin/end reset model
-    // whilst it updated the ride list
+    // the cache told us to begin/end reset model whilst it
+    // updated the ride list, unless it replaced one in place
+    invalidateRanks();
 }
 
 void
@@ -160,6 +286,7 @@ RideCacheModel::startRemove(int index)
 void
 RideCacheModel::endRemove(int)
 {
+    invalidateRanks();
     endRemoveRows();
 }
 
@@ -202,6 +329,8 @@ RideCacheModel::configChanged(qint32)
 {
     // we are resetting
     beginResetModel();
+    invalidateRanks();
+    clearFormatters();
 
     // get field config
     metadata = GlobalContext::context()->rideMetadata->getFields();
@@ -261,6 +390,8 @@ RideCacheModel::configChanged(qint32)
 void 
 RideCacheModel::refreshUpdate(QDate)
 {
+    // metrics are being recomputed
+    invalidateRanks();
 }
 
 void 
@@ -271,4 +402,5 @@ RideCacheModel::refreshStart()
 void 
 RideCacheModel::refreshEnd()
 {
+    invalidateRanks();
 }
@@ -30,6 +30,8 @@
 #include <QAbstractTableModel>
 #include <QModelIndex>
 #include <QVariant>
+#include <QVector>
+#include <QHash>
 
 class Context;
 
@@ -39,6 +41,13 @@ class RideCacheModel : public QAbstractTableModel
 
     public:
         RideCacheModel(Context *, RideCache *);
+        ~RideCacheModel();
+
+        // roles beyond display, for sorting without formatting every cell
+        enum Roles {
+            SortRole = Qt::UserRole + 16,   // typed value, metrics as stored in metrics_
+            RankRole = Qt::UserRole + 17    // [int] row's place sorted ascending on the column, ties equal
+        };
 
         // must reimplement these
         int rowCount(const QModelIndex &parent = QModelIndex()) const; 
@@ -75,6 +84,21 @@ class RideCacheModel : public QAbstractTableModel
         RideCache *rideCache;
         RideMetricFactory *factory;
 
+        QVariant sortValue(const RideItem *item, int column) const;
+
+        // ranks of every row for each column sorted so far, the sort proxy
+        // compares these and reads them backwards for descending; dropped
+        // whenever any item or the rows change
+        const QVector<int> &ranks(int column) const;
+        void invalidateRanks() { ranks_.clear(); }
+        mutable QHash<int, QVector<int> > ranks_;
+
+        // our own copies of the metrics to format values with, rather than
+        // setting values on the ones the factory shares with everyone
+        RideMetric *formatter(int i) const;
+        void clearFormatters() const;
+        mutable QVector<RideMetric*> formatters_;
+
         int columns_; // column count, based upon metric + meta config
         QStringList headings_;
         QStringList headingsTechnical_;
@@ -18,9 +18,11 @@
 
 #include "RideItem.h"
 #include "RideCache.h"
+#include "RideResidency.h"
 #include "RideMetric.h"
 #include "RideFile.h"
 #include "RideFileCache.h"
+#include "RideCacheJournal.h"
 #include "RideMetadata.h"
 #include "IntervalItem.h"
 #include "Route.h"
@@ -33,12 +35,16 @@
 #include "AddIntervalDialog.h" // till we fixup ridefilecache to have offsets
 #include "TimeUtils.h" // time_to_string()
 #include "WPrime.h" // for matches
+#include "RidePrefix.h" // for interval metrics
 
 #include <cmath>
 #include <QtAlgorithms>
 #include <QMap>
 #include <QMapIterator>
 #include <QByteArray>
+#include <QThread>
+#include <QElapsedTimer>
+#include <QApplication>
 
 // used to create a temporary ride item that is not in the cache and just
 // used to enable using the same calling semantics in things like the
@@ -172,14 +178,53 @@ RideItem::metaCRC()
     return qChecksum(ba);
 }
 
+// the residency manager looks after rides opened on the GUI thread, the
+// refresh threads open and close their own
+static RideResidency *
+residency(Context *context, bool anyThread = false)
+{
+    if (!anyThread && QThread::currentThread() != qApp->thread()) return NULL;
+    if (context && context->athlete && context->athlete->rideCache) return context->athlete->rideCache->residency();
+    return NULL;
+}
+
 RideFile *RideItem::ride(bool open)
 {
-    if (!open || ride_) return ride_;
+    if (!open) return ride_;
+
+    RideResidency *residency = ::residency(context);
+    if (ride_) {
+        if (residency) residency->touch(this);
+        return ride_;
+    }
+
+    // the GUI waits whilst we read it
+    QElapsedTimer stalled;
+    stalled.start();
+
+    // being read in the background already?
+    if (residency && residency->wait(this)) {
+        residency->stalled(stalled.nsecsElapsed() / 1000);
+        return ride_;
+    }
 
     // open the ride file
     QFile file(path + "/" + fileName);
-    ride_ = RideFileFactory::instance().openRideFile(context, file, errors_);
-    if (ride_ == NULL) return NULL; // failed to read ride
+    RideFile *read = RideFileFactory::instance().openRideFile(context, file, errors_);
+    if (read == NULL) return NULL; // failed to read ride
+
+    opened(read);
+    if (residency) {
+        residency->opened(this);
+        residency->stalled(stalled.nsecsElapsed() / 1000);
+    }
+    return ride_;
+}
+
+void
+RideItem::opened(RideFile *ride)
+{
+    ride_ = ride;
 
     // update the overrides
     overrides_.clear();
@@ -235,14 +280,15 @@ RideFile *RideItem::ride(bool open)
     connect(ride_, SIGNAL(modified()), this, SLOT(modified()));
     connect(ride_, SIGNAL(saved()), this, SLOT(saved()));
     connect(ride_, SIGNAL(reverted()), this, SLOT(reverted()));
-
-    return ride_;
 }
 
 RideItem::~RideItem()
 {
     // add to the deleted list
-    if (context && context->athlete && context->athlete->rideCache) context->athlete->rideCache->deletelist << this;
+    if (context && context->athlete && context->athlete->rideCache) {
+        context->athlete->rideCache->deletelist << this;
+        context->athlete->rideCache->index_.remove(this);
+    }
 
     //qDebug()<<"deleting:"<<fileName;
     if (isOpen()) close();
@@ -359,11 +405,9 @@ RideItem::notifyRideDataChanged()
     // wipe user data
     userCache.clear();
 
-    // force a recompute of derived data series
-    if (ride_) {
-        ride_->wstale = true;
-        ride_->recalculateDerivedSeries(true);
-    }
+    // the edits marked the derived series they made stale, they
+    // get worked out again when next read
+    if (ride_) ride_->wstale = true;
 
     // refresh the cache
     if (fileCache_) fileCache_->refresh(ride_);
@@ -430,6 +474,7 @@ RideItem::setFileName(QString path, QString fileName)
 {
     this->path = path;
     this->fileName = fileName;
+    if (context && context->athlete && context->athlete->rideCache) context->athlete->rideCache->reindex(this);
 }
 
 bool
@@ -443,6 +488,9 @@ RideItem::close()
 {
     // ride data
     if (ride_) {
+        RideResidency *residency = ::residency(context, true);
+        if (residency) residency->closed(this);
+
         // break link to ride file
         foreach(IntervalItem *x, intervals()) x->rideInterval = NULL;
         delete ride_;
@@ -461,11 +509,12 @@ RideItem::setStartTime(QDateTime newDateTime)
 {
     dateTime = newDateTime;
     ride()->setStartTime(newDateTime);
+    if (context && context->athlete && context->athlete->rideCache) context->athlete->rideCache->reindex(this);
 }
 
 // check if we need to be refreshed
 bool
-RideItem::checkStale()
+RideItem::checkStale(const RideJournalEntry *unchanged)
 {
     // if we're marked stale already then just return that !
     if (isstale) return true;
@@ -514,19 +563,22 @@ RideItem::checkStale()
 
             } else {
 
-                // or has file content changed ?
-                QString fullPath =  QString(context->athlete->home->activities().absolutePath()) + "/" + fileName;
-                QFile file(fullPath);
+                // or has file content changed ? no need to look if the
+                // journal says it hasn't been touched since we were clean
+                if (unchanged == NULL) {
+                    QString fullPath =  QString(context->athlete->home->activities().absolutePath()) + "/" + fileName;
+                    QFile file(fullPath);
 
-                // has timestamp changed ?
-                if (timestamp < QFileInfo(file).lastModified().toSecsSinceEpoch()) {
+                    // has timestamp changed ?
+                    if (timestamp < QFileInfo(file).lastModified().toSecsSinceEpoch()) {
 
-                    // if timestamp has changed then check crc
-                    unsigned long fcrc = RideFile::computeFileCRC(fullPath);
+                        // if timestamp has changed then check crc
+                        unsigned long fcrc = RideFile::computeFileCRC(fullPath);
 
-                    if (crc == 0 || crc != fcrc) {
-                        crc = fcrc; // update as expensive to calculate
-                        isstale = true;
+                        if (crc == 0 || crc != fcrc) {
+                            crc = fcrc; // update as expensive to calculate
+                            isstale = true;
+                        }
                     }
                 }
 
@@ -540,7 +592,11 @@ RideItem::checkStale()
     }
 
     // still reckon its clean? what about the cache ?
-    if (isstale == false) isstale = RideFileCache::checkStale(context, this);
+    // the journal knows the header of an untouched .cpx, so only the weight can differ
+    if (isstale == false) {
+        if (unchanged) isstale = unchanged->cpxweight != getWeight();
+        else isstale = RideFileCache::checkStale(context, this);
+    }
 
     // we need to mark stale in case "special" fields may have changed (e.g. CP)
     if (metacrc != metaCRC()) isstale = true;
@@ -591,6 +647,10 @@ RideItem::refresh()
     // update current state coz we'll fix it below
     isstale = false;
 
+    // we're usually on a refresh thread, so keep the residency
+    // manager from closing it under us
+    RideHandle pinned(this);
+
     // open ride file will extract details too, but only if not
     // already open since its a user entry point and will call
     // refresh when opened. We don't want a recursion here.
@@ -711,10 +771,10 @@ RideItem::refresh()
             close();
         } else {
 
-            // if it is open then recompute
+            // if it is open then recompute when next read
             userCache.clear();
             ride_->wstale = true;
-            ride_->recalculateDerivedSeries(true);
+            ride_->invalidateDerived(RideFile::DeriveAll);
         }
 
     } else {
@@ -911,6 +971,10 @@ RideItem::updateIntervals()
         return;
     }
 
+    // running totals of the samples for the metrics that can use them,
+    // as there may be dozens of intervals; built as they're needed
+    RidePrefix prefix(f, context->athlete->zones(sport), zoneRange);
+
     // Get CP and W' estimates for date of ride
     double CP = 0;
     double WPRIME = 0;
@@ -959,7 +1023,7 @@ RideItem::updateIntervals()
                                                 RideFileInterval::ALL);
 
         // same as the whole ride, not need to compute
-        entire->refresh();
+        entire->refresh(&prefix);
         entire->rideInterval = NULL;
         intervals_ << entire;
     }
@@ -998,7 +1062,7 @@ RideItem::updateIntervals()
                                                       RideFileInterval::USER);
 
         intervalItem->rideInterval = interval;
-        intervalItem->refresh();        // XXX will get called in constructor when refactor
+        intervalItem->refresh(&prefix);        // XXX will get called in constructor when refactor
         intervals_ << intervalItem;
 
         count++;
@@ -1035,7 +1099,7 @@ RideItem::updateIntervals()
                                                             false,
                                                             RideFileInterval::PEAKPOWER);
                 intervalItem->rideInterval = NULL;
-                intervalItem->refresh();        // XXX will get called in constructore when refactor
+                intervalItem->refresh(&prefix);        // XXX will get called in constructore when refactor
                 intervals_ << intervalItem;
             }
         }
@@ -1072,7 +1136,7 @@ RideItem::updateIntervals()
                                                             false,
                                                             RideFileInterval::PEAKPACE);
                 intervalItem->rideInterval = NULL;
-                intervalItem->refresh();        // XXX will get called in constructore when refactor
+                intervalItem->refresh(&prefix);        // XXX will get called in constructore when refactor
                 intervals_ << intervalItem;
             }
         }
@@ -1359,7 +1423,7 @@ RideItem::updateIntervals()
             }
 
             intervalItem->rideInterval = NULL;
-            intervalItem->refresh();        // XXX will get called in constructore when refactor
+            intervalItem->refresh(&prefix);        // XXX will get called in constructore when refactor
             intervals_ << intervalItem;
 
             //qDebug()<<fileName<<"IS EFFORT"<<x.quality<<"at"<<x.start<<"duration"<<x.duration;
@@ -1380,7 +1444,7 @@ RideItem::updateIntervals()
 
 
             intervalItem->rideInterval = NULL;
-            intervalItem->refresh();        // XXX will get called in constructore when refactor
+            intervalItem->refresh(&prefix);        // XXX will get called in constructore when refactor
             intervals_ << intervalItem;
 
             //qDebug()<<fileName<<"IS EFFORT"<<x.quality<<"at"<<x.start<<"duration"<<x.duration;
@@ -1481,7 +1545,7 @@ RideItem::updateIntervals()
                                                                           false,
                                                                           RideFileInterval::CLIMB);
                             intervalItem->rideInterval = NULL;
-                            intervalItem->refresh();        // XXX will get called in constructore when refactor
+                            intervalItem->refresh(&prefix);        // XXX will get called in constructore when refactor
                             intervals_ << intervalItem;
                         } else {
                             //qDebug() << "        NOT HILL " << "at " << pstart->km << "km " <<  pstart->secs/60.0 <<"-"<< pstop->secs/60.0 << "min " <<  distance  << "km" << height/distance/10.0 << "%";
@@ -1515,7 +1579,7 @@ RideItem::updateIntervals()
         // add to ride !
         foreach(IntervalItem *add, here) {
             add->rideInterval = NULL;
-            add->refresh();
+            add->refresh(&prefix);
             intervals_ << add;
         }
     }
@@ -1539,7 +1603,7 @@ RideItem::updateIntervals()
                                                             false, // XXX FIXME should this be a test if to exhaustion ??? XXX
                                                             RideFileInterval::EFFORT);
                 intervalItem->rideInterval = NULL;
-                intervalItem->refresh();        // XXX will get called in constructore when refactor
+                intervalItem->refresh(&prefix);        // XXX will get called in constructore when refactor
 
                 // now all the metrics are computed update the name to
                 // reflect the AP which was calculated for it, and duration
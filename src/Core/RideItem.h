@@ -27,6 +27,8 @@
 #include <QString>
 #include <QMap>
 #include <QVector>
+#include <QAtomicInt>
+#include <atomic>
 
 class RideFile;
 class RideFileCache;
@@ -37,6 +39,9 @@ class IntervalSummaryWindow;
 class Context;
 class UserData;
 class ComparePane;
+class RideResidency;
+class RideHandle;
+struct RideJournalEntry;
 
 class RideItem : public QObject
 {
@@ -53,11 +58,21 @@ class RideItem : public QObject
         friend class ::IntervalSummaryWindow;
         friend class ::UserData;
         friend class ::ComparePane;
+        friend class ::RideResidency;
+        friend class ::RideHandle;
 
         // ridefile
         RideFile *ride_;
         RideFileCache *fileCache_;
 
+        // held open by RideHandles, -1 whilst RideResidency closes it,
+        // and when last asked for (RideResidency)
+        QAtomicInt pins_;
+        std::atomic<quint64> used_ {0};
+
+        // take on a ride file just read for us
+        void opened(RideFile *ride);
+
         // precomputed metrics & user overrides
         QVector<double> metrics_;
         QVector<double> count_;
@@ -201,6 +216,8 @@ class RideItem : public QObject
         // traverse currently open rides when config changes
         void close();
         bool isOpen();
+        bool isPinned() const { return pins_.loadRelaxed() > 0; }
+        quint64 lastUsed() const { return used_.load(std::memory_order_relaxed); }
 
         // create and destroy
         RideItem();
@@ -213,7 +230,7 @@ class RideItem : public QObject
         // state
         void setDirty(bool);
         bool isDirty() { return isdirty; }
-        bool checkStale(); // check if we need to refresh
+        bool checkStale(const RideJournalEntry *unchanged = NULL); // check if we need to refresh, journal entry if files untouched
         bool isStale() { return isstale; }
 
         // Activity linking methods
@@ -0,0 +1,435 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "RideResidency.h"
+#include "RideItem.h"
+#include "RideFile.h"
+#include "RideCache.h"
+#include "Context.h"
+#include "Athlete.h"
+#include "Settings.h"
+
+#include <QtConcurrent>
+#include <algorithm>
+
+RideResidency::RideResidency(Context *context, QObject *parent) : QObject(parent),
+    context(context), trimming(false), notifying(false),
+    stalls_(1000, 5000), selections_(1000, 5000), renders_(1000, 5000), clock(0)
+{
+    counts = Stats();
+
+    // a thread or two is plenty, its the disk we're waiting on
+    pool.setMaxThreadCount(2);
+
+    connect(context, SIGNAL(rideSelected(RideItem*)), this, SLOT(rideSelected(RideItem*)));
+}
+
+RideResidency::~RideResidency()
+{
+    // anything still being read is thrown away
+    pool.clear();
+    pool.waitForDone();
+    foreach(QFutureWatcher<RideFile*> *watcher, loading.keys()) {
+        disconnect(watcher, NULL, this, NULL);
+        watcher->waitForFinished();
+        delete watcher->result();
+    }
+}
+
+qint64
+RideResidency::budget() const
+{
+    return appsettings->value(NULL, GC_RIDE_MEMORY, 1024).toLongLong() * 1024 * 1024;
+}
+
+qint64
+RideResidency::footprint(RideFile *ride)
+{
+    if (ride == NULL) return 0;
+
+    qint64 bytes = sizeof(RideFile);
+    bytes += ride->dataPoints().count() * qint64(sizeof(RideFilePoint) + sizeof(RideFilePoint*));
+    foreach(XDataSeries *series, ride->xdata())
+        bytes += series->datapoints.count() * qint64(sizeof(XDataPoint) + sizeof(XDataPoint*));
+    return bytes;
+}
+
+void
+RideResidency::touch(RideItem *item)
+{
+    item->used_.store(++clock, std::memory_order_relaxed);
+}
+
+void
+RideResidency::opened(RideItem *item, How how)
+{
+    QMutexLocker locker(&mutex);
+
+    Entry add;
+    add.bytes = footprint(item->ride_);
+    add.prefetched = (how == Prefetched);
+    if (resident.contains(item)) counts.bytes -= resident.value(item).bytes;
+    resident.insert(item, add);
+    touch(item);
+
+    counts.bytes += add.bytes;
+    if (counts.bytes > counts.peak) counts.peak = counts.bytes;
+    switch (how) {
+    case Opened: counts.opens++; break;
+    case Loaded: counts.loads++; break;
+    case Prefetched: counts.prefetched++; break;
+    }
+
+    // not whilst the caller is still using what it asked for
+    qint64 limit = budget();
+    if (limit > 0 && counts.bytes > limit && !trimming) {
+        trimming = true;
+        QMetaObject::invokeMethod(this, "trim", Qt::QueuedConnection);
+    }
+}
+
+void
+RideResidency::closed(RideItem *item)
+{
+    QMutexLocker locker(&mutex);
+
+    QHash<RideItem*, Entry>::iterator it = resident.find(item);
+    if (it == resident.end()) return;
+
+    counts.bytes -= it.value().bytes;
+    if (it.value().prefetched) counts.wasted++;
+    resident.erase(it);
+}
+
+static bool
+lessRecent(const RideItem *a, const RideItem *b)
+{
+    return a->lastUsed() < b->lastUsed();
+}
+
+void
+RideResidency::trim()
+{
+    trimming = false;
+
+    qint64 limit = budget();
+    if (limit <= 0) return;
+
+    // the ones we can close, oldest first
+    QVector<RideItem*> candidates;
+    mutex.lock();
+    if (counts.bytes > limit) {
+        for(QHash<RideItem*, Entry>::const_iterator it = resident.constBegin(); it != resident.constEnd(); ++it) {
+            RideItem *item = it.key();
+            if (item->isPinned() || item->isdirty || item->isedit || item == context->rideItem()) continue;
+            candidates << item;
+        }
+    }
+    mutex.unlock();
+    std::sort(candidates.begin(), candidates.end(), lessRecent);
+
+    // leave some room so we aren't back here on the next open
+    foreach(RideItem *item, candidates) {
+
+        mutex.lock();
+        bool done = counts.bytes <= limit * 9 / 10;
+        mutex.unlock();
+        if (done) break;
+
+        // the refresh threads and python pin rides as they go, so one
+        // may have been pinned since we looked, if so it stays open
+        if (!item->pins_.testAndSetOrdered(0, -1)) continue;
+        item->close();
+        item->pins_.storeRelease(0);
+
+        mutex.lock();
+        counts.evictions++;
+        mutex.unlock();
+    }
+}
+
+void
+RideResidency::rideSelected(RideItem *item)
+{
+    if (item == NULL) return;
+
+    // counted in select() when it was us
+    mutex.lock();
+    QHash<RideItem*, Entry>::iterator it = resident.find(item);
+    if (it != resident.end()) {
+        if (!notifying) counts.hits++;
+        it.value().prefetched = false;
+    } else if (!notifying && !item->isOpen()) {
+        counts.misses++;
+    }
+    qint64 bytes = counts.bytes;
+    mutex.unlock();
+
+    // the neighbours in the list, if there's room for them
+    qint64 limit = budget();
+    if (limit > 0 && bytes > limit * 9 / 10) return;
+
+    if (context->athlete->rideCache == NULL) return;
+    const QVector<RideItem*> &rides = context->athlete->rideCache->rides();
+    int index = rides.indexOf(item);
+    if (index < 0) return;
+    if (index > 0) prefetch(rides[index-1]);
+    if (index < rides.count()-1) prefetch(rides[index+1]);
+}
+
+void
+RideResidency::select(RideItem *item, bool wait)
+{
+    if (item == NULL) return;
+
+    selecting_ = item;
+    selectTimer.start();
+
+    // the user has moved on, anything not started yet isn't wanted
+    for(QHash<QFutureWatcher<RideFile*>*, Load>::iterator it = loading.begin(); it != loading.end(); ++it)
+        if (it.value().item != item) *it.value().cancelled = true;
+
+    mutex.lock();
+    if (item->isOpen()) counts.hits++;
+    else counts.misses++;
+    mutex.unlock();
+
+    // a read already under way is waited for
+    if (wait && !item->isOpen()) item->ride();
+
+    if (item->isOpen() || wait) selected();
+    else read(item, false);
+}
+
+void
+RideResidency::cancelSelection()
+{
+    selecting_ = NULL;
+    for(QHash<QFutureWatcher<RideFile*>*, Load>::iterator it = loading.begin(); it != loading.end(); ++it)
+        *it.value().cancelled = true;
+}
+
+void
+RideResidency::selected()
+{
+    RideItem *item = selecting_;
+    selecting_ = NULL;
+    if (item == NULL) return;
+
+    selections_.add(selectTimer.nsecsElapsed() / 1000);
+
+    // charts mostly redraw as they're told
+    QElapsedTimer render;
+    render.start();
+    notifying = true;
+    context->notifyRideSelected(item);
+    notifying = false;
+    renders_.add(render.nsecsElapsed() / 1000);
+}
+
+void
+RideResidency::load(RideItem *item)
+{
+    if (item == NULL) return;
+    if (item->isOpen()) emit loaded(item);
+    else read(item, false);
+}
+
+void
+RideResidency::prefetch(RideItem *item)
+{
+    if (item == NULL || item->isOpen()) return;
+    read(item, true);
+}
+
+void
+RideResidency::read(RideItem *item, bool prefetch)
+{
+    if (item->fileName.isEmpty()) return;
+
+    // already on its way, but wanted now
+    for(QHash<QFutureWatcher<RideFile*>*, Load>::iterator it = loading.begin(); it != loading.end(); ++it) {
+        if (it.value().item == item) {
+            if (!prefetch) it.value().prefetch = false;
+            *it.value().cancelled = false;
+            return;
+        }
+    }
+
+    Load add;
+    add.item = item;
+    add.prefetch = prefetch;
+    add.cancelled = QSharedPointer<std::atomic<bool> >(new std::atomic<bool>(false));
+
+    // read it on the pool and hand it back to the GUI thread, with
+    // W'bal worked out since most charts will want it
+    QString filename = item->path + "/" + item->fileName;
+    Context *context = this->context;
+    QThread *gui = thread();
+    QSharedPointer<std::atomic<bool> > cancelled = add.cancelled;
+
+    QFutureWatcher<RideFile*> *watcher = new QFutureWatcher<RideFile*>(this);
+    loading.insert(watcher, add);
+    connect(watcher, SIGNAL(finished()), this, SLOT(finished()));
+    watcher->setFuture(QtConcurrent::run(&pool, [filename, context, gui, cancelled]() -> RideFile* {
+        if (*cancelled) return NULL;
+
+        QFile file(filename);
+        QStringList errors;
+        RideFile *ride = RideFileFactory::instance().openRideFile(context, file, errors);
+        if (ride == NULL) return NULL;
+
+        if (!*cancelled) ride->wprimeData();
+        ride->moveToThread(gui);
+        return ride;
+    }));
+}
+
+bool
+RideResidency::wait(RideItem *item)
+{
+    for(QHash<QFutureWatcher<RideFile*>*, Load>::iterator it = loading.begin(); it != loading.end(); ++it) {
+        if (it.value().item != item) continue;
+
+        // we'll see to it here rather than in finished()
+        QFutureWatcher<RideFile*> *watcher = it.key();
+        Load load = it.value();
+        loading.erase(it);
+        disconnect(watcher, NULL, this, NULL);
+
+        *load.cancelled = false;
+        watcher->waitForFinished();
+        RideFile *ride = watcher->result();
+        watcher->deleteLater();
+
+        if (ride == NULL) return false;
+        adopt(item, ride, load.prefetch ? Prefetched : Loaded);
+
+        // still to be announced, unless something else was selected since
+        if (item == selecting_) {
+            QPointer<RideItem> was(item);
+            QMetaObject::invokeMethod(this, [this, was]() { if (was && was == selecting_) selected(); }, Qt::QueuedConnection);
+        }
+        return item->isOpen();
+    }
+    return false;
+}
+
+void
+RideResidency::finished()
+{
+    QFutureWatcher<RideFile*> *watcher = static_cast<QFutureWatcher<RideFile*>*>(sender());
+    Load load = loading.take(watcher);
+    RideFile *ride = watcher->result();
+    watcher->deleteLater();
+
+    RideItem *item = load.item;
+    if (ride) adopt(item, ride, load.prefetch ? Prefetched : Loaded);
+
+    // if it couldn't be read the charts will find out when they try
+    if (item && item == selecting_) selected();
+}
+
+void
+RideResidency::adopt(RideItem *item, RideFile *ride, How how)
+{
+    // deleted, or opened whilst we were reading it
+    if (item == NULL || item->isOpen()) {
+        delete ride;
+        mutex.lock();
+        counts.wasted++;
+        mutex.unlock();
+        return;
+    }
+
+    item->opened(ride);
+    opened(item, how);
+    emit loaded(item);
+}
+
+RideResidency::Stats
+RideResidency::stats() const
+{
+    QMutexLocker locker(&mutex);
+
+    Stats returning = counts;
+    returning.resident = resident.count();
+    return returning;
+}
+
+QString
+RideResidency::Stats::toString() const
+{
+    return QString("resident=%1 bytes=%2MB peak=%3MB hits=%4 misses=%5 opens=%6 loads=%7 prefetched=%8 wasted=%9 evictions=%10")
+           .arg(resident).arg(bytes / 1048576.0, 0, 'f', 1).arg(peak / 1048576.0, 0, 'f', 1)
+           .arg(hits).arg(misses).arg(opens).arg(loads).arg(prefetched).arg(wasted).arg(evictions);
+}
+
+//
+// RideHandle
+//
+RideHandle::RideHandle(RideItem *item) : item_(item)
+{
+    pin();
+}
+
+RideHandle::RideHandle(const RideHandle &other) : item_(other.item_)
+{
+    pin();
+}
+
+RideHandle &
+RideHandle::operator=(const RideHandle &other)
+{
+    if (item_ != other.item_) {
+        unpin();
+        item_ = other.item_;
+        pin();
+    }
+    return *this;
+}
+
+RideHandle::~RideHandle()
+{
+    unpin();
+}
+
+RideFile *
+RideHandle::ride() const
+{
+    return item_ ? item_->ride() : NULL;
+}
+
+void
+RideHandle::pin()
+{
+    if (item_ == NULL) return;
+
+    // if it is being closed wait for that to finish, it won't be long
+    forever {
+        int pins = item_->pins_.loadAcquire();
+        if (pins >= 0 && item_->pins_.testAndSetOrdered(pins, pins + 1)) break;
+        QThread::yieldCurrentThread();
+    }
+}
+
+void
+RideHandle::unpin()
+{
+    if (item_) item_->pins_.deref();
+}
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _GC_RideResidency_h
+#define _GC_RideResidency_h 1
+#include "GoldenCheetah.h"
+
+#include "LatencyHistogram.h"
+
+#include <QObject>
+#include <QHash>
+#include <QPointer>
+#include <QMutex>
+#include <QThreadPool>
+#include <QFutureWatcher>
+#include <QSharedPointer>
+#include <QElapsedTimer>
+#include <atomic>
+
+class Context;
+class RideItem;
+class RideFile;
+
+//
+// Keeps the rides opened on the GUI thread within a memory budget.
+//
+// RideItem::ride() tells us when it opens a ride and each time it is asked
+// for one that is already open; once the rides held open go over the budget
+// those used least recently are closed, unless pinned with a RideHandle,
+// unsaved, being edited or the one selected.
+//
+// Rides are read on a small pool of threads, with W'bal worked out whilst
+// there, and handed to their RideItem on the GUI thread. A ride selected in
+// the activity list is read that way and only announced once it is open,
+// so the GUI doesn't wait on the disk; choosing another before it is ready
+// cancels whatever hasn't been started. Selections made from code are still
+// opened and announced before select() returns, as callers expect. The neighbours of the selected ride
+// are read ahead so stepping through the list finds them open already.
+//
+// How long the GUI thread waited for rides to open, how long a selection
+// took to be ready and how long the charts took over it are kept in
+// histograms for the diagnostics.
+//
+class RideResidency : public QObject
+{
+    Q_OBJECT
+
+    public:
+
+        RideResidency(Context *context, QObject *parent = NULL);
+        ~RideResidency();
+
+        // from RideItem, opened and closed on the GUI thread only
+        enum How { Opened, Loaded, Prefetched };
+        void opened(RideItem *item, How how = Opened);
+        void closed(RideItem *item);
+        void touch(RideItem *item);
+
+        // the GUI thread couldn't get on whilst a ride was opened
+        void stalled(qint64 usecs) { stalls_.add(usecs); }
+
+        // take a background read of the ride if there is one, waiting for
+        // it to finish, true if the ride is open now
+        bool wait(RideItem *item);
+
+        // open in the background, loaded() once it is
+        void load(RideItem *item);
+        void prefetch(RideItem *item);
+
+        // select once it is open, replacing any selection still loading,
+        // when waiting it is opened and announced before we return
+        void select(RideItem *item, bool wait = false);
+        RideItem *selecting() const { return selecting_; }
+
+        // the user went back to the ride already selected, so nothing
+        // still loading is to be announced
+        void cancelSelection();
+
+        // bytes to keep open, from GC_RIDE_MEMORY (MB), 0 for no limit
+        qint64 budget() const;
+
+        // what a ride costs us, near enough
+        static qint64 footprint(RideFile *ride);
+
+        // how we're doing
+        struct Stats {
+            int resident;           // rides open
+            qint64 bytes, peak;     // and their footprint
+            int hits, misses;       // selected rides that were / were not open
+            int opens;              // opened on the GUI thread, the user waited
+            int loads;              // opened in the background when asked
+            int prefetched, wasted; // opened in the background, and never used
+            int evictions;
+            QString toString() const;
+        };
+        Stats stats() const;
+
+        // usecs, see above
+        const LatencyHistogram &stalls() const { return stalls_; }
+        const LatencyHistogram &selections() const { return selections_; }
+        const LatencyHistogram &renders() const { return renders_; }
+
+    public slots:
+
+        // close the least recently used until back under budget
+        void trim();
+
+        void rideSelected(RideItem *item);
+
+    signals:
+
+        void loaded(RideItem *item);
+
+    private slots:
+
+        void finished();
+        void selected();
+
+    private:
+
+        Context *context;
+        mutable QMutex mutex;
+
+        struct Entry {
+            qint64 bytes;
+            bool prefetched;        // and not used since
+        };
+        QHash<RideItem*, Entry> resident;
+        QThreadPool pool;
+        bool trimming;
+
+        // reads in progress, GUI thread only
+        struct Load {
+            QPointer<RideItem> item;
+            bool prefetch;
+            QSharedPointer<std::atomic<bool> > cancelled;
+        };
+        QHash<QFutureWatcher<RideFile*>*, Load> loading;
+        void read(RideItem *item, bool prefetch);
+        void adopt(RideItem *item, RideFile *ride, How how);
+
+        QPointer<RideItem> selecting_;
+        QElapsedTimer selectTimer;
+        bool notifying;
+        LatencyHistogram stalls_, selections_, renders_;
+
+        std::atomic<quint64> clock;
+        Stats counts;
+};
+
+//
+// Holds a ride open whilst in scope (or copied), the residency manager
+// won't close a pinned ride to make room for others.
+//
+class RideHandle
+{
+    public:
+
+        RideHandle(RideItem *item = NULL);
+        RideHandle(const RideHandle &other);
+        RideHandle &operator=(const RideHandle &other);
+        ~RideHandle();
+
+        RideItem *item() const { return item_; }
+        RideFile *ride() const; // opened if need be, NULL if it can't be read
+
+    private:
+
+        void pin();
+        void unpin();
+
+        RideItem *item_;
+};
+
+#endif
@@ -165,6 +165,7 @@
 #define GC_LAST_VERSION_CHECKED         "<global-general>lastVersionChecked"
 #define GC_LAST_VERSION_CHECK_DATE      "<global-general>lastVersionCheckDate"
 #define GC_STARTUP_VIEW                 "<global-general>startupView"
+#define GC_RIDE_MEMORY                  "<global-general>rideMemory"                         // MB of activities kept open
 
 
 
@@ -195,6 +196,7 @@
 #define GC_SPD2THB		            	"<global-general>dataprocess/fixmoxy/spd2thb"
 #define GC_DPFLS_PL                     "<global-general>dataprocess/fixlapswim/pool_length"
 #define GC_DPFLS_MR                     "<global-general>dataprocess/fixlapswim/min_rest"
+#define GC_DPFE_DEMDIR                  "<global-general>dataprocess/fixelevation/demdir"
 #define GC_RR_MAX                       "<global-general>dataprocess/filterhrv/rr_max"                 //
 #define GC_RR_MIN                       "<global-general>dataprocess/filterhrv/rr_min"                 //
 #define GC_RR_FILT                      "<global-general>dataprocess/filterhrv/rr_filt"                 //
@@ -292,6 +294,7 @@
 #define GC_AUTOBACKUP_FOLDER            "<athlete-preferences>autobackup/folder"
 #define GC_AUTOBACKUP_PERIOD            "<athlete-preferences>autobackup/period"                  // how often is the Athlete Folder backuped up / 0 == never
 #define GC_AUTOBACKUP_COUNTER           "<athlete-preferences>autobackup/counter"                 // counts to the next backup
+#define GC_AUTOBACKUP_INCREMENTAL       "<athlete-preferences>autobackup/incremental"             // only backup what changed since the last one
 
 #define GC_CLOUDDB_TC_ACCEPTANCE       "<athlete-preferences>clouddb/acceptance"                  // bool
 #define GC_CLOUDDB_TC_ACCEPTANCE_DATE  "<athlete-preferences>clouddb/acceptancedate"              // date/time string of acceptance
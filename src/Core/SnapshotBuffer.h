@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _GC_SnapshotBuffer_h
+#define _GC_SnapshotBuffer_h 1
+
+#include <atomic>
+
+//
+// Hands the latest value from one producer thread to one consumer thread,
+// e.g. realtime telemetry to the GUI. Unlike SpscQueue only the most recent
+// value matters; the producer never waits and overwrites anything the
+// consumer hasn't taken yet.
+//
+// Three copies are kept, one each for the producer and the consumer to work
+// on and one in the middle they swap with, so neither ever sees a value the
+// other is part way through writing.
+//
+template <typename T>
+class SnapshotBuffer
+{
+    public:
+
+        SnapshotBuffer() : back(0), front(1), middle(2) {}
+
+        // producer side
+        void publish(const T &value) {
+            slots[back].value = value;
+            back = middle.exchange(back | Fresh, std::memory_order_acq_rel) & Index;
+        }
+
+        // consumer side, false (and value untouched) if nothing has been
+        // published since the last call
+        bool latest(T &value) {
+            if ((middle.load(std::memory_order_relaxed) & Fresh) == 0) return false;
+            front = middle.exchange(front, std::memory_order_acq_rel) & Index;
+            value = slots[front].value;
+            return true;
+        }
+
+    private:
+
+        SnapshotBuffer(const SnapshotBuffer &);
+        SnapshotBuffer &operator=(const SnapshotBuffer &);
+
+        enum { Index = 0x3, Fresh = 0x4 };
+
+        struct Slot { alignas(64) T value; };
+        Slot slots[3];
+
+        int back;                   // producer only
+        int front;                  // consumer only
+        alignas(64) std::atomic<int> middle;
+};
+
+#endif
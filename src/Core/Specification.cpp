@@ -63,9 +63,9 @@ PlanFilter::pass
 }
 
 
-Specification::Specification(DateRange dr, FilterSet fs, PlanFilter pf) : dr(dr), fs(fs), pf(pf), it(NULL), recintsecs(0), ri(NULL) {}
-Specification::Specification(IntervalItem *it, double recintsecs) : it(it), recintsecs(recintsecs), ri(NULL) {}
-Specification::Specification() : it(NULL), recintsecs(0), ri(NULL) {}
+Specification::Specification(DateRange dr, FilterSet fs, PlanFilter pf) : dr(dr), fs(fs), pf(pf), it(NULL), px(NULL), recintsecs(0), ri(NULL) {}
+Specification::Specification(IntervalItem *it, double recintsecs) : it(it), px(NULL), recintsecs(recintsecs), ri(NULL) {}
+Specification::Specification() : it(NULL), px(NULL), recintsecs(0), ri(NULL) {}
 
 // does the date pass the specification ?
 bool
@@ -114,6 +114,12 @@ Specification::addMatches(QStringList other)
     fs.addFilter(true, other);
 }
 
+void
+Specification::addMatches(const FilterMatches &other)
+{
+    fs.addFilter(true, other);
+}
+
 void
 Specification::setIntervalItem(IntervalItem *it, double recintsecs)
 {
@@ -23,6 +23,7 @@
 #include <QStringList>
 #include <QSet>
 #include "TimeUtils.h"
+#include "FilterCache.h"
 
 //
 // A 'specification' can be passed around to use as a filter.
@@ -35,6 +36,7 @@
 class RideItem;
 class RideFile;
 class IntervalItem;
+class RidePrefix;
 struct RideFilePoint;
 
 class FilterSet
@@ -42,6 +44,7 @@ class FilterSet
 
     // used to collect filters and apply if needed
     QVector<QSet<QString>> filters_;
+    QVector<FilterMatches> matches_;    // from the FilterCache
 
     public:
 
@@ -57,21 +60,28 @@ class FilterSet
         void addFilter(bool on, QStringList list) {
             if (on) filters_ << QSet<QString>(list.begin(), list.end());
         }
+        void addFilter(bool on, const FilterMatches &matches) {
+            if (on) matches_ << matches;
+        }
 
         // clear the filter set
         void clear() {
             filters_.clear();
+            matches_.clear();
         }
 
         // does the name in question pass the filter set ?
-        bool pass(QString name) const {
-            foreach(QSet<QString> set, filters_)
+        bool pass(const QString &name) const {
+            for (const FilterMatches &matches : matches_)
+                if (!matches.contains(name))
+                    return false;
+            for (const QSet<QString> &set : filters_)
                 if (!set.contains(name))
                     return false;
             return true;
         }
 
-        int count() { return filters_.count(); }
+        int count() { return filters_.count() + matches_.count(); }
 };
 
 enum class PlanFilterType {
@@ -119,6 +129,11 @@ class Specification
         // non-null if exists
         IntervalItem *interval() { return it; }
 
+        // running totals for the ride when working through its intervals,
+        // metrics that can use them needn't iterate, NULL if not
+        const RidePrefix *prefix() const { return px; }
+        void setPrefix(const RidePrefix *prefix) { px = prefix; }
+
         // set criteria
         void setDateRange(DateRange dr);
         void setFilterSet(FilterSet fs);
@@ -127,6 +142,7 @@ class Specification
         void setRideItem(RideItem *ri);
 
         void addMatches(QStringList matches);
+        void addMatches(const FilterMatches &matches);
 
         DateRange dateRange() { return dr; }
         FilterSet filterSet() { return fs; }
@@ -147,6 +163,7 @@ class Specification
         FilterSet fs;
         PlanFilter pf;
         IntervalItem *it;
+        const RidePrefix *px;
         double recintsecs;
         RideItem *ri;
 };
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _GC_SpscQueue_h
+#define _GC_SpscQueue_h 1
+
+#include <atomic>
+#include <vector>
+#include <cstddef>
+
+//
+// Bounded lock-free queue for exactly one producer thread and one consumer
+// thread, e.g. the realtime loop handing samples to a writer thread. Neither
+// side ever blocks; push() fails when the queue is full so the producer can
+// decide what to drop.
+//
+// Capacity is rounded up to a power of two.
+//
+template <typename T>
+class SpscQueue
+{
+    public:
+
+        explicit SpscQueue(size_t capacity = 1024) : head(0), tail(0) {
+            size_t size = 2;
+            while (size < capacity) size <<= 1;
+            buffer.resize(size);
+            mask = size - 1;
+        }
+
+        // producer side
+        bool push(const T &value) {
+            const size_t t = tail.load(std::memory_order_relaxed);
+            if (t - head.load(std::memory_order_acquire) > mask) return false; // full
+            buffer[t & mask] = value;
+            tail.store(t + 1, std::memory_order_release);
+            return true;
+        }
+
+        // consumer side
+        bool pop(T &value) {
+            const size_t h = head.load(std::memory_order_relaxed);
+            if (h == tail.load(std::memory_order_acquire)) return false; // empty
+            value = buffer[h & mask];
+            head.store(h + 1, std::memory_order_release);
+            return true;
+        }
+
+        // approximate when called whilst the other side is active
+        size_t count() const { return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire); }
+        bool isEmpty() const { return count() == 0; }
+        size_t capacity() const { return mask + 1; }
+
+    private:
+
+        SpscQueue(const SpscQueue &);
+        SpscQueue &operator=(const SpscQueue &);
+
+        std::vector<T> buffer;
+        size_t mask;
+
+        // keep the two indexes on separate cache lines
+        alignas(64) std::atomic<size_t> head;
+        alignas(64) std::atomic<size_t> tail;
+};
+
+#endif
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "StreamingFilters.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+void
+SortedWindow::insert(double value)
+{
+    values.insert(std::upper_bound(values.begin(), values.end(), value), value);
+}
+
+bool
+SortedWindow::remove(double value)
+{
+    std::vector<double>::iterator it = std::lower_bound(values.begin(), values.end(), value);
+    if (it == values.end() || *it != value) return false;
+    values.erase(it);
+    return true;
+}
+
+double
+SortedWindow::median() const
+{
+    const int n = count();
+    if (n == 0) return 0;
+    if (n % 2) return values[n/2];
+    return (values[n/2 - 1] + values[n/2]) / 2.0;
+}
+
+double
+SortedWindow::mad() const
+{
+    const int n = count();
+    if (n == 0) return 0;
+
+    // the deviations below and above the median are each already
+    // in order, walking away from the median, so the median of them
+    // is the k'th smallest of two sorted lists
+    const double m = median();
+    const int split = int(std::lower_bound(values.begin(), values.end(), m) - values.begin());
+    const int nl = split, nr = n - split;
+    const double *v = values.data();
+
+    auto left = [&](int i) { return m - v[split - 1 - i]; };
+    auto right = [&](int j) { return v[split + j] - m; };
+
+    auto kth = [&](int k) {
+        int lo = std::max(0, k + 1 - nr), hi = std::min(k + 1, nl);
+        while (lo <= hi) {
+            int i = (lo + hi) / 2;      // taken from the left
+            int j = k + 1 - i;          // taken from the right
+            if (i < nl && j > 0 && right(j-1) > left(i)) lo = i + 1;
+            else if (i > 0 && j < nr && left(i-1) > right(j)) hi = i - 1;
+            else {
+                double a = i > 0 ? left(i-1) : -std::numeric_limits<double>::infinity();
+                double b = j > 0 ? right(j-1) : -std::numeric_limits<double>::infinity();
+                return std::max(a, b);
+            }
+        }
+        return 0.0; // not reached
+    };
+
+    if (n % 2) return kth(n/2);
+    return (kth(n/2 - 1) + kth(n/2)) / 2.0;
+}
+
+// slide a centred window along the series calling back for each sample
+template<typename F>
+static void slide(const QVector<double> &series, int window, F f)
+{
+    const int n = series.count();
+    const int half = std::max(window, 1) / 2;
+
+    SortedWindow w;
+    w.reserve(2 * half + 1);
+
+    int from = 0, to = 0; // [from, to) currently in the window
+    for (int i=0; i<n; i++) {
+        int start = std::max(0, i - half), stop = std::min(n, i + half + 1);
+        while (to < stop) w.insert(series[to++]);
+        while (from < start) w.remove(series[from++]);
+        f(i, w);
+    }
+}
+
+QVector<double>
+StreamingFilters::median(const QVector<double> &series, int window)
+{
+    QVector<double> returning(series.count());
+    slide(series, window, [&](int i, const SortedWindow &w) { returning[i] = w.median(); });
+    return returning;
+}
+
+QVector<double>
+StreamingFilters::mad(const QVector<double> &series, int window)
+{
+    QVector<double> returning(series.count());
+    slide(series, window, [&](int i, const SortedWindow &w) { returning[i] = w.mad(); });
+    return returning;
+}
+
+QVector<int>
+StreamingFilters::hampel(QVector<double> &series, int window, double nsigma)
+{
+    // decide on the original values, then correct
+    QVector<int> changed;
+    QVector<double> replacement;
+    slide(series, window, [&](int i, const SortedWindow &w) {
+        double m = w.median();
+        if (std::fabs(series[i] - m) > nsigma * 1.4826 * w.mad()) {
+            changed << i;
+            replacement << m;
+        }
+    });
+    for (int k=0; k<changed.count(); k++) series[changed[k]] = replacement[k];
+    return changed;
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _GC_StreamingFilters_h
+#define _GC_StreamingFilters_h 1
+
+#include <QVector>
+#include <vector>
+
+//
+// The values in a sliding window kept in order, so the median is a lookup
+// and the median absolute deviation a binary search, rather than sorting
+// the window again for every sample.
+//
+// Adding and removing a value is a binary search and a memmove, for the
+// window sizes the data processors use (a few to a few hundred samples)
+// that is quicker than a pair of heaps or a skiplist and is exact.
+//
+class SortedWindow
+{
+    public:
+
+        void clear() { values.clear(); }
+        void reserve(int n) { values.reserve(n); }
+        int count() const { return int(values.size()); }
+
+        void insert(double value);
+        bool remove(double value); // false if it isn't in the window
+        void replace(double old, double value) { remove(old); insert(value); }
+
+        // mean of the two middle values when count is even, as gsl does
+        double median() const;
+
+        // median of |x - median|, unscaled
+        double mad() const;
+
+    private:
+
+        std::vector<double> values;
+};
+
+//
+// Filters over a whole series built on SortedWindow, O(n log w) with the
+// window centred on each sample and shrinking at the ends of the series.
+//
+class StreamingFilters
+{
+    public:
+
+        static QVector<double> median(const QVector<double> &series, int window);
+        static QVector<double> mad(const QVector<double> &series, int window);
+
+        // Hampel filter, samples more than nsigma robust standard deviations
+        // (1.4826 * MAD) from the window median are replaced by the median.
+        // Returns the indexes changed, series is updated in place.
+        static QVector<int> hampel(QVector<double> &series, int window, double nsigma);
+};
+
+#endif
@@ -28,6 +28,9 @@
 #include "PowerProfile.h"
 #include "GcCrashDialog.h" // for versionHTML
 #include "OverviewItems.h"
+#include "RealtimeEngine.h"
+#include "NullController.h"
+#include "BT40Decoder.h"
 
 #include <QApplication>
 #include <QtGui>
@@ -261,6 +264,8 @@ main(int argc, char *argv[])
     bool server = false;
     nogui = false;
     bool help = false;
+    int trainTiming = 0;
+    QString bleReplay;
 
     // honour command line switches
     QString arg;
@@ -293,6 +298,8 @@ main(int argc, char *argv[])
             fprintf(stderr, "--debug-file file   to direct diagnostic messages to file\n");
             fprintf(stderr, "--debug-rules \"rules\" to specify which diagnostic messages to output, using the same syntax as QT_LOGGING_RULES\n");
             fprintf(stderr, "--debug-format \"format\" to specify the format of diagnostic messages, using the same syntax as QT_MESSAGE_PATTERN\n");
+            fprintf(stderr, "--train-timing secs to poll a robot trainer for secs, print the timing and exit\n");
+            fprintf(stderr, "--ble-replay file   to parse a hex dump of bluetooth notifications, print the rates and exit\n");
 
 #ifdef GC_HAS_CLOUD_DB
             fprintf(stderr, "--clouddbcurator    to add CloudDB curator specific functions to the menus\n");
@@ -351,6 +358,12 @@ main(int argc, char *argv[])
         } else if (arg == "--debug-rules" && i < sargs.length()) {
             debugRules = QString(sargs[i]);
             i++;
+        } else if (arg == "--train-timing" && i < sargs.length()) {
+            trainTiming = qMax(1, sargs[i].toInt());
+            i++;
+        } else if (arg == "--ble-replay" && i < sargs.length()) {
+            bleReplay = QString(sargs[i]);
+            i++;
         } else if (arg == "--clouddbcurator") {
 #ifdef GC_HAS_CLOUD_DB
             CloudDBCommon::addCuratorFeatures = true;
@@ -385,6 +398,21 @@ main(int argc, char *argv[])
         exit(0);
     }
 
+    // how steadily does the realtime engine poll? no athlete or gui needed
+    if (trainTiming) {
+        NullController robot(NULL, NULL);
+        QString timing = RealtimeEngine::capture(&robot, trainTiming);
+        fprintf(stderr, "%s\n", timing.toLocal8Bit().constData());
+        exit(0);
+    }
+
+    // the bluetooth notification parsers, no hardware needed
+    if (bleReplay != "") {
+        QString rates = BT40Pipeline::replay(bleReplay, 100);
+        fprintf(stderr, "%s\n", rates.toLocal8Bit().constData());
+        exit(0);
+    }
+
     //
     // INITIALISE ONE TIME OBJECTS
     //
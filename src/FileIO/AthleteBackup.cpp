@@ -25,9 +25,7 @@
 #include "AthleteBackup.h"
 #include "Settings.h"
 #include "GcUpgrade.h"
-
-#include "../qzip/zipwriter.h"
-#include "../qzip/zipreader.h"
+#include "BackupEngine.h"
 
 
 
@@ -107,6 +105,37 @@ AthleteBackup::backupImmediate()
 
 }
 
+void
+AthleteBackup::restoreImmediate()
+{
+    backupFolder = appsettings->cvalue(athlete, GC_AUTOBACKUP_FOLDER, "").toString();
+    QStringList zips = QFileDialog::getOpenFileNames(NULL, tr("Select Backup Files"), backupFolder,
+                                                     tr("Backup Files (*.zip)"));
+    if (zips.isEmpty()) return;
+
+    QString dir = QFileDialog::getExistingDirectory(NULL, tr("Select Directory to Restore to"),
+                            "", QFileDialog::ShowDirsOnly | QFileDialog::DontResolveSymlinks);
+    if (dir == "") {
+        QMessageBox::information(NULL, tr("Athlete Restore"), tr("No directory selected - restore aborted"));
+        return;
+    }
+
+    BackupEngine engine;
+    QProgressDialog progress(tr("Restoring athlete %1 ...").arg(athlete), tr("Abort Restore"), 0, 0, NULL);
+    progress.setWindowModality(Qt::WindowModal);
+    connect(&engine, &BackupEngine::progressed, &progress, [&progress](int done, int total) {
+        progress.setMaximum(total);
+        progress.setValue(done);
+    });
+    connect(&progress, &QProgressDialog::canceled, &engine, &BackupEngine::cancel);
+
+    bool ok = engine.restore(zips, QDir(dir));
+    progress.close();
+
+    if (ok) QMessageBox::information(NULL, tr("Athlete Restore"), tr("Backup successfully restored to \n%1").arg(dir));
+    else if (engine.errorString() != "") QMessageBox::warning(NULL, tr("Athlete Restore"), engine.errorString());
+}
+
 // -- private methods
 
 bool
@@ -144,8 +173,16 @@ AthleteBackup::backup(QString progressText)
         return false;
     }
 
+    // an incremental backup only holds what's changed since the last one,
+    // every so often start again with a full one so restoring doesn't need
+    // the whole history
+    QString manifestFile = backupFolder + "/GC_" + athlete + ".manifest";
+    BackupManifest previous;
+    bool incremental = appsettings->cvalue(athlete, GC_AUTOBACKUP_INCREMENTAL, false).toBool() &&
+                       previous.load(manifestFile) && previous.chain < 9;
+
     QChar zero = QLatin1Char('0');
-    QString targetFileName = QString( "GC_%1_%2_%3_%4_%5_%6_%7_%8.zip" )
+    QString targetFileName = QString( "GC_%1_%2_%3_%4_%5_%6_%7_%8%9.zip" )
                        .arg ( VERSION_LATEST )
                        .arg ( athlete )
                        .arg ( QDate::currentDate().year(), 4, 10, zero )
@@ -153,52 +190,30 @@ AthleteBackup::backup(QString progressText)
                        .arg ( QDate::currentDate().day(), 2, 10, zero )
                        .arg ( QTime::currentTime().hour(), 2, 10, zero )
                        .arg ( QTime::currentTime().minute(), 2, 10, zero )
-                       .arg ( QTime::currentTime().second(), 2, 10, zero );
-
+                       .arg ( QTime::currentTime().second(), 2, 10, zero )
+                       .arg ( incremental ? "_incremental" : "" );
 
-    // add files using zip writer
-    QFile zipFile(backupFolder+"/"+targetFileName);
-    if (!zipFile.open(QIODevice::WriteOnly)) {
-        QMessageBox::warning(NULL, tr("Athlete Backup"), tr("Backup file %1 cannot be created.").arg(zipFile.fileName()));
-        return false;
-    }
-    zipFile.close();
-    ZipWriter writer(zipFile.fileName());
+    BackupEngine engine;
+    engine.setFolders(sourceFolderList);
+    if (incremental) engine.setIncremental(previous);
 
     QProgressDialog progress(tr("Adding files to backup %1 for athlete %2 ...").arg(targetFileName).arg(athlete), progressText, 0, fileCount, NULL);
     progress.setWindowModality(Qt::WindowModal);
-
-    // now do the Zipping
-    bool userCanceled = false;
-    int fileCounter = 0;
-    foreach (QDir folder, sourceFolderList) {
-        // get all files
-        writer.addDirectory(folder.dirName());
-        foreach (QFileInfo fileName, folder.entryInfoList(QDir::Files | QDir::NoDotAndDotDot | QDir::NoSymLinks)) {
-            QFile file(fileName.canonicalFilePath());
-            if (file.open(QIODevice::ReadOnly)) {
-                if (progress.wasCanceled()) {
-                    userCanceled = true;
-                    break;
-                }
-                writer.addFile(folder.dirName()+"/"+fileName.fileName(), file.readAll());
-                progress.setValue(fileCounter);
-                fileCounter++;
-                file.close();
-            }
-        }
-        if (userCanceled) break;
-    }
-
-    // final processing
-    writer.close();
-
-    // delete the .ZIP file if the user canceled the backup
-    if (userCanceled) {
-        zipFile.remove();
+    connect(&engine, &BackupEngine::progressed, &progress, [&progress](int done, int total) {
+        progress.setMaximum(total);
+        progress.setValue(done);
+    });
+    connect(&progress, &QProgressDialog::canceled, &engine, &BackupEngine::cancel);
+
+    // now do the Zipping, the engine removes the .ZIP file if the user canceled
+    if (!engine.backup(backupFolder+"/"+targetFileName)) {
+        if (engine.errorString() != "") QMessageBox::warning(NULL, tr("Athlete Backup"), engine.errorString());
         return false;
     }
 
+    // for the next one to work from
+    engine.manifest().save(manifestFile);
+
     // we are done, full progress
     progress.setValue(fileCount);
     return true;
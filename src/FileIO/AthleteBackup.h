@@ -33,6 +33,7 @@ class AthleteBackup : public QObject
         ~AthleteBackup();
         void backupOnClose();
         void backupImmediate();
+        void restoreImmediate();
 
     private:
         AthleteDirectoryStructure *athleteDirs;
@@ -0,0 +1,413 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "BackupEngine.h"
+
+#include "../qzip/zipwriter.h"
+#include "../qzip/zipreader.h"
+
+#include <QFile>
+#include <QSaveFile>
+#include <QFileInfo>
+#include <QDataStream>
+#include <QElapsedTimer>
+#include <QCryptographicHash>
+#include <QSet>
+#include <QtConcurrent>
+#include <algorithm>
+
+#define MANIFEST_MAGIC   0x47434d46  // "GCMF"
+#define MANIFEST_VERSION 1
+#define MANIFEST_ENTRY   "backup.manifest"
+
+QByteArray
+BackupManifest::toByteArray() const
+{
+    QByteArray bytes;
+    QDataStream out(&bytes, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_5_0);
+
+    out << quint32(MANIFEST_MAGIC) << quint32(MANIFEST_VERSION) << created << qint32(chain) << quint32(files.count());
+    QMapIterator<QString, Entry> i(files);
+    while (i.hasNext()) {
+        i.next();
+        out << i.key() << i.value().size << i.value().mtime << i.value().hash;
+    }
+    return bytes;
+}
+
+bool
+BackupManifest::fromByteArray(const QByteArray &bytes)
+{
+    files.clear();
+
+    QDataStream in(bytes);
+    in.setVersion(QDataStream::Qt_5_0);
+
+    quint32 magic, version, n;
+    qint32 chain;
+    in >> magic >> version;
+    if (in.status() != QDataStream::Ok || magic != MANIFEST_MAGIC || version != MANIFEST_VERSION) return false;
+    in >> created >> chain >> n;
+    this->chain = chain;
+
+    for (quint32 i=0; i<n; i++) {
+        QString key;
+        Entry e;
+        in >> key >> e.size >> e.mtime >> e.hash;
+        if (in.status() != QDataStream::Ok) {
+            // truncated, trust none of it
+            files.clear();
+            return false;
+        }
+        files.insert(key, e);
+    }
+    return in.status() == QDataStream::Ok;
+}
+
+bool
+BackupManifest::load(QString filename)
+{
+    QFile file(filename);
+    if (!file.open(QFile::ReadOnly)) {
+        files.clear();
+        return false;
+    }
+    return fromByteArray(file.readAll());
+}
+
+bool
+BackupManifest::save(QString filename) const
+{
+    // written aside and renamed so a crash never leaves half a manifest
+    QSaveFile file(filename);
+    if (!file.open(QFile::WriteOnly)) return false;
+    file.write(toByteArray());
+    return file.commit();
+}
+
+bool
+BackupManifest::isSafePath(const QString &path)
+{
+    if (path.isEmpty() || QDir::isAbsolutePath(path)) return false;
+
+    // absolute or drive relative on any platform, not just this one
+    QString slashed = QString(path).replace('\\', '/');
+    if (slashed.startsWith('/') || slashed.contains(':')) return false;
+
+    foreach (const QString &part, slashed.split('/'))
+        if (part == "..") return false;
+    return true;
+}
+
+QString
+BackupEngine::Stats::toString() const
+{
+    return QString("files=%1 added=%2 skipped=%3 in=%4KB out=%5KB peak=%6KB %7ms")
+           .arg(files).arg(added).arg(skipped)
+           .arg(bytesIn / 1024).arg(bytesOut / 1024).arg(peak / 1024)
+           .arg(msecs);
+}
+
+BackupEngine::BackupEngine(QObject *parent) : QObject(parent), window(64 * 1024 * 1024), cancelled(false)
+{
+}
+
+static QFileInfoList
+backupFiles(const QDir &folder)
+{
+    return folder.entryInfoList(QDir::Files | QDir::NoDotAndDotDot | QDir::NoSymLinks);
+}
+
+int
+BackupEngine::count(qint64 *bytes) const
+{
+    int files = 0;
+    qint64 size = 0;
+    foreach (const QDir &folder, folders) {
+        foreach (const QFileInfo &info, backupFiles(folder)) {
+            files++;
+            size += info.size();
+        }
+    }
+    if (bytes) *bytes = size;
+    return files;
+}
+
+namespace {
+
+    // a file on its way to the zip
+    struct Job {
+        QString name, path;
+        qint64 size, mtime;
+        bool readable, unchanged;
+        QByteArray hash;
+        ZipWriter::Compressed entry;
+    };
+}
+
+bool
+BackupEngine::backup(QString zipFile)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    cancelled = false;
+    error = "";
+    stats_ = Stats();
+    current = BackupManifest();
+    current.created = QDateTime::currentDateTime();
+    current.chain = previous.isEmpty() ? 0 : previous.chain + 1;
+
+    // what's there, anything with the same size and mtime as last time
+    // is taken as it was without even reading it
+    QVector<Job> jobs;
+    foreach (const QDir &folder, folders) {
+        foreach (const QFileInfo &info, backupFiles(folder)) {
+            Job job;
+            job.name = folder.dirName() + "/" + info.fileName();
+            job.path = info.canonicalFilePath();
+            job.size = info.size();
+            job.mtime = info.lastModified().toMSecsSinceEpoch();
+            job.readable = job.unchanged = false;
+            stats_.files++;
+
+            QMap<QString, BackupManifest::Entry>::const_iterator was = previous.files.constFind(job.name);
+            if (was != previous.files.constEnd() && was->size == job.size && was->mtime == job.mtime) {
+                current.files.insert(job.name, *was);
+                stats_.skipped++;
+                continue;
+            }
+            jobs << job;
+        }
+    }
+    const int total = stats_.files;
+    int done = stats_.skipped;
+    emit progressed(done, total);
+
+    ZipWriter writer(zipFile);
+    writer.setCompressionPolicy(ZipWriter::AutoCompress);
+    if (writer.status() != ZipWriter::NoError || !writer.isWritable()) {
+        error = tr("Backup file %1 cannot be created.").arg(zipFile);
+        return false;
+    }
+    foreach (const QDir &folder, folders) writer.addDirectory(folder.dirName());
+
+    // a window at a time, read, hash and compress in parallel, then add to
+    // the zip in order
+    int next = 0;
+    while (next < jobs.count() && !cancelled) {
+
+        QVector<int> batch;
+        qint64 held = 0;
+        while (next < jobs.count() && (batch.isEmpty() || held + jobs[next].size <= window)) {
+            held += jobs[next].size;
+            batch << next++;
+        }
+
+        QtConcurrent::blockingMap(batch, [&jobs, this](int i) {
+            Job &job = jobs[i];
+            if (cancelled) return;
+
+            QFile file(job.path);
+            if (!file.open(QIODevice::ReadOnly)) return;
+            QByteArray contents = file.readAll();
+            job.readable = true;
+            job.size = contents.size();
+            job.hash = QCryptographicHash::hash(contents, QCryptographicHash::Sha1);
+
+            // touched but not changed
+            QMap<QString, BackupManifest::Entry>::const_iterator was = previous.files.constFind(job.name);
+            if (was != previous.files.constEnd() && was->hash == job.hash) {
+                job.unchanged = true;
+                return;
+            }
+            job.entry = ZipWriter::compress(contents, ZipWriter::AutoCompress);
+        });
+
+        foreach (int i, batch) {
+            if (cancelled) break;
+
+            Job &job = jobs[i];
+            held += job.entry.data.size();
+
+            // not readable, leave it out as we always have
+            if (!job.readable) {
+                stats_.skipped++;
+
+            } else {
+                BackupManifest::Entry add;
+                add.size = job.size;
+                add.mtime = job.mtime;
+                add.hash = job.hash;
+                current.files.insert(job.name, add);
+
+                if (job.unchanged) {
+                    stats_.skipped++;
+                } else {
+                    writer.addCompressedFile(job.name, job.entry);
+                    stats_.added++;
+                    stats_.bytesIn += job.size;
+                    stats_.bytesOut += job.entry.data.size();
+                }
+            }
+            job.entry = ZipWriter::Compressed();
+            emit progressed(++done, total);
+        }
+        stats_.peak = qMax(stats_.peak, held);
+    }
+
+    writer.addFile(MANIFEST_ENTRY, current.toByteArray());
+    writer.close();
+    stats_.msecs = timer.elapsed();
+
+    if (!cancelled && writer.status() != ZipWriter::NoError)
+        error = tr("Backup file %1 could not be written.").arg(zipFile);
+
+    // don't leave half a backup lying around
+    if (cancelled || error != "") {
+        QFile::remove(zipFile);
+        return false;
+    }
+    return true;
+}
+
+bool
+BackupEngine::restore(QStringList zipFiles, QDir target)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    cancelled = false;
+    error = "";
+    stats_ = Stats();
+
+    struct Archive {
+        QString path;
+        ZipReader *reader;
+        BackupManifest manifest;
+        QSet<QString> entries;
+    };
+    QList<Archive> archives, plain;
+    foreach (const QString &path, zipFiles) {
+        Archive add;
+        add.path = path;
+        add.reader = new ZipReader(path);
+        if (!add.reader->isReadable()) {
+            error = tr("Backup file %1 cannot be read.").arg(path);
+            delete add.reader;
+            continue;
+        }
+        if (add.manifest.fromByteArray(add.reader->fileData(MANIFEST_ENTRY))) {
+            foreach (const ZipReader::FileInfo &info, add.reader->fileInfoList())
+                if (info.isFile) add.entries.insert(info.filePath);
+            archives << add;
+        } else {
+            plain << add;
+        }
+    }
+    std::sort(archives.begin(), archives.end(), [](const Archive &a, const Archive &b) {
+        return a.manifest.created < b.manifest.created;
+    });
+    std::sort(plain.begin(), plain.end(), [](const Archive &a, const Archive &b) {
+        return QFileInfo(a.path).lastModified() < QFileInfo(b.path).lastModified();
+    });
+
+    // older backups without a manifest are complete, just unpack them a
+    // file at a time, they can't be trusted any more than a manifest can
+    // so nothing outside the target and no symlinks
+    int missing = 0, unsafe = 0;
+    foreach (const Archive &archive, plain) {
+        bool failed = false;
+        foreach (const ZipReader::FileInfo &info, archive.reader->fileInfoList()) {
+            if (cancelled) break;
+            if (info.isSymLink || !BackupManifest::isSafePath(info.filePath)) {
+                unsafe++;
+                continue;
+            }
+            if (info.isDir) {
+                if (!target.mkpath(info.filePath)) failed = true;
+                continue;
+            }
+
+            // isFile isn't always set, so anything else is a file
+            QByteArray contents = archive.reader->fileData(info.filePath);
+            QFileInfo to(target.absoluteFilePath(info.filePath));
+            target.mkpath(to.absolutePath());
+            QFile file(to.absoluteFilePath());
+            if (file.open(QIODevice::WriteOnly) && file.write(contents) == contents.size()) {
+                if (info.permissions > 0) file.setPermissions(info.permissions);
+                stats_.added++;
+                stats_.bytesOut += contents.size();
+            } else failed = true;
+            stats_.peak = qMax(stats_.peak, qint64(contents.size()));
+            stats_.files++;
+        }
+        if (failed) error = tr("Backup file %1 could not be restored.").arg(archive.path);
+    }
+
+    // everything as at the latest backup, from the latest archive that
+    // has each file as it was then
+    if (archives.count()) {
+        const BackupManifest &latest = archives.last().manifest;
+        const int total = latest.files.count();
+        int done = 0;
+        QMapIterator<QString, BackupManifest::Entry> i(latest.files);
+        while (i.hasNext() && !cancelled) {
+            i.next();
+
+            // never write outside the target
+            if (!BackupManifest::isSafePath(i.key())) {
+                unsafe++;
+                stats_.files++;
+                emit progressed(++done, total);
+                continue;
+            }
+
+            bool found = false;
+            for (int a = archives.count() - 1; a >= 0 && !found; a--) {
+                if (!archives[a].entries.contains(i.key())) continue;
+
+                QByteArray contents = archives[a].reader->fileData(i.key());
+                if (QCryptographicHash::hash(contents, QCryptographicHash::Sha1) != i.value().hash) continue;
+
+                QFileInfo info(target.absoluteFilePath(i.key()));
+                target.mkpath(info.absolutePath());
+                QFile file(info.absoluteFilePath());
+                if (file.open(QIODevice::WriteOnly) && file.write(contents) == contents.size()) {
+                    stats_.added++;
+                    stats_.bytesOut += contents.size();
+                    found = true;
+                }
+                stats_.peak = qMax(stats_.peak, qint64(contents.size()));
+            }
+            if (!found) missing++;
+            stats_.files++;
+            emit progressed(++done, total);
+        }
+    }
+    if (missing) error = tr("%1 files could not be restored, an earlier backup may be missing.").arg(missing);
+    if (unsafe) error = tr("%1 files in the backup are links or outside the athlete folder and were not restored.").arg(unsafe);
+
+    foreach (const Archive &archive, archives) delete archive.reader;
+    foreach (const Archive &archive, plain) delete archive.reader;
+
+    stats_.skipped = missing + unsafe;
+    stats_.msecs = timer.elapsed();
+    return !cancelled && error == "";
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _GC_BackupEngine_h
+#define _GC_BackupEngine_h 1
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QDateTime>
+#include <QList>
+#include <QMap>
+#include <QDir>
+#include <atomic>
+
+// what each file looked like when it was backed up, a copy goes into each
+// archive as backup.manifest and another is kept in the backup folder so the
+// next backup can leave out anything that hasn't changed
+class BackupManifest
+{
+    public:
+
+        struct Entry {
+            Entry() : size(-1), mtime(0) {}
+            qint64 size, mtime;         // mtime in msecs
+            QByteArray hash;            // sha1 of the contents
+        };
+
+        BackupManifest() : chain(0) {}
+
+        QDateTime created;
+        int chain;                      // incrementals since the last full backup
+        QMap<QString, Entry> files;     // "folder/file" as in the archive
+
+        bool isEmpty() const { return files.isEmpty(); }
+
+        QByteArray toByteArray() const;
+        bool fromByteArray(const QByteArray &bytes);
+        bool load(QString filename);
+        bool save(QString filename) const;
+
+        // a relative path that stays inside the folder it's restored to,
+        // the manifest comes from the archive so can't be trusted
+        static bool isSafePath(const QString &path);
+};
+
+//
+// Writes the athlete folders to a zip, reading, hashing and compressing the
+// files on all cores a window at a time and writing them in order, so
+// no more than the window is ever held in memory whatever the size of the
+// athlete.
+//
+// Given the manifest of the last backup it only stores files that have
+// changed, size and mtime first, then the contents for those that were
+// touched but not changed. restore() puts them back together again.
+//
+class BackupEngine : public QObject
+{
+    Q_OBJECT
+
+    public:
+
+        struct Stats {
+            Stats() : files(0), added(0), skipped(0), bytesIn(0), bytesOut(0), msecs(0), peak(0) {}
+            int files, added, skipped;
+            qint64 bytesIn, bytesOut;   // of those added, before and after compression
+            qint64 msecs;
+            qint64 peak;                // most held in memory at once
+            QString toString() const;
+        };
+
+        BackupEngine(QObject *parent = NULL);
+
+        void setFolders(const QList<QDir> &folders) { this->folders = folders; }
+        void setWindow(qint64 bytes) { window = qMax(qint64(1), bytes); }
+
+        // only back up what's changed since this backup, when it's empty
+        // (the default) everything is
+        void setIncremental(const BackupManifest &previous) { this->previous = previous; }
+
+        // files to be considered and their total size
+        int count(qint64 *bytes = NULL) const;
+
+        // false on error or when cancelled, the zip is removed
+        bool backup(QString zipFile);
+
+        // as at the most recent of the archives, which can be given in any
+        // order; those without a manifest are just unpacked oldest first
+        bool restore(QStringList zipFiles, QDir target);
+
+        const BackupManifest &manifest() const { return current; }
+        const Stats &stats() const { return stats_; }
+        QString errorString() const { return error; }
+
+    public slots:
+
+        void cancel() { cancelled = true; }
+
+    signals:
+
+        void progressed(int done, int total);
+
+    private:
+
+        QList<QDir> folders;
+        qint64 window;
+        BackupManifest previous, current;
+        Stats stats_;
+        QString error;
+        std::atomic<bool> cancelled;
+};
+
+#endif
@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "BatchDataProcessor.h"
+#include "Context.h"
+#include "Athlete.h"
+#include "RideCache.h"
+#include "RideItem.h"
+#include "JsonRideFile.h"
+
+#include <QtConcurrent>
+#include <QSaveFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QElapsedTimer>
+#include <QMutexLocker>
+
+BatchDataProcessor::BatchDataProcessor(Context *context) :
+    context(context), next(0), workers(0), cancelled(false), running(false), done(0)
+{
+    for (int i=0; i<4; i++) tally[i] = 0;
+}
+
+BatchDataProcessor::~BatchDataProcessor()
+{
+    cancel();
+    pool.waitForDone();
+}
+
+void
+BatchDataProcessor::addProcessor(DataProcessor *processor, DataProcessorConfig *config)
+{
+    if (running || !canBatch(processor)) return;
+
+    Step add;
+    add.processor = processor;
+    add.config = config;
+    steps << add;
+}
+
+void
+BatchDataProcessor::setRides(const QList<RideItem*> &rides)
+{
+    if (running) return;
+
+    jobs.clear();
+    foreach(RideItem *item, rides) {
+        Job add;
+        add.item = item;
+        add.filename = item->fileName;
+        add.path = item->path + "/" + item->fileName;
+        add.status = Failed;
+        jobs.push_back(add);
+    }
+}
+
+void
+BatchDataProcessor::setSpecification(Specification spec)
+{
+    QList<RideItem*> rides;
+    foreach(RideItem *item, context->athlete->rideCache->rides())
+        if (spec.pass(item)) rides << item;
+    setRides(rides);
+}
+
+void
+BatchDataProcessor::setThreads(int threads)
+{
+    if (running) return;
+    pool.setMaxThreadCount(qMax(1, threads));
+}
+
+void
+BatchDataProcessor::start()
+{
+    if (running) return;
+
+    running = true;
+    cancelled = false;
+    next = 0;
+    done = 0;
+    for (int i=0; i<4; i++) tally[i] = 0;
+    nsecs.clear();
+
+    // the workers can't read the config widgets, they get a copy
+    foreach(const Step &step, steps)
+        if (step.config) step.config->freeze();
+
+    // anything that can't be done on a worker thread is settled here
+    for (size_t i=0; i<jobs.size(); i++) {
+        Job &job = jobs[i];
+        job.status = Failed;
+        job.message = "";
+        if (job.item->isDirty()) {
+            job.status = Skipped;
+            job.message = tr("Has unsaved changes");
+        } else if (QFileInfo(job.filename).suffix().toLower() != "json") {
+            job.status = Skipped;
+            job.message = tr("Not saved as .json");
+        }
+    }
+
+    // each worker takes the next job until there are none left, so we
+    // never have more rides in memory than workers
+    workers = qMin(pool.maxThreadCount(), qMax(1, int(jobs.size())));
+    for (int i=0, n=workers; i<n; i++) QtConcurrent::run(&pool, [this]() { work(); });
+}
+
+void
+BatchDataProcessor::work()
+{
+    for (int index = next++; index < int(jobs.size()); index = next++) {
+        Job &job = jobs[index];
+        if (cancelled) {
+            job.status = Skipped;
+            job.message = tr("Cancelled");
+        } else if (job.status != Skipped) {
+            process(job);
+        }
+        QMetaObject::invokeMethod(this, "jobDone", Qt::QueuedConnection, Q_ARG(int, index));
+    }
+
+    // posted after all of our jobDone so they are seen first
+    QMetaObject::invokeMethod(this, "workerDone", Qt::QueuedConnection);
+}
+
+void
+BatchDataProcessor::process(Job &job)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QFile file(job.path);
+    QStringList errors;
+    RideFile *ride = RideFileFactory::instance().openRideFile(context, file, errors);
+    addTime("open", timer.nsecsElapsed());
+
+    if (!ride) {
+        job.status = Failed;
+        job.message = tr("Read error");
+        return;
+    }
+
+    bool changed = false;
+    foreach(const Step &step, steps) {
+        timer.restart();
+        if (step.processor->postProcess(ride, step.config, "UPDATE")) changed = true;
+        addTime(step.processor->id(), timer.nsecsElapsed());
+    }
+
+    if (!changed) {
+        job.status = Unchanged;
+        job.message = tr("Unchanged");
+        delete ride;
+        return;
+    }
+
+    timer.restart();
+
+    // update the change history, same as a save
+    QString log = ride->getTag("Change History", "");
+    log +=  tr("Changes on ");
+    log +=  QDateTime::currentDateTime().toString() + ":";
+    log += '\n' + ride->command->changeLog();
+    ride->setTag("Change History", log);
+
+    // as JsonFileReader::writeRideFile but renamed into place on commit,
+    // the original is untouched if we fail part way through
+    QSaveFile out(job.path);
+    bool written = false;
+    if (out.open(QIODevice::WriteOnly)) {
+        QTextStream stream(&out);
+        stream.setGenerateByteOrderMark(true);
+        stream << JsonFileReader().toByteArray(context, ride, true, true, true, true);
+        stream.flush();
+        written = out.commit();
+    }
+    addTime("save", timer.nsecsElapsed());
+    delete ride;
+
+    job.status = written ? Processed : Failed;
+    job.message = written ? tr("Processed") : tr("Write failed");
+}
+
+void
+BatchDataProcessor::addTime(const QString &step, qint64 elapsed)
+{
+    QMutexLocker locker(&timingMutex);
+    nsecs[step] += elapsed;
+}
+
+QMap<QString, qint64>
+BatchDataProcessor::timing() const
+{
+    QMutexLocker locker(&timingMutex);
+    QMap<QString, qint64> returning;
+    QMapIterator<QString, qint64> it(nsecs);
+    while (it.hasNext()) {
+        it.next();
+        returning.insert(it.key(), it.value() / 1000000);
+    }
+    return returning;
+}
+
+void
+BatchDataProcessor::jobDone(int index)
+{
+    const Job &job = jobs[index];
+    tally[job.status]++;
+    done++;
+
+    emit rideDone(job.filename, job.status, job.message);
+    emit progress(done, int(jobs.size()));
+}
+
+void
+BatchDataProcessor::workerDone()
+{
+    if (--workers > 0) return;
+
+    foreach(const Step &step, steps)
+        if (step.config) step.config->thaw();
+
+    // the copies in memory are out of date, drop them and let the
+    // ride cache notice the new timestamps and refresh the metrics
+    RideItem *current = NULL;
+    for (size_t i=0; i<jobs.size(); i++) {
+        if (jobs[i].status != Processed) continue;
+        RideItem *item = jobs[i].item;
+        if (item->isOpen()) item->close();
+        if (item == context->ride) current = item;
+    }
+    context->athlete->rideCache->refresh();
+    if (current) context->notifyRideSelected(current);
+
+    running = false;
+    emit finished();
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _BatchDataProcessor_h
+#define _BatchDataProcessor_h
+#include "GoldenCheetah.h"
+
+#include "DataProcessor.h"
+#include "Specification.h"
+
+#include <QObject>
+#include <QThreadPool>
+#include <QMutex>
+#include <QMap>
+#include <QVector>
+#include <atomic>
+#include <vector>
+
+class Context;
+class RideItem;
+
+//
+// Runs a chain of data processors over many activities, a few at a time
+// on a thread pool rather than one after another on the GUI thread.
+//
+// Each worker opens the activity from disk, runs the chain, and when
+// anything changed writes it back atomically (QSaveFile) and moves on, so
+// no more than threads() rides are ever in memory. Once all are done the
+// rides that changed are refreshed by the ride cache as usual.
+//
+// Activities with unsaved changes in memory, or that aren't .json, are
+// skipped rather than risk losing edits or converting formats behind
+// the user's back.
+//
+class BatchDataProcessor : public QObject
+{
+    Q_OBJECT
+
+    public:
+
+        enum Status { Processed, Unchanged, Skipped, Failed };
+
+        BatchDataProcessor(Context *context);
+        ~BatchDataProcessor();
+
+        // run in the order added, a null config uses the saved defaults,
+        // otherwise its settings are copied when started
+        void addProcessor(DataProcessor *processor, DataProcessorConfig *config = NULL);
+
+        // which activities, those passing the specification or a list
+        void setSpecification(Specification spec);
+        void setRides(const QList<RideItem*> &rides);
+
+        // rides in flight at once, defaults to the ideal thread count
+        void setThreads(int threads);
+        int threads() const { return pool.maxThreadCount(); }
+
+        // processors that show dialogs or run scripts can't be run off
+        // the GUI thread, only core processors are allowed
+        static bool canBatch(const DataProcessor *processor) { return processor && processor->isCoreProcessor(); }
+
+        void start();
+        void cancel() { cancelled = true; }
+        bool isRunning() const { return running; }
+
+        // results when finished
+        int count() const { return int(jobs.size()); }
+        int processed() const { return tally[Processed]; }
+        int unchanged() const { return tally[Unchanged]; }
+        int skipped() const { return tally[Skipped]; }
+        int failed() const { return tally[Failed]; }
+
+        // time spent in each step, by processor id, plus "open" and "save"
+        QMap<QString, qint64> timing() const; // msecs, all threads
+
+    signals:
+
+        void progress(int done, int total);
+        void rideDone(QString filename, int status, QString message);
+        void finished();
+
+    private slots:
+
+        void jobDone(int index);
+        void workerDone();
+
+    private:
+
+        struct Step {
+            DataProcessor *processor;
+            DataProcessorConfig *config;
+        };
+
+        struct Job {
+            RideItem *item;
+            QString filename, path;
+            Status status;
+            QString message;
+        };
+
+        void work();            // on a pool thread
+        void process(Job &job); // on a pool thread
+        void addTime(const QString &step, qint64 elapsed);
+
+        Context *context;
+        QVector<Step> steps;
+        std::vector<Job> jobs; // not shared, workers write their own
+
+        QThreadPool pool;
+        std::atomic<int> next, workers;
+        std::atomic<bool> cancelled;
+        bool running;
+        int done;
+        int tally[4];
+
+        mutable QMutex timingMutex;
+        QMap<QString, qint64> nsecs;
+};
+#endif // _BatchDataProcessor_h
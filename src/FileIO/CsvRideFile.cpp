@@ -128,12 +128,8 @@ RideFile *CsvFileReader::openRideFile(QFile &file, QStringList &errors, QList<Ri
     XDataSeries *gcSeries=NULL;
     XDataSeries *rowSeries=NULL;
     XDataSeries *trainSeries=NULL;
-    XDataSeries *rrSeries=NULL;
-    XDataSeries *posSeries=NULL;
     XDataSeries *ibikeSeries=NULL;
     XDataSeries *xdataSeries=NULL;
-    XDataSeries *vo2Series=NULL;
-    XDataSeries *develSeries=NULL;
 
     /* Joule 1.0
     Version,Date/Time,Km,Minutes,RPE,Tags,"Weight, kg","Work, kJ",FTP,"Sample Rate, s",Device Type,Firmware Version,Last Updated,Category 1,Category 2
@@ -1499,8 +1495,24 @@ RideFile *CsvFileReader::openRideFile(QFile &file, QStringList &errors, QList<Ri
         return NULL;
     }
 
+    // vo2, core temperature, r-r and position recorded alongside
+    readCompanionFiles(rideFile, file.fileName());
+
+    // all done
+    return rideFile;
+}
+
+void
+CsvFileReader::readCompanionFiles(RideFile *rideFile, QString filename)
+{
+    int lineno;
+    XDataSeries *vo2Series=NULL;
+    XDataSeries *develSeries=NULL;
+    XDataSeries *rrSeries=NULL;
+    XDataSeries *posSeries=NULL;
+
     // Is there an associated .vo2 file?
-    QFile vo2file(file.fileName().replace(".csv",".vo2"));
+    QFile vo2file(QString(filename).replace(".csv",".vo2"));
     if (vo2file.open(QFile::ReadOnly))
     {
         // create the XDATA series
@@ -1568,7 +1580,7 @@ RideFile *CsvFileReader::openRideFile(QFile &file, QStringList &errors, QList<Ri
 
     // is there an associated tcore tcr file?
     // Store coretemp into developer fields
-    QFile tcorefile(file.fileName().replace(".csv",".tcr"));
+    QFile tcorefile(QString(filename).replace(".csv",".tcr"));
     if (tcorefile.open(QFile::ReadOnly))
     {
         // create the XDATA series        
@@ -1646,7 +1658,7 @@ RideFile *CsvFileReader::openRideFile(QFile &file, QStringList &errors, QList<Ri
     //
     // typically only for GC csv, but lets not constrain that
     // so long as the filename matches we'll import it into XDATA
-    QFile rrfile(file.fileName().replace(".csv",".rr"));
+    QFile rrfile(QString(filename).replace(".csv",".rr"));
     if (rrfile.open(QFile::ReadOnly))
     {
 
@@ -1710,7 +1722,7 @@ RideFile *CsvFileReader::openRideFile(QFile &file, QStringList &errors, QList<Ri
     //
     // typically only for GC csv, but lets not constrain that
     // so long as the filename matches we'll import it into XDATA
-    QFile posFile(file.fileName().replace(".csv",".pos.csv"));
+    QFile posFile(QString(filename).replace(".csv",".pos.csv"));
     if (posFile.open(QFile::ReadOnly))
     {
 
@@ -1769,9 +1781,6 @@ RideFile *CsvFileReader::openRideFile(QFile &file, QStringList &errors, QList<Ri
         // add if we got any ....
         if (posSeries->datapoints.count() > 0) rideFile->addXData("position", posSeries);
     }
-
-    // all done
-    return rideFile;
 }
 
 bool
@@ -1781,6 +1790,9 @@ CsvFileReader::writeRideFile(Context *, const RideFile *ride, QFile &file, CsvTy
 
     if (!file.open(QIODevice::WriteOnly)) return(false);
 
+    // slope and haemoglobin are exported even when derived
+    const_cast<RideFile*>(ride)->derive(RideFile::DeriveSlope | RideFile::DeriveHb);
+
     // always save CSV in metric format
     bool bIsMetric = true;
 
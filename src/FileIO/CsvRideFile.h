@@ -37,6 +37,10 @@ struct CsvFileReader : public RideFileReader {
     // write but able to select format
     bool writeRideFile(Context *context, const RideFile *ride, QFile &file, CsvType format) const;
     bool hasWrite() const { return true; }
+
+    // add the .vo2, .tcr, .rr and .pos.csv files recorded in Train mode
+    // alongside filename (a .csv) as XDATA
+    static void readCompanionFiles(RideFile *rideFile, QString filename);
 };
 
 #endif // _CsvRideFile_h
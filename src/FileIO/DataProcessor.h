@@ -35,6 +35,7 @@
 #include <QTextEdit>
 #include <QLineEdit>
 #include <QMap>
+#include <QVariantMap>
 #include <QVector>
 
 // This file defines four classes:
@@ -62,10 +63,23 @@ class DataProcessorConfig : public QWidget
     Q_OBJECT
 
     public:
-        DataProcessorConfig(QWidget *parent=0) : QWidget(parent) {}
+        DataProcessorConfig(QWidget *parent=0) : QWidget(parent), isfrozen(false) {}
         virtual ~DataProcessorConfig() {}
         virtual void readConfig() = 0;
         virtual void saveConfig() = 0;
+
+        // the settings as shown, keyed as saveConfig() saves them
+        virtual QVariantMap settings() const { return QVariantMap(); }
+
+        // what postProcess reads, widgets can only be read on the GUI
+        // thread so freeze() a copy there to process on any other
+        QVariant value(const QString &key) const { return isfrozen ? frozen.value(key) : settings().value(key); }
+        void freeze() { frozen = settings(); isfrozen = true; }
+        void thaw() { isfrozen = false; }
+
+    private:
+        QVariantMap frozen;
+        bool isfrozen;
 };
 
 // the data processor abstract base class
@@ -203,6 +203,16 @@ public:
         appsettings->setValue(GC_RR_WINDOW, hrvWindow->value());
         appsettings->setValue(GC_RR_SET_REST_HRV, setRestHrv->checkState());
     }
+
+    QVariantMap settings() const {
+        QVariantMap returning;
+        returning.insert(GC_RR_MAX, hrvMax->value());
+        returning.insert(GC_RR_MIN, hrvMin->value());
+        returning.insert(GC_RR_FILT, hrvFilt->value());
+        returning.insert(GC_RR_WINDOW, hrvWindow->value());
+        returning.insert(GC_RR_SET_REST_HRV, setRestHrv->checkState());
+        return returning;
+    }
 };
 
 class FilterHrvOutliers : public DataProcessor {
@@ -267,11 +277,11 @@ FilterHrvOutliers::postProcess(RideFile *ride, DataProcessorConfig *config=0, QS
             setRestHrv = appsettings->value(NULL, GC_RR_SET_REST_HRV, Qt::Unchecked).toBool();
         }
         else { // being called manually
-            rrMax = ((FilterHrvOutliersConfig*)(config))->hrvMax->value();
-            rrMin = ((FilterHrvOutliersConfig*)(config))->hrvMin->value();
-            rrFilt = ((FilterHrvOutliersConfig*)(config))->hrvFilt->value();
-            rrWindow = (int) ((FilterHrvOutliersConfig*)(config))->hrvWindow->value();
-            setRestHrv = (bool) ((FilterHrvOutliersConfig*)(config))->setRestHrv->checkState();
+            rrMax = config->value(GC_RR_MAX).toDouble();
+            rrMin = config->value(GC_RR_MIN).toDouble();
+            rrFilt = config->value(GC_RR_FILT).toDouble();
+            rrWindow = (int) config->value(GC_RR_WINDOW).toDouble();
+            setRestHrv = config->value(GC_RR_SET_REST_HRV).toBool();
         }
         FilterHrv(series, rrMin, rrMax, rrFilt, rrWindow);
 
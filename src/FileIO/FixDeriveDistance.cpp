@@ -62,6 +62,12 @@ class FixDeriveDistanceConfig : public DataProcessorConfig
         void saveConfig() {
             appsettings->setValue(GC_DPDD_UCS, useCubicSplines->checkState());
         }
+
+        QVariantMap settings() const {
+            QVariantMap returning;
+            returning.insert(GC_DPDD_UCS, useCubicSplines->checkState());
+            return returning;
+        }
 };
 
 
@@ -123,7 +129,7 @@ FixDeriveDistance::postProcess(RideFile *ride, DataProcessorConfig *config=0, QS
     if (config == NULL) { // being called automatically
         fUseCubicSplines = appsettings->value(NULL, GC_DPDD_UCS, Qt::Unchecked).toBool();
     } else { // being called manually
-        fUseCubicSplines = ((FixDeriveDistanceConfig*)(config))->useCubicSplines->isChecked();
+        fUseCubicSplines = config->value(GC_DPDD_UCS).toBool();
     }
 
     GeoPointInterpolator gpi;
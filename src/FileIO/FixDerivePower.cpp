@@ -124,6 +124,17 @@ class FixDerivePowerConfig : public DataProcessorConfig
             appsettings->setValue(GC_DPDP_CDA, cdA->value());
             appsettings->setValue(GC_DPDP_DRAFTM, draftM->value());
         }
+
+        QVariantMap settings() const {
+            QVariantMap returning;
+            returning.insert(GC_DPDP_BIKEWEIGHT, bikeWeight->value());
+            returning.insert(GC_DPDP_CRR, crr->value());
+            returning.insert(GC_DPDP_CDA, cdA->value());
+            returning.insert(GC_DPDP_DRAFTM, draftM->value());
+            returning.insert("windSpeed", windSpeed->value());
+            returning.insert("windHeading", windHeading->value());
+            return returning;
+        }
 };
 
 
@@ -209,12 +220,12 @@ FixDerivePower::postProcess(RideFile *ride, DataProcessorConfig *config=0, QStri
         windSpeed = 0.0;
         windHeading = 0.0;
     } else { // being called manually
-        MBik = ((FixDerivePowerConfig*)(config))->bikeWeight->value();
-        CrV = ((FixDerivePowerConfig*)(config))->crr->value();
-        CdA = ((FixDerivePowerConfig*)(config))->cdA->value();
-        DraftM = ((FixDerivePowerConfig*)(config))->draftM->value();
-        windSpeed = ((FixDerivePowerConfig*)(config))->windSpeed->value();                // kph
-        windHeading = ((FixDerivePowerConfig*)(config))->windHeading->value() / 180 * MATHCONST_PI; // rad
+        MBik = config->value(GC_DPDP_BIKEWEIGHT).toDouble();
+        CrV = config->value(GC_DPDP_CRR).toDouble();
+        CdA = config->value(GC_DPDP_CDA).toDouble();
+        DraftM = config->value(GC_DPDP_DRAFTM).toDouble();
+        windSpeed = config->value("windSpeed").toDouble();                // kph
+        windHeading = config->value("windHeading").toDouble() / 180 * MATHCONST_PI; // rad
     }
     bool CdANotSet = (CdA == 0.0);
 
@@ -250,6 +261,9 @@ FixDerivePower::postProcess(RideFile *ride, DataProcessorConfig *config=0, QStri
     // apply the change
     ride->command->startLUW("Estimate Power");
 
+    // we need slope and acceleration, which may not be derived yet
+    ride->derive(RideFile::DeriveSlope | RideFile::DeriveDeltas);
+
     if (ride->areDataPresent()->slope) {
         for (int i=0; i<ride->dataPoints().count(); i++) {
             RideFilePoint *p = ride->dataPoints()[i];
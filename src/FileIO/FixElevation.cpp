@@ -21,12 +21,20 @@
 #include "Settings.h"
 #include "Units.h"
 #include "HelpWhatsThis.h"
+#include "DemTiles.h"
 #include <algorithm>
 #include <QVector>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QFileDialog>
 #include <QNetworkAccessManager>
 #include <QNetworkRequest>
 #include <QNetworkReply>
 #include <QMessageBox>
+#include <QThread>
+#include <QApplication>
 #include <QJsonDocument>
 #include <QJsonArray>
 #include <QJsonObject>
@@ -45,17 +53,47 @@ class FixElevationConfig : public DataProcessorConfig
     Q_DECLARE_TR_FUNCTIONS(FixElevationConfig)
     friend class ::FixElevation;
     protected:
+        QLineEdit *demDirectory;
+        QPushButton *browse;
+
     public:
-        // there is no config
         FixElevationConfig(QWidget *parent) : DataProcessorConfig(parent) {
 
             HelpWhatsThis *help = new HelpWhatsThis(parent);
             parent->setWhatsThis(help->getWhatsThisText(HelpWhatsThis::MenuBar_Edit_FixElevationErrors));
+
+            QHBoxLayout *layout = new QHBoxLayout(this);
+            layout->setContentsMargins(0,0,0,0);
+            setContentsMargins(0,0,0,0);
+
+            // a folder of SRTM .hgt tiles, when blank we use open-elevation.com
+            demDirectory = new QLineEdit(this);
+            demDirectory->setPlaceholderText(tr("Open-Elevation.com"));
+            browse = new QPushButton(tr("Browse"), this);
+            connect(browse, &QPushButton::clicked, this, [this]() {
+                QString dir = QFileDialog::getExistingDirectory(this, tr("Select Elevation Tiles Directory"),
+                                        demDirectory->text(), QFileDialog::ShowDirsOnly);
+                if (dir != "") demDirectory->setText(dir);
+            });
+
+            layout->addWidget(new QLabel(tr("Tiles")));
+            layout->addWidget(demDirectory);
+            layout->addWidget(browse);
+        }
+
+        void readConfig() {
+            demDirectory->setText(appsettings->value(NULL, GC_DPFE_DEMDIR, "").toString());
         }
 
-        void readConfig() {}
-        void saveConfig() {}
+        void saveConfig() {
+            appsettings->setValue(GC_DPFE_DEMDIR, demDirectory->text());
+        }
 
+        QVariantMap settings() const {
+            QVariantMap returning;
+            returning.insert(GC_DPFE_DEMDIR, demDirectory->text());
+            return returning;
+        }
 };
 
 
@@ -97,7 +135,9 @@ class FixElevation : public DataProcessor {
                       "present it will be removed and overwritten."
                       "\nElevation data is provided by Open-Elevation.com public API,"
                       " consider a donation if you find it useful."
-                      "\n\nINTERNET CONNECTION REQUIRED.");
+                      "\n\nINTERNET CONNECTION REQUIRED, unless a directory of SRTM"
+                      " elevation tiles (.hgt files named as N45E006.hgt) is set, in"
+                      " which case they are used instead.");
         }
 
     private:
@@ -106,10 +146,12 @@ class FixElevation : public DataProcessor {
 
 static bool fixElevationAdded = DataProcessorFactory::instance().registerProcessor(new FixElevation());
 
+// tiles stay mapped between rides, they are shared by everyone
+static DemTiles demTiles;
+
 bool
 FixElevation::postProcess(RideFile *ride, DataProcessorConfig *config=0, QString op="")
 {
-    Q_UNUSED(config)
     Q_UNUSED(op)
 
     // Cannot process without without GPS data
@@ -120,7 +162,10 @@ FixElevation::postProcess(RideFile *ride, DataProcessorConfig *config=0, QString
 
     std::vector<elevationGPSPoint> elvPoints;
 
-    ride->command->startLUW("Fix Elevation Data");
+    // work on a copy and apply the changes in one go at the end
+    const int n = ride->dataPoints().count();
+    QVector<double> alt(n);
+    for (int i=0; i<n; i++) alt[i] = ride->dataPoints()[i]->alt;
 
     int lastDistance = 0;
     for (int i=0; i<ride->dataPoints().count(); i++) {
@@ -139,57 +184,83 @@ FixElevation::postProcess(RideFile *ride, DataProcessorConfig *config=0, QString
                 //grab a gps point every 20 meters
                 lastDistance = (int) (ride->dataPoints()[i]->km * 1000) + 20;
             }
-            ride->command->setPointValue(i, RideFile::alt, 0);
+            alt[i] = 0;
         }
     }
 
-    //loop through points and build a string to sent to Open-Elevation public API
+    // local tiles when we have them
+    if (config == NULL) { // being called automatically
+        demTiles.setDirectory(appsettings->value(NULL, GC_DPFE_DEMDIR, "").toString());
+    } else { // being called manually
+        demTiles.setDirectory(config->value(GC_DPFE_DEMDIR).toString());
+    }
+    bool local = demTiles.isValid();
+
     QList<double> elevationPoints;
-    QString latLngCollection = "";
-    int pointCount = 0;
-    try {
+    if (local) {
+
+        // all of the points in one pass over the tiles
+        QVector<double> lat, lon;
+        lat.reserve(int(elvPoints.size()));
+        lon.reserve(int(elvPoints.size()));
+        for (std::vector<elevationGPSPoint>::iterator point = elvPoints.begin(); point != elvPoints.end(); ++point) {
+            lat << point->lat;
+            lon << point->lon;
+        }
 
-        for (std::vector<elevationGPSPoint>::iterator point = elvPoints.begin();
-             point != elvPoints.end(); ++point) {
+        foreach(double elevation, demTiles.elevation(lat, lon)) elevationPoints << elevation;
 
-            if (latLngCollection.length() == 0) {
-                latLngCollection.append("{\"locations\":[");
-            } else {
+    } else {
+
+        //loop through points and build a string to sent to Open-Elevation public API
+        QString latLngCollection = "";
+        int pointCount = 0;
+        try {
+
+            for (std::vector<elevationGPSPoint>::iterator point = elvPoints.begin();
+                 point != elvPoints.end(); ++point) {
+
+                if (latLngCollection.length() == 0) {
+                    latLngCollection.append("{\"locations\":[");
+                } else {
+                    latLngCollection.append(',');
+                }
+
+                // these values need extended precision or place marker jumps around.
+                latLngCollection.append("{\"latitude\":" + QString::number(point->lat,'g',10));
                 latLngCollection.append(',');
+                latLngCollection.append("\"longitude\":" + QString::number(point->lon,'g',10) + "}");
+
+                // To avoid 302 error for longer rides we break requests in 2000 points chunks
+                if (pointCount == 2000) {
+                    latLngCollection.append("]}");
+                    elevationPoints = elevationPoints + FetchElevationData(latLngCollection);
+                    latLngCollection = "";
+                    pointCount = 0;
+                } else {
+                    ++pointCount;
+                }
             }
 
-            // these values need extended precision or place marker jumps around.
-            latLngCollection.append("{\"latitude\":" + QString::number(point->lat,'g',10));
-            latLngCollection.append(',');
-            latLngCollection.append("\"longitude\":" + QString::number(point->lon,'g',10) + "}");
-
-            // To avoid 302 error for longer rides we break requests in 2000 points chunks
-            if (pointCount == 2000) {
+            // send a request for the remainder points, currently all at once for efficiency
+            if (pointCount > 0) {
                 latLngCollection.append("]}");
                 elevationPoints = elevationPoints + FetchElevationData(latLngCollection);
-                latLngCollection = "";
-                pointCount = 0;
-            } else {
-                ++pointCount;
             }
-        }
 
-        // send a request for the remainder points, currently all at once for efficiency
-        if (pointCount > 0) {
-            latLngCollection.append("]}");
-            elevationPoints = elevationPoints + FetchElevationData(latLngCollection);
-        }
+        } catch (QString err) {
 
-    } catch (QString err) {
+            qDebug() << "Cannot fetch elevation data: " << err;
 
-        qDebug() << "Cannot fetch elevation data: " << err;
-        QMessageBox oops(QMessageBox::Critical, tr("Fix Elevation Data not possible"),
-                         tr("The following problem occured: %1").arg(err));
-        oops.exec();
-        // close LUW
-        ride->command->endLUW();
-        return false;
+            // not when run in a batch off the GUI thread
+            if (QThread::currentThread() == QApplication::instance()->thread()) {
+                QMessageBox oops(QMessageBox::Critical, tr("Fix Elevation Data not possible"),
+                                 tr("The following problem occured: %1").arg(err));
+                oops.exec();
+            }
+            return false;
 
+        }
     }
 
 
@@ -224,31 +295,27 @@ FixElevation::postProcess(RideFile *ride, DataProcessorConfig *config=0, QString
         for( std::vector<elevationGPSPoint>::iterator point = elvPoints.begin() ; point != elvPoints.end() ; ++point ) {
             double elev = smoothArray.size() > loopCount ? smoothArray[loopCount] : -100;
             // ignore any seriously negative points
-            if (elev>-100) ride->command->setPointValue(point->rideFileIndex, RideFile::alt, elev);
+            if (elev>-100) alt[point->rideFileIndex] = elev;
             ++loopCount;
         }
 
-        // set data present if not currently so
-        if (ride->areDataPresent()->alt == false) ride->command->setDataPresent(RideFile::alt, true);
-
-
         int lastgood = -1;  // where did we last have decent GPS data?
-        for (int i=0; i<ride->dataPoints().count(); i++) {
+        for (int i=0; i<n; i++) {
             // is this one decent?
-            if (ride->dataPoints()[i]->alt != double(0)) {
+            if (alt[i] != double(0)) {
 
                 if (lastgood != -1 && (lastgood+1) != i) {
                     // interpolate from last good to here
                     // then set last good to here
-                    double deltaAlt = (ride->dataPoints()[i]->alt - ride->dataPoints()[lastgood]->alt) / double(i-lastgood);
+                    double deltaAlt = (alt[i] - alt[lastgood]) / double(i-lastgood);
                     for (int j=lastgood+1; j<i; j++) {
-                        ride->command->setPointValue(j, RideFile::alt, ride->dataPoints()[lastgood]->alt + (double(j-lastgood)*deltaAlt));
+                        alt[j] = alt[lastgood] + (double(j-lastgood)*deltaAlt);
                         errors++;
                     }
                 } else if (lastgood == -1) {
                     // fill to front
                     for (int j=0; j<i; j++) {
-                        ride->command->setPointValue(j, RideFile::alt, ride->dataPoints()[i]->alt);
+                        alt[j] = alt[i];
                         errors++;
                     }
                 }
@@ -257,18 +324,37 @@ FixElevation::postProcess(RideFile *ride, DataProcessorConfig *config=0, QString
         }
 
         // fill to end...
-        if (lastgood != -1 && lastgood != (ride->dataPoints().count()-1)) {
+        if (lastgood != -1 && lastgood != (n-1)) {
            // fill from lastgood to end with lastgood
-            for (int j=lastgood+1; j<ride->dataPoints().count(); j++) {
-                ride->command->setPointValue(j, RideFile::alt, ride->dataPoints()[lastgood]->alt);
+            for (int j=lastgood+1; j<n; j++) {
+                alt[j] = alt[lastgood];
                 errors++;
             }
         }
+    }
+
+    // one command for all of the changes, not one per sample
+    QVector<int> rows;
+    QVector<double> values;
+    for (int i=0; i<n; i++) {
+        if (alt[i] != ride->dataPoints()[i]->alt) {
+            rows << i;
+            values << alt[i];
+        }
+    }
+
+    ride->command->startLUW("Fix Elevation Data");
+
+    if (elevationPoints.length() > 0) {
+
+        // set data present if not currently so
+        if (ride->areDataPresent()->alt == false) ride->command->setDataPresent(RideFile::alt, true);
 
         // Invalidate slope data to be recomputed based on new altitude data
-        if (ride->areDataPresent()->slope == true)
+        if (ride->isDataPresent(RideFile::slope) == true)
             ride->command->setDataPresent(RideFile::slope, false);
     }
+    if (rows.count()) ride->command->setPointValues(RideFile::alt, rows, values, "Fix Elevation Data");
 
     // close LUW
     ride->command->endLUW();
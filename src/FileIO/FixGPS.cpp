@@ -526,6 +526,19 @@ class FixGPSConfig : public DataProcessorConfig
             appsettings->setValue(GC_FIXGPS_ROUTE_FIX_DEGREE1,        degree1SpinBoxRoute->value());
             appsettings->setValue(GC_FIXGPS_ROUTE_OUTLIER_PERCENT,    outlierSpinBoxRoute->value());
         }
+
+        QVariantMap settings() const {
+            QVariantMap returning;
+            returning.insert(GC_FIXGPS_ALTITUDE_FIX_DOAPPLY, doSmoothAltitude->checkState());
+            returning.insert(GC_FIXGPS_ALTITUDE_FIX_DEGREE, degree0SpinBox->value());
+            returning.insert(GC_FIXGPS_ALTITUDE_FIX_DEGREE1, degree1SpinBox->value());
+            returning.insert(GC_FIXGPS_ALTITUDE_OUTLIER_PERCENT, outlierSpinBox->value());
+            returning.insert(GC_FIXGPS_ROUTE_FIX_DOAPPLY, doSmoothRoute->checkState());
+            returning.insert(GC_FIXGPS_ROUTE_FIX_DEGREE, degree0SpinBoxRoute->value());
+            returning.insert(GC_FIXGPS_ROUTE_FIX_DEGREE1, degree1SpinBoxRoute->value());
+            returning.insert(GC_FIXGPS_ROUTE_OUTLIER_PERCENT, outlierSpinBoxRoute->value());
+            return returning;
+        }
 };
 
 // RideFile Dataprocessor -- used to handle gaps in recording
@@ -1060,7 +1073,7 @@ bool FixGPS::postProcess(RideFile *ride, DataProcessorConfig *config, QString op
 
     bool fHasAlt = ride->areDataPresent()->alt;
     bool fHasLoc = ride->areDataPresent()->lat && ride->areDataPresent()->lon;
-    bool fHasSlope = ride->areDataPresent()->slope;
+    bool fHasSlope = ride->isDataPresent(RideFile::slope);
     bool fInvalidateSlope = false;
 
     // We can operate on alt and/or loc, but cannot operate if there are neither.
@@ -1145,15 +1158,15 @@ bool FixGPS::postProcess(RideFile *ride, DataProcessorConfig *config, QString op
     unsigned degree0, degree1, degree0Route, degree1Route;
     double outlierCriteria, outlierCriteriaRoute;
     if (config) {
-        fDoSmoothAltitude    = ((FixGPSConfig*)(config))->doSmoothAltitude->checkState();
-        degree0              = ((FixGPSConfig*)(config))->degree0SpinBox->value();
-        degree1              = ((FixGPSConfig*)(config))->degree1SpinBox->value();
-        outlierCriteria      = (((FixGPSConfig*)(config))->outlierSpinBox->value()) / 100.;      // cm to m
-
-        fDoSmoothRoute       = ((FixGPSConfig*) (config))->doSmoothRoute->checkState();
-        degree0Route         = ((FixGPSConfig*) (config))->degree0SpinBoxRoute->value();
-        degree1Route         = ((FixGPSConfig*) (config))->degree1SpinBoxRoute->value();
-        outlierCriteriaRoute = (((FixGPSConfig*)(config))->outlierSpinBoxRoute->value()) / 100.; // cm to m
+        fDoSmoothAltitude    = config->value(GC_FIXGPS_ALTITUDE_FIX_DOAPPLY).toBool();
+        degree0              = config->value(GC_FIXGPS_ALTITUDE_FIX_DEGREE).toInt();
+        degree1              = config->value(GC_FIXGPS_ALTITUDE_FIX_DEGREE1).toInt();
+        outlierCriteria      = config->value(GC_FIXGPS_ALTITUDE_OUTLIER_PERCENT).toDouble() / 100.;      // cm to m
+
+        fDoSmoothRoute       = config->value(GC_FIXGPS_ROUTE_FIX_DOAPPLY).toBool();
+        degree0Route         = config->value(GC_FIXGPS_ROUTE_FIX_DEGREE).toInt();
+        degree1Route         = config->value(GC_FIXGPS_ROUTE_FIX_DEGREE1).toInt();
+        outlierCriteriaRoute = config->value(GC_FIXGPS_ROUTE_OUTLIER_PERCENT).toDouble() / 100.; // cm to m
     } else {
         fDoSmoothAltitude     = appsettings->value(NULL, GC_FIXGPS_ALTITUDE_FIX_DOAPPLY, Qt::Unchecked).toBool();
         degree0               = appsettings->value(NULL, GC_FIXGPS_ALTITUDE_FIX_DEGREE, 200).toUInt();
@@ -75,6 +75,13 @@ class FixGapsConfig : public DataProcessorConfig
             appsettings->setValue(GC_DPFG_TOLERANCE, tolerance->value());
             appsettings->setValue(GC_DPFG_STOP, beerandburrito->value());
         }
+
+        QVariantMap settings() const {
+            QVariantMap returning;
+            returning.insert(GC_DPFG_TOLERANCE, tolerance->value());
+            returning.insert(GC_DPFG_STOP, beerandburrito->value());
+            return returning;
+        }
 };
 
 
@@ -141,14 +148,17 @@ FixGaps::postProcess(RideFile *ride, DataProcessorConfig *config=0, QString op="
 {
     Q_UNUSED(op)
 
+    // slope and core temperature are interpolated across the gaps too
+    ride->derive(RideFile::DeriveSlope | RideFile::DeriveCoreTemp);
+
     // get settings
     double tolerance, stop;
     if (config == NULL) { // being called automatically
         tolerance = appsettings->value(NULL, GC_DPFG_TOLERANCE, "1.0").toDouble();
         stop = appsettings->value(NULL, GC_DPFG_STOP, "90.0").toDouble();
     } else { // being called manually
-        tolerance = ((FixGapsConfig*)(config))->tolerance->value();
-        stop = ((FixGapsConfig*)(config))->beerandburrito->value();
+        tolerance = config->value(GC_DPFG_TOLERANCE).toDouble();
+        stop = config->value(GC_DPFG_STOP).toDouble();
     }
 
     // if the number of duration / number of samples
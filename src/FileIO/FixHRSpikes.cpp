@@ -69,6 +69,12 @@ class FixHRSpikesConfig : public DataProcessorConfig
         void saveConfig() {
             appsettings->setValue(GC_DPFHRS_MAX, max->value());
         }
+
+        QVariantMap settings() const {
+            QVariantMap returning;
+            returning.insert(GC_DPFHRS_MAX, max->value());
+            return returning;
+        }
 };
 
 
@@ -135,32 +141,38 @@ FixHRSpikes::postProcess(RideFile *ride, DataProcessorConfig *config=0, QString
     if (config == NULL) { // being called automatically
         max = appsettings->value(NULL, GC_DPFHRS_MAX, "200").toDouble();
     } else { // being called manually
-        max = ((FixHRSpikesConfig*)(config))->max->value();
+        max = config->value(GC_DPFHRS_MAX).toDouble();
     }
 
     // Find the HR outliers
     int spikes = 0;
     double spiketime = 0.0;
 
-    ride->command->startLUW("Fix Spikes in Recording"); // Start LogicalUnitOfWork
+    // corrections collected and applied as one edit at the end, only
+    // the good points are read so the original values are fine to use
+    QVector<int> rows;
+    QVector<double> values;
 
+    const QVector<RideFilePoint*> &points = ride->dataPoints();
     int lastgood = -1;  // where did we last have decent HR data?
-    for (int i=0; i<ride->dataPoints().count(); i++) {
+    for (int i=0; i<points.count(); i++) {
       // If we have a non-zero HR that is not above the specified MAX
-      if(ride->dataPoints()[i]->hr > 0 && ride->dataPoints()[i]->hr <= max) {
+      if(points[i]->hr > 0 && points[i]->hr <= max) {
 	if (lastgood != -1 && (lastgood+1) != i) {
 	  // interpolate from last good to here
-	  double deltaHR = (ride->dataPoints()[i]->hr - ride->dataPoints()[lastgood]->hr) / double(i-lastgood);
+	  double deltaHR = (points[i]->hr - points[lastgood]->hr) / double(i-lastgood);
 
 	  for (int j=lastgood+1; j<i; j++) {
 	    // Round as fractional HR is not very useful
-	    ride->command->setPointValue(j, RideFile::hr, ride->dataPoints()[lastgood]->hr + round(double(j-lastgood)*deltaHR));
+	    rows << j;
+	    values << points[lastgood]->hr + round(double(j-lastgood)*deltaHR);
 	    spikes++;
 	  }
 	} else if (lastgood == -1) {
 	  // fill to front
 	  for (int j=0; j<i; j++) {
-	    ride->command->setPointValue(j, RideFile::hr, ride->dataPoints()[i]->hr);
+	    rows << j;
+	    values << points[i]->hr;
 	    spikes++;
 	  }
 	}
@@ -169,15 +181,16 @@ FixHRSpikes::postProcess(RideFile *ride, DataProcessorConfig *config=0, QString
       }
     }
     // fill to end...
-    if (lastgood != -1 && lastgood != (ride->dataPoints().count()-1)) {
+    if (lastgood != -1 && lastgood != (points.count()-1)) {
        // fill from lastgood to end with lastgood
-        for (int j=lastgood+1; j<ride->dataPoints().count(); j++) {
-            ride->command->setPointValue(j, RideFile::hr, ride->dataPoints()[lastgood]->hr);
+        for (int j=lastgood+1; j<points.count(); j++) {
+            rows << j;
+            values << points[lastgood]->hr;
             spikes++;
         }
     }
 
-    ride->command->endLUW();	// End of LogicalUnitOfWork
+    if (rows.count()) ride->command->setPointValues(RideFile::hr, rows, values, "Fix Spikes in Recording");
 
     ride->setTag("Spikes", QString("%1").arg(spikes));
     ride->setTag("Spike Time", QString("%1").arg(spiketime));
@@ -78,6 +78,13 @@ class FixLapSwimConfig : public DataProcessorConfig
             appsettings->setValue(GC_DPFLS_PL, pl->value());
             appsettings->setValue(GC_DPFLS_MR, minRest->value());
         }
+
+        QVariantMap settings() const {
+            QVariantMap returning;
+            returning.insert(GC_DPFLS_PL, pl->value());
+            returning.insert(GC_DPFLS_MR, minRest->value());
+            return returning;
+        }
 };
 
 
@@ -143,8 +150,8 @@ FixLapSwim::postProcess(RideFile *ride, DataProcessorConfig *config=0, QString o
         pl = (op == "NEW") ? 0.0 : appsettings->value(NULL, GC_DPFLS_PL, "0").toDouble();
         minRest = appsettings->value(NULL, GC_DPFLS_MR, "3").toDouble();
     } else { // being called manually
-        pl = ((FixLapSwimConfig*)(config))->pl->value();
-        minRest = ((FixLapSwimConfig*)(config))->minRest->value();
+        pl = config->value(GC_DPFLS_PL).toInt();
+        minRest = config->value(GC_DPFLS_MR).toInt();
     }
 
     if (pl == 0.0) // If Pool Length is not configured, get from metadata
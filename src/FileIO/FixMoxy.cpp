@@ -66,6 +66,13 @@ class FixMoxyConfig : public DataProcessorConfig
 	    appsettings->setValue(GC_CAD2SMO2, cadConv->checkState());
 	    appsettings->setValue(GC_SPD2THB, spdConv->checkState());
 	}
+
+        QVariantMap settings() const {
+            QVariantMap returning;
+            returning.insert(GC_CAD2SMO2, cadConv->checkState());
+            returning.insert(GC_SPD2THB, spdConv->checkState());
+            return returning;
+        }
 };
 
 
@@ -126,8 +133,8 @@ FixMoxy::postProcess(RideFile *ride, DataProcessorConfig *config=0, QString op="
 	isCad = appsettings->value(NULL, GC_CAD2SMO2, Qt::Checked).toBool();
 	isSpd = appsettings->value(NULL, GC_SPD2THB, Qt::Checked).toBool();
     } else { // being called manually
-	isCad = ((FixMoxyConfig*)(config))->cadConv->checkState();
-	isSpd = ((FixMoxyConfig*)(config))->spdConv->checkState();
+	isCad = config->value(GC_CAD2SMO2).toBool();
+	isSpd = config->value(GC_SPD2THB).toBool();
     }
 
     // does this ride have power?
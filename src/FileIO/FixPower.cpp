@@ -73,6 +73,13 @@ class FixPowerConfig : public DataProcessorConfig
             appsettings->setValue(GC_DPPA, paRel->value());
             appsettings->setValue(GC_DPPA_ABS, paAbs->value());
         }
+
+        QVariantMap settings() const {
+            QVariantMap returning;
+            returning.insert(GC_DPPA, paRel->value());
+            returning.insert(GC_DPPA_ABS, paAbs->value());
+            return returning;
+        }
 };
 
 
@@ -137,8 +144,8 @@ FixPower::postProcess(RideFile *ride, DataProcessorConfig *config=0, QString op=
         percentageAdjust = appsettings->value(nullptr, GC_DPPA, 0).toDouble();
         absoluteAdjust = appsettings->value(nullptr, GC_DPPA_ABS, 0).toDouble();
     } else { // being called manually
-        percentageAdjust = ((FixPowerConfig*)(config))->paRel->value();
-        absoluteAdjust = ((FixPowerConfig*)(config))->paAbs->value();
+        percentageAdjust = config->value(GC_DPPA).toDouble();
+        absoluteAdjust = config->value(GC_DPPA_ABS).toDouble();
 
     }
 
@@ -102,6 +102,15 @@ class FixRunningPowerConfig : public DataProcessorConfig
             appsettings->setValue(GC_DPRP_EQUIPWEIGHT, equipWeight->value());
             appsettings->setValue(GC_DPDR_DRAFTM, draftM->value());
         }
+
+        QVariantMap settings() const {
+            QVariantMap returning;
+            returning.insert(GC_DPRP_EQUIPWEIGHT, equipWeight->value());
+            returning.insert(GC_DPDR_DRAFTM, draftM->value());
+            returning.insert("windSpeed", windSpeed->value());
+            returning.insert("windHeading", windHeading->value());
+            return returning;
+        }
 };
 
 
@@ -175,10 +184,10 @@ FixRunningPower::postProcess(RideFile *ride, DataProcessorConfig *config=0, QStr
         windSpeed = 0.0;
         windHeading = 0.0;
     } else { // being called manually
-        MEquip = ((FixRunningPowerConfig*)(config))->equipWeight->value();
-        DraftM = ((FixRunningPowerConfig*)(config))->draftM->value();
-        windSpeed = ((FixRunningPowerConfig*)(config))->windSpeed->value();                // kph
-        windHeading = ((FixRunningPowerConfig*)(config))->windHeading->value() / 180 * MATHCONST_PI; // rad
+        MEquip = config->value(GC_DPRP_EQUIPWEIGHT).toDouble();
+        DraftM = config->value(GC_DPDR_DRAFTM).toDouble();
+        windSpeed = config->value("windSpeed").toDouble();                // kph
+        windHeading = config->value("windHeading").toDouble() / 180 * MATHCONST_PI; // rad
     }
 
     // if not a run do nothing !
@@ -205,6 +214,9 @@ FixRunningPower::postProcess(RideFile *ride, DataProcessorConfig *config=0, QStr
     // apply the change
     ride->command->startLUW("Estimate Running Power");
 
+    // we need slope and acceleration, which may not be derived yet
+    ride->derive(RideFile::DeriveSlope | RideFile::DeriveDeltas);
+
     if (ride->areDataPresent()->slope) {
         for (int i=0; i<ride->dataPoints().count(); i++) {
             RideFilePoint *p = ride->dataPoints()[i];
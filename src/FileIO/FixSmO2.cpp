@@ -79,6 +79,14 @@ class FixSmO2Config : public DataProcessorConfig
             appsettings->setValue(GC_MOXY_FIX_THB_MAX, maxtHbInput->value());
         }
 
+        QVariantMap settings() const {
+            QVariantMap returning;
+            returning.insert(GC_MOXY_FIX_SMO2, fixSmO2Box->checkState());
+            returning.insert(GC_MOXY_FIX_THB, fixtHbBox->checkState());
+            returning.insert(GC_MOXY_FIX_THB_MAX, maxtHbInput->value());
+            return returning;
+        }
+
 };
 
 
@@ -143,9 +151,9 @@ FixSmO2::postProcess(RideFile *ride, DataProcessorConfig *config=0, QString op="
         maxtHb = appsettings->value(NULL, GC_MOXY_FIX_THB_MAX, "50.0").toDouble();
 
     } else { // being called manually
-        fixSmO2 = ((FixSmO2Config*)(config))->fixSmO2Box->isChecked();
-        fixtHb = ((FixSmO2Config*)(config))->fixtHbBox->isChecked();
-        maxtHb = ((FixSmO2Config*)(config))->maxtHbInput->value();
+        fixSmO2 = config->value(GC_MOXY_FIX_SMO2).toBool();
+        fixtHb = config->value(GC_MOXY_FIX_THB).toBool();
+        maxtHb = config->value(GC_MOXY_FIX_THB_MAX).toDouble();
     }
 
     int smO2spikes = 0;
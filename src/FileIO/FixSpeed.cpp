@@ -66,6 +66,12 @@ class FixSpeedConfig : public DataProcessorConfig
         void saveConfig() {
             appsettings->setValue(GC_DPFV_MA, ma->value());
         }
+
+        QVariantMap settings() const {
+            QVariantMap returning;
+            returning.insert(GC_DPFV_MA, ma->value());
+            return returning;
+        }
 };
 
 
@@ -125,7 +131,7 @@ FixSpeed::postProcess(RideFile *ride, DataProcessorConfig *config=0, QString op=
     if (config == NULL) { // being called automatically
         ma = appsettings->value(NULL, GC_DPFV_MA, 1).toInt();
     } else { // being called manually
-        ma = ((FixSpeedConfig*)(config))->ma->value();
+        ma = config->value(GC_DPFV_MA).toInt();
     }
 
     // no dice if we don't have Distance
@@ -139,8 +145,9 @@ FixSpeed::postProcess(RideFile *ride, DataProcessorConfig *config=0, QString op=
     int index = 0;
     double sum = 0;
 
-    // apply the change
-    bool changed=false;
+    // changes collected and applied as one edit at the end
+    QVector<int> rows;
+    QVector<double> values;
 
     double secs = 0.0;
     double km = 0.0;
@@ -163,12 +170,8 @@ FixSpeed::postProcess(RideFile *ride, DataProcessorConfig *config=0, QString op=
 
         // If different enough, update
         if (std::abs(kph - p->kph) > 10e-6) {
-            // ok, lets start a luw if not already changed
-            if (!changed) {
-                changed = true;
-                ride->command->startLUW("Fix Speed from Distance");
-            }
-            ride->command->setPointValue(i, RideFile::kph, kph);
+            rows << i;
+            values << kph;
         }
 
         // update accumulated time and distance
@@ -176,9 +179,9 @@ FixSpeed::postProcess(RideFile *ride, DataProcessorConfig *config=0, QString op=
         km = p->km;
     }
 
-    if (changed || !ride->areDataPresent()->kph) {
+    if (rows.count() || !ride->areDataPresent()->kph) {
         ride->setDataPresent(ride->kph, true);
-        ride->command->endLUW();
+        if (rows.count()) ride->command->setPointValues(RideFile::kph, rows, values, "Fix Speed from Distance");
         return true;
     }
 
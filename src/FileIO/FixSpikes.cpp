@@ -19,14 +19,13 @@
 
 #include "DataProcessor.h"
 #include "LTMOutliers.h"
+#include "StreamingFilters.h"
 #include "Settings.h"
 #include "Units.h"
 #include "Colors.h"
 #include "HelpWhatsThis.h"
 #include <algorithm>
 #include <QVector>
-#include <gsl/gsl_statistics.h>
-#include <gsl/gsl_sort.h>
 
 // Config widget used by the Preferences/Options config panes
 class FixSpikes;
@@ -102,6 +101,15 @@ class FixSpikesConfig : public DataProcessorConfig
             appsettings->setValue(GC_DPFS_MEDWINSIZ, medWinSize->value());
             appsettings->setValue(GC_DPFS_MEDALGO, algo->checkState());
         }
+
+        QVariantMap settings() const {
+            QVariantMap returning;
+            returning.insert(GC_DPFS_MAX, max->value());
+            returning.insert(GC_DPFS_VARIANCE, variance->value());
+            returning.insert(GC_DPFS_MEDWINSIZ, medWinSize->value());
+            returning.insert(GC_DPFS_MEDALGO, algo->checkState());
+            return returning;
+        }
 };
 
 
@@ -191,10 +199,10 @@ FixSpikes::postProcess(RideFile *ride, DataProcessorConfig *config=0, QString op
         medianWinSize = appsettings->value(NULL, GC_DPFS_MEDWINSIZ, "13").toInt();
     }
     else {// being called manually
-        medAlgo = ((FixSpikesConfig*)(config))->algo->isChecked();
-        max = ((FixSpikesConfig*)(config))->max->value();
-        variance = ((FixSpikesConfig*)(config))->variance->value();
-        medianWinSize = ((FixSpikesConfig*)(config))->medWinSize->value();
+        medAlgo = config->value(GC_DPFS_MEDALGO).toBool();
+        max = config->value(GC_DPFS_MAX).toDouble();
+        variance = config->value(GC_DPFS_VARIANCE).toDouble();
+        medianWinSize = config->value(GC_DPFS_MEDWINSIZ).toInt();
     }
 
     if (!medAlgo) {
@@ -215,8 +223,11 @@ FixSpikes::postProcess(RideFile *ride, DataProcessorConfig *config=0, QString op
             secs.append(point->secs);
         }
 
+        // corrections collected and applied as one edit at the end
+        QVector<int> rows;
+        QVector<double> values;
+
         LTMOutliers *outliers = new LTMOutliers(secs.data(), power.data(), power.count(), windowsize, false);
-        ride->command->startLUW("Fix Spikes in Recording");
         for (int i=0; i<secs.count(); i++) {
 
             // An entry is a fixup candidate only if its variance is high AND it is above a concerning power level.
@@ -229,18 +240,22 @@ FixSpikes::postProcess(RideFile *ride, DataProcessorConfig *config=0, QString op
             spikes++;
             spiketime += ride->recIntSecs();
 
-            // which one is it
+            // which one is it, neighbours may have been fixed already
             int pos = outliers->getIndexForRank(i);
             double left=0.0, right=0.0;
 
-            if (pos > 0) left = ride->dataPoints()[pos-1]->watts;
-            if (pos < (ride->dataPoints().count()-1)) right = ride->dataPoints()[pos+1]->watts;
+            if (pos > 0) left = power[pos-1];
+            if (pos < (power.count()-1)) right = power[pos+1];
 
-            ride->command->setPointValue(pos, RideFile::watts, (left+right)/2.0);
+            power[pos] = (left+right)/2.0;
+            rows << pos;
+            values << power[pos];
         }
 
         delete outliers;
 
+        if (rows.count()) ride->command->setPointValues(RideFile::watts, rows, values, "Fix Spikes in Recording");
+
     } else {
 
         // We use a median window to find spikes if the ride is
@@ -248,44 +263,66 @@ FixSpikes::postProcess(RideFile *ride, DataProcessorConfig *config=0, QString op
         // of post processing anyway (e.g. manual workouts)
         if (medianWinSize > ride->dataPoints().count()) return false;
 
-        double* data = new double[medianWinSize];
         int halfMedianWin = medianWinSize / 2;
-
-        ride->command->startLUW("Fix Spikes Median in Recording");
         int numDataPnts = ride->dataPoints().count();
-        for (int dataPntPosn = 0; dataPntPosn < ride->dataPoints().count(); dataPntPosn++) {
-
-            double wattsAtPnt = ride->dataPoints()[dataPntPosn]->watts;
-
-            // load median window with values
-            for (int medianWin = 0; medianWin < medianWinSize; medianWin++) {
 
-                int dp = dataPntPosn + medianWin - halfMedianWin;
-
-                // Load the median window...
-
-                if (dp < 0) {
-                    // At the beginning of the ride, the left-hand side of the median window doesn't align with any ride data, it's
-                    // somewhat arbitrary how to pad this data, but choosing a single data point to replicate runs the risk of
-                    // skewing the median filter so choose some reasonably close ride data to avoid this scenario.
-                    data[medianWin] = ride->dataPoints()[dataPntPosn + medianWin + halfMedianWin + 1]->watts;
-                }
-                else if (dp > numDataPnts - 1) {
-                    // Again at the end of the ride, the right-hand side of the median window doesn't align with any ride data, it's
-                    // best to avoid a single data point to replicate as this runs the risk of skewing the median filter
-                    // so choose some reasonably close ride data to avoid this scenario.
-                    data[medianWin] = ride->dataPoints()[dataPntPosn - halfMedianWin - (medianWinSize - medianWin)]->watts;
-                }
-                else {
-                    // The Median window lies completely within the ride data.
-                    data[medianWin] = ride->dataPoints()[dp]->watts;
+        // work on a copy, fixed values feed into the windows that follow
+        QVector<double> watts(numDataPnts);
+        for (int i=0; i<numDataPnts; i++) watts[i] = ride->dataPoints()[i]->watts;
+
+        QVector<int> rows;
+        QVector<double> values;
+
+        // the median window is kept in order as it slides along the ride
+        // so each point costs a couple of binary searches, not a sort
+        SortedWindow window;
+        window.reserve(medianWinSize);
+        bool sliding = false;
+
+        for (int dataPntPosn = 0; dataPntPosn < numDataPnts; dataPntPosn++) {
+
+            double wattsAtPnt = watts[dataPntPosn];
+            int first = dataPntPosn - halfMedianWin;
+            int last = first + medianWinSize - 1;
+            bool inside = first >= 0 && last < numDataPnts;
+
+            if (inside && sliding) {
+
+                // The Median window lies completely within the ride data, move it on one
+                window.remove(watts[first-1]);
+                window.insert(watts[last]);
+
+            } else {
+
+                // load median window with values
+                window.clear();
+                for (int medianWin = 0; medianWin < medianWinSize; medianWin++) {
+
+                    int dp = dataPntPosn + medianWin - halfMedianWin;
+
+                    // Load the median window...
+
+                    if (dp < 0) {
+                        // At the beginning of the ride, the left-hand side of the median window doesn't align with any ride data, it's
+                        // somewhat arbitrary how to pad this data, but choosing a single data point to replicate runs the risk of
+                        // skewing the median filter so choose some reasonably close ride data to avoid this scenario.
+                        window.insert(watts[dataPntPosn + medianWin + halfMedianWin + 1]);
+                    }
+                    else if (dp > numDataPnts - 1) {
+                        // Again at the end of the ride, the right-hand side of the median window doesn't align with any ride data, it's
+                        // best to avoid a single data point to replicate as this runs the risk of skewing the median filter
+                        // so choose some reasonably close ride data to avoid this scenario.
+                        window.insert(watts[dataPntPosn - halfMedianWin - (medianWinSize - medianWin)]);
+                    }
+                    else {
+                        // The Median window lies completely within the ride data.
+                        window.insert(watts[dp]);
+                    }
                 }
             }
+            sliding = inside;
 
-            // Sort entries into ascending numerical order. 
-            gsl_sort(data, 1, medianWinSize);
-
-            double medianVal = gsl_stats_median_from_sorted_data(data, 1, medianWinSize);
+            double medianVal = window.median();
 
             // An entry is a fixup candidate if it differs by more than the variance threshold.
             if (fabs(medianVal - wattsAtPnt) < variance) continue; // Note: Only works for two positive numbers.
@@ -295,14 +332,15 @@ FixSpikes::postProcess(RideFile *ride, DataProcessorConfig *config=0, QString op
             spiketime += ride->recIntSecs();
 
             // Fix data point
-            ride->command->setPointValue(dataPntPosn, RideFile::watts, medianVal);
+            window.replace(wattsAtPnt, medianVal);
+            watts[dataPntPosn] = medianVal;
+            rows << dataPntPosn;
+            values << medianVal;
         }
 
-        delete[] data;
+        if (rows.count()) ride->command->setPointValues(RideFile::watts, rows, values, "Fix Spikes Median in Recording");
     }
 
-    ride->command->endLUW();
-
     ride->setTag("Spikes", QString("%1").arg(spikes));
     ride->setTag("Spike Time", QString("%1").arg(spiketime));
 
@@ -59,6 +59,12 @@ class FixTorqueConfig : public DataProcessorConfig
         void saveConfig() {
             appsettings->setValue(GC_DPTA, ta->text());
         }
+
+        QVariantMap settings() const {
+            QVariantMap returning;
+            returning.insert(GC_DPTA, ta->text());
+            return returning;
+        }
 };
 
 
@@ -124,7 +130,7 @@ FixTorque::postProcess(RideFile *ride, DataProcessorConfig *config=0, QString op
     if (config == NULL) { // being called automatically
         ta = appsettings->value(NULL, GC_DPTA, "0 nm").toString();
     } else { // being called manually
-        ta = ((FixTorqueConfig*)(config))->ta->text();
+        ta = config->value(GC_DPTA).toString();
     }
 
     // patrick's torque adjustment code
@@ -618,6 +618,9 @@ JsonFileReader::toByteArray(Context *, const RideFile *ride, bool withAlt, bool
     //
     if (ride->dataPoints().count()) {
 
+        // slope is written out even when derived
+        const_cast<RideFile*>(ride)->deriveSeries(RideFile::slope);
+
         out += ",\n\t\t\"SAMPLES\":[\n";
         bool first = true;
 
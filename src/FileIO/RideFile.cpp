@@ -28,7 +28,8 @@
 #include "Settings.h"
 #include "Colors.h"
 #include "Units.h"
-#include "SplineLookup.h"
+#include "ResampleKernel.h"
+#include "RideFileSidecar.h"
 
 #include <QJsonObject>
 #include <QJsonArray>
@@ -36,16 +37,14 @@
 
 #include <QtXml/QtXml>
 #include <algorithm> // for std::lower_bound
+#include <atomic>
+#include <QElapsedTimer>
 #include <assert.h>
 #ifdef Q_CC_MSVC
 #include <float.h>
 #endif
 #include <cmath>
 
-#ifdef GC_HAVE_SAMPLERATE
-// we have libsamplerate
-#include <samplerate.h>
-#endif
 
 #include "../qzip/zipwriter.h"
 #include "../qzip/zipreader.h"
@@ -69,7 +68,7 @@ const QChar deltaChar(0x0394);
 RideFile::RideFile(const QDateTime &startTime, double recIntSecs) :
             wstale(true), startTime_(startTime), recIntSecs_(recIntSecs),
             data(NULL), wprime_(NULL),
-            weight_(0), totalCount(0), totalTemp(0), dstale(true)
+            weight_(0), totalCount(0), totalTemp(0), dstale(DeriveAll)
 {
     command = new RideFileCommand(this);
 
@@ -84,7 +83,7 @@ RideFile::RideFile(const QDateTime &startTime, double recIntSecs) :
 // and we want to get special fields and ESPECIALLY "CP" and "Weight"
 RideFile::RideFile(RideFile *p) :
     wstale(true), recIntSecs_(p->recIntSecs_), data(NULL), wprime_(NULL),
-    weight_(p->weight_), totalCount(0), totalTemp(0), dstale(true)
+    weight_(p->weight_), totalCount(0), totalTemp(0), dstale(DeriveAll)
 {
     startTime_ = p->startTime_;
     tags_ = p->tags_;
@@ -105,7 +104,7 @@ RideFile::RideFile(RideFile *p) :
 
 RideFile::RideFile() : 
     wstale(true), recIntSecs_(0.0), data(NULL), wprime_(NULL),
-    weight_(0), totalCount(0), totalTemp(0), dstale(true)
+    weight_(0), totalCount(0), totalTemp(0), dstale(DeriveAll)
 {
     command = new RideFileCommand(this);
 
@@ -187,12 +186,15 @@ RideFile::updateDataTag()
     if (areDataPresent()->lat ||
         areDataPresent()->lon ) flags += 'G'; // GPS
     else flags += '-';
-    if (areDataPresent()->slope) flags += 'L'; // Slope
+    if (areDataPresent()->slope ||
+        (areDataPresent()->alt && areDataPresent()->km)) flags += 'L'; // Slope, derived if need be
     else flags += '-';
     if (areDataPresent()->headwind) flags += 'W'; // Windspeed
     else flags += '-';
+    XDataSeries *developer = xdata("DEVELOPER");
     if (areDataPresent()->temp ||
-        areDataPresent()->tcore) flags += 'E'; // Temperature
+        areDataPresent()->tcore || areDataPresent()->hr || // core temperature is derived from hr
+        (developer && developer->datapoints.count() && developer->valuename.contains("core_temperature"))) flags += 'E'; // Temperature
     else flags += '-';
     if (areDataPresent()->lrbalance) flags += 'V'; // V for "Vector" aka lr pedal data
     else flags += '-';
@@ -918,8 +920,18 @@ RideFile *RideFileFactory::openRideFile(Context *context, QFile &file,
 
     } else {
 
-        // open and read the file
-        result = reader->openRideFile(file, errors, rideList);
+        // our own json has a binary copy in the cache, saves parsing it
+        QFileInfo source(file.fileName());
+        QString sidecar = RideFileSidecar::sidecarFor(context, file.fileName());
+        result = sidecar.isEmpty() ? NULL : RideFileSidecar::read(sidecar, source);
+
+        if (!result) {
+            // open and read the file
+            result = reader->openRideFile(file, errors, rideList);
+
+            // before post processing, that is done on every open
+            if (result && !sidecar.isEmpty() && errors.isEmpty()) RideFileSidecar::write(sidecar, source, result);
+        }
     }
 
     // if it was successful, lets post process the file
@@ -1051,9 +1063,6 @@ RideFile *RideFileFactory::openRideFile(Context *context, QFile &file,
             FilterHrv(series, rrMin, rrMax, rrFilt, rrWindow);
         }
 
-        // calculate derived data series -- after data fixers applied above
-        if (context) result->recalculateDerivedSeries();
-
         // what data is present - after processor in case 'derived' or adjusted
         result->updateDataTag();
 
@@ -1860,6 +1869,9 @@ RideFile::setDataPresent(SeriesType series, bool value)
 bool
 RideFile::isDataPresent(SeriesType series)
 {
+    // derived series aren't there until worked out
+    deriveSeries(series);
+
     switch (series) {
         case secs : return dataPresent.secs; break;
         case cadd :
@@ -2109,6 +2121,8 @@ RideFilePoint::setValue(RideFile::SeriesType series, double value)
 double
 RideFile::getPointValue(int index, SeriesType series) const
 {
+    // derived series are worked out the first time they are read
+    const_cast<RideFile*>(this)->deriveSeries(series);
     return dataPoints_[index]->value(series);
 }
 
@@ -2368,7 +2382,8 @@ void
 RideFile::emitSaved()
 {
     weight_ = 0;
-    wstale = dstale = true;
+    wstale = true;
+    dstale.storeRelease(DeriveAll);
     emit saved();
 }
 
@@ -2376,15 +2391,17 @@ void
 RideFile::emitReverted()
 {
     weight_ = 0;
-    wstale = dstale = true;
+    wstale = true;
+    dstale.storeRelease(DeriveAll);
     emit reverted();
 }
 
 void
 RideFile::emitModified()
 {
+    // the commands marked the derived data they changed
     weight_ = 0;
-    wstale = dstale = true;
+    wstale = true;
     emit modified();
 }
 
@@ -2487,93 +2504,112 @@ RideFile::arePresent()
 //          * Iso Power (Coggan)
 //
 
-void
-RideFile::recalculateDerivedSeries(bool force)
-{
-    // derived data is calculated from the data that is present
-    // we should set to 0 where we cannot derive since we may
-    // be called after data is deleted or added
-    if (!force && dstale == false) return; // we're already up to date
-
-    //
-    // IsoPower Initialisation -- working variables
-    //
-    QVector<double> NProlling;
-    int NProllingwindowsize = 30 / (recIntSecs_ ? recIntSecs_ : 1);
-    if (NProllingwindowsize > 1) NProlling.resize(NProllingwindowsize);
-    double NPtotal = 0;
-    int NPcount = 0;
-    int NPindex = 0;
-    double NPsum = 0;
-
-    //
-    // XPower Initialisation -- working variables
-    //
-    static const double EPSILON = 0.1;
-    static const double NEGLIGIBLE = 0.1;
-    double XPsecsDelta = recIntSecs_ ? recIntSecs_ : 1;
-    double XPsampsPerWindow = 25.0 / XPsecsDelta;
-    double XPattenuation = XPsampsPerWindow / (XPsampsPerWindow + XPsecsDelta);
-    double XPsampleWeight = XPsecsDelta / (XPsampsPerWindow + XPsecsDelta);
-    double XPlastSecs = 0.0;
-    double XPweighted = 0.0;
-    double XPtotal = 0.0;
-    int XPcount = 0;
-
-    //
-    // APower Initialisation -- working variables
-    double APtotal=0;
-    double APcount=0;
+// what each group works out, in the order of the bits
+static const char *derivedNames[] = { "deltas", "np", "xp", "apower", "tiss", "slope", "gear", "hb", "clength", "tcore" };
+static const int derivedGroups = sizeof(derivedNames) / sizeof(derivedNames[0]);
+static std::atomic<quint64> derivedCount[derivedGroups];
+static std::atomic<quint64> derivedUsecs[derivedGroups];
 
-    // aTISS - Aerobic Training Impact Scoring System
-    static const double a = 0.663788683661645f;
-    static const double b = -7.5095428451195f;
-    static const double c = -0.86118031563782f;
-    //static const double t = 2;
-    // anTISS
-    static const double an = 0.238923886004611f;
-    //static const double bn = -12.2066385296127f;
-    static const double bn = -61.849f;
-    static const double cn = -1.73549567522521f;
-
-    int CP = 0;
-    //int WPRIME = 0;
-    double aTISS = 0.0f;
-    double anTISS = 0.0f;
-
-    // set WPrime and CP
-    if (context->athlete->zones(sport())) {
-        int zoneRange = context->athlete->zones(sport())->whichRange(startTime().date());
-        CP = zoneRange >= 0 ? context->athlete->zones(sport())->getCP(zoneRange) : 0;
-        //WPRIME = zoneRange >= 0 ? context->athlete->zones(sport())->getWprime(zoneRange) : 0;
+int
+RideFile::derivedFrom(SeriesType series)
+{
+    switch (series) {
+    case kphd: case wattsd: case cadd: case nmd: case hrd: return DeriveDeltas;
+    case IsoPower: return DeriveNP;
+    case xPower: return DeriveXP;
+    case aPower: case aPowerKg: return DeriveAPower;
+    case aTISS: case anTISS: return DeriveTISS;
+    case slope: return DeriveSlope;
+    case gear: return DeriveGear;
+    case o2hb: case hhb: return DeriveHb;
+    case clength: return DeriveCycleLength;
+    case tcore: return DeriveCoreTemp;
+    default: return 0;
+    }
+}
 
-        // did we override CP in metadata / metrics ?
-        int oCP = getTag("CP","0").toInt();
-        if (oCP) CP=oCP;
+int
+RideFile::dependsOn(SeriesType series)
+{
+    switch (series) {
+    case secs: return DeriveAll;
+    case watts: return DeriveDeltas | DeriveNP | DeriveXP | DeriveAPower | DeriveTISS | DeriveGear;
+    case alt: return DeriveAPower | DeriveSlope;
+    case km: case slope: return DeriveSlope;
+    case kph: case cad: return DeriveDeltas | DeriveGear | DeriveCycleLength;
+    case rcad: return DeriveCycleLength;
+    case nm: return DeriveDeltas;
+    case hr: return DeriveDeltas | DeriveCoreTemp;
+    case smo2: case thb: return DeriveHb;
+    default: return 0;
     }
+}
 
-    // wheelsize - use meta, then config then drop to 2100
-    double wheelsize = getTag(tr("Wheelsize"), "0.0").toDouble();
-    if (wheelsize == 0) wheelsize = appsettings->cvalue(context->athlete->cyclist, GC_WHEELSIZE, 2100).toInt();
-    wheelsize /= 1000.00f; // need it in meters
+int
+RideFile::dependsOnXData(const QString &name)
+{
+    if (name == "GEARS") return DeriveGear;
+    if (name == "DEVELOPER") return DeriveCoreTemp;
+    return 0;
+}
 
-    // last point looked at
-    RideFilePoint *lastP = NULL;
+QString
+RideFile::derivedTimings()
+{
+    QStringList returning;
+    for (int i=0; i<derivedGroups; i++)
+        returning << QString("%1 n=%2 %3ms").arg(derivedNames[i])
+                                          .arg(derivedCount[i].load(std::memory_order_relaxed))
+                                          .arg(derivedUsecs[i].load(std::memory_order_relaxed) / 1000);
+    return returning.join("\n");
+}
 
-    // Hold cursor into xdata to speed up search
-    int coreidx = -1;
-    XDataSeries *devseries = xdata("DEVELOPER");
-    if (devseries && devseries->datapoints.count() > 0)  {
-        if (devseries->valuename.contains("core_temperature"))
-        {
-            setDataPresent(RideFile::tcore, true);
-            coreidx = 0;
+bool
+RideFile::derive(int which, bool force)
+{
+    // derived data is calculated from the data that is present
+    // we should set to 0 where we cannot derive since we may
+    // be called after data is deleted or added
+    if (!force && (which & dstale.loadAcquire()) == 0) return false; // we're already up to date
+
+    // readers on other threads wait for us, then find it done
+    QMutexLocker locker(&deriving);
+    if (!force) which &= dstale.loadAcquire();
+    if (which == 0) return false;
+
+    QElapsedTimer timer;
+    for (int i=0; i<derivedGroups; i++) {
+
+        if ((which & (1<<i)) == 0) continue;
+
+        timer.start();
+        switch (1<<i) {
+        case DeriveDeltas: deriveDeltas(); break;
+        case DeriveNP: deriveNP(); break;
+        case DeriveXP: deriveXP(); break;
+        case DeriveAPower: deriveAPower(); break;
+        case DeriveTISS: deriveTISS(); break;
+        case DeriveSlope: deriveSlope(); break;
+        case DeriveGear: deriveGear(); break;
+        case DeriveHb: deriveHb(); break;
+        case DeriveCycleLength: deriveCycleLength(); break;
+        case DeriveCoreTemp: deriveCoreTemp(); break;
         }
+        derivedCount[i].fetch_add(1, std::memory_order_relaxed);
+        derivedUsecs[i].fetch_add(timer.nsecsElapsed() / 1000, std::memory_order_relaxed);
     }
 
+    // and we're done
+    dstale.fetchAndAndOrdered(~which);
+    return true;
+}
+
+void
+RideFile::deriveDeltas()
+{
+    RideFilePoint *lastP = NULL;
     foreach(RideFilePoint *p, dataPoints_) {
 
-        // Delta
         if (lastP) {
 
             double deltaSpeed = (p->kph - lastP->kph) / 3.60f;
@@ -2600,10 +2636,26 @@ RideFile::recalculateDerivedSeries(bool force)
 
             }
         }
+        lastP = p;
+    }
+}
+
+void
+RideFile::deriveNP()
+{
+    //
+    // IsoPower Initialisation -- working variables
+    //
+    QVector<double> NProlling;
+    int NProllingwindowsize = 30 / (recIntSecs_ ? recIntSecs_ : 1);
+    if (NProllingwindowsize > 1) NProlling.resize(NProllingwindowsize);
+    double NPtotal = 0;
+    int NPcount = 0;
+    int NPindex = 0;
+    double NPsum = 0;
+
+    foreach(RideFilePoint *p, dataPoints_) {
 
-        //
-        // IsoPower
-        //
         if (dataPresent.watts && NProllingwindowsize > 1) {
 
             dataPresent.np = true;
@@ -2635,10 +2687,31 @@ RideFile::recalculateDerivedSeries(bool force)
         // now the min and max values for IsoPower
         if (p->np > maxPoint->np) maxPoint->np = p->np;
         if (p->np < minPoint->np) minPoint->np = p->np;
+    }
+
+    avgPoint->np = NPcount ? (NPtotal / NPcount) : 0;
+    totalPoint->np = NPtotal;
+}
+
+void
+RideFile::deriveXP()
+{
+    //
+    // XPower Initialisation -- working variables
+    //
+    static const double EPSILON = 0.1;
+    static const double NEGLIGIBLE = 0.1;
+    double XPsecsDelta = recIntSecs_ ? recIntSecs_ : 1;
+    double XPsampsPerWindow = 25.0 / XPsecsDelta;
+    double XPattenuation = XPsampsPerWindow / (XPsampsPerWindow + XPsecsDelta);
+    double XPsampleWeight = XPsecsDelta / (XPsampsPerWindow + XPsecsDelta);
+    double XPlastSecs = 0.0;
+    double XPweighted = 0.0;
+    double XPtotal = 0.0;
+    int XPcount = 0;
+
+    foreach(RideFilePoint *p, dataPoints_) {
 
-        //
-        // xPower
-        //
         if (dataPresent.watts) {
 
             dataPresent.xp = true;
@@ -2659,11 +2732,23 @@ RideFile::recalculateDerivedSeries(bool force)
             p->xp = pow(XPtotal / XPcount, 0.25);
         }
 
-        // now the min and max values for IsoPower
+        // now the min and max values for xPower
         if (p->xp > maxPoint->xp) maxPoint->xp = p->xp;
         if (p->xp < minPoint->xp) minPoint->xp = p->xp;
+    }
+
+    avgPoint->xp = XPcount ? (XPtotal / XPcount) : 0;
+    totalPoint->xp = XPtotal;
+}
+
+void
+RideFile::deriveAPower()
+{
+    double APtotal=0;
+    double APcount=0;
+
+    foreach(RideFilePoint *p, dataPoints_) {
 
-        // aPower
         if (dataPresent.watts == true && dataPresent.alt == true) {
 
             dataPresent.apower = true;
@@ -2693,46 +2778,124 @@ RideFile::recalculateDerivedSeries(bool force)
             p->apower = p->watts;
         }
 
-        // now the min and max values for IsoPower
+        // now the min and max values for aPower
         if (p->apower > maxPoint->apower) maxPoint->apower = p->apower;
         if (p->apower < minPoint->apower) minPoint->apower = p->apower;
 
         APtotal += p->apower;
         APcount++;
+    }
 
-        // Anaerobic and Aerobic TISS
-        if (CP && dataPresent.watts) {
+    avgPoint->apower = APcount ? (APtotal / APcount) : 0;
+    totalPoint->apower = APtotal;
+}
 
-            // a * exp (b * exp (c * fraction of cp) ) 
-            aTISS += recIntSecs_ * (a * exp(b * exp(c * (double(p->watts) / double(CP)))));
-            anTISS += recIntSecs_ * (an * exp(bn * exp(cn * (double(p->watts) / double(CP)))));
-            p->atiss = aTISS;
-            p->antiss = anTISS;
-        }
+void
+RideFile::deriveTISS()
+{
+    // aTISS - Aerobic Training Impact Scoring System
+    static const double a = 0.663788683661645f;
+    static const double b = -7.5095428451195f;
+    static const double c = -0.86118031563782f;
+    //static const double t = 2;
+    // anTISS
+    static const double an = 0.238923886004611f;
+    //static const double bn = -12.2066385296127f;
+    static const double bn = -61.849f;
+    static const double cn = -1.73549567522521f;
 
-        if (!dataPresent.slope && dataPresent.alt && dataPresent.km) {
-            if (lastP) {
-                double deltaDistance = p->km - lastP->km;
-                double deltaAltitude = p->alt - lastP->alt;
-                if (deltaDistance>0) {
-                    p->slope = deltaAltitude / (deltaDistance * 10); // * 100 for gradient, / 1000 to convert to meters
-                } else {
-                    // Repeat previous slope if distance hasn't changed.
-                    p->slope = lastP->slope;
-                }
-                if (p->slope > 40 || p->slope < -40) {
-                    p->slope = lastP->slope;
-                }
+    int CP = 0;
+    //int WPRIME = 0;
+    double aTISS = 0.0f;
+    double anTISS = 0.0f;
+
+    // set WPrime and CP
+    if (context && context->athlete->zones(sport())) {
+        int zoneRange = context->athlete->zones(sport())->whichRange(startTime().date());
+        CP = zoneRange >= 0 ? context->athlete->zones(sport())->getCP(zoneRange) : 0;
+        //WPRIME = zoneRange >= 0 ? context->athlete->zones(sport())->getWprime(zoneRange) : 0;
+
+        // did we override CP in metadata / metrics ?
+        int oCP = getTag("CP","0").toInt();
+        if (oCP) CP=oCP;
+    }
+    if (!CP || !dataPresent.watts) return;
+
+    foreach(RideFilePoint *p, dataPoints_) {
+
+        // a * exp (b * exp (c * fraction of cp) ) 
+        aTISS += recIntSecs_ * (a * exp(b * exp(c * (double(p->watts) / double(CP)))));
+        anTISS += recIntSecs_ * (an * exp(bn * exp(cn * (double(p->watts) / double(CP)))));
+        p->atiss = aTISS;
+        p->antiss = anTISS;
+    }
+}
+
+void
+RideFile::deriveSlope()
+{
+    // only when we don't have it already
+    if (dataPresent.slope || !dataPresent.alt || !dataPresent.km) return;
+
+    RideFilePoint *lastP = NULL;
+    foreach(RideFilePoint *p, dataPoints_) {
+        if (lastP) {
+            double deltaDistance = p->km - lastP->km;
+            double deltaAltitude = p->alt - lastP->alt;
+            if (deltaDistance>0) {
+                p->slope = deltaAltitude / (deltaDistance * 10); // * 100 for gradient, / 1000 to convert to meters
+            } else {
+                // Repeat previous slope if distance hasn't changed.
+                p->slope = lastP->slope;
             }
+            if (p->slope > 40 || p->slope < -40) {
+                p->slope = lastP->slope;
+            }
+        }
+        lastP = p;
+    }
+
+    // Smooth the slope since it has been derived
+    int smoothPoints = 10;
+    // initialise rolling average
+    double rtot = 0;
+    for (int i=smoothPoints; i>0 && dataPoints_.count()-i >=0; i--) {
+        rtot += dataPoints_[dataPoints_.count()-i]->slope;
+    }
+
+    // now run backwards setting the rolling average
+    for (int i=dataPoints_.count()-1; i>=smoothPoints; i--) {
+        double here = dataPoints_[i]->slope;
+        dataPoints_[i]->slope = rtot / smoothPoints;
+        // remove rounding effect 0.01% is flat ;)
+        if (dataPoints_[i]->slope < 0.01f && dataPoints_[i]->slope > -0.01f) {
+            dataPoints_[i]->slope = 0;
         }
+        rtot -= here;
+        rtot += dataPoints_[i-smoothPoints]->slope;
+    }
+    setDataPresent(RideFile::slope, true);
+}
+
+void
+RideFile::deriveGear()
+{
+    // wheelsize - use meta, then config then drop to 2100
+    double wheelsize = getTag(tr("Wheelsize"), "0.0").toDouble();
+    if (wheelsize == 0) wheelsize = context ? appsettings->cvalue(context->athlete->cyclist, GC_WHEELSIZE, 2100).toInt() : 2100;
+    wheelsize /= 1000.00f; // need it in meters
+
+    XDataSeries *series = xdata("GEARS");
+    bool gears = series && series->datapoints.count() > 0;
+
+    foreach(RideFilePoint *p, dataPoints_) {
 
         // derive or calculate gear ratio either from XDATA (if "GEARS" XData data exists)
         // or from speed and cadence
         double front = RideFile::NA;
         double rear = RideFile::NA;
 
-        XDataSeries *series = xdata("GEARS");
-        if (series && series->datapoints.count() > 0)  {
+        if (gears)  {
             int idx=0;
             front = xdataValue(p, idx, "GEARS", "FRONT", RideFile::REPEAT);
             rear = xdataValue(p, idx, "GEARS", "REAR", RideFile::REPEAT);
@@ -2771,56 +2934,6 @@ RideFile::recalculateDerivedSeries(bool force)
                 p->gear = 0.0f;
             }
         }
-
-        // split out O2Hb and HHb when we have SmO2 and tHb
-        // O2Hb is oxygenated haemoglobin and HHb is deoxygenated haemoglobin
-        if (dataPresent.smo2 && dataPresent.thb) {
-
-            if (p->smo2 > 0 && p->thb > 0) {
-                setDataPresent(RideFile::o2hb, true);
-                setDataPresent(RideFile::hhb, true);
-
-                p->o2hb = (p->thb * p->smo2) / 100.00f;
-                p->hhb = p->thb - p->o2hb;
-            } else {
-
-                p->o2hb = p->hhb = 0;
-            }
-        }
-
-        // can we derive cycle length ?
-        // needs speed and cadence
-        if (p->kph && (p->cad || p->rcad)) {
-            // need to say we got it
-            setDataPresent(RideFile::clength, true);
-
-            //  only if ride point has cadence and speed > 0
-            if ((p->cad > 0.0f  || p->rcad > 0.0f ) && p->kph > 0.0f) {
-                double cad = p->rcad;
-                if (cad == 0)
-                    cad = p->cad;
-
-                p->clength = (1000.00f * p->kph) / (cad * 60.00f);
-
-                // rounding to 2 decimals
-                p->clength = round(p->clength * 100.00f) / 100.00f;
-            }
-            else {
-                p->clength = 0.0f; // to be filled up with previous gear later
-            }
-
-        } else {
-            p->clength = 0.0f;
-        }
-
-        // Since TCORE isn't stored in json, retrieve it from XDATA
-        // Otherwise, derive it later
-        //
-        if (coreidx>=0)
-            p->tcore = xdataValue(p, coreidx, "DEVELOPER","core_temperature", RideFile::REPEAT);
-
-        // last point
-        lastP = p;
     }
 
     // remove gear outlier (for single outlier values = 1 second) and
@@ -2850,28 +2963,76 @@ RideFile::recalculateDerivedSeries(bool force)
 
         }
     }
+}
+
+void
+RideFile::deriveHb()
+{
+    // split out O2Hb and HHb when we have SmO2 and tHb
+    // O2Hb is oxygenated haemoglobin and HHb is deoxygenated haemoglobin
+    if (!dataPresent.smo2 || !dataPresent.thb) return;
 
-    // Smooth the slope if it has been derived
-    if (!dataPresent.slope && dataPresent.alt && dataPresent.km) {
-        int smoothPoints = 10;
-        // initialise rolling average
-        double rtot = 0;
-        for (int i=smoothPoints; i>0 && dataPoints_.count()-i >=0; i--) {
-            rtot += dataPoints_[dataPoints_.count()-i]->slope;
+    foreach(RideFilePoint *p, dataPoints_) {
+
+        if (p->smo2 > 0 && p->thb > 0) {
+            setDataPresent(RideFile::o2hb, true);
+            setDataPresent(RideFile::hhb, true);
+
+            p->o2hb = (p->thb * p->smo2) / 100.00f;
+            p->hhb = p->thb - p->o2hb;
+        } else {
+
+            p->o2hb = p->hhb = 0;
         }
+    }
+}
 
-        // now run backwards setting the rolling average
-        for (int i=dataPoints_.count()-1; i>=smoothPoints; i--) {
-            double here = dataPoints_[i]->slope;
-            dataPoints_[i]->slope = rtot / smoothPoints;
-            // remove rounding effect 0.01% is flat ;)
-            if (dataPoints_[i]->slope < 0.01f && dataPoints_[i]->slope > -0.01f) {
-                dataPoints_[i]->slope = 0;
+void
+RideFile::deriveCycleLength()
+{
+    foreach(RideFilePoint *p, dataPoints_) {
+
+        // can we derive cycle length ?
+        // needs speed and cadence
+        if (p->kph && (p->cad || p->rcad)) {
+            // need to say we got it
+            setDataPresent(RideFile::clength, true);
+
+            //  only if ride point has cadence and speed > 0
+            if ((p->cad > 0.0f  || p->rcad > 0.0f ) && p->kph > 0.0f) {
+                double cad = p->rcad;
+                if (cad == 0)
+                    cad = p->cad;
+
+                p->clength = (1000.00f * p->kph) / (cad * 60.00f);
+
+                // rounding to 2 decimals
+                p->clength = round(p->clength * 100.00f) / 100.00f;
+            }
+            else {
+                p->clength = 0.0f; // to be filled up with previous gear later
             }
-            rtot -= here;
-            rtot += dataPoints_[i-smoothPoints]->slope;
+
+        } else {
+            p->clength = 0.0f;
         }
-        setDataPresent(RideFile::slope, true);
+    }
+}
+
+void
+RideFile::deriveCoreTemp()
+{
+    // Since TCORE isn't stored in json, retrieve it from XDATA
+    // Otherwise, derive it below
+    XDataSeries *devseries = xdata("DEVELOPER");
+    if (devseries && devseries->datapoints.count() > 0 && devseries->valuename.contains("core_temperature")) {
+
+        setDataPresent(RideFile::tcore, true);
+
+        // Hold cursor into xdata to speed up search
+        int coreidx = 0;
+        foreach(RideFilePoint *p, dataPoints_)
+            p->tcore = xdataValue(p, coreidx, "DEVELOPER","core_temperature", RideFile::REPEAT);
     }
 
     //
@@ -3030,296 +3191,82 @@ RideFile::recalculateDerivedSeries(bool force)
             foreach(RideFilePoint *p, dataPoints_) p->tcore = CTStart;
         }
     }
-
-    // Averages and Totals
-    avgPoint->np = NPcount ? (NPtotal / NPcount) : 0;
-    totalPoint->np = NPtotal;
-
-    avgPoint->xp = XPcount ? (XPtotal / XPcount) : 0;
-    totalPoint->xp = XPtotal;
-
-    avgPoint->apower = APcount ? (APtotal / APcount) : 0;
-    totalPoint->apower = APtotal;
-
-    // and we're done
-    dstale=false;
-}
-
-#ifdef GC_HAVE_SAMPLERATE
-//
-// if we have libsamplerate available we use their simple api
-// but always fill the gaps in recording according to the 
-// interpolate setting.
-//
-RideFile *
-RideFile::resample(double newRecIntSecs, int interpolate)
-{
-    Q_UNUSED(interpolate);
-
-    // structures used by libsamplerate
-    SRC_DATA data;
-    float *input, *output, *source, *target;
-
-    // too few data points !
-    if (dataPoints().count() < 3) return NULL;
-
-    // allocate space for arrays
-    QVector<RideFile::seriestype> series = arePresent();
-
-    // how many samples /should/ there be ?
-    float duration = dataPoints().last()->secs - dataPoints().first()->secs;
-
-    // backwards !?
-    if (duration <= 0) return NULL;
-
-    float insamples = 1 + (duration / recIntSecs());
-    float outsamples = 1 + (duration / newRecIntSecs);
-
-    // allocate memory
-    source = input = (float*)malloc(sizeof(float) * series.count() * insamples);
-    target = output = (float*)malloc(sizeof(float) * series.count() * outsamples); 
-
-    // create the input array
-    bool first = true;
-    RideFilePoint *lp=NULL;
-
-    int inframes = 0;
-    foreach(RideFilePoint *p, dataPoints()) {
-
-        // hit limits ?
-        if (inframes >= insamples) break;
-
-        // yuck! nasty data -- ignore it
-        if (p->secs > (25*60*60)) continue;
-
-        // always start at 0 seconds
-        if (first) {
-            first = false;
-        }
-
-        // fill gaps in recording with zeroes
-        if (lp) {
-
-            // fill with zeroes
-            for(double t=lp->secs+recIntSecs();
-                    (t + recIntSecs()) < p->secs;
-                    t += recIntSecs()) {
-
-                // add zero point
-                inframes++;
-                for(int i=0; i<series.count(); i++) *source++ = 0.0f;
-            }
-        }
-
-        // lets not go backwards -- or two samples at the same time
-        if ((lp && p->secs > lp->secs) || !lp) {
-            // add this point
-            inframes++;
-            foreach(RideFile::seriestype x, series) *source++ = float(p->value(x));
-        }
-
-        // moving on to next sample
-        lp = p;
-
-    }
-
-    //
-    // THE MAGIC HAPPENS HERE ... resample to new recording interval
-    //
-    data.src_ratio = float(recIntSecs()) / float(newRecIntSecs); 
-    data.data_in = input;
-    data.input_frames = inframes;
-    data.data_out = output;
-    data.output_frames = outsamples;
-    data.input_frames_used = 0;
-    data.output_frames_gen = 0;
-    int count = src_simple(&data, SRC_LINEAR, series.count());
-
-    if (count) {
-        // didn't work !
-        //qDebug()<<"resampling error:"<<src_strerror(count);
-        free(input);
-        free(output);
-        return NULL;
-    } else {
-
-        // build new ridefile struct
-        //qDebug()<<"went from"<<inframes<<"using"<<data.input_frames_used<<"to"<<data.output_frames_gen<<"during resampling.";
-
-        RideFile *returning = new RideFile(this);
-        returning->recIntSecs_ = newRecIntSecs;
-
-        float time = 0;
-
-        // unpack the data series
-        for(int frame=0; frame < data.output_frames_gen; frame++) {
-
-            RideFilePoint add;
-            add.secs = time;
-
-            // now set each of the series
-            foreach(RideFile::seriestype x, series) {
-                if (x != RideFile::secs)
-                    add.setValue(x, *target++);
-                else
-                    target++;
-            }
-
-            // append
-            returning->appendPoint(add);
-
-            time += newRecIntSecs;
-        }
-        returning->setDataPresent(secs, true);
-
-        // free memory
-        free(input);
-        free(output);
-
-        return returning;
-    }
 }
 
-#else
-
 //
-// If we do not have libsamplerate available we use a more primitive
-// approach by creating a spline and downsampling from it
-// This is sufficient for most users who are typically converting from
-// 1.26s sampling or higher to 1s sampling when merging data.
+// Resample with ResampleKernel, all the series from one plan of the
+// times, filling gaps in recording with zeroes. Builds with libsamplerate
+// have always resampled linearly, the others from a spline.
 //
 RideFile *
 RideFile::resample(double newRecIntSecs, int /*interpolate*/)
 {
     // resample if interval has changed
     if (newRecIntSecs != recIntSecs()) {
-        QwtSplineBasis spline;
-        QMap<SeriesType, SplineLookup*> splineLookups;
-
-        // we remember the last point in time with data
-        double last = 0;
-
-        // create a spline for every series present in the ridefile
-        for(int i=0; i < static_cast<int>(none); i++) {
-
-            // save us casting all the time
-            SeriesType series = static_cast<SeriesType>(i);
-
-            if (series == secs) continue; // don't resample that !
-
-            // create a spline if its in the file
-            if (isDataPresent(series)) {
-
-                // collect the x,y points; x=time, y=series
-                QVector<QPointF> points;
-
-                double offset = 0; // always start from zero seconds (e.g. intervals start at and offset in ride)
-                bool first = true;
-                RideFilePoint *lp=NULL;
-
-                foreach(RideFilePoint *p, dataPoints()) {
-
-                    // yuck! nasty data -- ignore it
-                    if (p->secs > (25*60*60)) continue;
-
-                    // always start at 0 seconds
-                    if (first) {
-                        offset = p->secs;
-                        first = false;
-                    }
-
-                    // fill gaps in recording with zeroes
-                    if (lp) {
-
-                        // fill with zeroes
-                        for(double t=lp->secs+recIntSecs();
-                                (t + recIntSecs()) < p->secs;
-                                t += recIntSecs()) {
-                            points << QPointF(t-offset, 0);
-                        }
-                    }
 
-                    // lets not go backwards -- or two samples at the same time
-                    if ((lp && p->secs > lp->secs) || !lp) {
-                        points << QPointF(p->secs - offset, p->value(series));
-                        last = p->secs-offset;
-                    }
-
-                    // moving on to next sample
-                    lp = p;
-                }
-
-                // Now create a spline with the values we've cleaned
-                SplineLookup *splineLookup = new SplineLookup();
-                splineLookup->update(spline, QPolygonF(points), 1);
-                splineLookups.insert(series, splineLookup);
-            }
+        QVector<SeriesType> series;
+        foreach(SeriesType x, arePresent()) if (x != secs) series << x;
+
+        // each series as a column, and the times
+        const int count = dataPoints().count();
+        QVector<double> times(count);
+        QVector<QVector<double> > columns(series.count(), QVector<double>(count));
+        for (int i=0; i<count; i++) {
+            const RideFilePoint *p = dataPoints()[i];
+            times[i] = p->secs;
+            for (int c=0; c<series.count(); c++) columns[c][i] = p->value(series[c]);
         }
 
+        ResampleKernel kernel;
+#ifdef GC_HAVE_SAMPLERATE
+        kernel.plan(times, recIntSecs(), newRecIntSecs, ResampleKernel::Linear);
+#else
+        kernel.plan(times, recIntSecs(), newRecIntSecs, ResampleKernel::Spline);
+#endif
         // no data to resample
-        if (splineLookups.count() == 0 || last == 0) return NULL;
+        if (series.count() == 0 || kernel.count() < 2) return NULL;
+
+        QVector<QVector<double> > resampled(series.count(), QVector<double>(kernel.count()));
+        QVector<const double *> in;
+        QVector<double *> out;
+        for (int c=0; c<series.count(); c++) {
+            in << columns[c].constData();
+            out << resampled[c].data();
+        }
+        kernel.apply(in, out);
+
+        // round to the appropriate decimal places
+        QVector<double> scale;
+        foreach(SeriesType x, series) scale << pow(10.0, qMax(0, decimalsFor(x)));
 
-        // we have a bunch of splines so lets add resampled
-        // data points to a clone of the current ride (ie. we
-        // need to update a copy of this ride, not update it
-        // directly)
+        // we have resampled data so lets add the points to a clone of
+        // the current ride (ie. we need to update a copy of this ride,
+        // not update it directly)
         RideFile *returning = new RideFile(this);
         returning->setRecIntSecs(newRecIntSecs);
         returning->setDataPresent(secs, true);
+        foreach(SeriesType x, series) returning->setDataPresent(x, true);
 
-        RideFilePoint lp;
-        for (double seconds = 0.0f; seconds < (last-newRecIntSecs); seconds += newRecIntSecs) {
+        double lastkm = 0;
+        for (int k=0; k<kernel.count(); k++) {
 
             RideFilePoint p;
-            p.secs = seconds;
+            p.secs = kernel.secsAt(k);
 
-            // for each spline get the value for point secs
-            QMapIterator<SeriesType, SplineLookup*> iterator(splineLookups);
-            while (iterator.hasNext()) {
-                iterator.next();
-
-                SeriesType series = iterator.key();
-                SplineLookup *splineLookup = iterator.value();
-
-                double sum = 0;
-                for (double i=0; i<1; i+= 0.25) {
-                    double dt = seconds + (newRecIntSecs * i);
-                    double dtn = seconds + (newRecIntSecs * (i+0.25f));
-                    sum += (splineLookup->valueY(dt) + splineLookup->valueY(dtn)) / 2.0f;
-                }
-                sum /= 4.0f;
-
-                // round to the appropriate decimal places
-                double rounded = 0.0f;
-                if (decimalsFor(series) > 0)
-                    rounded = QString("%1").arg(sum, 15, 'f', decimalsFor(series)).toDouble();
-                else
-                    rounded = qRound(sum);
+            for (int c=0; c<series.count(); c++) {
+                double value = round(resampled[c][k] * scale[c]) / scale[c];
 
                 // don't go backwards for distance !
-                if (series == km && rounded < lp.km)
-                    p.setValue(series, lp.km);
-                else
-                    p.setValue(series, rounded);
-
-                // make sure we get to see it !
-                returning->setDataPresent(series, true);
+                if (series[c] == km) {
+                    if (value < lastkm) value = lastkm;
+                    lastkm = value;
+                }
+                p.setValue(series[c], value);
             }
             returning->appendPoint(p);
-
-            // remember last point
-            lp = p;
-        }
-
-        // clean up and return
-        // wipe away any splines created
-        QMapIterator<SeriesType, SplineLookup*> iterator(splineLookups);
-        while (iterator.hasNext()) {
-            iterator.next();
-            delete iterator.value();
         }
-
         return returning;
+
     } else {
         // not resampling but cloning a working copy
         // and removing gaps in recording
@@ -3375,7 +3322,6 @@ RideFile::resample(double newRecIntSecs, int /*interpolate*/)
         return returning;
     }
 }
-#endif
 
 double 
 RideFile::getWeight()
@@ -20,11 +20,13 @@
 #define _RideFile_h
 #include "GoldenCheetah.h"
 
+#include <QAtomicInt>
 #include <QDate>
 #include <QDir>
 #include <QFile>
 #include <QList>
 #include <QMap>
+#include <QMutex>
 #include <QVector>
 #include <QObject>
 #include <QRegExp>
@@ -331,16 +333,37 @@ class RideFile : public QObject // QObject to emit signals
 
         const QVector<RideFilePoint*> &dataPoints() const { return dataPoints_; }
 
-        // recalculate all the derived data series
-        // might want to move to a factory for these
-        // at some point, but for now hard coded
+        // recalculate all the derived data series, for those
+        // that hand the whole ride on (export, upload, scripts)
         //
-        // YOU MUST ALWAYS CALL THIS BEFORE ACESSING
-        // THE DERIVED DATA. IT IS REFRESHED ON DEMAND.
-        // STATE IS MAINTAINED IN 'bool dstale' BELOW
-        // TO ENSURE IT IS ONLY REFRESHED IF NEEDED
+        // NOTHING IS DERIVED WHEN A RIDE IS OPENED, YOU MUST
+        // CALL THIS OR deriveSeries() BEFORE ACCESSING THE
+        // DERIVED DATA IN THE POINTS. getPointValue() AND
+        // isDataPresent() DO IT FOR YOU.
         //
-        void recalculateDerivedSeries(bool force=false);
+        void recalculateDerivedSeries(bool force=false) { derive(DeriveAll, force); }
+
+        // derived series are worked out in groups, each only when asked
+        // for and kept until a series it is worked out from is changed
+        // (RideFileCommand says what each edit touched). Safe to call
+        // from any thread, true if anything needed working out
+        enum derived { DeriveDeltas = 0x1,          // kphd, wattsd, cadd, nmd, hrd
+                       DeriveNP = 0x2, DeriveXP = 0x4, DeriveAPower = 0x8,
+                       DeriveTISS = 0x10,           // atiss, antiss
+                       DeriveSlope = 0x20, DeriveGear = 0x40,
+                       DeriveHb = 0x80,             // o2hb, hhb
+                       DeriveCycleLength = 0x100, DeriveCoreTemp = 0x200,
+                       DeriveAll = 0x3ff };
+        bool derive(int which, bool force=false);
+        bool deriveSeries(SeriesType series) { return derive(derivedFrom(series)); }
+        void invalidateDerived(int which) { dstale.fetchAndOrOrdered(which); }
+
+        static int derivedFrom(SeriesType series);          // the group that works it out
+        static int dependsOn(SeriesType series);            // groups worked out from it
+        static int dependsOnXData(const QString &name);
+
+        // how often each group was worked out and how long it took
+        static QString derivedTimings();
 
         // Working with DATAPRESENT flags
         inline const RideFileDataPresent *areDataPresent() const { return &dataPresent; }
@@ -493,7 +516,20 @@ class RideFile : public QObject // QObject to emit signals
         void updateAvg(SeriesType series, double value);
         void updateAvg(RideFilePoint* point);
 
-        bool dstale; // is derived data up to date?
+        QAtomicInt dstale; // which derived data is out of date?
+        QMutex deriving;   // one thread works them out at a time
+
+        // each group of derived series, see derive()
+        void deriveDeltas();
+        void deriveNP();
+        void deriveXP();
+        void deriveAPower();
+        void deriveTISS();
+        void deriveSlope();
+        void deriveGear();
+        void deriveHb();
+        void deriveCycleLength();
+        void deriveCoreTemp();
 
         // data required to compute headwind based on weather broadcast
         double windSpeed_, windHeading_;
@@ -32,6 +32,7 @@
 #include <QFileInfo>
 #include <QMessageBox>
 #include <QtAlgorithms> // for qStableSort
+#include <QtConcurrent>
 
 static const int maxcache = 25; // lets max out at 25 caches
 
@@ -49,7 +50,7 @@ static const double wbalDelta  = 1;
 
 // cache from ride
 RideFileCache::RideFileCache(Context *context, QString fileName, double weight, RideFile *passedride, bool check, bool refresh) :
-               incomplete(false), context(context), rideFileName(fileName), ride(passedride)
+               incomplete(false), context(context), rideFileName(fileName), ride(passedride), fingerprint(0)
 {
     // resize all the arrays to zero
     wattsMeanMax.resize(0);
@@ -527,7 +528,7 @@ QVector<float> RideFileCache::meanMaxFor(QString cacheDir, RideFile::SeriesType
 }
 
 RideFileCache::RideFileCache(RideFile *ride) :
-               incomplete(false), context(ride->context), rideFileName(""), ride(ride)
+               incomplete(false), context(ride->context), rideFileName(""), ride(ride), fingerprint(0)
 {
     // resize all the arrays to zero
     wattsMeanMax.resize(0);
@@ -1702,8 +1703,8 @@ RideFileCache::computeDistribution(QVector<float> &array, RideFile::SeriesType s
 // AGGREGATE FOR A GIVEN DATE RANGE
 //
 
-// select and update bests
-static void meanMaxAggregate(QVector<double> &into, QVector<double> &other, QVector<QDate>&dates, QDate rideDate)
+// select and update bests, dated rideDate or as they were in other
+static void meanMaxAggregate(QVector<double> &into, QVector<QDate>&dates, const QVector<double> &other, const QVector<QDate> &otherDates, QDate rideDate)
 {
     if (into.size() < other.size()) {
         into.resize(other.size());
@@ -1713,20 +1714,74 @@ static void meanMaxAggregate(QVector<double> &into, QVector<double> &other, QVec
     for (int i=0; i<other.size(); i++)
         if (other[i] > into[i]) {
             into[i] = other[i];
-            dates[i] = rideDate;
+            dates[i] = rideDate.isValid() ? rideDate : otherDates[i];
         }
 }
 
 // resize into and then sum the arrays
-static void distAggregate(QVector<double> &into, QVector<double> &other)
+static void distAggregate(QVector<double> &into, const QVector<double> &other)
 {
     if (into.size() < other.size()) into.resize(other.size());
     for (int i=0; i<other.size(); i++) into[i] += other[i];
 
 }
 
+// split n rides into runs to share across the thread pool, a few
+// per thread so one with longer rides doesn't hold up the rest
+static int chunkSize(int n)
+{
+    return qMax(1, n / (QThread::idealThreadCount() * 4));
+}
+
+void
+RideFileCache::aggregate(const RideFileCache &other, QDate rideDate)
+{
+    meanMaxAggregate(wattsMeanMaxDouble, wattsMeanMaxDate, other.wattsMeanMaxDouble, other.wattsMeanMaxDate, rideDate);
+    meanMaxAggregate(hrMeanMaxDouble, hrMeanMaxDate, other.hrMeanMaxDouble, other.hrMeanMaxDate, rideDate);
+    meanMaxAggregate(cadMeanMaxDouble, cadMeanMaxDate, other.cadMeanMaxDouble, other.cadMeanMaxDate, rideDate);
+    meanMaxAggregate(nmMeanMaxDouble, nmMeanMaxDate, other.nmMeanMaxDouble, other.nmMeanMaxDate, rideDate);
+    meanMaxAggregate(kphMeanMaxDouble, kphMeanMaxDate, other.kphMeanMaxDouble, other.kphMeanMaxDate, rideDate);
+    meanMaxAggregate(kphdMeanMaxDouble, kphdMeanMaxDate, other.kphdMeanMaxDouble, other.kphdMeanMaxDate, rideDate);
+    meanMaxAggregate(wattsdMeanMaxDouble, wattsdMeanMaxDate, other.wattsdMeanMaxDouble, other.wattsdMeanMaxDate, rideDate);
+    meanMaxAggregate(caddMeanMaxDouble, caddMeanMaxDate, other.caddMeanMaxDouble, other.caddMeanMaxDate, rideDate);
+    meanMaxAggregate(nmdMeanMaxDouble, nmdMeanMaxDate, other.nmdMeanMaxDouble, other.nmdMeanMaxDate, rideDate);
+    meanMaxAggregate(hrdMeanMaxDouble, hrdMeanMaxDate, other.hrdMeanMaxDouble, other.hrdMeanMaxDate, rideDate);
+    meanMaxAggregate(xPowerMeanMaxDouble, xPowerMeanMaxDate, other.xPowerMeanMaxDouble, other.xPowerMeanMaxDate, rideDate);
+    meanMaxAggregate(npMeanMaxDouble, npMeanMaxDate, other.npMeanMaxDouble, other.npMeanMaxDate, rideDate);
+    meanMaxAggregate(vamMeanMaxDouble, vamMeanMaxDate, other.vamMeanMaxDouble, other.vamMeanMaxDate, rideDate);
+    meanMaxAggregate(wattsKgMeanMaxDouble, wattsKgMeanMaxDate, other.wattsKgMeanMaxDouble, other.wattsKgMeanMaxDate, rideDate);
+    meanMaxAggregate(aPowerMeanMaxDouble, aPowerMeanMaxDate, other.aPowerMeanMaxDouble, other.aPowerMeanMaxDate, rideDate);
+    meanMaxAggregate(aPowerKgMeanMaxDouble, aPowerKgMeanMaxDate, other.aPowerKgMeanMaxDouble, other.aPowerKgMeanMaxDate, rideDate);
+
+    distAggregate(wattsDistributionDouble, other.wattsDistributionDouble);
+    distAggregate(hrDistributionDouble, other.hrDistributionDouble);
+    distAggregate(cadDistributionDouble, other.cadDistributionDouble);
+    distAggregate(gearDistributionDouble, other.gearDistributionDouble);
+    distAggregate(nmDistributionDouble, other.nmDistributionDouble);
+    distAggregate(kphDistributionDouble, other.kphDistributionDouble);
+    distAggregate(xPowerDistributionDouble, other.xPowerDistributionDouble);
+    distAggregate(npDistributionDouble, other.npDistributionDouble);
+    distAggregate(wattsKgDistributionDouble, other.wattsKgDistributionDouble);
+    distAggregate(aPowerDistributionDouble, other.aPowerDistributionDouble);
+    distAggregate(smo2DistributionDouble, other.smo2DistributionDouble);
+    distAggregate(wbalDistributionDouble, other.wbalDistributionDouble);
+
+    // cumulate timeinzones
+    for (int i=0; i<10; i++) {
+        paceTimeInZone[i] += other.paceTimeInZone[i];
+        hrTimeInZone[i] += other.hrTimeInZone[i];
+        wattsTimeInZone[i] += other.wattsTimeInZone[i];
+        if (i<4) {
+            paceCPTimeInZone[i] += other.paceCPTimeInZone[i];
+            hrCPTimeInZone[i] += other.hrCPTimeInZone[i];
+            wattsCPTimeInZone[i] += other.wattsCPTimeInZone[i];
+            wbalTimeInZone[i] += other.wbalTimeInZone[i];
+        }
+    }
+}
+
 RideFileCache::RideFileCache(Context *context, QDate start, QDate end, bool filter, QStringList files, bool onhome, RideItem *rideItem)
-               : start(start), end(end), incomplete(false), context(context), rideFileName(""), ride(0)
+               : start(start), end(end), incomplete(false), context(context), rideFileName(""), ride(0), fingerprint(0)
 {
 
     // remember parameters for getting heat
@@ -1734,17 +1789,43 @@ RideFileCache::RideFileCache(Context *context, QDate start, QDate end, bool filt
     this->files = files;
     this->onhome = onhome;
 
-    // Oh lets get from the cache if we can -- but not if filtered
-    if (!filter && !context->isfiltered && !rideItem) {
+    // Which rides? Iterate over the ride files (not the cpx files since
+    // they /might/ not exist, or /might/ be out of date.
+    foreach (RideItem *item, context->athlete->rideCache->rides()) {
 
-        // oh and not if we're onhome and homefiltered
-        if ((onhome && !context->ishomefiltered) || !onhome) {
-            foreach(RideFileCache *p, context->athlete->cpxCache) {
-                if (p->start == start && p->end == end) {
-                    *this = *p;
-                    return;
-                }
-            }
+        QDate rideDate = item->dateTime.date();
+
+        if (((filter == true && files.contains(item->fileName)) || filter == false) &&
+            rideDate >= start && rideDate <= end) {
+
+            // skip globally filtered values
+            if (context->isfiltered && !context->filters.contains(item->fileName)) continue;
+            if (onhome && context->ishomefiltered && !context->homeFilters.contains(item->fileName)) continue;
+            // skip other sports if rideItem is given
+            if (rideItem && (rideItem->sport != item->sport)) continue;
+
+            Source add;
+            add.fileName = item->fileName;
+            add.weight = item->getWeight();
+            add.date = rideDate;
+            sources << add;
+
+            // the ride, its content, zones and weight all go into its cpx
+            fingerprint = fingerprint * 31 + qHash(item->fileName);
+            fingerprint = fingerprint * 31 + item->crc;
+            fingerprint = fingerprint * 31 + item->timestamp;
+            fingerprint = fingerprint * 31 + item->fingerprint;
+            fingerprint = fingerprint * 31 + qHash(add.weight);
+        }
+    }
+    fingerprint = fingerprint * 31 + RideFileCacheVersion;
+
+    // Oh lets get from the cache if we can, it's only the same
+    // if it's the same rides with the same caches, however filtered
+    foreach(RideFileCache *p, context->athlete->cpxCache) {
+        if (p->start == start && p->end == end && p->fingerprint == fingerprint) {
+            *this = *p;
+            return;
         }
     }
 
@@ -1789,85 +1870,60 @@ RideFileCache::RideFileCache(Context *context, QDate start, QDate end, bool filt
     paceCPTimeInZone.resize(4);
     wbalTimeInZone.resize(4);
 
-    // set cursor busy whilst we aggregate -- bit of feedback
-    // and less intrusive than a popup box
-    context->mainWindow->setCursor(Qt::WaitCursor);
-
-    // Iterate over the ride files (not the cpx files since they /might/ not
-    // exist, or /might/ be out of date.
-    foreach (RideItem *item, context->athlete->rideCache->rides()) {
-
-        QDate rideDate = item->dateTime.date();
-
-        if (((filter == true && files.contains(item->fileName)) || filter == false) &&
-            rideDate >= start && rideDate <= end) {
+    if (sources.count()) {
+
+        // set cursor busy whilst we aggregate -- bit of feedback
+        // and less intrusive than a popup box
+        context->mainWindow->setCursor(Qt::WaitCursor);
+
+        // each run of rides is read and merged into its own copy of
+        // this (still empty) aggregate on the thread pool
+        const QString path = context->athlete->home->activities().canonicalPath() + "/";
+        const int chunk = chunkSize(sources.count());
+        QVector<RideFileCache*> partials;
+        QVector<int> runs;
+        for (int i=0; i<sources.count(); i += chunk) {
+            runs << partials.count();
+            partials << new RideFileCache(this);
+        }
 
-            // skip globally filtered values
-            if (context->isfiltered && !context->filters.contains(item->fileName)) continue;
-            if (onhome && context->ishomefiltered && !context->homeFilters.contains(item->fileName)) continue;
-            // skip other sports if rideItem is given
-            if (rideItem && (rideItem->sport != item->sport)) continue;
+        QtConcurrent::blockingMap(runs, [&](int run) {
+            RideFileCache *into = partials[run];
+            for (int i=run*chunk; i<sources.count() && i<(run+1)*chunk; i++) {
 
-            // get its cached values (will NOT! refresh if needed...)
-            // the true means it will check only
-            RideFileCache rideCache(context, context->athlete->home->activities().canonicalPath() + "/" + item->fileName, item->getWeight(), NULL, false, false);
-            if (rideCache.incomplete == true) {
-                // ack, data not available !
-                incomplete = true;
-            } else {
-
-                // lets aggregate
-                meanMaxAggregate(wattsMeanMaxDouble, rideCache.wattsMeanMaxDouble, wattsMeanMaxDate, rideDate);
-                meanMaxAggregate(hrMeanMaxDouble, rideCache.hrMeanMaxDouble, hrMeanMaxDate, rideDate);
-                meanMaxAggregate(cadMeanMaxDouble, rideCache.cadMeanMaxDouble, cadMeanMaxDate, rideDate);
-                meanMaxAggregate(nmMeanMaxDouble, rideCache.nmMeanMaxDouble, nmMeanMaxDate, rideDate);
-                meanMaxAggregate(kphMeanMaxDouble, rideCache.kphMeanMaxDouble, kphMeanMaxDate, rideDate);
-                meanMaxAggregate(kphdMeanMaxDouble, rideCache.kphdMeanMaxDouble, kphdMeanMaxDate, rideDate);
-                meanMaxAggregate(wattsdMeanMaxDouble, rideCache.wattsdMeanMaxDouble, wattsdMeanMaxDate, rideDate);
-                meanMaxAggregate(caddMeanMaxDouble, rideCache.caddMeanMaxDouble, caddMeanMaxDate, rideDate);
-                meanMaxAggregate(nmdMeanMaxDouble, rideCache.nmdMeanMaxDouble, nmdMeanMaxDate, rideDate);
-                meanMaxAggregate(hrdMeanMaxDouble, rideCache.hrdMeanMaxDouble, hrdMeanMaxDate, rideDate);
-                meanMaxAggregate(xPowerMeanMaxDouble, rideCache.xPowerMeanMaxDouble, xPowerMeanMaxDate, rideDate);
-                meanMaxAggregate(npMeanMaxDouble, rideCache.npMeanMaxDouble, npMeanMaxDate, rideDate);
-                meanMaxAggregate(vamMeanMaxDouble, rideCache.vamMeanMaxDouble, vamMeanMaxDate, rideDate);
-                meanMaxAggregate(wattsKgMeanMaxDouble, rideCache.wattsKgMeanMaxDouble, wattsKgMeanMaxDate, rideDate);
-                meanMaxAggregate(aPowerMeanMaxDouble, rideCache.aPowerMeanMaxDouble, aPowerMeanMaxDate, rideDate);
-                meanMaxAggregate(aPowerKgMeanMaxDouble, rideCache.aPowerKgMeanMaxDouble, aPowerKgMeanMaxDate, rideDate);
-
-                distAggregate(wattsDistributionDouble, rideCache.wattsDistributionDouble);
-                distAggregate(hrDistributionDouble, rideCache.hrDistributionDouble);
-                distAggregate(cadDistributionDouble, rideCache.cadDistributionDouble);
-                distAggregate(gearDistributionDouble, rideCache.gearDistributionDouble);
-                distAggregate(nmDistributionDouble, rideCache.nmDistributionDouble);
-                distAggregate(kphDistributionDouble, rideCache.kphDistributionDouble);
-                distAggregate(xPowerDistributionDouble, rideCache.xPowerDistributionDouble);
-                distAggregate(npDistributionDouble, rideCache.npDistributionDouble);
-                distAggregate(wattsKgDistributionDouble, rideCache.wattsKgDistributionDouble);
-                distAggregate(aPowerDistributionDouble, rideCache.aPowerDistributionDouble);
-                distAggregate(smo2DistributionDouble, rideCache.smo2DistributionDouble);
-                distAggregate(wbalDistributionDouble, rideCache.wbalDistributionDouble);
-
-                // cumulate timeinzones
-                for (int i=0; i<10; i++) {
-                    paceTimeInZone[i] += rideCache.paceTimeInZone[i];
-                    hrTimeInZone[i] += rideCache.hrTimeInZone[i];
-                    wattsTimeInZone[i] += rideCache.wattsTimeInZone[i];
-                    if (i<4) {
-                        paceCPTimeInZone[i] += rideCache.paceCPTimeInZone[i];
-                        hrCPTimeInZone[i] += rideCache.hrCPTimeInZone[i];
-                        wattsCPTimeInZone[i] += rideCache.wattsCPTimeInZone[i];
-                        wbalTimeInZone[i] += rideCache.wbalTimeInZone[i];
-                    }
+                // get its cached values (will NOT! refresh if needed...)
+                RideFileCache rideCache(context, path + sources[i].fileName, sources[i].weight, NULL, false, false);
+                if (rideCache.incomplete == true) {
+                    // ack, data not available !
+                    into->incomplete = true;
+                } else {
+                    // lets aggregate
+                    into->aggregate(rideCache, sources[i].date);
                 }
             }
+        });
+
+        // then merge neighbouring runs pairwise till there's one left,
+        // the earlier on the left so a tie still goes to the first ride
+        for (int step=1; step < partials.count(); step *= 2) {
+            QVector<int> pairs;
+            for (int i=0; i+step < partials.count(); i += 2*step) pairs << i;
+
+            QtConcurrent::blockingMap(pairs, [&](int i) {
+                partials[i]->aggregate(*partials[i+step], QDate());
+                if (partials[i+step]->incomplete) partials[i]->incomplete = true;
+            });
         }
-    }
 
-    // set the cursor back to normal
-    context->mainWindow->setCursor(Qt::ArrowCursor);
+        *this = *partials[0];
+        foreach(RideFileCache *p, partials) delete p;
+
+        // set the cursor back to normal
+        context->mainWindow->setCursor(Qt::ArrowCursor);
+    }
 
-    // lets add to the cache for others to re-use -- but not if filtered or incomplete
-    if (incomplete == false && !context->isfiltered && (!context->ishomefiltered || !onhome) && !filter) {
+    // lets add to the cache for others to re-use -- but not if incomplete
+    if (incomplete == false) {
 
         if (context->athlete->cpxCache.count() > maxcache) {
             delete(context->athlete->cpxCache.at(0));
@@ -1885,33 +1941,41 @@ QVector<float> &RideFileCache::heatMeanMaxArray()
     // not aggregated or already done it return the result
     if (ride || heatMeanMax.count()) return heatMeanMax;
 
-    // make it big enough
-    heatMeanMax.resize(wattsMeanMaxDouble.size());
-
     // ok, we need to iterate again and compute heat based upon
-    // how close to the absolute best we've got
-    foreach(RideItem *item, context->athlete->rideCache->rides()) {
-
-        QDate rideDate = item->dateTime.date();
-
-        if (((filter == true && files.contains(item->fileName)) || filter == false) &&
-            rideDate >= start && rideDate <= end) {
+    // how close to the absolute best we've got, counting up
+    // each run of rides on the thread pool then summing
+    const QString path = context->athlete->home->activities().canonicalPath() + "/";
+    const int chunk = chunkSize(sources.count());
+    QVector<QVector<float> > heats;
+    for (int i=0; i<sources.count(); i += chunk) heats << QVector<float>(wattsMeanMaxDouble.size());
 
-            // skip globally filtered values
-            if (context->isfiltered && !context->filters.contains(item->fileName)) continue;
-            if (onhome && context->ishomefiltered && !context->homeFilters.contains(item->fileName)) continue;
+    QVector<int> runs;
+    for (int i=0; i<heats.count(); i++) runs << i;
+    QtConcurrent::blockingMap(runs, [&](int run) {
+        QVector<float> &heat = heats[run];
+        for (int i=run*chunk; i<sources.count() && i<(run+1)*chunk; i++) {
 
-            // get its cached values (will refresh if needed...)
-            RideFileCache rideCache(context, context->athlete->home->activities().canonicalPath() + "/" + item->fileName, item->getWeight());
+            // get its cached values, as when aggregating
+            RideFileCache rideCache(context, path + sources[i].fileName, sources[i].weight, NULL, false, false);
 
-            for(int i=0; i<rideCache.wattsMeanMaxDouble.count() && i<wattsMeanMaxDouble.count(); i++) {
+            for(int j=0; j<rideCache.wattsMeanMaxDouble.count() && j<wattsMeanMaxDouble.count(); j++) {
 
                 // is it within 10% of the best we have ?
-                if (rideCache.wattsMeanMaxDouble[i] >= (0.9f * wattsMeanMaxDouble[i]))
-                    heatMeanMax[i] = heatMeanMax[i] + 1;
+                if (rideCache.wattsMeanMaxDouble[j] >= (0.9f * wattsMeanMaxDouble[j]))
+                    heat[j] = heat[j] + 1;
             }
         }
-    }
+    });
+
+    // make it big enough
+    heatMeanMax.fill(0, wattsMeanMaxDouble.size());
+    foreach(const QVector<float> &heat, heats)
+        for (int i=0; i<heat.count(); i++) heatMeanMax[i] += heat[i];
+
+    // and keep it with the in-core aggregate for next time
+    foreach(RideFileCache *p, context->athlete->cpxCache)
+        if (p != this && p->start == start && p->end == end && p->fingerprint == fingerprint)
+            p->heatMeanMax = heatMeanMax;
 
     return heatMeanMax;
 }
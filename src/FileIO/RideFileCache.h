@@ -241,6 +241,9 @@ class RideFileCache
         //void computeMeanMax(QVector<float>&, RideFile::SeriesType);      // compute mean max arrays
         void computeDistribution(QVector<float>&, RideFile::SeriesType); // compute the distributions
 
+        // merge another cache's bests, distributions and time in zone into
+        // this one, the bests dated rideDate or as they were if it's not valid
+        void aggregate(const RideFileCache &other, QDate rideDate);
 
     private:
 
@@ -282,6 +285,16 @@ class RideFileCache
         bool filter, onhome; // saving parameters re-used when aggregating heat
         QStringList files;
 
+        // the rides aggregated, and a fingerprint of them and their caches
+        // so an in-core aggregate is only reused for exactly the same data
+        struct Source {
+            QString fileName;
+            double weight;
+            QDate date;
+        };
+        QVector<Source> sources;
+        quint64 fingerprint;
+
 
         QVector<double> wattsMeanMaxDouble; // RideFile::watts
         QVector<double> hrMeanMaxDouble; // RideFile::hr
@@ -50,6 +50,16 @@ RideFileCommand::setPointValue(int index, RideFile::SeriesType series, double va
     doCommand(cmd);
 }
 
+void
+RideFileCommand::setPointValues(RideFile::SeriesType series, QVector<int> rows, QVector<double> values, QString name)
+{
+    QVector<double> current(rows.count());
+    for (int i=0; i<rows.count(); i++) current[i] = ride->getPointValue(rows[i], series);
+
+    SetPointValuesCommand *cmd = new SetPointValuesCommand(ride, series, rows, current, values, name);
+    doCommand(cmd);
+}
+
 void
 RideFileCommand::deletePoint(int index)
 {
@@ -219,6 +229,7 @@ RideFileCommand::doCommand(RideCommand *cmd, bool noexec)
         luw->addCommand(cmd);
         beginCommand(false, cmd);
         cmd->doCommand(); // luw must be executed as added!!!
+        ride->invalidateDerived(cmd->invalidates());
         cmd->docount++;
         endCommand(false, cmd);
         return;
@@ -236,6 +247,7 @@ RideFileCommand::doCommand(RideCommand *cmd, bool noexec)
     if (noexec == false) {
         beginCommand(false, cmd); // signal
         cmd->doCommand(); // execute
+        ride->invalidateDerived(cmd->invalidates());
     }
     cmd->docount++;
     endCommand(false, cmd); // signal - even if LUW
@@ -250,6 +262,7 @@ RideFileCommand::redoCommand()
     if (stackptr < stack.count()) {
         beginCommand(false, stack[stackptr]); // signal
         stack[stackptr]->doCommand();
+        ride->invalidateDerived(stack[stackptr]->invalidates());
         stack[stackptr]->docount++;
         stackptr++; // increment before end to keep in sync in case
                     // it is queried 'after' the command is executed
@@ -266,6 +279,7 @@ RideFileCommand::undoCommand()
 
         beginCommand(true, stack[stackptr]); // signal
         stack[stackptr]->undoCommand();
+        ride->invalidateDerived(stack[stackptr]->invalidates());
         endCommand(true, stack[stackptr]); // signal
     }
 }
@@ -322,6 +336,14 @@ LUWCommand::doCommand()
     return true;
 }
 
+int
+LUWCommand::invalidates() const
+{
+    int returning = 0;
+    foreach(RideCommand *cmd, worklist) returning |= cmd->invalidates();
+    return returning;
+}
+
 bool
 LUWCommand::undoCommand()
 {
@@ -363,6 +385,30 @@ SetPointValueCommand::undoCommand()
     return true;
 }
 
+// Set a value for many points in one series
+SetPointValuesCommand::SetPointValuesCommand(RideFile *ride, RideFile::SeriesType series, QVector<int> rows,
+            QVector<double> oldvalues, QVector<double> newvalues, QString name) :
+            RideCommand(ride), // base class looks after these
+            series(series), rows(rows), oldvalues(oldvalues), newvalues(newvalues)
+{
+    type = RideCommand::SetPointValues;
+    description = name;
+}
+
+bool
+SetPointValuesCommand::doCommand()
+{
+    for (int i=0; i<rows.count(); i++) ride->setPointValue(rows[i], series, newvalues[i]);
+    return true;
+}
+
+bool
+SetPointValuesCommand::undoCommand()
+{
+    for (int i=rows.count(); i > 0; i--) ride->setPointValue(rows[i-1], series, oldvalues[i-1]);
+    return true;
+}
+
 // Remove a point
 DeletePointCommand::DeletePointCommand(RideFile *ride, int row, RideFilePoint point) :
         RideCommand(ride), // base class looks after these
@@ -49,6 +49,7 @@ class RideFileCommand : public QObject
         virtual ~RideFileCommand();
 
         void setPointValue(int index, RideFile::SeriesType series, double value);
+        void setPointValues(RideFile::SeriesType series, QVector<int> rows, QVector<double> values, QString name);
         void deletePoint(int index);
         void deletePoints(int index, int count);
         void insertPoint(int index, RideFilePoint *point);
@@ -104,7 +105,7 @@ class RideCommand
 {
     public:
         // supported command types
-        enum commandtype { NoOp, LUW, SetPointValue, DeletePoint, DeletePoints, InsertPoint, AppendPoints, SetDataPresent,
+        enum commandtype { NoOp, LUW, SetPointValue, SetPointValues, DeletePoint, DeletePoints, InsertPoint, AppendPoints, SetDataPresent,
                            removeXData, addXData, RemoveXDataSeries, AddXDataSeries,
                            SetXDataPointValue, DeleteXDataPoints, InsertXDataPoint, AppendXDataPoints };
         typedef enum commandtype CommandType;
@@ -115,6 +116,9 @@ class RideCommand
         virtual bool doCommand() { return true; }
         virtual bool undoCommand() { return true; }
 
+        // the derived series (RideFile::derived) it makes out of date
+        virtual int invalidates() const { return RideFile::DeriveAll; }
+
         // state of selection model -- if passed at all
         CommandType type;
         QString description;
@@ -134,6 +138,7 @@ class LUWCommand : public RideCommand
         void addCommand(RideCommand *cmd) { worklist.append(cmd); }
         bool doCommand();
         bool undoCommand();
+        int invalidates() const;
 
         QVector<RideCommand*> worklist;
         RideFileCommand *commander;
@@ -147,6 +152,7 @@ class RemoveXDataCommand : public RideCommand
         RemoveXDataCommand(RideFile *ride, QString name);
         bool doCommand();
         bool undoCommand();
+        int invalidates() const { return RideFile::dependsOnXData(name); }
 
         // state
         QString name;
@@ -161,6 +167,7 @@ class AddXDataCommand : public RideCommand
         AddXDataCommand(RideFile *ride, XDataSeries *series);
         bool doCommand();
         bool undoCommand();
+        int invalidates() const { return RideFile::dependsOnXData(series->name); }
 
         // state
         XDataSeries *series;
@@ -174,6 +181,7 @@ class RemoveXDataSeriesCommand : public RideCommand
         RemoveXDataSeriesCommand(RideFile *ride, QString xdata, QString name);
         bool doCommand();
         bool undoCommand();
+        int invalidates() const { return RideFile::dependsOnXData(xdata); }
 
         // state
         QString xdata, name;
@@ -189,6 +197,7 @@ class AddXDataSeriesCommand : public RideCommand
         AddXDataSeriesCommand(RideFile *ride, QString xdata, QString name, QString unit);
         bool doCommand();
         bool undoCommand();
+        int invalidates() const { return RideFile::dependsOnXData(xdata); }
 
         // state
         QString xdata, name, unit;
@@ -202,6 +211,7 @@ class SetPointValueCommand : public RideCommand
         SetPointValueCommand(RideFile *ride, int row, RideFile::SeriesType series, double oldvalue, double newvalue);
         bool doCommand();
         bool undoCommand();
+        int invalidates() const { return RideFile::dependsOn(series); }
 
         // state
         int row;
@@ -209,6 +219,24 @@ class SetPointValueCommand : public RideCommand
         double oldvalue, newvalue;
 };
 
+// one series, many rows, e.g. a data processor fixing spikes
+class SetPointValuesCommand : public RideCommand
+{
+    Q_DECLARE_TR_FUNCTIONS(SetPointValuesCommand)
+
+    public:
+        SetPointValuesCommand(RideFile *ride, RideFile::SeriesType series, QVector<int> rows,
+                              QVector<double> oldvalues, QVector<double> newvalues, QString name);
+        bool doCommand();
+        bool undoCommand();
+        int invalidates() const { return RideFile::dependsOn(series); }
+
+        // state
+        RideFile::SeriesType series;
+        QVector<int> rows;
+        QVector<double> oldvalues, newvalues;
+};
+
 class SetXDataPointValueCommand : public RideCommand
 {
     Q_DECLARE_TR_FUNCTIONS(SetXDataPointValueCommand)
@@ -217,6 +245,7 @@ class SetXDataPointValueCommand : public RideCommand
         SetXDataPointValueCommand(RideFile *ride, QString xdata, int row, int col, double oldvalue, double newvalue);
         bool doCommand();
         bool undoCommand();
+        int invalidates() const { return RideFile::dependsOnXData(xdata); }
 
         // state
         int row, col;
@@ -232,6 +261,7 @@ class DeleteXDataPointsCommand : public RideCommand
         DeleteXDataPointsCommand(RideFile *ride, QString xdata, int row, int count, QVector<XDataPoint*> current);
         bool doCommand();
         bool undoCommand();
+        int invalidates() const { return RideFile::dependsOnXData(xdata); }
 
         // state
         QString xdata;
@@ -290,6 +320,7 @@ class InsertXDataPointCommand : public RideCommand
         InsertXDataPointCommand(RideFile *ride, QString xdata, int row, XDataPoint *point);
         bool doCommand();
         bool undoCommand();
+        int invalidates() const { return RideFile::dependsOnXData(xdata); }
 
         // state
         QString xdata;
@@ -316,6 +347,7 @@ class AppendXDataPointsCommand : public RideCommand
         AppendXDataPointsCommand(RideFile *ride, QString xdata, int row, QVector<XDataPoint*> points);
         bool doCommand();
         bool undoCommand();
+        int invalidates() const { return RideFile::dependsOnXData(xdata); }
 
         QString xdata;
         int row, count;
@@ -330,6 +362,7 @@ class SetDataPresentCommand : public RideCommand
                               bool newvalue, bool oldvalue);
         bool doCommand();
         bool undoCommand();
+        int invalidates() const { return RideFile::dependsOn(series); }
         RideFile::SeriesType series;
         bool oldvalue, newvalue;
 };
@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "RideFileSidecar.h"
+#include "RideFile.h"
+#include "ColumnCodec.h"
+#include "Context.h"
+#include "Athlete.h"
+
+#include <QFile>
+#include <QSaveFile>
+#include <QDataStream>
+#include <QDateTime>
+#include <QColor>
+
+#define SIDECAR_MAGIC 0x47434252 // "GCBR"
+
+// the sample columns, in the order RideFile::appendPoint takes them
+static double RideFilePoint::* const sampleColumns[] = {
+    &RideFilePoint::secs, &RideFilePoint::cad, &RideFilePoint::hr, &RideFilePoint::km,
+    &RideFilePoint::kph, &RideFilePoint::nm, &RideFilePoint::watts, &RideFilePoint::alt,
+    &RideFilePoint::lon, &RideFilePoint::lat, &RideFilePoint::headwind,
+    &RideFilePoint::slope, &RideFilePoint::temp, &RideFilePoint::lrbalance,
+    &RideFilePoint::lte, &RideFilePoint::rte, &RideFilePoint::lps, &RideFilePoint::rps,
+    &RideFilePoint::lpco, &RideFilePoint::rpco,
+    &RideFilePoint::lppb, &RideFilePoint::rppb, &RideFilePoint::lppe, &RideFilePoint::rppe,
+    &RideFilePoint::lpppb, &RideFilePoint::rpppb, &RideFilePoint::lpppe, &RideFilePoint::rpppe,
+    &RideFilePoint::smo2, &RideFilePoint::thb,
+    &RideFilePoint::rvert, &RideFilePoint::rcad, &RideFilePoint::rcontact, &RideFilePoint::tcore
+};
+static const int sampleColumnCount = sizeof(sampleColumns) / sizeof(sampleColumns[0]);
+
+// samples and references are both stored as columns
+static void writePoints(QDataStream &out, const QVector<RideFilePoint*> &points)
+{
+    const int n = points.count();
+    out << qint32(n);
+
+    QVector<double> column(n);
+    for (int c=0; c<sampleColumnCount; c++) {
+        for (int i=0; i<n; i++) column[i] = points[i]->*sampleColumns[c];
+        ColumnCodec::write(out, column);
+    }
+    for (int i=0; i<n; i++) column[i] = points[i]->interval;
+    ColumnCodec::write(out, column);
+}
+
+static bool readPoints(QDataStream &in, QVector<RideFilePoint> &points)
+{
+    qint32 n;
+    in >> n;
+    if (in.status() != QDataStream::Ok || n < 0) return false;
+
+    points.resize(n);
+    QVector<double> column;
+    for (int c=0; c<sampleColumnCount; c++) {
+        if (!ColumnCodec::read(in, column, n)) return false;
+        for (int i=0; i<n; i++) points[i].*sampleColumns[c] = column[i];
+    }
+    if (!ColumnCodec::read(in, column, n)) return false;
+    for (int i=0; i<n; i++) points[i].interval = int(column[i]);
+
+    return true;
+}
+
+QString
+RideFileSidecar::sidecarFor(Context *context, const QString &filename)
+{
+    if (!context || !context->athlete || !context->athlete->home) return QString();
+
+    // only for the athlete's own activities, not imports
+    QFileInfo info(filename);
+    if (info.suffix().toLower() != "json") return QString();
+
+    QString folder = info.canonicalPath();
+    QString cache = context->athlete->home->cache().canonicalPath();
+    if (folder == context->athlete->home->activities().canonicalPath())
+        return cache + "/" + info.baseName() + ".gcb";
+    if (folder == context->athlete->home->planned().canonicalPath())
+        return cache + "/planned/" + info.baseName() + ".gcb";
+    return QString();
+}
+
+bool
+RideFileSidecar::write(const QString &sidecar, const QFileInfo &source, RideFile *ride)
+{
+    // renamed into place on commit, readers never see half a file
+    QSaveFile file(sidecar);
+    if (!file.open(QFile::WriteOnly)) return false;
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_6);
+
+    out << quint32(SIDECAR_MAGIC) << quint32(RIDEFILESIDECAR_VERSION) << ColumnCodec::byteOrder()
+        << qint64(source.size()) << qint64(source.lastModified().toMSecsSinceEpoch());
+
+    // first class, metadata and overrides
+    out << ride->startTime() << ride->recIntSecs() << ride->id() << ride->fileFormat();
+    out << ride->tags() << ride->metricOverrides;
+
+    out << qint32(ride->intervals().count());
+    foreach(const RideFileInterval *interval, ride->intervals())
+        out << qint32(interval->type) << interval->start << interval->stop << interval->name
+            << interval->color << interval->test;
+
+    out << qint32(ride->calibrations().count());
+    foreach(const RideFileCalibration *calibration, ride->calibrations())
+        out << calibration->start << qint32(calibration->value) << calibration->name;
+
+    writePoints(out, ride->referencePoints());
+
+    // xdata, columns of secs, km and as many values as are used
+    out << qint32(ride->xdata().count());
+    QMapIterator<QString, XDataSeries*> it(ride->xdata());
+    while (it.hasNext()) {
+        it.next();
+        const XDataSeries *series = it.value();
+        const int n = series->datapoints.count();
+
+        int width = qMin(series->valuename.count(), XDATA_MAXVALUES);
+        foreach(const XDataPoint *p, series->datapoints)
+            for (int v=XDATA_MAXVALUES-1; v >= width; v--)
+                if (p->number[v] != 0) { width = v+1; break; }
+
+        out << it.key() << series->name << series->valuename << series->unitname << qint32(n) << qint32(width);
+
+        QVector<double> column(n);
+        for (int i=0; i<n; i++) column[i] = series->datapoints[i]->secs;
+        ColumnCodec::write(out, column);
+        for (int i=0; i<n; i++) column[i] = series->datapoints[i]->km;
+        ColumnCodec::write(out, column);
+        for (int v=0; v<width; v++) {
+            for (int i=0; i<n; i++) column[i] = series->datapoints[i]->number[v];
+            ColumnCodec::write(out, column);
+        }
+    }
+
+    writePoints(out, ride->dataPoints());
+
+    if (out.status() != QDataStream::Ok) {
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
+}
+
+RideFile *
+RideFileSidecar::read(const QString &sidecar, const QFileInfo &source)
+{
+    QFile file(sidecar);
+    if (!file.open(QFile::ReadOnly)) return NULL;
+
+    // map it where we can, the columns are copied straight out
+    QByteArray contents;
+    uchar *mapped = file.map(0, file.size());
+    if (mapped) contents = QByteArray::fromRawData(reinterpret_cast<const char*>(mapped), int(file.size()));
+    else contents = file.readAll();
+
+    QDataStream in(contents);
+    in.setVersion(QDataStream::Qt_5_6);
+
+    quint32 magic, version, byteorder;
+    qint64 size, modified;
+    in >> magic >> version >> byteorder >> size >> modified;
+    if (in.status() != QDataStream::Ok || magic != SIDECAR_MAGIC || version != RIDEFILESIDECAR_VERSION ||
+        byteorder != ColumnCodec::byteOrder()) return NULL;
+
+    // made from this json ?
+    if (size != source.size() || modified != source.lastModified().toMSecsSinceEpoch()) return NULL;
+
+    RideFile *ride = new RideFile;
+
+    QDateTime startTime;
+    double recIntSecs;
+    QString id, fileFormat;
+    QMap<QString,QString> tags;
+    in >> startTime >> recIntSecs >> id >> fileFormat >> tags >> ride->metricOverrides;
+    ride->setStartTime(startTime);
+    ride->setRecIntSecs(recIntSecs);
+    ride->setId(id);
+    ride->setFileFormat(fileFormat);
+    QMapIterator<QString,QString> t(tags);
+    while (t.hasNext()) {
+        t.next();
+        ride->setTag(t.key(), t.value());
+    }
+
+    qint32 count;
+    in >> count;
+    for (int i=0; i<count && in.status() == QDataStream::Ok; i++) {
+        qint32 type;
+        double start, stop;
+        QString name;
+        QColor color;
+        bool test;
+        in >> type >> start >> stop >> name >> color >> test;
+        ride->addInterval(RideFileInterval::IntervalType(type), start, stop, name, color, test);
+    }
+
+    in >> count;
+    for (int i=0; i<count && in.status() == QDataStream::Ok; i++) {
+        double start;
+        qint32 value;
+        QString name;
+        in >> start >> value >> name;
+        ride->addCalibration(start, value, name);
+    }
+
+    QVector<RideFilePoint> points;
+    bool ok = in.status() == QDataStream::Ok && readPoints(in, points);
+    for (int i=0; ok && i<points.count(); i++) ride->appendReference(points[i]);
+
+    in >> count;
+    for (int x=0; ok && x<count; x++) {
+        QString key;
+        qint32 n, width;
+        XDataSeries *series = new XDataSeries;
+        in >> key >> series->name >> series->valuename >> series->unitname >> n >> width;
+        ride->addXData(key, series);
+
+        QVector<double> secs, km, column;
+        ok = in.status() == QDataStream::Ok && width >= 0 && width <= XDATA_MAXVALUES &&
+             ColumnCodec::read(in, secs, n) && ColumnCodec::read(in, km, n);
+        if (!ok) break;
+
+        series->datapoints.reserve(n);
+        for (int i=0; i<n; i++) {
+            XDataPoint *p = new XDataPoint;
+            p->secs = secs[i];
+            p->km = km[i];
+            series->datapoints.append(p);
+        }
+        for (int v=0; ok && v<width; v++) {
+            ok = ColumnCodec::read(in, column, n);
+            for (int i=0; ok && i<n; i++) series->datapoints[i]->number[v] = column[i];
+        }
+    }
+
+    // samples go through appendPoint same as the json reader, so the
+    // data present flags and min/max/avg come out the same
+    ok = ok && readPoints(in, points);
+    for (int i=0; ok && i<points.count(); i++) ride->appendPoint(points[i]);
+
+    if (!ok || in.status() != QDataStream::Ok) {
+        delete ride;
+        return NULL;
+    }
+    return ride;
+}
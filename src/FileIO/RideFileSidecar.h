@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _RideFileSidecar_h
+#define _RideFileSidecar_h
+#include "GoldenCheetah.h"
+
+#include <QString>
+#include <QFileInfo>
+
+class RideFile;
+class Context;
+
+// bump when what the json reader produces changes, old sidecars are rebuilt
+#define RIDEFILESIDECAR_VERSION 1
+
+//
+// Binary copy of a GC .json activity kept in the athlete cache folder
+// (cache/<name>.gcb, cache/planned/ for planned activities).
+//
+// Parsing the json is most of the cost of opening an activity, so once a
+// json has been parsed the RideFile it produced is written out with the
+// samples and xdata stored column by column (see ColumnCodec) and the next
+// open maps the sidecar instead. The sidecar holds what the json reader
+// returned before RideFileFactory post-processes it, so the rest of the
+// open is unchanged.
+//
+// The json is always the master. The sidecar records the size and mtime of
+// the json it was made from and is ignored (and rewritten) if they differ,
+// so editing, replacing or syncing the json just falls back to parsing it.
+//
+class RideFileSidecar
+{
+    public:
+
+        // where the sidecar for a ride file lives, empty if it shouldn't have one
+        static QString sidecarFor(Context *context, const QString &filename);
+
+        // NULL if missing, stale or damaged
+        static RideFile *read(const QString &sidecar, const QFileInfo &source);
+        static bool write(const QString &sidecar, const QFileInfo &source, RideFile *ride);
+};
+
+#endif // _RideFileSidecar_h
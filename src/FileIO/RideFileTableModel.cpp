@@ -17,6 +17,7 @@
  */
 
 #include "RideFileTableModel.h"
+#include <algorithm>
 
 RideFileTableModel::RideFileTableModel(RideFile *ride) : ride(ride)
 {
@@ -113,7 +114,7 @@ RideFileTableModel::setHeadings(RideFile::SeriesType series)
             headings_ << tr("Headwind");
             headingsType << RideFile::headwind;
         }
-        if (series == RideFile::slope || ride->areDataPresent()->slope) {
+        if (series == RideFile::slope || ride->isDataPresent(RideFile::slope)) {
             headings_ << tr("Slope");
             headingsType << RideFile::slope;
         }
@@ -121,7 +122,7 @@ RideFileTableModel::setHeadings(RideFile::SeriesType series)
             headings_ << tr("Temperature");
             headingsType << RideFile::temp;
         }
-        if (series == RideFile::tcore || ride->areDataPresent()->tcore) {
+        if (series == RideFile::tcore || ride->isDataPresent(RideFile::tcore)) {
             headings_ << tr("Core Temperature");
             headingsType << RideFile::tcore;
         }
@@ -382,6 +383,7 @@ RideFileTableModel::beginCommand(bool undo, RideCommand *cmd)
     switch (cmd->type) {
 
         case RideCommand::SetPointValue:
+        case RideCommand::SetPointValues:
             break;
 
         case RideCommand::InsertPoint:
@@ -432,6 +434,16 @@ RideFileTableModel::endCommand(bool undo, RideCommand *cmd)
             dataChanged(cell, cell);
             break;
         }
+        case RideCommand::SetPointValues:
+        {
+            SetPointValuesCommand *spv = (SetPointValuesCommand*)cmd;
+            if (spv->rows.isEmpty()) break;
+            int column = headingsType.indexOf(spv->series);
+            int first = *std::min_element(spv->rows.begin(), spv->rows.end());
+            int last = *std::max_element(spv->rows.begin(), spv->rows.end());
+            dataChanged(index(first, column), index(last, column));
+            break;
+        }
         case RideCommand::InsertPoint:
             if (!undo) endInsertRows();
             else endRemoveRows();
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "TrainRecord.h"
+
+#include <cstddef>
+#include <cstring>
+
+quint32
+TrainRecord::checksum() const
+{
+    // FNV-1a, plenty to spot a partially written record
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(this);
+    const size_t n = offsetof(TrainRecord, check);
+    quint32 hash = 2166136261u;
+    for (size_t i=0; i<n; i++) {
+        hash ^= p[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+TrainRecordReader::TrainRecordReader(QIODevice &device) :
+    device(device), status_(Ok), index(0), count(0), done(false)
+{
+    memset(&header_, 0, sizeof(header_));
+    if (device.read(reinterpret_cast<char *>(&header_), sizeof(header_)) != sizeof(header_)
+        || header_.magic != TRAINRECORD_MAGIC) {
+        status_ = NotARecording;
+    } else if (header_.version != TRAINRECORD_VERSION || header_.recordSize != sizeof(TrainRecord)) {
+        status_ = Unsupported;
+    }
+    if (status_ != Ok) done = true;
+}
+
+bool
+TrainRecordReader::next(TrainRecord &record)
+{
+    const int perblock = 1024;
+
+    if (index == count) {
+        if (done) return false;
+
+        block = device.read(perblock * sizeof(TrainRecord));
+        count = block.size() / sizeof(TrainRecord);
+        index = 0;
+        if (count < perblock) done = true;
+        if (count == 0) return false;
+    }
+
+    memcpy(&record, block.constData() + index * sizeof(TrainRecord), sizeof(TrainRecord));
+    index++;
+
+    // torn, nothing after it can be trusted
+    if (!record.isSealed()) {
+        done = true;
+        index = count;
+        return false;
+    }
+    return true;
+}
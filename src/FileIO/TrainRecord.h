@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _GC_TrainRecord_h
+#define _GC_TrainRecord_h 1
+
+#include <QIODevice>
+#include <QByteArray>
+#include <QtGlobal>
+
+//
+// Train mode recording format (.gctr)
+//
+// A fixed size header followed by fixed size records appended once per
+// sample. Nothing is formatted whilst riding and a record is only ever
+// appended, so after a crash everything up to the last complete record
+// that passes its check is still good. Values are stored in host byte
+// order, as per the .csv it replaces it is read back on the same machine.
+//
+// The companion .rr, .vo2, .tcr and .pos.csv files are written alongside
+// as before and merged in when the recording is read.
+//
+
+#define TRAINRECORD_MAGIC   0x52544347 // "GCTR"
+#define TRAINRECORD_VERSION 1
+
+struct TrainRecordHeader
+{
+    quint32 magic;
+    quint32 version;
+    quint32 recordSize;
+    quint32 reserved;
+    qint64 startTime;   // msecs since epoch
+};
+
+struct TrainRecord
+{
+    double secs;
+    double cad, hr, km, kph, nm, watts, alt, lon, lat;
+    double headwind, slope, temp, lrbalance, lte, rte, lps, rps;
+    double smo2, thb, o2hb, hhb, target;
+    double rppb, rppe, rpppb, rpppe, lppb, lppe, lpppb, lpppe;
+    qint32 interval;
+    quint32 check;      // over the bytes above, spots a torn write
+
+    void seal() { check = checksum(); }
+    bool isSealed() const { return check == checksum(); }
+
+    private:
+        quint32 checksum() const;
+};
+
+//
+// Reads the records back a block at a time, up to the end or the first
+// record that was torn when the app or machine went down mid-write.
+//
+class TrainRecordReader
+{
+    public:
+
+        enum Status { Ok, NotARecording, Unsupported };
+
+        // reads the header from an open device
+        TrainRecordReader(QIODevice &device);
+
+        Status status() const { return status_; }
+        const TrainRecordHeader &header() const { return header_; }
+
+        // false at the end
+        bool next(TrainRecord &record);
+
+    private:
+
+        QIODevice &device;
+        TrainRecordHeader header_;
+        Status status_;
+        QByteArray block;
+        int index, count;
+        bool done;
+};
+
+#endif // _GC_TrainRecord_h
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "TrainRecordFile.h"
+#include "CsvRideFile.h"
+
+#include <QRegularExpression>
+#include <algorithm>
+#include <cmath>
+
+static int trainRecordFileReaderRegistered =
+    RideFileFactory::instance().registerReader(
+        "gctr", "GoldenCheetah Train Recording", new TrainRecordFileReader());
+
+RideFile *
+TrainRecordFileReader::openRideFile(QFile &file, QStringList &errors, QList<RideFile*>*) const
+{
+    if (!file.open(QFile::ReadOnly)) {
+        errors << ("Could not open ride file: \"" + file.fileName() + "\"");
+        return NULL;
+    }
+
+    TrainRecordReader reader(file);
+    if (reader.status() == TrainRecordReader::NotARecording) {
+        errors << ("Not a train recording: \"" + file.fileName() + "\"");
+        file.close();
+        return NULL;
+    }
+    if (reader.status() == TrainRecordReader::Unsupported) {
+        errors << ("Unsupported train recording version in \"" + file.fileName() + "\"");
+        file.close();
+        return NULL;
+    }
+
+    RideFile *rideFile = new RideFile();
+    rideFile->setDeviceType("GoldenCheetah");
+    rideFile->setFileFormat("GoldenCheetah Train Recording (gctr)");
+    rideFile->setStartTime(QDateTime::fromMSecsSinceEpoch(reader.header().startTime));
+
+    XDataSeries *trainSeries = NULL;
+
+    // everything up to the end, or the last record that was whole
+    TrainRecord r;
+    while (reader.next(r)) {
+        rideFile->appendPoint(r.secs, r.cad, r.hr, r.km,
+                              r.kph, r.nm, r.watts, r.alt, r.lon, r.lat,
+                              r.headwind, r.slope, r.temp, r.lrbalance,
+                              r.lte, r.rte, r.lps, r.rps,
+                              0.0, 0.0,
+                              r.lppb, r.rppb, r.lppe, r.rppe,
+                              r.lpppb, r.rpppb, r.lpppe, r.rpppe,
+                              r.smo2, r.thb,
+                              0.0, 0.0, 0.0, 0.0, r.interval);
+
+        if (r.target > 0.0) {
+            if (trainSeries == NULL)  {
+                // add XDATA
+                trainSeries = new XDataSeries();
+                trainSeries->name = "TRAIN";
+                trainSeries->valuename << "TARGET";
+                trainSeries->unitname << "Watts";
+            }
+
+            XDataPoint *p = new XDataPoint();
+            p->secs = r.secs;
+            p->km = r.km;
+            p->number[0] = r.target;
+
+            trainSeries->datapoints.append(p);
+        }
+    }
+    file.close();
+
+    if (trainSeries != NULL) rideFile->addXData("TRAIN", trainSeries);
+
+    // less than 2 data points is not a valid ride file
+    int n = qMin(rideFile->dataPoints().size(), 1000);
+    if (n < 2) {
+        errors << "Insufficient valid data in file \"" + file.fileName() + "\". ";
+        delete rideFile;
+        return NULL;
+    }
+
+    // recording interval is the median of the first 1000 samples
+    QVector<double> secs(n-1);
+    for (int i = 0; i < n-1; ++i) {
+        secs[i] = rideFile->dataPoints()[i+1]->secs - rideFile->dataPoints()[i]->secs;
+    }
+    std::sort(secs.begin(), secs.end());
+    rideFile->setRecIntSecs(round(secs[n / 2 - 1] * 1000.0) / 1000.0);
+
+    // optional workout name saved as Route metadata, as per the .csv
+    // yyyy_MM_dd_hh_mm_ss[_workoutname].gctr
+    QRegularExpression rideName("^.*/\\d\\d\\d\\d_\\d\\d_\\d\\d_\\d\\d_\\d\\d_\\d\\d_([^\\.]+)\\.gctr$",
+                                QRegularExpression::CaseInsensitiveOption);
+    QRegularExpressionMatch match = rideName.match(file.fileName());
+    if (match.hasMatch()) rideFile->setTag("Route", match.captured(1));
+
+    // vo2, core temperature, r-r and position recorded alongside
+    CsvFileReader::readCompanionFiles(rideFile, QString(file.fileName()).replace(".gctr", ".csv"));
+
+    return rideFile;
+}
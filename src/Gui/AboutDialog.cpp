@@ -19,6 +19,13 @@
 #include "AboutDialog.h"
 #include "GcUpgrade.h"
 #include "GcCrashDialog.h"
+#include "Athlete.h"
+#include "RideCache.h"
+#include "RideResidency.h"
+#include "FilterCache.h"
+#include "RideFile.h"
+
+#include <QTimer>
 
 AboutDialog::AboutDialog(Context *context) : context(context)
 {
@@ -26,12 +33,14 @@ AboutDialog::AboutDialog(Context *context) : context(context)
     aboutPage = new AboutPage(context);
     versionPage = new VersionPage(context);
     contributorsPage = new ContributorsPage(context);
+    diagnosticsPage = new DiagnosticsPage(context);
 
     tabWidget = new QTabWidget;
     tabWidget->setContentsMargins(0,0,0,0);
     tabWidget->addTab(aboutPage, tr("About"));
     tabWidget->addTab(versionPage, tr("Version"));
     tabWidget->addTab(contributorsPage, tr("Contributors"));
+    tabWidget->addTab(diagnosticsPage, tr("Diagnostics"));
 
     mainLayout = new QVBoxLayout;
     mainLayout->addWidget(tabWidget);
@@ -232,3 +241,75 @@ ContributorsPage::ContributorsPage(Context *context) : context(context)
 
     setLayout(mainLayout);
 }
+
+//
+// Diagnostics page
+//
+DiagnosticsPage::DiagnosticsPage(Context *context) : context(context)
+{
+    text=new QLabel(this);
+    text->setContentsMargins(0,0,0,0);
+    text->setAlignment(Qt::AlignTop | Qt::AlignHCenter);
+    text->setTextInteractionFlags(Qt::TextSelectableByMouse);
+
+    QVBoxLayout *mainLayout = new QVBoxLayout;
+    mainLayout->setSpacing(0);
+    mainLayout->setContentsMargins(0,0,0,0);
+    mainLayout->addWidget(text);
+    setLayout(mainLayout);
+
+    QTimer *timer = new QTimer(this);
+    connect(timer, SIGNAL(timeout()), this, SLOT(refresh()));
+    timer->start(1000);
+    refresh();
+}
+
+// count, median, 99th percentile and worst in ms
+static QString
+timing(const LatencyHistogram &h)
+{
+    if (h.count() == 0) return "-";
+    return QString("n=%1 p50=%2ms p99=%3ms max=%4ms").arg(h.count())
+           .arg(h.percentile(50) / 1000).arg(h.percentile(99) / 1000).arg(h.max() / 1000);
+}
+
+void
+DiagnosticsPage::refresh()
+{
+    if (!isVisible() && !text->text().isEmpty()) return;
+
+    RideCache *cache = context->athlete->rideCache;
+    RideResidency::Stats rides = cache->residency()->stats();
+    qint64 budget = cache->residency()->budget();
+    FilterCache *filters = cache->filterCache();
+
+    QString row("<tr><td>%1</td><td align=\"right\">%2</td></tr>");
+    QString html = "<center><table cellspacing=4>";
+    html += "<tr><td colspan=2><b>" + tr("Activities in memory") + "</b></td></tr>";
+    html += row.arg(tr("Open")).arg(rides.resident);
+    html += row.arg(tr("Memory")).arg(QString("%1 MB").arg(rides.bytes / 1048576.0, 0, 'f', 1));
+    html += row.arg(tr("Peak")).arg(QString("%1 MB").arg(rides.peak / 1048576.0, 0, 'f', 1));
+    html += row.arg(tr("Budget")).arg(budget > 0 ? QString("%1 MB").arg(budget / 1048576) : tr("No limit"));
+    html += row.arg(tr("Selected when open")).arg(rides.hits);
+    html += row.arg(tr("Selected when closed")).arg(rides.misses);
+    html += row.arg(tr("Opened on demand")).arg(rides.opens);
+    html += row.arg(tr("Opened in the background")).arg(rides.loads);
+    html += row.arg(tr("Read ahead")).arg(rides.prefetched);
+    html += row.arg(tr("Read ahead and not used")).arg(rides.wasted);
+    html += row.arg(tr("Closed to make room")).arg(rides.evictions);
+    html += "<tr><td colspan=2><br><b>" + tr("Waiting on activities") + "</b></td></tr>";
+    html += row.arg(tr("GUI stalled opening")).arg(timing(cache->residency()->stalls()));
+    html += row.arg(tr("Selection ready")).arg(timing(cache->residency()->selections()));
+    html += row.arg(tr("Charts updating")).arg(timing(cache->residency()->renders()));
+    html += "<tr><td colspan=2><br><b>" + tr("Filters and searches") + "</b></td></tr>";
+    html += row.arg(tr("Results reused")).arg(filters->hits());
+    html += row.arg(tr("Results evaluated")).arg(filters->misses());
+    html += "<tr><td colspan=2><br><b>" + tr("Derived series") + "</b></td></tr>";
+    foreach(QString line, RideFile::derivedTimings().split("\n")) {
+        int space = line.indexOf(" ");
+        html += row.arg(line.left(space)).arg(line.mid(space+1));
+    }
+    html += "</table></center>";
+
+    text->setText(html);
+}
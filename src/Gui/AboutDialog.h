@@ -10,6 +10,8 @@ class AboutPage;
 class VersionPage;
 class ConfigPage;
 class ContributorsPage;
+class DiagnosticsPage;
+class QLabel;
 
 class AboutDialog: public QDialog
 {
@@ -25,6 +27,7 @@ class AboutDialog: public QDialog
         AboutPage *aboutPage;
         VersionPage *versionPage;
         ContributorsPage *contributorsPage;
+        DiagnosticsPage *diagnosticsPage;
 
         QTabWidget *tabWidget;
         QVBoxLayout *mainLayout;
@@ -71,5 +74,23 @@ class ContributorsPage : public QWidget
 
 };
 
+// how the caches are doing, updated whilst shown
+class DiagnosticsPage : public QWidget
+{
+    Q_OBJECT
+    G_OBJECT
+
+
+    public:
+        DiagnosticsPage(Context *context);
+
+    public slots:
+        void refresh();
+
+    private:
+        Context *context;
+        QLabel *text;
+};
+
 
 #endif // ABOUTDIALOG_H
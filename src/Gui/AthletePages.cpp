@@ -602,15 +602,22 @@ BackupPage::BackupPage
     autoBackupPeriod->setSuffix(" " + tr("times"));
     autoBackupPeriod->setSpecialValueText(tr("never"));
 
+    autoBackupIncremental = new QCheckBox(tr("Only backup files changed since the last backup"));
+    autoBackupIncremental->setChecked(appsettings->cvalue(context->athlete->cyclist, GC_AUTOBACKUP_INCREMENTAL, false).toBool());
+
     QPushButton *backupNow = new QPushButton(tr("Backup now"));
+    QPushButton *restoreNow = new QPushButton(tr("Restore..."));
 
     QFormLayout *form = newQFormLayout(this);
     form->addRow(tr("Auto Backup Folder"), autoBackupFolder);
     form->addRow(tr("Auto Backup after closing the athlete"), autoBackupPeriod);
+    form->addRow("", autoBackupIncremental);
     form->addItem(new QSpacerItem(1, 15 * dpiYFactor));
     form->addRow("", backupNow);
+    form->addRow("", restoreNow);
 
     connect(backupNow, SIGNAL(clicked()), this, SLOT(backupNow()));
+    connect(restoreNow, SIGNAL(clicked()), this, SLOT(restoreNow()));
 }
 
 void
@@ -621,12 +628,21 @@ BackupPage::backupNow
     backup.backupImmediate();
 }
 
+void
+BackupPage::restoreNow
+()
+{
+    AthleteBackup backup(context->athlete->home->root());
+    backup.restoreImmediate();
+}
+
 qint32
 BackupPage::saveClicked()
 {
     // Auto Backup
     appsettings->setCValue(context->athlete->cyclist, GC_AUTOBACKUP_FOLDER, autoBackupFolder->getPath());
     appsettings->setCValue(context->athlete->cyclist, GC_AUTOBACKUP_PERIOD, autoBackupPeriod->value());
+    appsettings->setCValue(context->athlete->cyclist, GC_AUTOBACKUP_INCREMENTAL, autoBackupIncremental->isChecked());
     return 0;
 }
 
@@ -191,9 +191,11 @@ class BackupPage : public QWidget
 
         QSpinBox *autoBackupPeriod;
         DirectoryPathWidget *autoBackupFolder;
+        QCheckBox *autoBackupIncremental;
 
     private slots:
         void backupNow();
+        void restoreNow();
 };
 
 class CredentialsPage : public QScrollArea
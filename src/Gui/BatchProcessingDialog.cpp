@@ -27,6 +27,7 @@
 #include "HelpWhatsThis.h"
 #include "CsvRideFile.h"
 #include "DataProcessor.h"
+#include "BatchDataProcessor.h"
 #include "RideMetadata.h"
 #include "SpecialFields.h"
 
@@ -741,6 +742,13 @@ BatchProcessingDialog::runDataProcessorOnActivities() {
     p->setWindowModality(Qt::ApplicationModal); // don't allow select other ride or it all goes wrong!
     bool ok = p->exec();
 
+    // core processors are run in parallel and saved as they go
+    if (ok && BatchDataProcessor::canBatch(dp)) {
+        bpFailureType result = runBatchDataProcessor(dp, config);
+        delete p;
+        return result;
+    }
+
     // loop through the table and run the data processor on each selected activity
     for (int i = 0; ok && i < files->invisibleRootItem()->childCount(); i++) {
 
@@ -785,6 +793,56 @@ BatchProcessingDialog::runDataProcessorOnActivities() {
     return bpFailureType::finishedF;
 }
 
+BatchProcessingDialog::bpFailureType
+BatchProcessingDialog::runBatchDataProcessor(DataProcessor *dp, DataProcessorConfig *config) {
+
+    // the selected activities
+    QList<RideItem*> rides;
+    QHash<QString, QTreeWidgetItem*> entries;
+    for (int i = 0; i < files->invisibleRootItem()->childCount(); i++) {
+
+        QTreeWidgetItem* current = files->invisibleRootItem()->child(i);
+        if (!static_cast<QCheckBox*>(files->itemWidget(current, 0))->isChecked()) continue;
+
+        RideItem *rideI = context->athlete->rideCache->getRide(current->text(1));
+        if (!rideI) { failedToProcessEntry(current); continue; } // eek!
+
+        rides << rideI;
+        entries.insert(rideI->fileName, current);
+        current->setText(4, tr("Queued"));
+    }
+
+    BatchDataProcessor batch(context);
+    batch.addProcessor(dp, config);
+    batch.setRides(rides);
+
+    connect(&batch, &BatchDataProcessor::rideDone, this, [this, &entries](QString filename, int result, QString message) {
+        QTreeWidgetItem *current = entries.value(filename, NULL);
+        if (!current) return;
+        files->setCurrentItem(current);
+        if (result == BatchDataProcessor::Processed) {
+            current->setText(4, message);
+            processed++;
+        } else {
+            failedToProcessEntry(current);
+            current->setText(4, message);
+        }
+    });
+    connect(&batch, &BatchDataProcessor::progress, this, [this](int done, int total) {
+        status->setText(tr("Processing %1 of %2...").arg(done).arg(total));
+    });
+
+    // wait, giving the user a chance to abort
+    batch.start();
+    while (batch.isRunning()) {
+        QApplication::processEvents(QEventLoop::WaitForMoreEvents);
+        if (aborted == true) batch.cancel();
+    }
+
+    if (aborted == true) return bpFailureType::userF; // user aborted!
+    return bpFailureType::finishedF;
+}
+
 BatchProcessingDialog::bpFailureType
 BatchProcessingDialog::setMetadataForActivities() {
 
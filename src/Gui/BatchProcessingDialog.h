@@ -39,6 +39,9 @@
 #include <QListIterator>
 #include <QDebug>
 
+class DataProcessor;
+class DataProcessorConfig;
+
 // Dialog class to allow batch processing of activities
 class BatchProcessingDialog final : public QDialog
 {
@@ -107,6 +110,7 @@ private:
     bpFailureType exportFiles();
     bpFailureType deleteFiles();
     bpFailureType runDataProcessorOnActivities();
+    bpFailureType runBatchDataProcessor(DataProcessor *dp, DataProcessorConfig *config);
     bpFailureType setMetadataForActivities();
     void failedToProcessEntry(QTreeWidgetItem* current);
 
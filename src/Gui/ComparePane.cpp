@@ -23,6 +23,7 @@
 #include "Colors.h"
 #include "RideCache.h"
 #include "RideItem.h"
+#include "RideResidency.h"
 #include "IntervalItem.h"
 #include "RideFile.h"
 #include "RideFileCache.h"
@@ -676,7 +677,8 @@ ComparePane::dropEvent(QDropEvent *event)
 
             stream >> ridep;
             RideItem *rideItem = (RideItem*)ridep;
-            RideFile *ride = rideItem->ride();
+            RideHandle handle(rideItem); // whilst we copy from it
+            RideFile *ride = handle.ride();
 
             // index into ridefile
             stream >> start;
@@ -692,6 +694,10 @@ ComparePane::dropEvent(QDropEvent *event)
             add.data = new RideFile(ride);
             add.data->context = sourceContext;
 
+            // the derived series are copied across below
+            ride->derive(RideFile::DeriveNP | RideFile::DeriveXP | RideFile::DeriveAPower |
+                         RideFile::DeriveSlope | RideFile::DeriveCoreTemp);
+
 
             // manage offsets
             bool first = true;
@@ -870,7 +876,8 @@ ComparePane::dropEvent(QDropEvent *event)
                             add.context = context;                  // UPDATE COMPARE INTERVAL
                             add.sourceContext = newOnes[0].sourceContext;      // UPDATE COMPARE INTERVAL
 
-                            RideFile *ride = matched->rideItem()->ride();
+                            RideHandle handle(matched->rideItem()); // whilst we copy from it
+                            RideFile *ride = handle.ride();
 
                             add.name = QString("%1/%2 %3").arg(matched->rideItem()->dateTime.date().day())
                                                           .arg(matched->rideItem()->dateTime.date().month())
@@ -881,6 +888,10 @@ ComparePane::dropEvent(QDropEvent *event)
                             add.data = new RideFile(ride);
                             add.data->context = context;
 
+                            // the derived series are copied across below
+                            ride->derive(RideFile::DeriveNP | RideFile::DeriveXP | RideFile::DeriveAPower |
+                                         RideFile::DeriveSlope | RideFile::DeriveCoreTemp);
+
                             // manage offsets
                             bool first = true;
                             double offset = 0.0f, offsetKM = 0.0f;
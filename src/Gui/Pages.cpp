@@ -165,6 +165,15 @@ GeneralPage::GeneralPage(Context *context) : context(context)
     if (appsettings->value(this, GC_WBALFORM, "diff").toString() == "diff") wbalForm->setCurrentIndex(0);
     else wbalForm->setCurrentIndex(1);
 
+    // memory for activities kept open, the least recently used
+    // are closed to stay within it
+    rideMemory = new QSpinBox(this);
+    rideMemory->setRange(0, 65536);
+    rideMemory->setSingleStep(256);
+    rideMemory->setSuffix(" " + tr("MB"));
+    rideMemory->setSpecialValueText(tr("No limit"));
+    rideMemory->setValue(appsettings->value(this, GC_RIDE_MEMORY, 1024).toInt());
+
     //
     // Warn to save on exit
     warnOnExit = new QCheckBox(tr("Warn for unsaved activities on exit"), this);
@@ -286,6 +295,7 @@ GeneralPage::GeneralPage(Context *context) : context(context)
     form->addRow("", warnOnExit);
     form->addRow("", openLastAthlete);
     form->addRow("", opendata);
+    form->addRow(tr("Activity memory"), rideMemory);
 
     form->addItem(new QSpacerItem(0, 15 * dpiYFactor));
     form->addRow(new QLabel(HLO + tr("Recording and Calculation") + HLC));
@@ -350,6 +360,9 @@ GeneralPage::saveClicked()
     // open last athlete on start
     appsettings->setValue(GC_OPENLASTATHLETE, openLastAthlete->isChecked());
 
+    // taken up next time a ride is opened
+    appsettings->setValue(GC_RIDE_MEMORY, rideMemory->value());
+
     // Directories
     appsettings->setValue(GC_HOMEDIR, athleteDirectory->text());
 #ifdef GC_WANT_R
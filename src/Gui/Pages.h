@@ -117,6 +117,7 @@ class GeneralPage : public QWidget
 #endif
         QCheckBox *opendata;
         QSpinBox *garminHWMarkedit;
+        QSpinBox *rideMemory;
         QDoubleSpinBox *hystedit;
         QLineEdit *athleteDirectory;
 
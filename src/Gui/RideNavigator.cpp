@@ -1042,8 +1042,8 @@ RideNavigator::selectionChanged(QItemSelection selected)
        }
     }
 
-    // lets notify others
-    context->athlete->selectRideFile(filename);
+    // lets notify others, once it has been read
+    context->athlete->selectRideFile(filename, true);
 
 }
 
@@ -1726,6 +1726,14 @@ bool
 RideNavigatorSortProxyModel::lessThan
 (const QModelIndex &left, const QModelIndex &right) const
 {
+    // activities are ranked once per column by the cache model, which
+    // knows their values without formatting them
+    QVariant leftRank = sourceModel()->data(left, RideCacheModel::RankRole);
+    QVariant rightRank = sourceModel()->data(right, RideCacheModel::RankRole);
+    if (leftRank.isValid() && rightRank.isValid()) {
+        return leftRank.toInt() < rightRank.toInt();
+    }
+
     QVariant leftData = sourceModel()->data(left);
     QVariant rightData = sourceModel()->data(right);
 
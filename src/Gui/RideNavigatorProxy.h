@@ -38,6 +38,7 @@
 
 #include <QtGui>
 #include "RideNavigator.h"
+#include "RideCacheModel.h"
 #include "RideItem.h"
 #include "RideFile.h"
 
@@ -82,7 +83,7 @@ private:
 
     QMap<QString, QVector<int>*> groupToSourceRow;
     QVector<int> sourceRowToGroupRow;
-    QList<rankx> rankedRows;
+    QVector<int> sourceRowToGroup;      // bucket, index into groups
 
     int countResetInProgress = 0;
 
@@ -109,7 +110,7 @@ private:
         groupIndexes.clear();
         groupToSourceRow.clear();
         sourceRowToGroupRow.clear();
-        rankedRows.clear();
+        sourceRowToGroup.clear();
     }
 
     static bool initGroupRanges();
@@ -234,17 +235,14 @@ public:
     QModelIndex mapFromSource(const QModelIndex &sourceIndex) const {
 
         // which group did we put this row into?
-        QString group = whichGroup(sourceIndex.row());
-        int groupNo = groups.indexOf(group);
+        int groupNo = sourceRowToGroup.value(sourceIndex.row(), -1);
 
-        if (groupNo < 0) {
+        if (groupNo < 0 || groupNo >= groupIndexes.count() || sourceIndex.row() >= sourceRowToGroupRow.size()) {
             return QModelIndex();
         } else {
-            QModelIndex *p = new QModelIndex(createIndex(groupNo, 0, (void*)NULL));
-            if (sourceIndex.row() > 0 && sourceIndex.row() < sourceRowToGroupRow.size())
-                return createIndex(sourceRowToGroupRow[sourceIndex.row()], sourceIndex.column()+2, &p); // accommodate virtual columns
-            else
-                return QModelIndex();
+            // parent encoded as in index()
+            return createIndex(sourceRowToGroupRow[sourceIndex.row()], sourceIndex.column()+2, // accommodate virtual columns
+                               (void*)&groupIndexes[groupNo]);
         }
     }
 
@@ -448,8 +446,16 @@ public:
                 returning = (proxyIndex.internalPointer() == nullptr);
             } else {
 
+                // column 1 = ride_time, sorts on ride_date
+                if (proxyIndex.column() == 1 && proxyIndex.internalPointer() &&
+                    (role == RideCacheModel::SortRole || role == RideCacheModel::RankRole)) {
+
+                    int groupNo = ((QModelIndex*)proxyIndex.internalPointer())->row();
+                    if (groupNo >= 0 && groupNo < groups.count())
+                        returning = sourceModel()->data(sourceModel()->index(groupToSourceRow.value(groups[groupNo])->at(proxyIndex.row()), dateColumn), role);
+
                 // column 1 = ride_time we have to use ride_date
-                if (proxyIndex.column() == 1 && proxyIndex.internalPointer())  {
+                } else if (proxyIndex.column() == 1 && proxyIndex.internalPointer())  {
                     QString date;
 
                     // hideous code, sorry
@@ -466,7 +472,8 @@ public:
                     returning = sourceModel()->data(mapToSource(proxyIndex), role);
 
                     // -255 temperature means not present
-                    if (mapToSource(proxyIndex).column() == tempIndex && returning.toDouble() == RideFile::NA) {
+                    if (role != RideCacheModel::SortRole && role != RideCacheModel::RankRole &&
+                        mapToSource(proxyIndex).column() == tempIndex && returning.toDouble() == RideFile::NA) {
                          returning = "";
                     }
                 }
@@ -581,13 +588,9 @@ public:
 
     QString whichGroup(int row) const {
 
-        if (row < 0 || row >= rankedRows.count()) return ("");
-        if (groupBy == -1) return tr("All Activities");
-        else return groupFromValue(headerData(groupBy+2, // accommodate virtual column
-                                    Qt::Horizontal).toString(),
-                                    sourceModel()->data(sourceModel()->index(row,groupBy)).toString(),
-                                    rankedRows[row].value, rankedRows.count());
-
+        int groupNo = sourceRowToGroup.value(row, -1);
+        if (groupNo < 0 || groupNo >= groups.count()) return ("");
+        return groups[groupNo];
     }
 
     // implemented in RideNavigator.cpp, to avoid developers
@@ -607,12 +610,20 @@ public:
         // wipe whatever is there first
         clearGroups();
 
+        const int count = sourceModel()->rowCount(QModelIndex());
+        QVector<QString> rowGroup(count);
+
         if (groupBy >= 0) {
 
-            // rank all the values
-            for (int i=0; i<sourceModel()->rowCount(QModelIndex()); i++) {
+            // fetch each value once, and rank them all
+            QVector<QString> values(count);
+            QList<rankx> rankedRows;
+            for (int i=0; i<count; i++) {
+                QVariant value = sourceModel()->data(sourceModel()->index(i,groupBy));
+                values[i] = value.toString();
+
                 rankx rank;
-                rank.value = sourceModel()->data(sourceModel()->index(i,groupBy)).toDouble();
+                rank.value = value.toDouble();
                 rank.row = i;
                 rankedRows << rank;
             }
@@ -626,12 +637,13 @@ public:
             // sort by row again
             std::stable_sort(rankedRows.begin(), rankedRows.end(), rankx::sortByRow);
 
-
             // create a QMap from 'group' string to list of rows in that group
-            for (int i=0; i<sourceModel()->rowCount(QModelIndex()); i++) {
+            QString heading = headerData(groupBy+2, Qt::Horizontal).toString(); // accommodate virtual column
+            for (int i=0; i<count; i++) {
 
                 // which group are we in?
-                QString value = whichGroup(i); // uses rankedRows
+                QString value = groupFromValue(heading, values[i], rankedRows[i].value, count);
+                rowGroup[i] = value;
 
                 QVector<int> *rows;
                 if ((rows=groupToSourceRow.value(value,NULL)) == NULL) {
@@ -652,9 +664,10 @@ public:
 
             // Just one group by 'All Activities'
             QVector<int> *rows = new QVector<int>;
-            for (int i=0; i<sourceModel()->rowCount(QModelIndex()); i++) {
+            for (int i=0; i<count; i++) {
                 rows->append(i);
                 sourceRowToGroupRow.append(i);
+                rowGroup[i] = "All Activities";
             }
             groupToSourceRow.insert("All Activities", rows);
 
@@ -662,13 +675,19 @@ public:
 
         // Update list of groups
         int group=0;
+        QHash<QString, int> groupNo;
         QMapIterator<QString, QVector<int>*> j(groupToSourceRow);
         while (j.hasNext()) {
             j.next();
+            groupNo.insert(j.key(), group);
             groups << j.key();
             groupIndexes << createIndex(group++,0,(void*)NULL);
         }
 
+        // and the bucket each row went into
+        sourceRowToGroup.resize(count);
+        for (int i=0; i<count; i++) sourceRowToGroup[i] = groupNo.value(rowGroup[i], -1);
+
         // all done. let the views know everything changed
         myEndResetModel();
     }
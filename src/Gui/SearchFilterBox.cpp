@@ -61,46 +61,15 @@ SearchFilterBox::SearchFilterBox(QWidget *parent, Context *context, bool nochoos
 QStringList 
 SearchFilterBox::matches(Context *context, QString filter)
 {
-    QStringList returning;
-    SearchBox::SearchBoxMode mode = SearchBox::Search;
-    QString spec;
-
-    // what kind of matching are we going to perform ?
-    if (filter.startsWith("search:")) {
-        mode = SearchBox::Search;
-        spec = (filter.mid(7, filter.length()-7));
-    } else if (filter.startsWith("filter")) {
-        mode = SearchBox::Filter;
-        spec = (filter.mid(7, filter.length()-7));
-    } else {
-        // whatever we were passed
-        spec = filter;
-    }
-
-    // no spec/filter just return all
-    if (spec == "") {
-        foreach(RideItem *item, context->athlete->rideCache->rides()) returning << item->fileName;
-        return returning;
-    }
-
-    // search or filter then.......
-    if (mode == SearchBox::Filter) {
-
-        DataFilter df(NULL, context, spec);
-        foreach(RideItem *item, context->athlete->rideCache->rides()) {
-            Result res = df.evaluate(item, NULL);
-            if (res.isNumber && res.number())
-                returning << item->fileName;
-        }
-    }
-
-    if (mode == SearchBox::Search) {
-
-        FreeSearch fs;
-        returning = fs.search(context, spec);
-    }
+    return filterMatches(context, filter).toStringList();
+}
 
-    return returning;
+// and as a bit for each ride, evaluated once until the rides change,
+// see FilterCache
+FilterMatches
+SearchFilterBox::filterMatches(Context *context, QString filter)
+{
+    return context->athlete->rideCache->filterCache()->matches(filter);
 }
 
 bool 
@@ -21,6 +21,7 @@
 
 #include "Context.h"
 #include "SearchBox.h" // for searchboxmode
+#include "FilterCache.h"
 
 class FreeSearch;
 class DataFilter;
@@ -50,6 +51,7 @@ public:
     int xwidth() const { return width(); }
 
     static QStringList matches(Context *context, QString filter); // get matches
+    static FilterMatches filterMatches(Context *context, QString filter); // as above, shared from the cache
     static bool isNull(QString filter); // is the filter null ?
 
 private slots:
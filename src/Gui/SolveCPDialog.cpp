@@ -32,6 +32,7 @@
 #include <QSplitter>
 #include <QFont>
 #include <QFontMetrics>
+#include <QThread>
 
 SolveCPDialog::SolveCPDialog(QWidget *parent, Context *context) : QDialog(parent), context(context)
 {
@@ -46,6 +47,7 @@ SolveCPDialog::SolveCPDialog(QWidget *parent, Context *context) : QDialog(parent
     // Widget creation
     //
     solver = new CPSolver(context);
+    solver->setChains(QThread::idealThreadCount());
 
     QFont bolden;
     bolden.setWeight(QFont::Bold);
@@ -760,6 +760,9 @@ SplitConfirm::createRideFile(long start, long stop)
     RideFile *returning = new RideFile; // target
     RideFile *ride = wizard->rideItem->ride(); // source
 
+    // derived slope and core temperature are copied across below
+    ride->derive(RideFile::DeriveSlope | RideFile::DeriveCoreTemp);
+
     // set offset in seconds, make sure in bounds too
     double offset = 0;
     double distanceoffset = 0;
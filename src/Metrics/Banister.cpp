@@ -52,6 +52,8 @@
 #include <QMutex>
 #include <QApplication>
 #include "lmcurve.h"
+#include "BanisterSolver.h"
+#include <QtConcurrent>
 
 // the mean athlete from opendata analysis
 const double typical_CP = 261,
@@ -104,7 +106,8 @@ const int typical_SeasonSize = 700; // a good couple of years needed
 //
 //
 Banister::Banister(Context *context, QString symbol, QString perf_symbol, double t1, double t2, double k1, double k2) :
-    symbol(symbol), perf_symbol(perf_symbol), k1(k1), k2(k2), t1(t1), t2(t2), days(0), context(context), isstale(true)
+    symbol(symbol), perf_symbol(perf_symbol), k1(k1), k2(k2), t1(t1), t2(t2), days(0), context(context), isstale(true),
+    decayfitted(false), fittedt1(0), fittedt2(0)
 {
     // when they all change we are ready to invalidate and refresh
     // don't worry about upstream events, this is what we are dependant on
@@ -203,8 +206,11 @@ Banister::init()
     rides = 0;
     meanscore = 0;
     days = 0;
+    performances = 0;
     data.resize(0);
     windows.clear();
+    decayfitted = false;
+    fittedt1 = fittedt2 = 0;
 
     // default values
     k1=0.2;
@@ -514,10 +520,46 @@ void Banister::setDecay(double one, double two)
     fit();
 
 }
+// the windows and tests as a BanisterSolver sees them
+BanisterSolver
+Banister::solver() const
+{
+    QVector<double> load(data.count());
+    for (int i=0; i<data.count(); i++) load[i] = data[i].score;
+
+    BanisterSolver returning(load, performanceDay.mid(0, performances), performanceScore.mid(0, performances));
+    foreach(const banisterFit &window, windows)
+        returning.addWindow(window.startIndex, window.stopIndex, window.testoffset, window.tests);
+    return returning;
+}
+
 void Banister::fit()
 {
+    // with t1/t2 fixed the fit is linear so solve it directly, all the
+    // windows at once, they only read the load and tests
+    BanisterSolver solve = solver();
+    QVector<BanisterSolver::Fit> fits(windows.length());
+    QVector<int> index(windows.length());
+    for (int i=0; i<index.count(); i++) index[i] = i;
+    QtConcurrent::blockingMap(index, [&](int i) { fits[i] = solve.fit(i, t1, t2); });
+
     for(int i=0; i<windows.length(); i++) {
 
+        // solved, just need to compute the curves, in order as they overlap
+        if (fits[i].ok) {
+            windows[i].k1 = fits[i].k1;
+            windows[i].k2 = fits[i].k2;
+            windows[i].p0 = fits[i].p0;
+            windows[i].t1 = t1;
+            windows[i].t2 = t2;
+            windows[i].compute(windows[i].startIndex, windows[i].stopIndex);
+
+            printd("solved window %d start=%s %d tests [k1=%g k2=%g p0=%g] sse %g\n", i, windows[i].startDate.toString().toStdString().c_str(),
+                   fits[i].n, fits[i].k1, fits[i].k2, fits[i].p0, fits[i].sse);
+            continue;
+        }
+
+        // too few tests to solve for all three, iterate from the priors as before
         double prior[3]={ k1, k2, performanceScore[windows[i].testoffset] };
 
         lm_control_struct control = lm_control_double;
@@ -555,6 +597,28 @@ void Banister::fit()
 #endif
 }
 
+bool
+Banister::fitDecay(double &one, double &two)
+{
+    if (isstale) refresh();
+
+    // search once, until the data changes
+    if (!decayfitted) {
+        decayfitted = true;
+        fittedt1 = fittedt2 = 0;
+
+        double a, b;
+        if (solver().search(a, b)) {
+            fittedt1 = a;
+            fittedt2 = b;
+        }
+    }
+
+    one = fittedt1;
+    two = fittedt2;
+    return fittedt1 > 0;
+}
+
 //
 // Convert power-duration of test, interval, ride to a percentage comparison
 // to the mean athlete from opendata (100% would be a mean effort, whilst a
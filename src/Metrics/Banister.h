@@ -37,6 +37,7 @@ extern double powerIndex(double averagepower, double duration, QString sport="Bi
 // gap with no training that constitutes break in seasons
 extern const int typical_SeasonBreak;
 
+class BanisterSolver;
 class banisterData{
 public:
     banisterData() : score(0), g(0), h(0), nte(0), pte(0), perf(0), test(0) {}
@@ -83,6 +84,10 @@ public:
     QDate getPeakPerf(QDate from, QDate to, double &perf, int &CP);
     double RMSE(QDate from, QDate to, int &n); // only look at it for a date range
 
+    // best fitting t1/t2 for the athlete's tests, searched for across all
+    // the windows, the model itself still uses t1/t2 (see setDecay)
+    bool fitDecay(double &t1, double &t2);
+
     // model parameters - initial 'priors' to use
     QString symbol;         // load metric
     QString perf_symbol;    // performance metric
@@ -119,8 +124,13 @@ public slots:
     void fit();         // perform fits along windows
 
 private:
+    BanisterSolver solver() const;
+
     Context *context;
     bool isstale;
 
+    bool decayfitted;
+    double fittedt1, fittedt2;
+
 };
 #endif
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "BanisterSolver.h"
+
+#include <QtConcurrent>
+#include <cmath>
+#include <limits>
+
+BanisterSolver::BanisterSolver(const QVector<double> &load, const QVector<double> &testDay, const QVector<double> &testScore) :
+    load(load), testDay(testDay), testScore(testScore)
+{
+}
+
+void
+BanisterSolver::addWindow(long start, long stop, int offset, int count)
+{
+    Window add;
+    add.start = start;
+    add.stop = qMin(stop, long(load.count()));
+    for (int i=offset; i>=0 && i<offset+count && i<testDay.count() && i<testScore.count(); i++) {
+        long day = long(testDay[i]);
+        if (day < add.start || day >= add.stop) continue;
+        add.days << day;
+        add.scores << testScore[i];
+    }
+    windows_ << add;
+}
+
+void
+BanisterSolver::response(int window, double t, QVector<double> &returning) const
+{
+    const Window &w = windows_[window];
+    const int n = w.days.count();
+    returning.resize(n);
+
+    const double decay = exp(-1/t);
+    double g = 0;
+    int k = 0;
+    for (long d=w.start; d<w.stop && k<n; d++) {
+        g = (d == w.start) ? 0 : g * decay + load[d];
+        while (k < n && w.days[k] == d) returning[k++] = g;
+    }
+}
+
+BanisterSolver::Fit
+BanisterSolver::solve(const double *g, const double *h, const double *perf, int n)
+{
+    Fit returning;
+    returning.n = n;
+    if (n < 3) return returning;
+
+    // normal equations for x = (p0, k1, k2) with columns 1, g, -h
+    double a[3][4] = {{0}};
+    for (int i=0; i<n; i++) {
+        const double c[3] = { 1, g[i], -h[i] };
+        for (int r=0; r<3; r++) {
+            for (int s=0; s<3; s++) a[r][s] += c[r] * c[s];
+            a[r][3] += c[r] * perf[i];
+        }
+    }
+
+    // gaussian elimination with partial pivoting, tolerance relative
+    // to the scale of the problem so nearly identical g and h fail
+    double scale = 0;
+    for (int r=0; r<3; r++) scale = qMax(scale, fabs(a[r][r]));
+    const double tiny = scale * 1e-12;
+
+    for (int col=0; col<3; col++) {
+        int pivot = col;
+        for (int r=col+1; r<3; r++) if (fabs(a[r][col]) > fabs(a[pivot][col])) pivot = r;
+        if (fabs(a[pivot][col]) <= tiny) return returning;
+        if (pivot != col) for (int s=0; s<4; s++) std::swap(a[col][s], a[pivot][s]);
+
+        for (int r=col+1; r<3; r++) {
+            double f = a[r][col] / a[col][col];
+            for (int s=col; s<4; s++) a[r][s] -= f * a[col][s];
+        }
+    }
+    double x[3];
+    for (int r=2; r>=0; r--) {
+        double v = a[r][3];
+        for (int s=r+1; s<3; s++) v -= a[r][s] * x[s];
+        x[r] = v / a[r][r];
+    }
+
+    returning.ok = true;
+    returning.p0 = x[0];
+    returning.k1 = x[1];
+    returning.k2 = x[2];
+    for (int i=0; i<n; i++) {
+        double e = x[0] + x[1] * g[i] - x[2] * h[i] - perf[i];
+        returning.sse += e * e;
+    }
+    return returning;
+}
+
+BanisterSolver::Fit
+BanisterSolver::fit(int window, double t1, double t2) const
+{
+    QVector<double> g, h;
+    response(window, t1, g);
+    response(window, t2, h);
+    return solve(g.constData(), h.constData(), windows_[window].scores.constData(), g.count());
+}
+
+double
+BanisterSolver::sse(double t1, double t2, int &n) const
+{
+    double returning = 0;
+    n = 0;
+    for (int w=0; w<windows_.count(); w++) {
+        Fit f = fit(w, t1, t2);
+        if (!f.ok) continue;
+        returning += f.sse;
+        n += f.n;
+    }
+    return returning;
+}
+
+bool
+BanisterSolver::search(double &t1, double &t2, double min, double max, double step) const
+{
+    if (step <= 0 || max <= min) return false;
+
+    // the response for each decay on the grid, each window, worked out
+    // once and shared by all the pairs that use it
+    const int grid = int((max - min) / step) + 1;
+    QVector<QVector<QVector<double> > > responses(grid);
+    QVector<int> decays(grid);
+    for (int j=0; j<grid; j++) decays[j] = j;
+    QtConcurrent::blockingMap(decays, [&](int j) {
+        responses[j].resize(windows_.count());
+        for (int w=0; w<windows_.count(); w++) response(w, min + j * step, responses[j][w]);
+    });
+
+    // fitness lasts longer than fatigue, t1 > t2 also keeps g and h apart
+    struct Pair { int a, b; double sse; int n; };
+    QVector<Pair> pairs;
+    for (int a=1; a<grid; a++)
+        for (int b=0; b<a; b++) {
+            Pair add = { a, b, 0, 0 };
+            pairs << add;
+        }
+    QtConcurrent::blockingMap(pairs, [&](Pair &p) {
+        for (int w=0; w<windows_.count(); w++) {
+            const QVector<double> &g = responses[p.a][w], &h = responses[p.b][w];
+            Fit f = solve(g.constData(), h.constData(), windows_[w].scores.constData(), g.count());
+            if (!f.ok) continue;
+            p.sse += f.sse;
+            p.n += f.n;
+        }
+    });
+
+    // compare pairs fitting the same tests, the most that can be
+    int most = 0;
+    foreach(const Pair &p, pairs) most = qMax(most, p.n);
+    if (most == 0) return false;
+
+    int best = -1;
+    for (int i=0; i<pairs.count(); i++)
+        if (pairs[i].n == most && (best < 0 || pairs[i].sse < pairs[best].sse)) best = i;
+
+    t1 = min + pairs[best].a * step;
+    t2 = min + pairs[best].b * step;
+
+    // refine each in turn between its neighbours on the grid, golden section
+    auto cost = [&](double one, double two) {
+        int n;
+        double e = sse(one, two, n);
+        return (n == most && one > two) ? e : std::numeric_limits<double>::max();
+    };
+    auto along = [&](int which, double value) {
+        return which ? cost(t1, value) : cost(value, t2);
+    };
+    const double phi = (sqrt(5.0) - 1) / 2;
+    for (int round=0; round<3; round++) {
+        for (int which=0; which<2; which++) {
+            double &t = which ? t2 : t1;
+            double lo = qMax(min, t - step), hi = qMin(max, t + step);
+            double c = hi - phi * (hi - lo), d = lo + phi * (hi - lo);
+            double fc = along(which, c), fd = along(which, d);
+            for (int i=0; i<20; i++) {
+                if (fc < fd) { hi = d; d = c; fd = fc; c = hi - phi * (hi - lo); fc = along(which, c); }
+                else { lo = c; c = d; fc = fd; d = lo + phi * (hi - lo); fd = along(which, d); }
+            }
+            if (qMin(fc, fd) < along(which, t)) t = fc < fd ? c : d;
+        }
+    }
+    return true;
+}
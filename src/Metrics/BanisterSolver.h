@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _GC_BanisterSolver_h
+#define _GC_BanisterSolver_h 1
+
+#include <QVector>
+
+//
+// Fitting the Banister model to performance tests.
+//
+// In each fitting window perf = p0 + k1.g - k2.h, where g and h are the
+// daily load accumulated with decays t1 and t2 (starting from zero on the
+// first day of the window, as banisterFit::compute does). With t1 and t2
+// fixed g and h don't depend on k1, k2 or p0 so the fit is just linear
+// least squares, solved here exactly rather than iterating with lmcurve.
+//
+// That makes it cheap enough to search for t1 and t2 too; the load
+// response for each decay on the grid is worked out once and shared by
+// every (t1, t2) pair that uses it, and the pairs are fitted in parallel.
+//
+class BanisterSolver
+{
+    public:
+
+        // daily load from day 0, and the test days (ascending) and scores
+        BanisterSolver(const QVector<double> &load, const QVector<double> &testDay, const QVector<double> &testScore);
+
+        // a fitting window of days [start, stop) using tests offset..offset+count-1,
+        // tests outside the days are left out as the model isn't computed there
+        void addWindow(long start, long stop, int offset, int count);
+        int windows() const { return windows_.count(); }
+
+        struct Fit {
+            Fit() : ok(false), k1(0), k2(0), p0(0), sse(0), n(0) {}
+            bool ok;            // false if there are too few tests, or they can't separate g and h
+            double k1, k2, p0;
+            double sse;         // sum of squared errors
+            int n;              // tests used
+        };
+
+        // closed form fit of one window for fixed decays
+        Fit fit(int window, double t1, double t2) const;
+
+        // sum of squared errors over all the windows that can be fitted,
+        // with n set to the tests used
+        double sse(double t1, double t2, int &n) const;
+
+        // best t1 > t2 from a grid over [min, max], refined by a coordinate
+        // search between grid points, false if nothing can be fitted
+        bool search(double &t1, double &t2, double min = 1, double max = 100, double step = 1) const;
+
+        // least squares for perf = p0 + k1.g - k2.h
+        static Fit solve(const double *g, const double *h, const double *perf, int n);
+
+    private:
+
+        // accumulated load at the window's tests for decay t
+        void response(int window, double t, QVector<double> &returning) const;
+
+        struct Window {
+            long start, stop;
+            QVector<long> days;
+            QVector<double> scores;
+        };
+
+        QVector<double> load;
+        QVector<double> testDay, testScore;
+        QVector<Window> windows_;
+};
+
+#endif
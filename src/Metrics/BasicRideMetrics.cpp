@@ -25,6 +25,7 @@
 #include "LTMOutliers.h"
 #include "Units.h"
 #include "Zones.h"
+#include "RidePrefix.h"
 #include "cmath"
 #include <assert.h>
 #include <algorithm>
@@ -995,6 +996,14 @@ class TotalWork : public RideMetric {
 
         joules = 0;
 
+        // from the ride's running totals when refreshing its intervals
+        int first, last;
+        if (spec.prefix() && spec.prefix()->range(spec, first, last)) {
+            joules = spec.prefix()->series(RideFile::watts).sum(first, last) * item->ride()->recIntSecs();
+            setValue(joules/1000);
+            return;
+        }
+
         RideFileIterator it(item->ride(), spec);
         while (it.hasNext()) {
             struct RideFilePoint *point = it.next();
@@ -1111,6 +1120,17 @@ struct AvgPower : public RideMetric {
 
         total = count = 0;
     
+        // from the ride's running totals when refreshing its intervals
+        int first, last;
+        if (spec.prefix() && spec.prefix()->range(spec, first, last)) {
+            const PrefixSeries &watts = spec.prefix()->series(RideFile::watts);
+            total = watts.sum(first, last);
+            count = watts.nonNegative(first, last);
+            setValue(count > 0 ? total / count : 0);
+            setCount(count);
+            return;
+        }
+
         RideFileIterator it(item->ride(), spec);
         while (it.hasNext()) {
             struct RideFilePoint *point = it.next();
@@ -1279,6 +1299,7 @@ struct AAvgPower : public RideMetric {
 
         total = count = 0;
 
+        item->ride()->deriveSeries(RideFile::aPower);
         RideFileIterator it(item->ride(), spec);
         while (it.hasNext()) {
             struct RideFilePoint *point = it.next();
@@ -1333,6 +1354,17 @@ struct NonZeroPower : public RideMetric {
 
         total = count = 0;
 
+        // from the ride's running totals when refreshing its intervals
+        int first, last;
+        if (spec.prefix() && spec.prefix()->range(spec, first, last)) {
+            const PrefixSeries &watts = spec.prefix()->series(RideFile::watts);
+            total = watts.sum(first, last);
+            count = watts.positive(first, last);
+            setValue(count > 0 ? total / count : 0);
+            setCount(count);
+            return;
+        }
+
         RideFileIterator it(item->ride(), spec);
         while (it.hasNext()) {
             struct RideFilePoint *point = it.next();
@@ -1387,6 +1419,18 @@ struct AvgHeartRate : public RideMetric {
         }
 
         total = count = 0;
+
+        // from the ride's running totals when refreshing its intervals
+        int first, last;
+        if (spec.prefix() && spec.prefix()->range(spec, first, last)) {
+            const PrefixSeries &hr = spec.prefix()->series(RideFile::hr);
+            total = hr.sum(first, last);
+            count = hr.positive(first, last);
+            setValue(count > 0 ? total / count : 0);
+            setCount(count);
+            return;
+        }
+
         RideFileIterator it(item->ride(), spec);
         while (it.hasNext()) {
             struct RideFilePoint *point = it.next();
@@ -1442,6 +1486,7 @@ struct AvgCoreTemp : public RideMetric {
 
         total = count = 0;
 
+        item->ride()->deriveSeries(RideFile::tcore);
         RideFileIterator it(item->ride(), spec);
         while (it.hasNext()) {
             struct RideFilePoint *point = it.next();
@@ -1796,6 +1841,17 @@ struct AvgCadence : public RideMetric {
 
         total = count = 0;
 
+        // from the ride's running totals when refreshing its intervals
+        int first, last;
+        if (spec.prefix() && spec.prefix()->range(spec, first, last)) {
+            const PrefixSeries &cad = spec.prefix()->series(RideFile::cad);
+            total = cad.sum(first, last);
+            count = cad.positive(first, last);
+            setValue(count > 0 ? total / count : count);
+            setCount(count);
+            return;
+        }
+
         RideFileIterator it(item->ride(), spec);
         while (it.hasNext()) {
             struct RideFilePoint *point = it.next();
@@ -1915,6 +1971,13 @@ class MaxPower : public RideMetric {
             return;
         }
 
+        // from the ride's running totals when refreshing its intervals
+        int first, last;
+        if (spec.prefix() && spec.prefix()->range(spec, first, last)) {
+            setValue(qMax(max, spec.prefix()->series(RideFile::watts).max(first, last)));
+            return;
+        }
+
         RideFileIterator it(item->ride(), spec);
         while (it.hasNext()) {
             struct RideFilePoint *point = it.next();
@@ -2156,6 +2219,13 @@ class MaxHr : public RideMetric {
             return;
         }
 
+        // from the ride's running totals when refreshing its intervals
+        int first, last;
+        if (spec.prefix() && spec.prefix()->range(spec, first, last)) {
+            setValue(qMax(max, spec.prefix()->series(RideFile::hr).max(first, last)));
+            return;
+        }
+
         RideFileIterator it(item->ride(), spec);
         while (it.hasNext()) {
             struct RideFilePoint *point = it.next();
@@ -2207,6 +2277,13 @@ class MinHr : public RideMetric {
         bool notset = true;
         min = 0;
 
+        // from the ride's running totals when refreshing its intervals
+        int first, last;
+        if (spec.prefix() && spec.prefix()->range(spec, first, last)) {
+            setValue(spec.prefix()->series(RideFile::hr).minPositive(first, last));
+            return;
+        }
+
         RideFileIterator it(item->ride(), spec);
         while (it.hasNext()) {
             struct RideFilePoint *point = it.next();
@@ -2259,6 +2336,7 @@ class MaxCT : public RideMetric {
             return;
         }
 
+        item->ride()->deriveSeries(RideFile::tcore);
         RideFileIterator it(item->ride(), spec);
         while (it.hasNext()) {
             struct RideFilePoint *point = it.next();
@@ -2363,6 +2441,13 @@ class MaxCadence : public RideMetric {
 
         double max = 0.0;
 
+        // from the ride's running totals when refreshing its intervals
+        int first, last;
+        if (spec.prefix() && spec.prefix()->range(spec, first, last)) {
+            setValue(qMax(max, spec.prefix()->series(RideFile::cad).max(first, last)));
+            return;
+        }
+
         RideFileIterator it(item->ride(), spec);
         while (it.hasNext()) {
             struct RideFilePoint *point = it.next();
@@ -25,6 +25,7 @@
 #include "RideItem.h"
 #include "RideFile.h"
 #include "WPrime.h"
+#include "CPSolverKernel.h"
 
 #include <QList>
 #include <QVector>
@@ -32,38 +33,6 @@
 
 class Context;
 
-// W'bal parameters passed around as a set
-class WBParms {
-public:
-    WBParms() : CP(0), W(0), TAU(0) {}
-    WBParms(double CP, double W, double TAU) : CP(CP), W(W), TAU(TAU) {}
-    double CP, W, TAU; // the parameters
-    double wpbal; // the result (used to pass back)
-};
-
-class CPSolverConstraints {
-    public:
-    CPSolverConstraints() : cpf(100), cpto(500), wf(5000), wto(50000), tf(300), tto(700) { check(); }
-    CPSolverConstraints(int cpf, int cpto, int wf, int wto, int tf, int tto) :
-    cpf(cpf), cpto(cpto), wf(wf), wto(wto), tf(tf), tto(tto) { check(); }
-    int cpf, cpto, wf, wto, tf, tto;
-    int ccpf, ccpto, cwf, cwto; // configured bounds for selected rides
-
-    void setConfig(int ccpf, int ccpto, int cwf, int cwto) {
-        this->ccpf = ccpf;
-        this->ccpto = ccpto;
-        this->cwf = cwf;
-        this->cwto = cwto;
-    }
-
-    // swap if malformed
-    void check() {
-        if (cpf > cpto) { int t=cpto; cpto=cpf; cpf=t; }
-        if (wf > wto) { int t=wto; wto=wf; wf=t; }
-        if (tf > tto) { int t=tto; tto=tf; tf=t; }
-    }
-};
-
 class CPSolver : public QObject {
 
     Q_OBJECT
@@ -77,16 +46,16 @@ class CPSolver : public QObject {
         // set the data to solve
         void setData(CPSolverConstraints constraints, QList<RideItem*>);
 
+        // annealing chains to run side by side, the best of them wins
+        void setChains(int x) { chains = qMax(1, x); }
+
         // compute the cost, using the settings passed
         double cost(WBParms parms);
 
-        // compute ending W'bal for the exhaustion series
+        // compute ending W'bal for the exhaustion series, second by
+        // second; the reference for the kernel the cost is worked out with
         double compute(QVector<int> &ride, WBParms parms);
 
-        WBParms neighbour(WBParms, int k, int kmax);
-        double probability(double,double,double);
-        double temperature(double);
-
         // get a 1s power array from the data
         QVector<int> power1s(RideFile *f, double secs);
 
@@ -114,8 +83,9 @@ class CPSolver : public QObject {
         QList<QVector<int> > data;
         QList<RideItem*> rides;
 
-        // annealling parms
-        WBParms s0, sbest;
+        // the same data laid out for the cost function
+        WbalKernel kernel;
+        int chains;
 
         // to signal we need to stop
         bool halt;
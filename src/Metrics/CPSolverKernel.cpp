@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "CPSolverKernel.h"
+
+#include <cmath>
+
+void
+WbalKernel::add(const QVector<int> &watts)
+{
+    Series add;
+    add.n = watts.count();
+    add.pad = (BlockSize - add.n % BlockSize) % BlockSize;
+    add.watts.fill(0, add.pad + add.n);
+    for (int i=0; i<add.n; i++) add.watts[add.pad + i] = watts[i];
+
+    const int blocks = add.watts.count() / BlockSize;
+    add.peak.fill(0, blocks);
+    for (int b=0; b<blocks; b++)
+        for (int j=0; j<BlockSize; j++)
+            add.peak[b] = qMax(add.peak[b], add.watts[b * BlockSize + j]);
+
+    series << add;
+}
+
+double
+WbalKernel::integralWpbal(const Series &s, const WBParms &parms, const double *weight, double decay) const
+{
+    const double CP = parms.CP;
+    const int blocks = s.peak.count();
+    const double *watts = s.watts.constData();
+
+    double sum = 0;
+    for (int b=0; b<blocks; b++, watts += BlockSize) {
+
+        // nothing above CP, just decays
+        if (s.peak[b] <= CP) {
+            sum *= decay;
+            continue;
+        }
+
+        // four sums so they don't wait on each other
+        double s0=0, s1=0, s2=0, s3=0;
+        for (int j=0; j<BlockSize; j += 4) {
+            double a0 = watts[j] - CP, a1 = watts[j+1] - CP, a2 = watts[j+2] - CP, a3 = watts[j+3] - CP;
+            s0 += weight[j] * (a0 > 0 ? a0 : 0);
+            s1 += weight[j+1] * (a1 > 0 ? a1 : 0);
+            s2 += weight[j+2] * (a2 > 0 ? a2 : 0);
+            s3 += weight[j+3] * (a3 > 0 ? a3 : 0);
+        }
+        sum = sum * decay + ((s0 + s1) + (s2 + s3));
+    }
+    return parms.W - sum;
+}
+
+double
+WbalKernel::differentialWpbal(const Series &s, const WBParms &parms) const
+{
+    const double *watts = s.watts.constData() + s.pad;
+    const double r = double(parms.TAU)/100.0f;
+
+    double wpbal = parms.W;
+    for (int i=0; i<s.n; i++) {
+        const double w = watts[i];
+        wpbal += w < parms.CP ? (r * (parms.W - wpbal)/parms.W * (parms.CP - w)) : (parms.CP - w);
+    }
+    return wpbal;
+}
+
+double
+WbalKernel::wpbal(int index, const WBParms &parms) const
+{
+    if (!integral) return differentialWpbal(series[index], parms);
+
+    // decay of a second at each position in a block, the last is now
+    double weight[BlockSize];
+    const double r = exp(-1.0 / parms.TAU);
+    weight[BlockSize-1] = 1;
+    for (int j=BlockSize-2; j>=0; j--) weight[j] = weight[j+1] * r;
+    return integralWpbal(series[index], parms, weight, weight[0] * r);
+}
+
+double
+WbalKernel::cost(const WBParms &parms) const
+{
+    if (series.count() == 0) return 0;
+
+    double weight[BlockSize];
+    double decay = 0;
+    if (integral) {
+        const double r = exp(-1.0 / parms.TAU);
+        weight[BlockSize-1] = 1;
+        for (int j=BlockSize-2; j>=0; j--) weight[j] = weight[j+1] * r;
+        decay = weight[0] * r;
+    }
+
+    double sumwb2 = 0;
+    for (int i=0; i<series.count(); i++) {
+        double wb = (integral ? integralWpbal(series[i], parms, weight, decay) : differentialWpbal(series[i], parms)) - 500;
+        sumwb2 += wb * wb;
+    }
+
+    // what we got - normalise to number of fits
+    return (sumwb2/series.count()) /1000.0f;
+}
+
+double
+WbalKernel::reference(const QVector<int> &ride, const WBParms &parms, bool integral)
+{
+    double I=0.00f;
+    int t=0;
+    double wpbal=parms.W;
+    foreach(int watts, ride) {
+
+        if (integral) {
+
+            // INTEGRAL
+            I += exp(((double)(t) / parms.TAU)) * (watts > parms.CP ? watts-parms.CP : 0);
+            wpbal = parms.W - (exp(-((double)(t) / parms.TAU)) * I);
+
+        } else {
+
+            // DIFFERENTIAL
+            wpbal  += watts < parms.CP ? ((double(parms.TAU)/100.0f) * (parms.W - wpbal)/parms.W * (parms.CP - watts) ) : (parms.CP-watts);
+        }
+
+        t++;
+    }
+    return wpbal;
+}
+
+CPSolverChain::CPSolverChain(const WbalKernel *kernel, CPSolverConstraints constraints, unsigned int seed, int kmax) :
+    kernel(kernel), constraints(constraints), rng(seed), k(0), kmax(kmax)
+{
+    // set starting conditions at maximals
+    s.CP =   constraints.cpto;
+    s.W =    constraints.wto;
+    s.TAU =  constraints.tto;
+
+    E = Ebest = kernel->cost(s);
+    sbest = s;
+}
+
+void
+CPSolverChain::run(int n, QVector<Step> *tried)
+{
+    for (int i=0; i<n && k < kmax; i++) {
+
+        WBParms snew = neighbour(s, k, kmax);
+        double Enew = kernel->cost(snew);
+
+        // progress update k=0 means stop so we offset by one
+        if (tried) {
+            Step add = { k+1, snew, Enew };
+            *tried << add;
+        }
+
+        // probability - always 1 if better, but randomly accept higher
+        double r = double(random()%101)/100.00f;
+        double temp = temperature(double(k)/double(kmax));
+        double prob = probability(E,Enew,temp);
+
+        if (prob > r) {
+            s = snew;
+            E = Enew;
+        }
+
+        // is it better than our very best?
+        if (E < Ebest) {
+            Ebest = E;
+            sbest = s;
+        }
+
+        // don't run forever
+        k++;
+    }
+}
+
+// get us a neighbour
+WBParms
+CPSolverChain::neighbour(WBParms p, int k, int kmax)
+{
+    WBParms returning;
+
+    // a crucial aspect of the simulated annealling algorithm is that
+    // we search a wide space for solutions as we start searching, but
+    // as time passes we look in a much smaller range; i.e. we distribute
+    // across the search space up front, but hone in as we get nearer the end
+
+    // wild ass guesses at the beginning down to very closest neighbours
+    // start at 150% and drop down to 1%
+    double factor = (double(kmax - k) / (double(kmax)));
+
+    // range from where we are now from hi to lo
+    // value range (e.g. 400 is range of CP between 100-500)
+    int CPrange = 3 + ((constraints.cpto - constraints.cpf) * factor);
+    int Wrange = 101 + ((constraints.wto - constraints.wf) * factor);
+    int TAUrange = 3 + ((constraints.tto - constraints.tf) * factor);
+    int it=0;
+
+    // scale random() to our range
+    double f = double(Wrange) / double(0x7fffffff);
+
+    do {
+        returning.CP = p.CP + (random()%CPrange - (CPrange/2));
+        returning.W = p.W + (int(double(random())*f)%Wrange - (Wrange/2));
+        returning.TAU = p.TAU + (random()%TAUrange - (TAUrange/2));
+
+    } while (it++ < 3 && (returning.CP < constraints.cpf || returning.CP > constraints.cpto ||
+                          returning.W > constraints.wto || returning.W < constraints.wf ||
+                          returning.TAU < constraints.tf || returning.TAU > constraints.tto));
+
+    // if we failed to randomise just check bounds
+    if (returning.CP > constraints.cpto) returning.CP = constraints.cpto;
+    if (returning.CP < constraints.cpf) returning.CP = constraints.cpf;
+    if (returning.W > constraints.wto) returning.W = constraints.wto;
+    if (returning.W < constraints.wf) returning.W = constraints.wf;
+    if (returning.TAU > constraints.tto) returning.TAU = constraints.tto;
+    if (returning.TAU < constraints.tf) returning.TAU = constraints.tf;
+
+    return returning;
+}
+
+double
+CPSolverChain::temperature(double alpha)
+{
+    return (1.0-(0.02*alpha));
+}
+
+double
+CPSolverChain::probability(double sold, double snew, double temperature)
+{
+    if(snew < sold ) return 1.0;
+    return(exp((sold - snew)/temperature));
+}
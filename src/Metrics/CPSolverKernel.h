@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _GC_CPSolverKernel_h
+#define _GC_CPSolverKernel_h 1
+
+#include <QVector>
+#include <random>
+
+// W'bal parameters passed around as a set
+class WBParms {
+public:
+    WBParms() : CP(0), W(0), TAU(0), wpbal(0) {}
+    WBParms(double CP, double W, double TAU) : CP(CP), W(W), TAU(TAU), wpbal(0) {}
+    double CP, W, TAU; // the parameters
+    double wpbal; // the result (used to pass back)
+};
+
+class CPSolverConstraints {
+    public:
+    CPSolverConstraints() : cpf(100), cpto(500), wf(5000), wto(50000), tf(300), tto(700) { check(); }
+    CPSolverConstraints(int cpf, int cpto, int wf, int wto, int tf, int tto) :
+    cpf(cpf), cpto(cpto), wf(wf), wto(wto), tf(tf), tto(tto) { check(); }
+    int cpf, cpto, wf, wto, tf, tto;
+    int ccpf, ccpto, cwf, cwto; // configured bounds for selected rides
+
+    void setConfig(int ccpf, int ccpto, int cwf, int cwto) {
+        this->ccpf = ccpf;
+        this->ccpto = ccpto;
+        this->cwf = cwf;
+        this->cwto = cwto;
+    }
+
+    // swap if malformed
+    void check() {
+        if (cpf > cpto) { int t=cpto; cpto=cpf; cpf=t; }
+        if (wf > wto) { int t=wto; wto=wf; wf=t; }
+        if (tf > tto) { int t=tto; tto=tf; tf=t; }
+    }
+};
+
+//
+// The CPSolver cost function, W'bal at each point of exhaustion for a set
+// of parameters, over all of the exhaustion series at once.
+//
+// The power leading up to each exhaustion point is kept as doubles in
+// blocks of 64s with the peak power of each block. For the integral model
+// W'bal at the end is W - sum(exp(-(n-1-t)/tau) * max(0, P(t)-CP)), which
+// is worked out a block at a time with a table of the decays rather than
+// the two exp() calls per second of CPSolver::compute, and a block that
+// never goes above CP only decays what came before it.
+//
+// The differential model has no exp() to save and runs second by second
+// over the same data.
+//
+class WbalKernel
+{
+    public:
+
+        static const int BlockSize = 64;
+
+        WbalKernel(bool integral = true) : integral(integral) {}
+
+        void setIntegral(bool x) { integral = x; }
+        bool isIntegral() const { return integral; }
+
+        void clear() { series.clear(); }
+        void add(const QVector<int> &watts);
+        int count() const { return series.count(); }
+
+        // W'bal at the end of one series
+        double wpbal(int index, const WBParms &parms) const;
+
+        // mean (W'bal - 500)^2 / 1000 over all the series, as CPSolver::cost
+        double cost(const WBParms &parms) const;
+
+        // second by second, as CPSolver::compute has always done
+        static double reference(const QVector<int> &watts, const WBParms &parms, bool integral);
+
+    private:
+
+        struct Series {
+            int n;                      // seconds
+            int pad;                    // zeros in front to fill the first block
+            QVector<double> watts;      // pad + n
+            QVector<double> peak;       // per block
+        };
+
+        double integralWpbal(const Series &s, const WBParms &parms, const double *weight, double decay) const;
+        double differentialWpbal(const Series &s, const WBParms &parms) const;
+
+        bool integral;
+        QVector<Series> series;
+};
+
+//
+// One simulated annealing chain, as CPSolver has always run it, with its
+// own random numbers so several can run side by side on different threads.
+//
+class CPSolverChain
+{
+    public:
+
+        struct Step { int k; WBParms parms; double cost; };
+
+        CPSolverChain(const WbalKernel *kernel, CPSolverConstraints constraints, unsigned int seed, int kmax = 100000);
+
+        // run up to n more iterations, the parameters tried are appended to
+        // tried when it isn't null
+        void run(int n, QVector<Step> *tried = NULL);
+
+        bool finished() const { return k >= kmax; }
+        int iteration() const { return k; }
+        WBParms best() const { return sbest; }
+        double bestCost() const { return Ebest; }
+
+        WBParms neighbour(WBParms, int k, int kmax);
+        static double probability(double,double,double);
+        static double temperature(double);
+
+    private:
+
+        int random() { return int(rng() & 0x7fffffff); }
+
+        const WbalKernel *kernel;
+        CPSolverConstraints constraints;
+        std::mt19937 rng;
+
+        int k, kmax;
+        WBParms s, sbest;
+        double E, Ebest;
+};
+
+#endif
@@ -227,6 +227,7 @@ private:
 
         score = 0.0;
 
+        item->ride()->deriveSeries(RideFile::slope);
         RideFileIterator it(item->ride(), spec);
         while (it.hasNext()) {
             struct RideFilePoint *point = it.next();
@@ -116,6 +116,7 @@ class LNP : public RideMetric {
 
             // loop over the data and convert to a rolling
             // average for the given windowsize
+            item->ride()->deriveSeries(RideFile::slope);
             RideFileIterator it(item->ride(), spec);
             while (it.hasNext()) {
                 struct RideFilePoint *point = it.next();
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "RidePrefix.h"
+#include "Specification.h"
+#include "Zones.h"
+
+RidePrefix::RidePrefix(RideFile *ride, const Zones *zones, int zoneRange) :
+    ride(ride), zones(zones), zoneRange(zones ? zoneRange : -1)
+{
+}
+
+bool
+RidePrefix::range(Specification spec, int &first, int &last) const
+{
+    RideFileIterator it(ride, spec);
+    first = it.firstIndex();
+    last = it.lastIndex();
+    return first >= 0 && first <= last;
+}
+
+const PrefixSeries &
+RidePrefix::series(RideFile::SeriesType series) const
+{
+    QMap<int, PrefixSeries>::iterator found = built.find(series);
+    if (found != built.end()) return found.value();
+
+    const int count = ride->dataPoints().count();
+    QVector<double> values(count);
+    for (int i=0; i<count; i++) values[i] = ride->getPointValue(i, series);
+
+    PrefixSeries &add = built[series];
+    add.build(values);
+    return add;
+}
+
+int
+RidePrefix::inZone(int zone, int first, int last) const
+{
+    if (zoneRange < 0 || zones->numZones(zoneRange) <= 0) return 0;
+
+    if (zoneCounts.isEmpty()) {
+        const int count = ride->dataPoints().count();
+        zoneCounts.resize(zones->numZones(zoneRange));
+        for (int z=0; z<zoneCounts.count(); z++) zoneCounts[z].fill(0, count+1);
+
+        for (int i=0; i<count; i++) {
+            int z = zones->whichZone(zoneRange, ride->dataPoints()[i]->watts);
+            for (int j=0; j<zoneCounts.count(); j++)
+                zoneCounts[j][i+1] = zoneCounts[j][i] + (j == z ? 1 : 0);
+        }
+    }
+
+    if (zone < 0 || zone >= zoneCounts.count()) return 0;
+    return zoneCounts[zone][last+1] - zoneCounts[zone][first];
+}
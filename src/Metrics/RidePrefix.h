@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _GC_RidePrefix_h
+#define _GC_RidePrefix_h 1
+#include "GoldenCheetah.h"
+
+#include "RideFile.h"
+#include "PrefixSeries.h"
+
+#include <QMap>
+#include <QVector>
+
+class Zones;
+class Specification;
+
+//
+// Running totals and extremes of a ride's samples so metrics computed for
+// many intervals of the same ride (all the discovered peaks, climbs and
+// efforts) can answer the simple ones without going over the samples again
+// for each one, see Specification::prefix().
+//
+// Only the series and zones actually asked for are built, the first time
+// they are. The ride must not change whilst it is in use, it's meant to
+// last while the intervals are being refreshed.
+//
+class RidePrefix
+{
+    public:
+
+        // zones and range for time in power zone, none if range < 0
+        RidePrefix(RideFile *ride, const Zones *zones = NULL, int zoneRange = -1);
+
+        // the samples a RideFileIterator would visit, false if none
+        bool range(Specification spec, int &first, int &last) const;
+
+        // the series over samples first..last, see PrefixSeries
+        const PrefixSeries &series(RideFile::SeriesType series) const;
+
+        // samples first..last in power zone (from 0)
+        int inZone(int zone, int first, int last) const;
+
+    private:
+
+        RideFile *ride;
+        const Zones *zones;
+        int zoneRange;
+
+        mutable QMap<int, PrefixSeries> built;
+        mutable QVector<QVector<int> > zoneCounts; // running count for each zone
+};
+
+#endif
@@ -427,6 +427,7 @@ struct AvgStrideLength  : public RideMetric {
 
         total = count = 0;
 
+        item->ride()->deriveSeries(RideFile::clength);
         RideFileIterator it(item->ride(), spec);
         while (it.hasNext()) {
             struct RideFilePoint *point = it.next();
@@ -23,6 +23,7 @@
 #include "Athlete.h"
 #include "Specification.h"
 #include "Zones.h"
+#include "RidePrefix.h"
 #include <cmath>
 #include <assert.h>
 #include <QApplication>
@@ -60,6 +61,15 @@ class ZoneTime : public RideMetric {
         double totalSecs = 0.0;
         seconds = 0;
 
+        // from the ride's running totals when refreshing its intervals
+        int first, last;
+        if (spec.prefix() && spec.prefix()->range(spec, first, last)) {
+            seconds = spec.prefix()->inZone(level, first, last) * item->ride()->recIntSecs();
+            setValue(seconds);
+            setCount((last - first + 1) * item->ride()->recIntSecs());
+            return;
+        }
+
         // iterate and compute
         RideFileIterator it(item->ride(), spec);
         while (it.hasNext()) {
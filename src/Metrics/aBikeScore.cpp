@@ -65,6 +65,7 @@ class aXPower : public RideMetric {
             return;
         }
 
+        item->ride()->deriveSeries(RideFile::aPower);
         RideFileIterator it(item->ride(), spec);
 
         static const double EPSILON = 0.1;
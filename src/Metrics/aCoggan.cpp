@@ -70,6 +70,7 @@ class aIsoPower : public RideMetric {
             int index = 0;
             double sum = 0;
 
+            item->ride()->deriveSeries(RideFile::aPower);
             RideFileIterator it(item->ride(), spec);
 
             // loop over the data and convert to a rolling
@@ -396,6 +396,10 @@ void PythonEmbed::runline(ScriptContext scriptContext, QString line)
         PyObject_CallFunction(static_cast<PyObject*>(clear), NULL);
     }
 
+    // the rides it used can be closed again
+    contexts[threadid].pins.clear();
+    contexts[threadid].visiting = RideHandle();
+
     PyGILState_Release(gstate);
     threadid=-1;
 }
@@ -22,9 +22,11 @@
 #include <QWidget>
 #include <QString>
 #include <QMap>
+#include <QHash>
 #include <QStringList>
 
 #include "RideItem.h"
+#include "RideResidency.h"
 #include "Specification.h"
 
 class Context;
@@ -61,6 +63,13 @@ class ScriptContext {
 
         bool readOnly;
         QList<RideFile *> *editedRideFiles;
+
+        // rides the script has used, kept open until it finishes, once
+        // each; those picked by date are only held whilst the script is
+        // on them (or if it edited them) so a season can be walked within
+        // the memory budget
+        QHash<RideItem*, RideHandle> pins;
+        RideHandle visiting;
 };
 
 // a plain C++ class, no QObject stuff
@@ -564,7 +564,7 @@ Bindings::selectRideFile(PyObject *activity, int compareindex) const
     Context *context = python->contexts.value(threadid()).context;
     RideFile *f;
     RideItem* item = fromDateTime(activity);
-    if (item && item->ride()) return item->ride();
+    if (item && pinned(item, true)) return item->ride();
 
     // return compare item when requested
     if (compareindex >= 0 && context && context->isCompareIntervals) {
@@ -578,16 +578,37 @@ Bindings::selectRideFile(PyObject *activity, int compareindex) const
     if (f) return f;
 
     item = python->contexts.value(threadid()).item;
-    if (item && item->ride()) return item->ride();
+    if (item && pinned(item)) return item->ride();
 
     if (context) {
         item = const_cast<RideItem*>(context->currentRideItem());
-        if (item && item->ride()) return item->ride();
+        if (item && pinned(item)) return item->ride();
     }
 
     return nullptr;
 }
 
+RideFile *
+Bindings::pinned(RideItem *item) const
+{
+    // scripts may not run on the GUI thread, so the residency manager
+    // mustn't close what we hand them until they are done with it
+    ScriptContext &here = python->contexts[threadid()];
+    if (!moving) {
+        if (!here.pins.contains(item)) here.pins.insert(item, RideHandle(item));
+
+    } else if (here.visiting.item() != item) {
+
+        // moved on to another ride by date, let the last one go unless
+        // the script has edits pending on it
+        RideFile *was = here.visiting.item() ? here.visiting.ride() : NULL;
+        if (was && here.editedRideFiles && here.editedRideFiles->contains(was))
+            here.pins.insert(here.visiting.item(), here.visiting);
+        here.visiting = RideHandle(item);
+    }
+    return item->ride();
+}
+
 // get the data series for the currently selected ride
 PythonDataSeries*
 Bindings::series(int type, PyObject* activity, int compareindex) const
@@ -608,6 +629,7 @@ Bindings::series(int type, PyObject* activity, int compareindex) const
     }
 
     PythonDataSeries* ds = new PythonDataSeries(seriesName(type), pCount, readOnly, seriesType, f);
+    f->deriveSeries(seriesType);
     it.toFront();
     for(int i=0; i<pCount && it.hasNext(); i++) {
         struct RideFilePoint *point = it.next();
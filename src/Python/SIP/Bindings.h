@@ -136,6 +136,7 @@ class Bindings {
         // find a RideItem by DateTime
         RideItem* fromDateTime(PyObject* activity=NULL) const;
         RideFile *selectRideFile(PyObject *activity = nullptr, int compareindex=-1) const;
+        RideFile *pinned(RideItem *item, bool moving = false) const; // held open whilst the script uses it
 
         // get a dict populated with metrics and metadata
         PyObject* activityMetrics(RideItem* item) const;
@@ -18,6 +18,7 @@
  */
 
 #include <QProgressDialog>
+#include <QThread>
 #include "BT40Controller.h"
 #include "RealtimeData.h"
 
@@ -82,6 +83,7 @@ int
 BT40Controller::start()
 {
     if (localDevice->isValid()) {
+        pipeline.begin();
         discoveryAgent->start();
     }
     return 0;
@@ -110,6 +112,7 @@ BT40Controller::stop()
         delete device;
     }
     devices.clear();
+    pipeline.stop();
     return 0;
 }
 
@@ -139,6 +142,45 @@ bool BT40Controller::doesLoad() { return true; }
 void
 BT40Controller::getRealtimeData(RealtimeData &rtData)
 {
+    // whatever the devices have told us since we were last polled
+    bool vo2 = false;
+    BT40Event event;
+    while (pipeline.next(event)) {
+        const double *v = event.value;
+        switch (event.type) {
+        case BT40Event::Hr: setBPM(v[0]); break;
+        case BT40Event::Watts: setWatts(v[0]); break;
+        case BT40Event::Cadence: setCadence(v[0]); break;
+        case BT40Event::WheelRpm: setWheelRpm(v[0]); break;
+        case BT40Event::Speed: setSpeed(v[0]); break;
+
+        // Convert kurt speed in kph to wheel rpm, using wheelsize (mm)
+        // Just so caller can convert wheel rpm back to kph... anyway...
+        case BT40Event::WheelSpeed: setWheelRpm(v[0] * (1000. / wheelSize) * (1000. / 60.)); break;
+
+        case BT40Event::Ventilation:
+            setRespiratoryFrequency(v[0]);
+            setRespiratoryMinuteVolume(v[1]);
+            setTv(v[2]);
+            break;
+
+        case BT40Event::GasExchange:
+            setVO2_VCO2(v[0], v[1]);
+            setFeO2(v[2]);
+            vo2 = true;
+            break;
+
+        case BT40Event::VO2Data:
+            setVO2_VCO2(v[0], 0);
+            setRespiratoryFrequency(v[1]);
+            setRespiratoryMinuteVolume(v[2]);
+            setFeO2(v[3]);
+            vo2 = true;
+            break;
+        }
+    }
+    if (vo2) emitVO2Data();
+
     rtData = telemetry;
     processRealtimeData(rtData);
 }
@@ -171,7 +213,7 @@ BT40Controller::addDevice(const QBluetoothDeviceInfo &info)
 
         if (deviceAllowed(info))
         {
-            BT40Device* dev = new BT40Device(this, info);
+            BT40Device* dev = new BT40Device(this, info, &pipeline, devices.count());
             devices.append(dev);
 
             // Only connect to device if we really want
@@ -322,6 +364,11 @@ BT40Controller::setWheelRpm(double wrpm) {
 
 void BT40Controller::setLoad(double l)
 {
+  // the devices live on our thread, the realtime engine calls from its own
+  if (QThread::currentThread() != thread()) {
+    QMetaObject::invokeMethod(this, [this, l]() { setLoad(l); }, Qt::QueuedConnection);
+    return;
+  }
   load = l;
   for (auto* dev: devices) {
     dev->setLoad(l);
@@ -330,6 +377,10 @@ void BT40Controller::setLoad(double l)
 
 void BT40Controller::setGradient(double g) 
 {
+  if (QThread::currentThread() != thread()) {
+    QMetaObject::invokeMethod(this, [this, g]() { setGradient(g); }, Qt::QueuedConnection);
+    return;
+  }
   gradient = g;
   for (auto* dev: devices) {
     dev->setGradient(g);
@@ -370,6 +421,10 @@ void BT40Controller::setRollingResistance(double rr)
 
 void BT40Controller::setWindResistance(double wr)
 {
+  if (QThread::currentThread() != thread()) {
+    QMetaObject::invokeMethod(this, [this, wr]() { setWindResistance(wr); }, Qt::QueuedConnection);
+    return;
+  }
   windResistance = wr;
   for (auto* dev: devices) {
     dev->setWindResistance(wr);
@@ -25,6 +25,7 @@
 #include <QBluetoothDeviceDiscoveryAgent>
 #include <QBluetoothDeviceInfo>
 #include "BT40Device.h"
+#include "BT40Decoder.h"
 
 #ifndef _GC_BT40Controller_h
 #define _GC_BT40Controller_h 1
@@ -117,7 +118,8 @@ private:
 private:
     QBluetoothDeviceDiscoveryAgent *discoveryAgent;
     QBluetoothLocalDevice* localDevice;
-    RealtimeData telemetry;
+    RealtimeData telemetry;             // only touched by whoever polls us
+    BT40Pipeline pipeline;              // parses what the devices are telling us
     QList<BT40Device*> devices;
     DeviceConfiguration* localDc;
     QList<DeviceInfo> allowedDevices;
@@ -0,0 +1,431 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "BT40Decoder.h"
+#include "Ftms.h"
+#include "KurtInRide.h"
+#include "KurtSmartControl.h"
+
+#include <QDataStream>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QRegularExpression>
+#include <QStringList>
+#include <QTextStream>
+#include <cstring>
+
+//
+// Notification kinds by name, as used in hex dumps
+//
+static const char *kindNames[BT40Notification::Kinds] = {
+    "unknown", "hr", "power", "csc", "ftms", "vo2vent", "vo2gas", "vo2data", "inride", "smartcontrol"
+};
+
+const char *
+BT40Notification::kindName(int kind)
+{
+    return (kind > 0 && kind < Kinds) ? kindNames[kind] : kindNames[0];
+}
+
+int
+BT40Notification::kindOf(const QString &name)
+{
+    for (int i=1; i<Kinds; i++) if (name == kindNames[i]) return i;
+    return Unknown;
+}
+
+// Bluetooth data is always little endian, and short notifications are
+// padded with zeroes so reading past the end gives 0 as QDataStream did
+static inline quint16 u16(const uchar *p) { return p[0] | (p[1] << 8); }
+static inline quint32 u32(const uchar *p) { return p[0] | (p[1] << 8) | (p[2] << 16) | (quint32(p[3]) << 24); }
+
+static inline int event(BT40Event *out, quint8 device, int type, double a, double b = 0, double c = 0, double d = 0)
+{
+    out->device = device;
+    out->type = type;
+    out->value[0] = a;
+    out->value[1] = b;
+    out->value[2] = c;
+    out->value[3] = d;
+    return 1;
+}
+
+void
+BT40Decoder::reset()
+{
+    prevWheelTime = 0;
+    prevWheelRevs = 0;
+    prevWheelStaleness = true;
+    prevCrankTime = 0;
+    prevCrankRevs = 0;
+    prevCrankStaleness = -1; // indicates prev crank data values aren't measured values
+}
+
+int
+BT40Decoder::decode(const BT40Notification &n, BT40Event *out)
+{
+    const uchar *p = n.data;
+    const quint8 device = n.device;
+    int count = 0;
+
+    switch (n.kind) {
+
+    case BT40Notification::HeartRate:
+        {
+            // HR 16 bit? otherwise 8 bit
+            quint8 flags = p[0];
+            count += event(out, device, BT40Event::Hr, (flags & 0x1) ? u16(p+1) : p[1]);
+        }
+        break;
+
+    case BT40Notification::CyclingPower:
+        {
+            quint16 flags = u16(p);
+            count += event(out, device, BT40Event::Watts, qint16(u16(p+2)));
+            p += 4;
+
+            if (flags & 0x01) p += 1; // power balance present
+            if (flags & 0x04) p += 2; // accumulated torque data present
+
+            // Power sensor uses 1/2048 second time base
+            if (flags & 0x10) { // wheel revolutions data present
+                count += wheelRpm(p, device, 2048, out + count);
+                p += 6;
+            }
+
+            // If this power meter reports crank revolutions, it is
+            // likely a crank-based meter (e.g. Stages)
+            if (flags & 0x20) count += cadence(p, device, out + count); // crank data present
+        }
+        break;
+
+    case BT40Notification::CSC:
+        {
+            quint8 flags = p[0];
+            p += 1;
+
+            // CSC sensor uses 1/1024 second time base
+            if (flags & 0x1) { // Wheel Revolution Data Present
+                count += wheelRpm(p, device, 1024, out + count);
+                p += 6;
+            }
+            if (flags & 0x2) count += cadence(p, device, out + count); // Crank Revolution Data Present
+        }
+        break;
+
+    case BT40Notification::FtmsIndoorBike:
+        {
+            FtmsIndoorBikeData bd;
+            memset(&bd, 0, sizeof(bd));
+            QByteArray value = QByteArray::fromRawData((const char*)n.data, n.size);
+            QDataStream ds(value);
+            ds.setByteOrder(QDataStream::LittleEndian);
+            ftms_parse_indoor_bike_data(ds, bd);
+
+            // Now update values of interest if they were present
+            if (bd.flags & FtmsIndoorBikeFlags::FTMS_INST_POWER_PRESENT)
+                count += event(out + count, device, BT40Event::Watts, bd.inst_power);
+
+            if (bd.flags & FtmsIndoorBikeFlags::FTMS_INST_CADENCE_PRESENT)
+                count += event(out + count, device, BT40Event::Cadence, bd.inst_cadence/2.0f);
+
+            // If "more data" is false, inst speed is present. Convert to km/h by dividing with 100.
+            if (!(bd.flags & FtmsIndoorBikeFlags::FTMS_MORE_DATA))
+                count += event(out + count, device, BT40Event::Speed, bd.inst_speed/100.0f);
+        }
+        break;
+
+    case BT40Notification::VO2Ventilatory:
+        {
+            // Value over BT is rf*100 etc
+            quint16 rf = u16(p), tidal_volume = u16(p+2), rmv = u16(p+4);
+            count += event(out, device, BT40Event::Ventilation, rf/100.0f, rmv/100.0f, tidal_volume/100.0f);
+        }
+        break;
+
+    case BT40Notification::VO2GasExchange:
+        {
+            quint16 feo2 = u16(p), vo2 = u16(p+4), vco2 = u16(p+6);
+
+            // If the value of FeO2 and VO2 for a given row are both exactly 22.0,
+            // said row is a "Ventilation-only row", ignore it to avoid getting
+            // logged rows with zero VO2.
+            if (feo2 == 2200 && vo2 == 22) break;
+            count += event(out, device, BT40Event::GasExchange, vo2, vco2, feo2/100.0f);
+        }
+        break;
+
+    case BT40Notification::VO2Data:
+        {
+            quint16 rf = u16(p), rmv = u16(p+4), feo2 = u16(p+6), vo2 = u16(p+8);
+
+            if (feo2 == 2200 && vo2 == 22) break; // as above
+            count += event(out, device, BT40Event::VO2Data, vo2, rf/100.0f, rmv/100.0f, feo2/100.0f);
+        }
+        break;
+
+    case BT40Notification::InRidePower:
+        {
+            // always 20 bytes, padded if not
+            inride_power_data ipd = inride_process_power_data(p);
+            count += event(out + count, device, BT40Event::Watts, ipd.power);
+            count += event(out + count, device, BT40Event::WheelSpeed, ipd.speedKPH);
+            count += event(out + count, device, BT40Event::Cadence, ipd.cadenceRPM);
+        }
+        break;
+
+    case BT40Notification::SmartControlPower:
+        {
+            smart_control_power_data scpd = smart_control_process_power_data(p, n.size);
+            count += event(out + count, device, BT40Event::Watts, scpd.power);
+            count += event(out + count, device, BT40Event::WheelSpeed, scpd.speedKPH);
+            count += event(out + count, device, BT40Event::Cadence, scpd.cadenceRPM);
+        }
+        break;
+
+    default:
+        break;
+    }
+    return count;
+}
+
+int
+BT40Decoder::cadence(const uchar *p, quint8 device, BT40Event *out)
+{
+    quint16 cur_revs = u16(p);
+    quint16 cur_time = u16(p+2);
+    int count = 0;
+
+    // figure wether to update cadence and with what value
+    //
+    // If we have a new crank event (new time) we push a new RPM, but
+    // only if the previous data is valid (fixes glitch on first
+    // update)
+    //
+    // If we don't have new crank data, push a zero for RPM, unless
+    // previous data is only 1 or 2 notifications old. This lets us
+    // report RPMs lower than 60 (assuming notification period is 1s)
+    // but still report a zero fairly quickly (2 notification periods)
+    if (cur_time != prevCrankTime) {
+
+        if (prevCrankStaleness >= 0) {
+
+            const int time = cur_time + (cur_time < prevCrankTime ? 0x10000:0) - prevCrankTime;
+            const int revs = cur_revs + (cur_revs < prevCrankRevs ? 0x10000:0) - prevCrankRevs;
+            const double rpm = 1024*60*revs / double(time);
+            count += event(out, device, BT40Event::Cadence, rpm);
+        }
+
+    } else if (prevCrankStaleness < 0 || prevCrankStaleness >= 2) {
+        count += event(out, device, BT40Event::Cadence, 0.0);
+    }
+
+    // update the staleness of the previous crank data
+    if (cur_time != prevCrankTime) {
+        prevCrankStaleness = 0;
+    } else if (prevCrankStaleness < 2) {
+        prevCrankStaleness += 1;
+    }
+
+    // update the previous crank data
+    prevCrankRevs = cur_revs;
+    prevCrankTime = cur_time;
+    return count;
+}
+
+int
+BT40Decoder::wheelRpm(const uchar *p, quint8 device, int timebase, BT40Event *out)
+{
+    quint32 wheelrevs = u32(p);
+    quint16 wheeltime = u16(p+4);
+
+    double rpm = 0.0;
+
+    if(!prevWheelStaleness) {
+        quint16 time = wheeltime - prevWheelTime;
+        quint32 revs = wheelrevs - prevWheelRevs;
+        if (time) rpm = timebase*60*revs / double(time);
+    }
+    else prevWheelStaleness = false;
+
+    prevWheelRevs = wheelrevs;
+    prevWheelTime = wheeltime;
+    return event(out, device, BT40Event::WheelRpm, rpm);
+}
+
+//
+// The pipeline
+//
+BT40Pipeline::BT40Pipeline(QObject *parent) : QThread(parent),
+    raw(256), events(1024), stopping(false), droppedCount(0), decodedCount(0), resets(0)
+{
+}
+
+BT40Pipeline::~BT40Pipeline()
+{
+    stop();
+}
+
+void
+BT40Pipeline::begin()
+{
+    if (isRunning()) return;
+    stopping = false;
+    start();
+}
+
+void
+BT40Pipeline::stop()
+{
+    if (!isRunning()) return;
+    stopping = true;
+    pending.release();
+    wait();
+}
+
+bool
+BT40Pipeline::notify(int device, int kind, const QByteArray &value)
+{
+    BT40Notification n;
+    n.device = device % MaxDevices;
+    n.kind = kind;
+    n.size = qMin(value.size(), int(BT40Notification::MaxSize));
+    memcpy(n.data, value.constData(), n.size);
+    memset(n.data + n.size, 0, BT40Notification::MaxSize - n.size);
+
+    if (!raw.push(n)) {
+        droppedCount++;
+        return false;
+    }
+    pending.release();
+    return true;
+}
+
+void
+BT40Pipeline::reset(int device)
+{
+    // the decoders belong to the pipeline thread, it resets them
+    resets.fetch_or(1u << (device % MaxDevices));
+}
+
+void
+BT40Pipeline::run()
+{
+    while (!stopping) {
+
+        // wake when there's something to do, or now and then to check
+        // if we're being stopped
+        pending.tryAcquire(1, 100);
+        drain();
+    }
+    drain();
+}
+
+void
+BT40Pipeline::drain()
+{
+    quint32 reset = resets.exchange(0);
+    for (int i=0; reset; i++, reset >>= 1) if (reset & 1) decoders[i].reset();
+
+    BT40Notification n;
+    BT40Event out[BT40Decoder::MaxEvents];
+    while (raw.pop(n)) {
+        int count = decoders[n.device].decode(n, out);
+        for (int i=0; i<count; i++) {
+            if (!events.push(out[i])) droppedCount++;
+        }
+        decodedCount += count;
+    }
+}
+
+bool
+BT40Pipeline::parseDump(const QString &filename, QVector<BT40Notification> &out, QString &error)
+{
+    QFile file(filename);
+    if (!file.open(QFile::ReadOnly)) {
+        error = QString("can't open %1").arg(filename);
+        return false;
+    }
+
+    QTextStream in(&file);
+    int lineno = 0;
+    while (!in.atEnd()) {
+        QString line = in.readLine().trimmed();
+        lineno++;
+        if (line.isEmpty() || line.startsWith("#")) continue;
+
+        QStringList tokens = line.split(QRegularExpression("\\s+"));
+        int device = 0;
+        if (tokens.count() == 3) device = tokens.takeFirst().toInt();
+        int kind = tokens.count() == 2 ? BT40Notification::kindOf(tokens[0]) : BT40Notification::Unknown;
+        if (kind == BT40Notification::Unknown) {
+            error = QString("%1:%2: expected [device] kind hex").arg(filename).arg(lineno);
+            return false;
+        }
+
+        QByteArray bytes = QByteArray::fromHex(tokens[1].toLatin1());
+        BT40Notification n;
+        n.device = device % MaxDevices;
+        n.kind = kind;
+        n.size = qMin(bytes.size(), int(BT40Notification::MaxSize));
+        memcpy(n.data, bytes.constData(), n.size);
+        memset(n.data + n.size, 0, BT40Notification::MaxSize - n.size);
+        out << n;
+    }
+    return true;
+}
+
+QString
+BT40Pipeline::replay(const QString &filename, int repeat)
+{
+    QVector<BT40Notification> dump;
+    QString error;
+    if (!parseDump(filename, dump, error)) return error;
+    if (dump.isEmpty()) return QString("%1: no notifications").arg(filename);
+
+    // feed them in from here as the Bluetooth thread would, and take the
+    // events off as the controller would when polled
+    BT40Pipeline pipeline;
+    pipeline.begin();
+
+    QElapsedTimer timer;
+    timer.start();
+
+    quint64 sent = 0, received = 0;
+    BT40Event event;
+    for (int r=0; r<repeat; r++) {
+        foreach(const BT40Notification &n, dump) {
+            while (!pipeline.raw.push(n)) {
+                while (pipeline.next(event)) received++;
+                QThread::yieldCurrentThread();
+            }
+            pipeline.pending.release();
+            sent++;
+            while (pipeline.next(event)) received++;
+        }
+    }
+    pipeline.stop();
+    while (pipeline.next(event)) received++;
+
+    double secs = timer.nsecsElapsed() / 1e9;
+    return QString("notifications=%1 events=%2 dropped=%3 took=%4ms notifications/s=%5 events/s=%6")
+           .arg(sent).arg(received).arg(pipeline.dropped())
+           .arg(secs * 1000, 0, 'f', 1)
+           .arg(secs > 0 ? sent / secs : 0, 0, 'f', 0)
+           .arg(secs > 0 ? received / secs : 0, 0, 'f', 0);
+}
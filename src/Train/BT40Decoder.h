@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _GC_BT40Decoder_h
+#define _GC_BT40Decoder_h 1
+
+#include "SpscQueue.h"
+
+#include <QThread>
+#include <QSemaphore>
+#include <QString>
+#include <QVector>
+#include <atomic>
+
+//
+// A characteristic notification as it came off the air, copied so it can be
+// queued without allocating. Kind is worked out from the uuid once by the
+// device so the decoder never compares uuids.
+//
+struct BT40Notification
+{
+    enum { MaxSize = 64 };      // anything longer than this is cut short
+    enum Kind {
+        Unknown = 0,
+        HeartRate, CyclingPower, CSC, FtmsIndoorBike,
+        VO2Ventilatory, VO2GasExchange, VO2Data,
+        InRidePower, SmartControlPower,
+        Kinds
+    };
+
+    quint8 device;              // which of the controller's devices
+    quint8 kind;
+    quint8 size;
+    quint8 data[MaxSize];
+
+    static const char *kindName(int kind);
+    static int kindOf(const QString &name);
+};
+
+//
+// What a notification tells us, as the BT40Controller setters take it
+//
+struct BT40Event
+{
+    enum Type {
+        Hr,                     // bpm
+        Watts,
+        Cadence,                // rpm
+        WheelRpm,
+        Speed,                  // kph
+        WheelSpeed,             // kph at the wheel, as wheel rpm for the controller's wheel size
+        Ventilation,            // rf, rmv, tv
+        GasExchange,            // vo2, vco2, feo2
+        VO2Data                 // vo2, rf, rmv, feo2 (older VM Pro firmware)
+    };
+
+    quint8 device;
+    quint8 type;
+    double value[4];
+};
+
+//
+// Parses the notifications from one device, keeping the crank and wheel
+// counts between them so cadence and wheel speed can be worked out as
+// BT40Device always has.
+//
+class BT40Decoder
+{
+    public:
+
+        enum { MaxEvents = 4 }; // from a single notification
+
+        BT40Decoder() { reset(); }
+        void reset();
+
+        // events into out, returns how many
+        int decode(const BT40Notification &n, BT40Event *out);
+
+    private:
+
+        int cadence(const uchar *p, quint8 device, BT40Event *out);
+        int wheelRpm(const uchar *p, quint8 device, int timebase, BT40Event *out);
+
+        int prevCrankStaleness;
+        quint16 prevCrankTime;
+        quint16 prevCrankRevs;
+        bool prevWheelStaleness;
+        quint16 prevWheelTime;
+        quint32 prevWheelRevs;
+};
+
+//
+// Takes the notifications off the Bluetooth (GUI) thread, parses them on
+// its own thread and queues the events for the controller to take when it
+// is polled. Both queues are single producer, single consumer and lock-free
+// so a busy GUI and the realtime engine never wait on each other; when a
+// queue is full the newest is dropped and counted.
+//
+class BT40Pipeline : public QThread
+{
+    Q_OBJECT
+
+    public:
+
+        enum { MaxDevices = 16 };
+
+        BT40Pipeline(QObject *parent = NULL);
+        ~BT40Pipeline();
+
+        void begin();
+        void stop();
+
+        // the thread the notifications arrive on
+        bool notify(int device, int kind, const QByteArray &value);
+        void reset(int device);
+
+        // the thread that polls the controller
+        bool next(BT40Event &event) { return events.pop(event); }
+
+        int dropped() const { return droppedCount; }
+        quint64 decoded() const { return decodedCount; }
+
+        // parse a hex dump of notifications, one per line as "kind hex",
+        // "device kind hex" or "# comment" where kind is as kindName(),
+        // through the pipeline repeat times and report the rates
+        static QString replay(const QString &filename, int repeat = 1);
+        static bool parseDump(const QString &filename, QVector<BT40Notification> &out, QString &error);
+
+    protected:
+
+        void run();
+
+    private:
+
+        void drain();
+
+        SpscQueue<BT40Notification> raw;
+        SpscQueue<BT40Event> events;
+        BT40Decoder decoders[MaxDevices];
+
+        QSemaphore pending;
+        std::atomic<bool> stopping;
+        std::atomic<int> droppedCount;
+        std::atomic<quint64> decodedCount;
+        std::atomic<quint32> resets;        // a bit per device to reset, from notify's thread
+};
+
+#endif // _GC_BT40Decoder_h
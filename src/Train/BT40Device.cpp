@@ -54,7 +54,8 @@ QMap<QBluetoothUuid, btle_sensor_type_t> BT40Device::supportedServices = {
     //{ QBluetoothUuid(QBluetoothUuid::ServiceClassUuid::DeviceInformation),        { "DeviceInformation", ":images / IconPower.png"}},
 };
 
-BT40Device::BT40Device(QObject *parent, QBluetoothDeviceInfo devinfo) : parent(parent), m_currentDevice(devinfo)
+BT40Device::BT40Device(QObject *parent, QBluetoothDeviceInfo devinfo, BT40Pipeline *pipeline, int index) :
+    parent(parent), m_currentDevice(devinfo), pipeline(pipeline), index(index)
 {
     m_control = QLowEnergyController::createCentral(m_currentDevice, this);
     connect(m_control, SIGNAL(connected()), this, SLOT(deviceConnected()), Qt::QueuedConnection);
@@ -64,12 +65,7 @@ BT40Device::BT40Device(QObject *parent, QBluetoothDeviceInfo devinfo) : parent(p
     connect(m_control, SIGNAL(discoveryFinished()), this, SLOT(serviceScanDone()), Qt::QueuedConnection);
 
     connected = false;
-    prevWheelTime = 0;
-    prevWheelRevs = 0;
-    prevWheelStaleness = true;
-    prevCrankTime = 0;
-    prevCrankRevs = 0;
-    prevCrankStaleness = -1; // indicates prev crank data values aren't measured values
+    pipeline->reset(index); // forget crank and wheel counts from whoever was here before
 
     loadType = Load_None;
     load = 0;
@@ -507,139 +503,40 @@ BT40Device::serviceStateChanged(QLowEnergyService::ServiceState s)
     }
 }
 
+// the characteristics whose notifications are telemetry
+static int
+notificationKind(const QBluetoothUuid &uuid)
+{
+    static const QMap<QBluetoothUuid, int> kinds = {
+        { QBluetoothUuid(QBluetoothUuid::CharacteristicType::HeartRateMeasurement),     BT40Notification::HeartRate },
+        { QBluetoothUuid(QBluetoothUuid::CharacteristicType::CyclingPowerMeasurement),  BT40Notification::CyclingPower },
+        { QBluetoothUuid(QBluetoothUuid::CharacteristicType::CSCMeasurement),           BT40Notification::CSC },
+        { s_FtmsIndoorBikeChar_UUID,                                                    BT40Notification::FtmsIndoorBike },
+        { QBluetoothUuid(QString(VO2MASTERPRO_VENTILATORY_CHAR_UUID)),                  BT40Notification::VO2Ventilatory },
+        { QBluetoothUuid(QString(VO2MASTERPRO_GASEXCHANGE_CHAR_UUID)),                  BT40Notification::VO2GasExchange },
+        { QBluetoothUuid(QString(VO2MASTERPRO_DATA_CHAR_UUID)),                         BT40Notification::VO2Data },
+        { s_KurtInRideService_Power_UUID,                                               BT40Notification::InRidePower },
+        { s_KurtSmartControlService_Power_UUID,                                         BT40Notification::SmartControlPower },
+    };
+    return kinds.value(uuid, BT40Notification::Unknown);
+}
+
 void
 BT40Device::updateValue(const QLowEnergyCharacteristic &c, const QByteArray &value)
 {
-    QDataStream ds(value);
-    ds.setByteOrder(QDataStream::LittleEndian); // Bluetooth data is always LE
-
-    if (c.uuid() == QBluetoothUuid(QBluetoothUuid::CharacteristicType::HeartRateMeasurement)) {
-        quint8 flags;
-        ds >> flags;
-        float hr;
-        if (flags & 0x1) { // HR 16 bit? otherwise 8 bit
-            quint16 heartRate;
-            ds >> heartRate;
-            hr = (float) heartRate;
-        } else {
-            quint8 heartRate;
-            ds >> heartRate;
-            hr = (float) heartRate;
-        }
-        dynamic_cast<BT40Controller*>(parent)->setBPM(hr);
-
-    } else if (c.uuid() == QBluetoothUuid(QBluetoothUuid::CharacteristicType::CyclingPowerMeasurement)) {
-
-        quint16 flags;
-        ds >> flags;
-        qint16 tmp_pwr;
-        ds >> tmp_pwr;
-        double power = (double) tmp_pwr;
-        dynamic_cast<BT40Controller*>(parent)->setWatts(power);
-
-        if (flags & 0x01) { // power balance present
-            qint8 byte;
-            ds >> byte;
-        }
-
-        if (flags & 0x04) { // accumulated torque data present
-            qint16 word;
-            ds >> word;
-        }
-
-        if (flags & 0x10) { // wheel revolutions data present
-            getWheelRpm(ds);
-        }
-
-        if (flags & 0x20) { // crank data present
-            // If this power meter reports crank revolutions, it is
-            // likely a crank-based meter (e.g. Stages)
-            getCadence(ds);
-        }
-
-    } else if (c.uuid() == QBluetoothUuid(QBluetoothUuid::CharacteristicType::CSCMeasurement)) {
+    // telemetry is parsed off this thread, see BT40Pipeline
+    const int kind = notificationKind(c.uuid());
+    if (kind != BT40Notification::Unknown) {
+        pipeline->notify(index, kind, value);
 
-        quint8 flags;
-        ds >> flags;
-
-        if (flags & 0x1) { // Wheel Revolution Data Present
-            getWheelRpm(ds);
-        }
-
-        if (flags & 0x2) { // Crank Revolution Data Present
-          getCadence(ds);
-        }
-    } else if (c.uuid() == QBluetoothUuid(QString(VO2MASTERPRO_VENTILATORY_CHAR_UUID))) {
-        // Modern firmwares uses three different characteristics:
-        // - VO2MASTERPRO_VENTILATORY_CHAR_UUID
-        // - VO2MASTERPRO_GASEXCHANGE_CHAR_UUID
-        // - VO2MASTERPRO_ENVIRONMENT_CHAR_UUID
-        // This is also the order in which they will be updated from the device.
-        //
-        // Older firmwares uses one VO2MASTERPRO_DATA_CHAR_UUID for all data, and those
-        // versions do not provide a VCO2 measurement.
-
-        quint16 rf; // Value over BT it rf*100;
-        quint16 tidal_volume, rmv;
-        ds >> rf;
-        ds >> tidal_volume;
-        ds >> rmv;
-
-        BT40Controller* controller = dynamic_cast<BT40Controller*>(parent);
-        controller->setRespiratoryFrequency((double)rf/100.0f);
-        controller->setRespiratoryMinuteVolume((double)rmv/100.0f);
-        controller->setTv((double)tidal_volume/100.0f);
-
-    } else if (c.uuid() == QBluetoothUuid(QString(VO2MASTERPRO_GASEXCHANGE_CHAR_UUID))) {
-        quint16 feo2, feco2, vo2, vco2;
-        ds >> feo2;
-        ds >> feco2;
-        ds >> vo2;
-        ds >> vco2;
-
-        if (feo2 == 2200 && vo2 == 22) {
-            // From the docs:
-            // If the value of FeO2 and VO2 for a given row are both exactly 22.0,
-            // said row is a “Ventilation-only row”. Such a row contains all the
-            // data less the FeO2 and VO2.
-
-            // Let's just ignore those updates completely, to avoid getting logged
-            // rows with zero VO2.
-            return;
-        }
+        // the InRide power notification also tells us how calibration is going
+        if (kind != BT40Notification::InRidePower) return;
+    }
 
-        BT40Controller* controller = dynamic_cast<BT40Controller*>(parent);
-        controller->setVO2_VCO2(vo2, vco2);
-        controller->setFeO2((double)feo2/100.0f);
-        controller->emitVO2Data();
-    } else if (c.uuid() == QBluetoothUuid(QString(VO2MASTERPRO_DATA_CHAR_UUID))) {
-        quint16 rf, rmv, feo2,vo2;
-        quint8 temp, hum;
-        ds >> rf;
-        ds >> temp;
-        ds >> hum;
-        ds >> rmv;
-        ds >> feo2;
-        ds >> vo2;
-
-        if (feo2 == 2200 && vo2 == 22) {
-            // From the docs:
-            // If the value of FeO2 and VO2 for a given row are both exactly 22.0,
-            // said row is a “Ventilation-only row”. Such a row contains all the
-            // data less the FeO2 and VO2.
-
-            // Let's just ignore those updates completely, to avoid getting logged
-            // rows with zero VO2.
-            return;
-        }
+    QDataStream ds(value);
+    ds.setByteOrder(QDataStream::LittleEndian); // Bluetooth data is always LE
 
-        BT40Controller* controller = dynamic_cast<BT40Controller*>(parent);
-        controller->setVO2_VCO2(vo2, 0);
-        controller->setRespiratoryFrequency((double)rf/100.0f);
-        controller->setRespiratoryMinuteVolume((double)rmv/100.0f);
-        controller->setFeO2((double)feo2/100.0f);
-        controller->emitVO2Data();
-    } else if (c.uuid() == s_KurtInRideService_Config_UUID) {
+    if (c.uuid() == s_KurtInRideService_Config_UUID) {
 
         if (value.size() == 20) {
             inride_config_data icd = inride_process_config_data((const uint8_t*)value.constData());
@@ -687,39 +584,10 @@ BT40Device::updateValue(const QLowEnergyCharacteristic &c, const QByteArray &val
             emit setNotification(tr("InRide Spindown Updated: ") + QString::number(ipd.spindownTime), 4);
         }
 
-        double power = ipd.power;
-        dynamic_cast<BT40Controller*>(parent)->setWatts(power);
-
-        // Convert kurt speed in kph to wheel rpm, using wheelsize (mm)
-        // Just so caller can convert wheel rpm back to kph... anyway...
-
-        double kph = ipd.speedKPH;
-        double wheelRpm = kph * (1000. / wheelSize) * (1000. / 60.);
-        dynamic_cast<BT40Controller*>(parent)->setWheelRpm(wheelRpm);
-
-        double cadenceRPM = ipd.cadenceRPM;
-        dynamic_cast<BT40Controller*>(parent)->setCadence(cadenceRPM);
+        // power, speed and cadence come through the pipeline
 
         //dynamic_cast<BT40Controller*>(parent)->setTrainerStatusString(inride_state_to_rtd_string(ipd.state, ipd.calibrationResult));
 
-    } else if (c.uuid() == s_KurtSmartControlService_Power_UUID) {
-
-        smart_control_power_data scpd = smart_control_process_power_data((const uint8_t*)value.constData(), value.size());
-
-        // Power
-        double power = scpd.power;
-        dynamic_cast<BT40Controller*>(parent)->setWatts(power);
-
-        // WheelRpm
-        double kph = scpd.speedKPH;
-        // Convert kurt speed in kph to wheel rpm, using wheelsize (mm)
-        double wheelRpm = kph * (1000. / wheelSize) * (1000. / 60.);
-        dynamic_cast<BT40Controller*>(parent)->setWheelRpm(wheelRpm);
-
-        // Cadence
-        double cadenceRPM = scpd.cadenceRPM;
-        dynamic_cast<BT40Controller*>(parent)->setCadence(cadenceRPM);
-
     } else if (c.uuid() == s_KurtSmartControlService_Config_UUID) {
 
         smart_control_config_data sccd = smart_control_process_config_data((const uint8_t*)value.data(), value.size());
@@ -785,26 +653,6 @@ BT40Device::updateValue(const QLowEnergyCharacteristic &c, const QByteArray &val
                 }
             }
         }
-    } else if (c.uuid() == s_FtmsIndoorBikeChar_UUID) {
-        FtmsIndoorBikeData bd;
-        ftms_parse_indoor_bike_data(ds, bd);
-
-        // Now update values of interest if they were present
-        if (bd.flags & FtmsIndoorBikeFlags::FTMS_INST_POWER_PRESENT)
-        {
-            dynamic_cast<BT40Controller*>(parent)->setWatts(bd.inst_power);
-        }
-
-        if (bd.flags & FtmsIndoorBikeFlags::FTMS_INST_CADENCE_PRESENT)
-        {
-            dynamic_cast<BT40Controller*>(parent)->setCadence(bd.inst_cadence/2.0f);
-        }
-
-        if ( !(bd.flags & FtmsIndoorBikeFlags::FTMS_MORE_DATA) )
-        {
-            // If "more data" is false, inst speed is present. Convert to km/h by dividing with 100.
-            dynamic_cast<BT40Controller*>(parent)->setSpeed(bd.inst_speed/100.0f);
-        }
     } else if (c.uuid() == s_FtmsFeatureChar_UUID) {
         quint32 features, target_settings;
         ds >> features >> target_settings;
@@ -943,74 +791,6 @@ BT40Device::confirmedCharacteristicWrite(const QLowEnergyCharacteristic &c, cons
     if(loadType == Wahoo_Kickr) commandWritten();
 }
 
-void
-BT40Device::getCadence(QDataStream& ds)
-{
-    quint16 cur_revs;
-    quint16 cur_time;
-    ds >> cur_revs;
-    ds >> cur_time;
-
-    // figure wether to update cadence and with what value
-    //
-    // If we have a new crank event (new time) we push a new RPM, but
-    // only if the previous data is valid (fixes glitch on first
-    // update)
-    //
-    // If we don't have new crank data, push a zero for RPM, unless
-    // previous data is only 1 or 2 notifications old. This lets us
-    // report RPMs lower than 60 (assuming notification period is 1s)
-    // but still report a zero fairly quickly (2 notification periods)
-    if (cur_time != prevCrankTime) {
-
-        if (prevCrankStaleness >= 0) {
-
-            const int time = cur_time + (cur_time < prevCrankTime ? 0x10000:0) - prevCrankTime;
-            const int revs = cur_revs + (cur_revs < prevCrankRevs ? 0x10000:0) - prevCrankRevs;
-            const double rpm = 1024*60*revs / double(time);
-            dynamic_cast<BT40Controller*>(parent)->setCadence(rpm);
-        }
-
-    } else if (prevCrankStaleness < 0 || prevCrankStaleness >= 2) {
-      dynamic_cast<BT40Controller*>(parent)->setCadence(0.0);
-
-    }
-
-    // update the staleness of the previous crank data
-    if (cur_time != prevCrankTime) {
-        prevCrankStaleness = 0;
-    } else if (prevCrankStaleness < 2) {
-        prevCrankStaleness += 1;
-    }
-
-    // update the previous crank data
-    prevCrankRevs = cur_revs;
-    prevCrankTime = cur_time;
-}
-
-void
-BT40Device::getWheelRpm(QDataStream& ds)
-{
-    quint32 wheelrevs;
-    quint16 wheeltime;
-    ds >> wheelrevs;
-    ds >> wheeltime;
-
-    double rpm = 0.0;
-
-    if(!prevWheelStaleness) {
-        quint16 time = wheeltime - prevWheelTime;
-        quint32 revs = wheelrevs - prevWheelRevs;
-        // Power sensor uses 1/2048 second time base and CSC sensor 1/1024
-        if (time) rpm = (has_power ? 2048 : 1024)*60*revs / double(time);
-    }
-    else prevWheelStaleness = false;
-
-    prevWheelRevs = wheelrevs;
-    prevWheelTime = wheeltime;
-    dynamic_cast<BT40Controller*>(parent)->setWheelRpm(rpm);
-}
-
 QBluetoothDeviceInfo
 BT40Device::deviceInfo() const
 {
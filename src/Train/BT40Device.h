@@ -27,6 +27,7 @@
 
 #include "CalibrationData.h"
 #include "Ftms.h"
+#include "BT40Decoder.h"
 
 typedef struct btle_sensor_type {
     const char *descriptive_name;
@@ -38,7 +39,8 @@ class BT40Device: public QObject
     Q_OBJECT
 
 public:
-    BT40Device(QObject *parent, QBluetoothDeviceInfo devinfo);
+    // telemetry goes through the controller's pipeline as device index
+    BT40Device(QObject *parent, QBluetoothDeviceInfo devinfo, BT40Pipeline *pipeline, int index);
     ~BT40Device();
     void connectDevice();
     void disconnectDevice();
@@ -84,12 +86,8 @@ private:
     QBluetoothDeviceInfo m_currentDevice;
     QLowEnergyController *m_control;
     QList<QLowEnergyService*> m_services;
-    int prevCrankStaleness;
-    quint16 prevCrankTime;
-    quint16 prevCrankRevs;
-    bool prevWheelStaleness;
-    quint16 prevWheelTime;
-    quint32 prevWheelRevs;
+    BT40Pipeline *pipeline;
+    int index;
     double load;
     double gradient;
     double prevGradient;
@@ -116,8 +114,6 @@ private:
     bool connected;
     QTimer *reconnectTimer;
     int reconnectAttempts;
-    void getCadence(QDataStream& ds);
-    void getWheelRpm(QDataStream& ds);
     void setLoadErg(double);
     void setLoadIntensity(double);
     void setLoadLevel(int);
@@ -455,13 +455,17 @@ double Bicycle::FilterWattIncrease(double watts, double altitudeMeters)
 // Compute new speed from state and time duration since last sample.
 SpeedDistance
 Bicycle::SampleSpeed(BicycleSimState &nowState)
+{
+    // Record current time and use dt since last sample.
+    return SampleSpeed(nowState, SampleDT());
+}
+
+SpeedDistance
+Bicycle::SampleSpeed(BicycleSimState &nowState, double dt)
 {
     // Detect and filter obvious power spikes.
     nowState.Watts() = FilterWattIncrease(nowState.Watts(), nowState.Altitude());
 
-    // Record current time and return dt since last sample.
-    double dt = SampleDT();
-
     // Compute new speed.
     MotionStatePair state(this,          // BicycleSim object (for accessing methods and constants)
                           this->m_state, // previous tick state
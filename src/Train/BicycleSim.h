@@ -161,6 +161,7 @@ public:
     Bicycle(Context* context, BicycleConstants constants, double riderWeightKG, double bicycleMassWithoutWheelsKG, BicycleWheel frontWheel, BicycleWheel rearWheel);
     Bicycle(Context* context);
     SpeedDistance SampleSpeed(BicycleSimState &newState);
+    SpeedDistance SampleSpeed(BicycleSimState &newState, double dt); // dt given, e.g. when simulating
 
     void Reset(Context* context);
 
@@ -85,7 +85,7 @@ ComputrainerController::getRealtimeData(RealtimeData &rtData)
     if(!myComputrainer->isRunning())
     {
         emit setNotification(tr("Cannot Connect to Computrainer"), 2);
-        parent->Stop(1);
+        failed(1);
         return;
     }
 
@@ -98,7 +98,7 @@ ComputrainerController::getRealtimeData(RealtimeData &rtData)
         // We're only interested in the act of pressing the button, not it being held down
         if (f3Depressed == false) {
             f3Depressed = true;
-            parent->Calibrate();
+            post(&TrainSidebar::Calibrate);
         }
     } else {
         f3Depressed = false; // It has been released
@@ -134,10 +134,10 @@ ComputrainerController::getRealtimeData(RealtimeData &rtData)
     Gradient = myComputrainer->getGradient();
 	// the calls to the parent will determine which mode we are on (ERG/SPIN) and adjust load/slop appropriately
     if (Buttons&CT_PLUS) {
-        parent->Higher();
+        post(&TrainSidebar::Higher);
     }
     if (Buttons&CT_MINUS) {
-        parent->Lower();
+        post(&TrainSidebar::Lower);
     }
     rtData.setLoad(Load);
 	rtData.setSlope(Gradient);
@@ -147,7 +147,7 @@ ComputrainerController::getRealtimeData(RealtimeData &rtData)
         // We're only interested in the act of pressing the button, not it being held down
         if (f1Depressed == false) {
             f1Depressed = true;
-            parent->Start();
+            post(&TrainSidebar::Start);
         }
     } else {
         f1Depressed = false; // It has been released
@@ -158,7 +158,7 @@ ComputrainerController::getRealtimeData(RealtimeData &rtData)
         // We're only interested in the act of pressing the button, not it being held down
         if (f2Depressed == false) {
             f2Depressed = true;
-            parent->newLap();
+            post(&TrainSidebar::newLap);
         }
     } else {
         f2Depressed = false; // It has been released
@@ -166,7 +166,7 @@ ComputrainerController::getRealtimeData(RealtimeData &rtData)
 
     // if Buttons == 0 we just pressed stop!
     if (Buttons&CT_RESET) {
-        parent->Stop(0);
+        post(&TrainSidebar::Stop, 0);
     }
 
 }
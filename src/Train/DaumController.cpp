@@ -21,8 +21,6 @@
 #include "Daum.h"
 #include "RealtimeData.h"
 
-#include <QMessageBox>
-
 DaumController::DaumController(TrainSidebar *parent,  DeviceConfiguration *dc) : RealtimeController(parent, dc)
     , daumDevice_(this, dc ? dc->portSpec : "", dc ? dc->deviceProfile : "") {
 }
@@ -54,11 +52,7 @@ bool DaumController::discover(QString name) {
  */
 void DaumController::getRealtimeData(RealtimeData &rtData) {
     if(!daumDevice_.isRunning()) {
-        QMessageBox msgBox;
-        msgBox.setText(tr("Cannot Connect to Daum"));
-        msgBox.setIcon(QMessageBox::Critical);
-        msgBox.exec();
-        parent->Stop(1);
+        failed(1, false, tr("Cannot Connect to Daum"));
         return;
     }
 
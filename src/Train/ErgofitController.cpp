@@ -21,7 +21,6 @@
 #include "Ergofit.h"
 #include "RealtimeData.h"
 
-#include <QMessageBox>
 #include <QSerialPort>
 
 ErgofitController::ErgofitController(TrainSidebar *parent,  DeviceConfiguration *dc) : RealtimeController(parent, dc)
@@ -80,11 +79,7 @@ ErgofitController::getRealtimeData(RealtimeData &rtData)
 {
     if (!m_ergofit->isConnected())
     {
-        QMessageBox msgBox;
-        msgBox.setText(tr("Cannot Connect to Ergofit"));
-        msgBox.setIcon(QMessageBox::Critical);
-        msgBox.exec();
-        parent->Stop(0);
+        failed(0, false, tr("Cannot Connect to Ergofit"));
         return;
     }
 
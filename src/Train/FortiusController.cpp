@@ -84,7 +84,7 @@ FortiusController::getRealtimeData(RealtimeData &rtData)
     if(!myFortius->isRunning())
     {
         emit setNotification(tr("Cannot Connect to Fortius"), 2);
-        parent->Stop(1);
+        failed(1);
         return;
     }
     // get latest telemetry
@@ -115,15 +115,15 @@ FortiusController::getRealtimeData(RealtimeData &rtData)
     if (parent->calibrating) return;
 
     // ADJUST LOAD
-    if ((Buttons&FT_PLUS)) parent->Higher();
+    if ((Buttons&FT_PLUS)) post(&TrainSidebar::Higher);
     
-    if ((Buttons&FT_MINUS)) parent->Lower();
+    if ((Buttons&FT_MINUS)) post(&TrainSidebar::Lower);
 
     // LAP/INTERVAL
-    if (Buttons&FT_ENTER) parent->newLap();
+    if (Buttons&FT_ENTER) post(&TrainSidebar::newLap);
 
     // CANCEL
-    if (Buttons&FT_CANCEL) parent->Stop(0);
+    if (Buttons&FT_CANCEL) post(&TrainSidebar::Stop, 0);
 
     // Ensure we set the UI load to the actual setpoint from the fortius (as it will clamp)
     rtData.setLoad(myFortius->getLoad());
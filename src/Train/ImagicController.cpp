@@ -83,12 +83,7 @@ ImagicController::getRealtimeData(RealtimeData &rtData)
 
     if(!myImagic->isRunning())
     {
-        QMessageBox msgBox;
-        msgBox.setText(tr("Cannot Connect to Imagic"));
-        msgBox.setIcon(QMessageBox::Critical);
-        msgBox.exec();
-        parent->Stop(1);
-        parent->Disconnect();
+        failed(1, true, tr("Cannot Connect to Imagic"));
         return;
     }
     // get latest telemetry
@@ -125,22 +120,22 @@ ImagicController::getRealtimeData(RealtimeData &rtData)
         if (pressCount < 100) ++pressCount;
         // UP or DOWN
         // Adjusts intensity
-        if ((Buttons&IM_PLUS) == 0 && (noPressCount > 0 || pressCount > 5)) parent->Higher();
-        if ((Buttons&IM_MINUS) == 0 && (noPressCount > 0 || pressCount > 5)) parent->Lower();
+        if ((Buttons&IM_PLUS) == 0 && (noPressCount > 0 || pressCount > 5)) post(&TrainSidebar::Higher);
+        if ((Buttons&IM_MINUS) == 0 && (noPressCount > 0 || pressCount > 5)) post(&TrainSidebar::Lower);
 
         // START
         // If not running, start. If paused, restart. Otherwise start new lap
         if ((Buttons&IM_ENTER) == 0 && noPressCount > 4) {
-            if (!parent->context->isRunning || parent->context->isPaused) parent->Start();
-            else  parent->newLap();
+            if (!parent->context->isRunning || parent->context->isPaused) post(&TrainSidebar::Start);
+            else  post(&TrainSidebar::newLap);
         }
 
         // CANCEL
         // Press once to pause, press again (while paused) to stop
         if ((Buttons&IM_CANCEL) == 0 && noPressCount > 4) {
             if (parent->context->isRunning) {
-                if (parent->context->isPaused) parent->Stop(0);
-                else  parent->Start();
+                if (parent->context->isPaused) post(&TrainSidebar::Stop, 0);
+                else  post(&TrainSidebar::Start);
             }
         }
         noPressCount = 0;
@@ -153,16 +148,16 @@ ImagicController::getRealtimeData(RealtimeData &rtData)
         // Steering is calibrated and seems to be within bounds
         if (Steering > (steerStraight+10)) {
             if (Steering > (steerStraight+20))
-                parent->steerScroll(+2);
+                post(&TrainSidebar::steerScroll, +2);
             else
-                parent->steerScroll(+1);
+                post(&TrainSidebar::steerScroll, +1);
             ++steerActive;
         }
         else if (Steering < (steerStraight-10)) {
             if (Steering < (steerStraight-20))
-                parent->steerScroll(-2);
+                post(&TrainSidebar::steerScroll, -2);
             else
-                parent->steerScroll(-1);
+                post(&TrainSidebar::steerScroll, -1);
             ++steerActive;
         }
         else {
@@ -180,7 +175,7 @@ ImagicController::getRealtimeData(RealtimeData &rtData)
              steerCalibrate = 0;
              steerActive = 0;
              steerStraight = 128;
-             parent->steerScroll(0);
+             post(&TrainSidebar::steerScroll, 0);
          }
          // Take average steering value over ~ 10secs and use that as new "straight ahead" value
          if (Steering > 0) {
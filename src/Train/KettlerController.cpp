@@ -21,7 +21,6 @@
 #include "Kettler.h"
 #include "RealtimeData.h"
 
-#include <QMessageBox>
 #include <QSerialPort>
 
 KettlerController::KettlerController(TrainSidebar *parent,  DeviceConfiguration *dc) : RealtimeController(parent, dc)
@@ -80,11 +79,7 @@ KettlerController::getRealtimeData(RealtimeData &rtData)
 {
     if (!m_kettler->isConnected())
     {
-        QMessageBox msgBox;
-        msgBox.setText(tr("Cannot Connect to Kettler"));
-        msgBox.setIcon(QMessageBox::Critical);
-        msgBox.exec();
-        parent->Stop(0);
+        failed(0, false, tr("Cannot Connect to Kettler"));
         return;
     }
 
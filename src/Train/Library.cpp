@@ -29,6 +29,7 @@
 #include <QApplication>
 #include <QDirIterator>
 #include <QFileInfo>
+#include <QtConcurrent>
 
 // helpers
 #include "VideoWindow.h"
@@ -89,7 +90,7 @@ Library::initialise(QDir gcRoot)
 void
 Library::importFiles(Context *context, QStringList files, LibraryBatchImportConfirmation showDialog)
 {
-    QStringList videos, workouts, videosyncs;
+    QStringList videos, workouts, videosyncs, candidates;
     MediaHelper helper;
 
     // sort the wheat from the chaff
@@ -101,12 +102,8 @@ Library::importFiles(Context *context, QStringList files, LibraryBatchImportConf
         // media just check file name
         if (helper.isMedia(file)) videos << file;
 
-        // if it is a workout we parse it to check
-        if (ErgFile::isWorkout(file)) {
-            ErgFile *p = new ErgFile(file, ErgFileFormat::unknown, context);
-            if (p->isValid()) workouts << file;
-            delete p;
-        }
+        // if it is a workout we parse it to check (below)
+        if (ErgFile::isWorkout(file)) candidates << file;
 
         // if it is a VideoSync we parse it to check
         if (VideoSyncFile::isVideoSync(file)) {
@@ -117,6 +114,15 @@ Library::importFiles(Context *context, QStringList files, LibraryBatchImportConf
         }
     }
 
+    // parse the workouts once, we keep the results for the import
+    QHash<QString, LibraryWorkoutScan> parsed;
+    foreach(const LibraryWorkoutScan &scan, scanWorkouts(context, candidates, false)) {
+        if (scan.valid) {
+            workouts << scan.filepath;
+            parsed.insert(scan.filepath, scan);
+        }
+    }
+
     // nothing to dialog about...
     if (!videos.count() && !workouts.count() && !videosyncs.count()) {
         if (showDialog != LibraryBatchImportConfirmation::noDialog) {
@@ -253,8 +259,7 @@ Library::importFiles(Context *context, QStringList files, LibraryBatchImportConf
                 }
 
                 // still add it, it may not have been scanned...
-                ErgFile file(targetWorkout, ErgFileFormat::unknown, context);
-                trainDB->importWorkout(targetWorkout, file);
+                importScanned(context, parsed.value(workout), targetWorkout);
             }
         }
 
@@ -282,19 +287,27 @@ Library::refreshWorkouts
 (Context *context)
 {
     QAbstractTableModel *model = trainDB->getWorkoutModel();
-    trainDB->startLUW();
-    bool ok = true;
+    QStringList filepaths;
     for (int i = 0; i < model->rowCount(); ++i) {
         QString type = model->data(model->index(i, TdbWorkoutModelIdx::type)).toString();
         if (type != "code") {
-            QString filepath = model->data(model->index(i, TdbWorkoutModelIdx::filepath)).toString();
-            ErgFile ergfile(filepath, ErgFileFormat::unknown, context);
-            if (ergfile.isValid()) {
-                ok &= trainDB->importWorkout(filepath, ergfile, ImportMode::update);
-            } else {
-                trainDB->deleteWorkout(filepath);
-                qDebug() << "Library::refreshWorkouts:" << i << "/" << model->rowCount() << ": Removing" << filepath << "- file does not parse correctly: Does it exist?";
-            }
+            filepaths << model->data(model->index(i, TdbWorkoutModelIdx::filepath)).toString();
+        }
+    }
+
+    // metrics depend upon CP, so we always parse everything
+    QList<LibraryWorkoutScan> scans = scanWorkouts(context, filepaths, false);
+
+    trainDB->startLUW();
+    bool ok = true;
+    for (int i = 0; i < scans.count(); ++i) {
+        const LibraryWorkoutScan &scan = scans[i];
+        if (scan.valid) {
+            ok &= trainDB->importWorkout(scan.filepath, scan.workout, ImportMode::update);
+            trainDB->stampWorkout(scan.filepath, scan.stamp);
+        } else {
+            trainDB->deleteWorkout(scan.filepath);
+            qDebug() << "Library::refreshWorkouts:" << i << "/" << scans.count() << ": Removing" << scan.filepath << "- file does not parse correctly: Does it exist?";
         }
     }
     trainDB->endLUW();
@@ -303,6 +316,86 @@ Library::refreshWorkouts
 }
 
 
+QList<LibraryWorkoutScan>
+Library::scanWorkouts
+(Context *context, QStringList files, bool skipUnchanged)
+{
+    // what we saw last time, only read whilst the threads run
+    const QHash<QString, WorkoutFileStamp> stamps = skipUnchanged ? trainDB->getWorkoutStamps()
+                                                                  : QHash<QString, WorkoutFileStamp>();
+
+    QVector<LibraryWorkoutScan> scans(files.count());
+    for (int i = 0; i < files.count(); ++i) {
+        scans[i].filepath = files[i];
+    }
+
+    // parsing and calculating metrics is cpu bound, so spread it across the cores
+    QtConcurrent::blockingMap(scans, [&stamps, context](LibraryWorkoutScan &scan) {
+
+        // quick check on size and modification time first
+        scan.stamp = TrainDB::fileStamp(scan.filepath, false);
+        if (scan.stamp.size < 0) {
+            return;
+        }
+        auto known = stamps.constFind(scan.filepath);
+        if (known != stamps.constEnd() && known->sameFile(scan.stamp)) {
+            scan.stamp.hash = known->hash;
+            scan.unchanged = true;
+            return;
+        }
+
+        // touched or copied, but is the content the same?
+        scan.stamp = TrainDB::fileStamp(scan.filepath);
+        if (known != stamps.constEnd() && known->hash == scan.stamp.hash) {
+            scan.unchanged = true;
+            return;
+        }
+
+        ErgFile file(scan.filepath, ErgFileFormat::unknown, context);
+        scan.valid = file.isValid();
+        if (scan.valid) {
+            scan.workout = file;
+        }
+    });
+
+    return scans.toList();
+}
+
+
+// add a scanned workout to the trainDB, must be called within a LUW
+void
+Library::importScanned
+(Context *context, const LibraryWorkoutScan &scan, QString target)
+{
+    if (! scan.valid && ! scan.unchanged) {
+        return;
+    }
+    if (target.isEmpty() || target == scan.filepath) {
+        if (scan.valid) {
+            trainDB->importWorkout(scan.filepath, scan.workout, ImportMode::insert);
+        }
+        trainDB->stampWorkout(scan.filepath, scan.stamp);
+        return;
+    }
+
+    // copied elsewhere, if the copy failed the target may not be what we parsed
+    WorkoutFileStamp stamp = TrainDB::fileStamp(target);
+    if (stamp.size < 0) {
+        return;
+    }
+    if (scan.valid && stamp.hash == scan.stamp.hash) {
+        trainDB->importWorkout(target, scan.workout, ImportMode::insert);
+        trainDB->stampWorkout(target, stamp);
+    } else {
+        ErgFile file(target, ErgFileFormat::unknown, context);
+        if (file.isValid()) {
+            trainDB->importWorkout(target, file, ImportMode::insert);
+            trainDB->stampWorkout(target, stamp);
+        }
+    }
+}
+
+
 void
 Library::removeRef(Context *context, QString ref)
 {
@@ -676,12 +769,9 @@ LibrarySearchDialog::updateDB()
     trainDB->startLUW();
 
     // workouts
-    // If the workout existed already, it won't be modified
-    foreach(QString ergFile, workoutsFound) {
-        ErgFile file(ergFile, ErgFileFormat::unknown, context);
-        if (file.isValid()) {
-            trainDB->importWorkout(ergFile, file);
-        }
+    // Files that are unchanged since the last scan are not parsed again
+    foreach(const LibraryWorkoutScan &scan, Library::scanWorkouts(context, workoutsFound)) {
+        Library::importScanned(context, scan);
     }
     // Now, we can delete old workouts in the table that have not been scanned now
     QStringList workouts = trainDB->getWorkouts();
@@ -711,6 +801,7 @@ LibrarySearchDialog::updateDB()
     // copied into the workout directory.
     if (library) {
         MediaHelper helper;
+        QStringList refWorkouts;
 
         foreach(QString r, library->refs) {
 
@@ -729,12 +820,10 @@ LibrarySearchDialog::updateDB()
             }
 
             // is a workout?
-            if (ErgFile::isWorkout(r)) {
-                ErgFile file(r, ErgFileFormat::unknown, context);
-                if (file.isValid()) {
-                    trainDB->importWorkout(r, file);
-                }
-            }
+            if (ErgFile::isWorkout(r)) refWorkouts << r;
+        }
+        foreach(const LibraryWorkoutScan &scan, Library::scanWorkouts(context, refWorkouts)) {
+            Library::importScanned(context, scan);
         }
     }
     trainDB->endLUW();
@@ -807,6 +896,7 @@ WorkoutImportDialog::WorkoutImportDialog(Context *context, QStringList files) :
     setFixedSize(450 *dpiXFactor, 450 *dpiYFactor);
 
     MediaHelper helper;
+    QStringList candidates;
 
     // sort the wheat from the chaff
     foreach(QString file, files) {
@@ -817,12 +907,9 @@ WorkoutImportDialog::WorkoutImportDialog(Context *context, QStringList files) :
         // media just check file name
         if (helper.isMedia(file)) videos << file;
 
-        // if it is a workout we parse it to check
-        if (ErgFile::isWorkout(file)) {
-            ErgFile *p = new ErgFile(file, ErgFileFormat::unknown, context);
-            if (p->isValid()) workouts << file;
-            delete p;
-        }
+        // if it is a workout we parse it to check (below)
+        if (ErgFile::isWorkout(file)) candidates << file;
+
         // if it is a videosync we parse it to check
         if (VideoSyncFile::isVideoSync(file)) {
             int mode = 0;
@@ -833,6 +920,14 @@ WorkoutImportDialog::WorkoutImportDialog(Context *context, QStringList files) :
 
     }
 
+    // parse the workouts once, we keep the results for the import
+    foreach(const LibraryWorkoutScan &scan, Library::scanWorkouts(context, candidates, false)) {
+        if (scan.valid) {
+            workouts << scan.filepath;
+            parsed.insert(scan.filepath, scan);
+        }
+    }
+
     QVBoxLayout *mainLayout = new QVBoxLayout(this);
 
     QLabel *notice = new QLabel(this);
@@ -928,8 +1023,7 @@ WorkoutImportDialog::import()
         if (!QFile(workout).exists()) continue;
 
         // cannot read or not valid
-        ErgFile file(workout, ErgFileFormat::unknown, context);
-        if (!file.isValid()) continue;
+        if (!parsed.contains(workout)) continue;
 
         // get target name
         QString target = workoutDir + "/" + QFileInfo(workout).fileName();
@@ -945,7 +1039,7 @@ WorkoutImportDialog::import()
         }
 
         // add to library now
-        trainDB->importWorkout(target, file);
+        Library::importScanned(context, parsed.value(workout), target);
     }
 
     // set target directory
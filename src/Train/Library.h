@@ -20,6 +20,8 @@
 #define _Library_h
 #include "GoldenCheetah.h"
 #include "ActionButtonBox.h"
+#include "ErgFileBase.h"
+#include "TrainDB.h"
 
 #include <QDir>
 #include <QLabel>
@@ -39,6 +41,15 @@ enum class LibraryBatchImportConfirmation {
     noDialog
 };
 
+// a workout file parsed during a library scan or import
+struct LibraryWorkoutScan {
+    QString filepath;
+    WorkoutFileStamp stamp;
+    bool unchanged = false;     // same as when it was last imported, nothing to do
+    bool valid = false;         // parsed ok and workout has the details
+    ErgFileBase workout;
+};
+
 class Library : QObject
 {
     Q_OBJECT
@@ -54,6 +65,11 @@ class Library : QObject
         void removeRef(Context *context, QString ref);
 
         static bool refreshWorkouts(Context *context);
+
+        // parse workouts across all cores, files with the same stamp as last
+        // time are not parsed again when skipUnchanged is set
+        static QList<LibraryWorkoutScan> scanWorkouts(Context *context, QStringList files, bool skipUnchanged=true);
+        static void importScanned(Context *context, const LibraryWorkoutScan &scan, QString target=QString());
 };
 
 extern QList<Library *> libraries;        // keep track of all Library search paths for all users
@@ -154,6 +170,7 @@ class WorkoutImportDialog : public QDialog
         QStringList files;
  
         QStringList videos, videosyncs, workouts;
+        QHash<QString, LibraryWorkoutScan> parsed;
 
         QTreeWidget *fileTable;
         QPushButton *okButton, *cancelButton;
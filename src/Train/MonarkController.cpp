@@ -21,7 +21,6 @@
 #include "MonarkConnection.h"
 #include "RealtimeData.h"
 
-#include <QMessageBox>
 #include <QSerialPort>
 
 MonarkController::MonarkController(TrainSidebar *parent,  DeviceConfiguration *dc) : RealtimeController(parent, dc)
@@ -86,12 +85,7 @@ MonarkController::getRealtimeData(RealtimeData &rtData)
 {
     if (m_monark->isFinished())
     {
-        QMessageBox msgBox;
-        msgBox.setText(tr("Cannot Connect to Monark"));
-        msgBox.setIcon(QMessageBox::Critical);
-        msgBox.exec();
-        parent->Stop(0);
-        parent->Disconnect();
+        failed(0, true, tr("Cannot Connect to Monark"));
         return;
     }
 
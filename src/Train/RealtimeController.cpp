@@ -21,6 +21,8 @@
 #include "RealtimeData.h"
 #include "Units.h"
 
+#include <QMessageBox>
+
 #ifdef Q_CC_MSVC
 // 'strcpy': This function or variable may be unsafe.
 #pragma warning(disable:4996)
@@ -41,7 +43,7 @@ void VirtualPowerTrainer::to_string(std::string& s) const {
 RealtimeController::RealtimeController(TrainSidebar *parent, DeviceConfiguration *dc) :
     parent(parent), dc(dc), polyFit(NULL), fUseWheelRpm(false), 
     inertialMomentKGM2(0.), fAdvancedSpeedPowerMapping(true),
-    prevTime(), prevRpm(0.), prevWatts(0.)
+    prevTime(), prevRpm(0.), prevWatts(0.), failing(false)
 {
     if (dc != NULL)
     {
@@ -56,6 +58,39 @@ RealtimeController::RealtimeController(TrainSidebar *parent, DeviceConfiguration
     processSetup();
 }
 
+void
+RealtimeController::post(void (TrainSidebar::*slot)())
+{
+    TrainSidebar *sidebar = parent;
+    QMetaObject::invokeMethod(parent, [sidebar, slot]() { (sidebar->*slot)(); }, Qt::QueuedConnection);
+}
+
+void
+RealtimeController::post(void (TrainSidebar::*slot)(int), int arg)
+{
+    TrainSidebar *sidebar = parent;
+    QMetaObject::invokeMethod(parent, [sidebar, slot, arg]() { (sidebar->*slot)(arg); }, Qt::QueuedConnection);
+}
+
+bool
+RealtimeController::failed(int status, bool disconnect, QString message)
+{
+    if (failing.exchange(true)) return false;
+
+    TrainSidebar *sidebar = parent;
+    QMetaObject::invokeMethod(parent, [sidebar, status, disconnect, message]() {
+        if (message != "") {
+            QMessageBox msgBox;
+            msgBox.setText(message);
+            msgBox.setIcon(QMessageBox::Critical);
+            msgBox.exec();
+        }
+        sidebar->Stop(status);
+        if (disconnect) sidebar->Disconnect();
+    }, Qt::QueuedConnection);
+    return true;
+}
+
 int RealtimeController::start() { return 0; }
 int RealtimeController::restart() { return 0; }
 int RealtimeController::pause() { return 0; }
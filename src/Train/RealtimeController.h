@@ -28,6 +28,7 @@
 #include "GoldenCheetah.h"
 
 #include <string>
+#include <atomic>
 
 #define DEVICE_ERROR 1
 #define DEVICE_OK 0
@@ -122,6 +123,20 @@ public:
     void   setCalibrationTimestamp();
     QTime  getCalibrationTimestamp();
 
+    // a fresh connection, failed() may report again
+    void   resetFailure() { failing = false; }
+
+protected:
+    // the realtime engine polls us from its own thread but the sidebar
+    // belongs to the GUI thread, so buttons queue the call for it
+    void post(void (TrainSidebar::*slot)());
+    void post(void (TrainSidebar::*slot)(int), int arg);
+
+    // the device has gone: queue a message box if there is a message,
+    // then Stop(status) and Disconnect() if asked. Only the first poll
+    // to notice gets true, the rest are ignored until resetFailure()
+    bool failed(int status, bool disconnect = false, QString message = QString());
+
 private:
     double estimatePowerFromSpeed(double v, double wheelRpm, const std::chrono::high_resolution_clock::time_point& wheelRpmSampleTime);
 public:
@@ -147,6 +162,8 @@ private:
     double prevRpm;
     double prevWatts;
 
+    std::atomic<bool> failing;
+
 public:
     VirtualPowerTrainerManager virtualPowerTrainerManager;
 
@@ -1370,9 +1370,8 @@ RealtimeDataSession::RealtimeDataSession(Context* context, double CP, double WPR
     sumAvgWattsLap = sumAvgSpeedLap = sumAvgCadenceLap = sumAvgHeartRateLap = 0.0;
     nAvgWattsLap = nAvgSpeedLap = nAvgCadenceLap = nAvgHeartRateLap = 0;
 
-    // W'bal
-    wbalr = 0;
-    wbal = WPRIME;
+    // W'bal, until the engine has worked it out
+    setWbal(WPRIME);
 
     // Coggan Metrics
     rolling.resize(150); // enough for 30 seconds at 5hz
@@ -1446,19 +1445,7 @@ void RealtimeDataSession::updateDerived()
     sumAvgHeartRateLap += getHr();
     setAvgHeartRateLap(sumAvgHeartRateLap/nAvgHeartRateLap++);
 
-    //
-    // W'bal on the fly using Dave Waterworth's reformulation
-    //
-
-    // any watts expended in last 200msec?
-    double joules = double(getWatts() - CP) / 5.00f;
-    if (joules < 0) joules = 0;
-
-    // running total of replenishment
-    wbalr += joules * exp((getMsecs()/1000.00f) / TAU);
-    wbal = WPRIME - (wbalr * exp((-getMsecs()/1000.00f) / TAU));
-
-    setWbal(wbal);
+    // W'bal is worked out by RealtimeEngine with the actual time between samples
 
     //
     // VAM
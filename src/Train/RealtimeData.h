@@ -364,8 +364,6 @@ private:
 
     Vaminator vaminator;
 
-    double wbalr, wbal;
-
     double sumAvgWatts, sumAvgSpeed, sumAvgCadence, sumAvgHeartRate;
     int nAvgWatts, nAvgSpeed, nAvgCadence, nAvgHeartRate;
     double sumAvgWattsLap, sumAvgSpeedLap, sumAvgCadenceLap, sumAvgHeartRateLap;
@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "RealtimeEngine.h"
+#include "RealtimeController.h"
+#include "DeviceTypes.h"
+#include "ErgFile.h"
+
+#include <QElapsedTimer>
+#include <cmath>
+#include <cstring>
+
+RealtimeEngine::RealtimeEngine(QObject *parent) : QThread(parent),
+    periodUsecs(REFRESHRATE * 1000), stopping(false), running(false), hold(false),
+    mode(RT_MODE_ERGO), load(0), slope(0), windResistance(0), ergTime(0), ergTimeSet(false),
+    tickCount(0), wbalReset(true), CP(0), WPRIME(0), TAU(0),
+    ergMsecs(0), secs(0), wbalr(0), wbal(0), lastLoad(0), lastSlope(0), sincePush(0)
+{
+    // devices signal r-r data etc from the engine's thread now
+    qRegisterMetaType<uint16_t>("uint16_t");
+    qRegisterMetaType<uint8_t>("uint8_t");
+}
+
+RealtimeEngine::~RealtimeEngine()
+{
+    stop();
+}
+
+void
+RealtimeEngine::addDevice(RealtimeController *controller, int type, int telemetry)
+{
+    Device add;
+    add.controller = controller;
+    add.type = type;
+    add.series = telemetry & (Hr|Cadence|Speed|Watts);
+
+    // the extras we've always taken from these
+    if (type == DEV_CT) add.series |= SpinScan | Trainer;
+    if (type == DEV_FORTIUS || type == DEV_IMAGIC) add.series |= Trainer;
+    if (type == DEV_ANTLOCAL || type == DEV_NULL) add.series |= Moxy;
+    if (type == DEV_NULL || type == DEV_BT40) add.series |= Respiration;
+
+    controller->resetFailure();
+    devices << add;
+}
+
+void
+RealtimeEngine::clearDevices()
+{
+    devices.clear();
+}
+
+void
+RealtimeEngine::begin()
+{
+    if (isRunning()) return;
+
+    // only apply load/gradient once it's changed
+    stopping = false;
+    lastLoad = load;
+    lastSlope = slope;
+    sincePush = 0;
+    start(QThread::TimeCriticalPriority);
+}
+
+void
+RealtimeEngine::stop()
+{
+    stopping = true;
+    wait();
+}
+
+void
+RealtimeEngine::setWbal(double CP, double WPRIME, double TAU)
+{
+    this->CP = CP;
+    this->WPRIME = WPRIME;
+    this->TAU = TAU;
+    wbalReset = true;
+}
+
+void
+RealtimeEngine::setErgProfile(const ErgFile *ergFile)
+{
+    QVector<QPointF> points;
+    if (ergFile && ergFile->isValid() && ergFile->hasWatts())
+        foreach(const ErgFilePoint &p, ergFile->Points) points << QPointF(p.x, p.val);
+    profileIn.publish(points);
+}
+
+void
+RealtimeEngine::run()
+{
+    QElapsedTimer clock;
+    clock.start();
+
+    qint64 last = -1;
+    qint64 next = clock.nsecsElapsed() / 1000;
+    while (!stopping) {
+
+        const qint64 period = periodUsecs;
+
+        // wait for the tick to come round
+        qint64 now = clock.nsecsElapsed() / 1000;
+        if (next > now) QThread::usleep(next - now);
+        now = clock.nsecsElapsed() / 1000;
+
+        // how late are we?
+        if (last >= 0) jitterHist.add(qAbs(now - last - period));
+        double elapsed = (last >= 0 ? now - last : period) / 1000000.0;
+        last = now;
+
+        tick(elapsed);
+        latencyHist.add(clock.nsecsElapsed() / 1000 - now);
+
+        // keep to the cadence, but if we fell a whole tick behind
+        // start again from now rather than trying to catch up
+        next += period;
+        if (next <= now) next = now + period;
+    }
+}
+
+void
+RealtimeEngine::tick(double elapsed)
+{
+    // calibrating, the devices are being driven from elsewhere
+    if (hold) return;
+
+    // what's changed on the GUI side
+    session.latest(base);
+    profileIn.latest(profile);
+    if (ergTimeSet.exchange(false)) ergMsecs = ergTime;
+    if (wbalReset.exchange(false)) {
+        secs = wbalr = 0;
+        wbal = WPRIME;
+    }
+
+    const bool isRunning = running;
+    if (isRunning) {
+        secs += elapsed;
+        ergMsecs += elapsed * 1000.0;
+    }
+
+    // follow the workout ourselves in ERG mode, the GUI may be busy
+    // and only tells us where it thinks we are once a second
+    const bool ergo = (mode & RT_MODE_ERGO);
+    double target = load;
+    if (ergo && isRunning && profile.count()) {
+        double watts = ergLoad(ergMsecs);
+        if (watts >= 0) target = watts;
+    }
+
+    RealtimeData fused = base;
+    fused.setLoad(target);
+    fused.setSlope(slope);
+
+    devicesMutex.lock();
+
+    // apply load/gradient when it changes, and once a second anyway when
+    // running as we always have since some trainers like to be reminded
+    sincePush += elapsed;
+    bool changed = ergo ? (target != lastLoad) : (slope != lastSlope);
+    if (changed || (isRunning && sincePush >= LOADRATE / 1000.0)) {
+        foreach(const Device &device, devices) {
+            if (ergo) {
+                device.controller->setLoad(target);
+            } else {
+                device.controller->setGradient(slope);
+                device.controller->setWindResistance(windResistance);
+            }
+        }
+        lastLoad = target;
+        lastSlope = slope;
+        sincePush = 0;
+    }
+
+    // fetch the right data from each device...
+    RealtimeData polled = fused;
+    foreach(const Device &device, devices) {
+        RealtimeData local = polled;
+        device.controller->getRealtimeData(local);
+        merge(fused, local, device.series);
+    }
+
+    devicesMutex.unlock();
+
+    //
+    // W'bal on the fly using Dave Waterworth's reformulation,
+    // with the actual time since the last tick
+    //
+    if (isRunning && TAU > 0) {
+        double joules = (fused.getWatts() - CP) * elapsed;
+        if (joules < 0) joules = 0;
+        wbalr += joules * exp(secs / TAU);
+        wbal = WPRIME - (wbalr * exp(-secs / TAU));
+    }
+    fused.setWbal(wbal);
+
+    telemetry.publish(fused);
+    tickCount++;
+}
+
+// as ErgFileQueryAdapter::wattsAt, -1 past the end
+double
+RealtimeEngine::ergLoad(double msecs) const
+{
+    if (msecs < 0 || profile.count() < 2 || msecs > profile.last().x()) return -1;
+
+    // first point at or after msecs, a point listed twice is a step
+    int right = 1;
+    while (right < profile.count() - 1 && profile[right].x() < msecs) right++;
+    const QPointF &l = profile[right-1], &r = profile[right];
+
+    if (l.y() == r.y() || l.x() == r.x()) return r.y();
+    return l.y() + (r.y() - l.y()) * (msecs - l.x()) / (r.x() - l.x());
+}
+
+void
+RealtimeEngine::merge(RealtimeData &to, const RealtimeData &from, int series)
+{
+    // get spinscan data from a computrainer?
+    if (series & SpinScan) memcpy((uint8_t*)to.spinScan, (uint8_t*)from.spinScan, 24);
+
+    // and get load in case it was adjusted to within defined limits
+    if (series & Trainer) {
+        to.setLoad(from.getLoad());
+        to.setSlope(from.getSlope());
+    }
+
+    // only moxy data from ant and robot devices right now
+    if (series & Moxy) {
+        to.setHb(from.getSmO2(), from.gettHb());
+        to.setTemp(from.getTemp());
+    }
+
+    // only robot and BT40 devices provide VO2 metrics
+    if (series & Respiration) {
+        to.setRf(from.getRf());
+        to.setRMV(from.getRMV());
+        to.setVO2_VCO2(from.getVO2(), from.getVCO2());
+        to.setTv(from.getTv());
+        to.setFeO2(from.getFeO2());
+    }
+
+    to.setCoreTemp(from.getCoreTemp(), from.getSkinTemp(), from.getHeatStrain());
+
+    // what are we getting from this one?
+    if (series & Hr) to.setHr(from.getHr());
+    if (series & Cadence) to.setCadence(from.getCadence());
+    if (series & Speed) {
+        to.setSpeed(from.getSpeed());
+        to.setDistance(from.getDistance());
+        to.setRouteDistance(from.getRouteDistance());
+        to.setDistanceRemaining(from.getDistanceRemaining());
+        to.setLapDistance(from.getLapDistance());
+        to.setLapDistanceRemaining(from.getLapDistanceRemaining());
+    }
+    if (series & Watts) {
+        to.setWatts(from.getWatts());
+        to.setAltWatts(from.getAltWatts());
+        to.setLRBalance(from.getLRBalance());
+        to.setLTE(from.getLTE());
+        to.setRTE(from.getRTE());
+        to.setLPS(from.getLPS());
+        to.setRPS(from.getRPS());
+        to.setRppb(from.getRppb());
+        to.setRppe(from.getRppe());
+        to.setRpppb(from.getRpppb());
+        to.setRpppe(from.getRpppe());
+        to.setLppb(from.getLppb());
+        to.setLppe(from.getLppe());
+        to.setLpppb(from.getLpppb());
+        to.setLpppe(from.getLpppe());
+    }
+    if (from.getTrainerStatusAvailable()) {
+        to.setTrainerStatusAvailable(true);
+        to.setTrainerReady(from.getTrainerReady());
+        to.setTrainerRunning(from.getTrainerRunning());
+        to.setTrainerCalibRequired(from.getTrainerCalibRequired());
+        to.setTrainerConfigRequired(from.getTrainerConfigRequired());
+        to.setTrainerBrakeFault(from.getTrainerBrakeFault());
+    }
+}
+
+QString
+RealtimeEngine::timing() const
+{
+    return QString("ticks=%1 period=%2ms\njitter  %3\nlatency %4")
+           .arg(tickCount).arg(period())
+           .arg(jitterHist.toString())
+           .arg(latencyHist.toString());
+}
+
+QString
+RealtimeEngine::capture(RealtimeController *device, int secs, int msecs)
+{
+    // as a robot, it's all there is
+    RealtimeEngine engine;
+    if (msecs > 0) engine.setPeriod(msecs);
+    engine.addDevice(device, DEV_NULL, All);
+    engine.setMode(RT_MODE_ERGO);
+    engine.setLoad(200);
+    engine.setWbal(250, 20000, 300);
+    engine.setRunning(true);
+
+    device->start();
+    engine.begin();
+    QThread::msleep(secs * 1000);
+    engine.stop();
+    device->stop();
+
+    return engine.timing();
+}
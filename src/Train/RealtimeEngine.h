@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _GC_RealtimeEngine_h
+#define _GC_RealtimeEngine_h 1
+#include "GoldenCheetah.h"
+
+#include "RealtimeData.h"
+#include "SnapshotBuffer.h"
+#include "LatencyHistogram.h"
+
+#include <QThread>
+#include <QVector>
+#include <QPointF>
+#include <QRecursiveMutex>
+#include <atomic>
+
+class RealtimeController;
+class ErgFile;
+
+//
+// Polls the Train mode devices from its own thread at a fixed cadence so a
+// busy GUI thread can't hold up the trainer.
+//
+// Each tick it applies the load (following the workout itself in ERG mode)
+// or gradient to the trainers, polls every device and fuses what they have
+// as TrainSidebar always has, works out W'bal from the actual time between
+// ticks and publishes the result for the GUI to take when it refreshes.
+//
+// How late each tick is against the cadence and how long it took are kept
+// in histograms, see timing().
+//
+class RealtimeEngine : public QThread
+{
+    Q_OBJECT
+
+    public:
+
+        // what to take from a device, see merge()
+        enum {
+            Hr = 0x01, Cadence = 0x02, Speed = 0x04, Watts = 0x08,      // as chosen for the device
+            Trainer = 0x10,         // load and slope as the trainer adjusted them
+            SpinScan = 0x20,        // Computrainer spinscan
+            Moxy = 0x40,            // muscle oxygen and temperature
+            Respiration = 0x80,     // VO2 and friends
+            All = 0xff
+        };
+
+        RealtimeEngine(QObject *parent = NULL);
+        ~RealtimeEngine();
+
+        // devices to poll with the series to take from each one,
+        // only change them whilst stopped
+        void addDevice(RealtimeController *controller, int type, int telemetry);
+        void clearDevices();
+
+        // hold this when calling into the devices from another thread so
+        // the call doesn't overlap a tick
+        QRecursiveMutex &deviceLock() { return devicesMutex; }
+
+        void setPeriod(int msecs) { periodUsecs = qMax(1, msecs) * 1000; }
+        int period() const { return periodUsecs / 1000; }
+
+        // poll until stop(), which waits for the last tick to finish
+        void begin();
+        void stop();
+
+        // a single tick on the calling thread taking the time given rather
+        // than the clock, to simulate faster than real time; never whilst
+        // begin()'d
+        void step(double secs) { tick(secs); }
+
+        // W'bal starts again from WPRIME
+        void setWbal(double CP, double WPRIME, double TAU);
+
+        // W'bal and the workout only move on whilst running
+        void setRunning(bool x) { running = x; }
+
+        // leave the devices alone, e.g. whilst calibrating
+        void setHold(bool x) { hold = x; }
+
+        // what the trainers should be doing
+        void setMode(int x) { mode = x; }                   // RT_MODE_ERGO or RT_MODE_SLOPE
+        void setLoad(double x) { load = x; }
+        void setGradient(double x) { slope = x; }
+        void setWindResistance(double x) { windResistance = x; }
+
+        // a copy of the workout power, NULL or no watts to stop following
+        // it, and where we are in it; between calls the engine keeps time
+        void setErgProfile(const ErgFile *ergFile);
+        void setErgTime(double msecs) { ergTime = msecs; ergTimeSet = true; }
+
+        // what the GUI has for the session, devices are polled with a copy
+        void setSession(const RealtimeData &rtData) { session.publish(rtData); }
+
+        // latest from the devices, false if nothing new since the last
+        // call, one consumer thread only
+        bool latest(RealtimeData &rtData) { return telemetry.latest(rtData); }
+        quint64 ticks() const { return tickCount; }
+
+        // copy the series selected from one set of telemetry to another
+        static void merge(RealtimeData &to, const RealtimeData &from, int series);
+
+        // how late each tick started and how long each took
+        const LatencyHistogram &jitter() const { return jitterHist; }
+        const LatencyHistogram &latency() const { return latencyHist; }
+        QString timing() const;
+
+        // poll a single device for secs and report the timing, nothing
+        // else is needed so it runs headless with a NullController
+        static QString capture(RealtimeController *device, int secs, int msecs = 0);
+
+    protected:
+
+        void run();
+
+    private:
+
+        void tick(double elapsed);
+        double ergLoad(double msecs) const;
+
+        struct Device {
+            RealtimeController *controller;
+            int type;
+            int series;
+        };
+        QVector<Device> devices;
+        QRecursiveMutex devicesMutex;
+
+        std::atomic<int> periodUsecs;
+        std::atomic<bool> stopping, running, hold;
+        std::atomic<int> mode;
+        std::atomic<double> load, slope, windResistance;
+        std::atomic<double> ergTime;
+        std::atomic<bool> ergTimeSet;
+        std::atomic<quint64> tickCount;
+
+        // from the GUI thread
+        SnapshotBuffer<RealtimeData> session;
+        SnapshotBuffer<QVector<QPointF> > profileIn;
+        std::atomic<bool> wbalReset;
+        std::atomic<double> CP, WPRIME, TAU;
+
+        // to the GUI thread
+        SnapshotBuffer<RealtimeData> telemetry;
+
+        // engine thread only
+        RealtimeData base;
+        QVector<QPointF> profile;
+        double ergMsecs, secs, wbalr, wbal;
+        double lastLoad, lastSlope;
+        double sincePush;
+
+        LatencyHistogram jitterHist, latencyHist;
+};
+
+#endif // _GC_RealtimeEngine_h
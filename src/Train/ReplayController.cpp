@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "ReplayController.h"
+#include "RideFile.h"
+
+ReplayController::ReplayController(const RideFile *ride) :
+    RealtimeController(NULL, NULL), ride(ride), index(0), secs(0), load(0), slope(0),
+    cadence(90), hr(140)
+{
+}
+
+int
+ReplayController::start()
+{
+    return restart();
+}
+
+int
+ReplayController::restart()
+{
+    index = 0;
+    secs = 0;
+    return 0;
+}
+
+bool
+ReplayController::finished() const
+{
+    return ride && (ride->dataPoints().isEmpty() || secs > ride->dataPoints().last()->secs);
+}
+
+void
+ReplayController::getRealtimeData(RealtimeData &rtData)
+{
+    rtData.setName((char *)"Replay");
+    rtData.setLoad(load);
+    rtData.setSlope(slope);
+
+    if (!ride) {
+        rtData.setWatts(load);
+        rtData.setCadence(load > 0 ? cadence : 0);
+        rtData.setHr(hr);
+        return;
+    }
+
+    // time only moves forward so carry on from where we were
+    const QVector<RideFilePoint*> &points = ride->dataPoints();
+    if (points.isEmpty()) return;
+    if (index >= points.count() || points[index]->secs > secs) index = 0;
+    while (index+1 < points.count() && points[index+1]->secs <= secs) index++;
+
+    const RideFilePoint *p = points[index];
+    rtData.setWatts(p->watts);
+    rtData.setCadence(p->cad);
+    rtData.setHr(p->hr);
+}
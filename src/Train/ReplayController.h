@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _GC_ReplayController_h
+#define _GC_ReplayController_h 1
+#include "GoldenCheetah.h"
+
+#include "RealtimeController.h"
+#include "RealtimeData.h"
+
+class RideFile;
+
+//
+// A pretend device for running Train mode without hardware, the rider is
+// scripted rather than random as with the NullController.
+//
+// Given a ride it replays the power, cadence and heartrate recorded at the
+// time it is told it is, otherwise it's a rider that holds whatever load the
+// trainer asks for at a steady cadence, i.e. a perfect ERG trainer.
+//
+class ReplayController : public RealtimeController
+{
+    Q_OBJECT
+
+    public:
+
+        ReplayController(const RideFile *ride = NULL);
+        ~ReplayController() { }
+
+        int start();
+        int restart();
+        bool find() { return true; }
+        bool discover(QString) { return true; }
+        bool doesPush() { return false; }
+        bool doesPull() { return true; }
+        bool doesLoad() { return true; }
+
+        void setLoad(double watts) { load = watts; }
+        void setGradient(double grade) { slope = grade; }
+
+        // where we are in the ride, set before each poll
+        void setTime(double secs) { this->secs = secs; }
+
+        // ran off the end of the ride
+        bool finished() const;
+
+        // the rider when there's no ride to follow
+        void setRider(double cadence, double hr) { this->cadence = cadence; this->hr = hr; }
+
+        void getRealtimeData(RealtimeData &rtData);
+
+    private:
+
+        const RideFile *ride;
+        int index;
+        double secs, load, slope;
+        double cadence, hr;
+};
+
+#endif // _GC_ReplayController_h
@@ -22,6 +22,7 @@
 #include <QMessageBox>
 #include <QSet>
 #include <QSqlQueryModel>
+#include <QCryptographicHash>
 
 
 // DB Schema Version - YOU MUST UPDATE THIS IF THE TRAIN DB SCHEMA CHANGES
@@ -97,6 +98,14 @@
     "last_run INTEGER," \
     "PRIMARY KEY(filepath)"
 
+#define TABLE_WORKOUT_SCAN "workout_scan"
+#define FIELDS_WORKOUT_SCAN \
+    "filepath TEXT NOT NULL UNIQUE," \
+    "size INTEGER NOT NULL," \
+    "mtime INTEGER NOT NULL," \
+    "hash TEXT NOT NULL," \
+    "PRIMARY KEY(filepath)"
+
 #define TABLE_VIDEO "video"
 #define FIELDS_VIDEO \
     "filepath TEXT NOT NULL UNIQUE," \
@@ -498,19 +507,25 @@ TrainDB::getWorkoutHashes
 () const
 {
     QHash<QString, QString> ret;
+    QHash<QString, WorkoutFileStamp> stamps = getWorkoutStamps();
     QSqlQuery query(connection());
     query.prepare("SELECT filepath FROM workout WHERE source IS NOT 'gcdefault' AND type IS NOT 'code'");
     if (query.exec()) {
         while (query.next()) {
-            QFile file(query.value(0).toString());
-            if (! file.open(QIODevice::ReadOnly)) {
+            QString filepath = query.value(0).toString();
+
+            // only read the file if it changed since it was last scanned
+            WorkoutFileStamp stamp = fileStamp(filepath, false);
+            if (stamp.size < 0) {
                 continue;
             }
-            QCryptographicHash hash(QCryptographicHash::Md5);
-            while (! file.atEnd()) {
-                hash.addData(file.read(8192));
+            auto known = stamps.constFind(filepath);
+            if (known != stamps.constEnd() && known->sameFile(stamp)) {
+                stamp.hash = known->hash;
+            } else {
+                stamp = fileStamp(filepath);
             }
-            ret.insert(hash.result().toHex(), query.value(0).toString());
+            ret.insert(stamp.hash, filepath);
         }
     }
     return ret;
@@ -727,6 +742,7 @@ TrainDB::checkDBVersion
 {
     QSet<QString> dataTables;
     dataTables << TABLE_WORKOUT
+               << TABLE_WORKOUT_SCAN
                << TABLE_VIDEO
                << TABLE_VIDEOSYNC
                << TABLE_TAGSTORE
@@ -922,10 +938,73 @@ TrainDB::deleteWorkout
     query.bindValue(":filepath", filepath);
     ok &= query.exec();
 
+    query.prepare("DELETE FROM workout_scan WHERE filepath = :filepath");
+    query.bindValue(":filepath", filepath);
+    ok &= query.exec();
+
     return ok;
 }
 
 
+WorkoutFileStamp
+TrainDB::fileStamp
+(const QString &filepath, bool withHash)
+{
+    WorkoutFileStamp stamp;
+    QFileInfo info(filepath);
+    if (! info.exists()) {
+        return stamp;
+    }
+    stamp.size = info.size();
+    stamp.mtime = info.lastModified().toMSecsSinceEpoch();
+    if (withHash) {
+        QFile file(filepath);
+        if (file.open(QIODevice::ReadOnly)) {
+            QCryptographicHash hash(QCryptographicHash::Md5);
+            while (! file.atEnd()) {
+                hash.addData(file.read(8192));
+            }
+            stamp.hash = hash.result().toHex();
+        }
+    }
+    return stamp;
+}
+
+
+QHash<QString, WorkoutFileStamp>
+TrainDB::getWorkoutStamps
+() const
+{
+    QHash<QString, WorkoutFileStamp> ret;
+    QSqlQuery query(connection());
+    query.prepare("SELECT filepath, size, mtime, hash FROM workout_scan");
+    if (query.exec()) {
+        while (query.next()) {
+            WorkoutFileStamp stamp;
+            stamp.size = query.value(1).toLongLong();
+            stamp.mtime = query.value(2).toLongLong();
+            stamp.hash = query.value(3).toString();
+            ret.insert(query.value(0).toString(), stamp);
+        }
+    }
+    return ret;
+}
+
+
+bool
+TrainDB::stampWorkout
+(QString filepath, const WorkoutFileStamp &stamp) const
+{
+    QSqlQuery query(connection());
+    query.prepare("INSERT OR REPLACE INTO workout_scan (filepath, size, mtime, hash) VALUES (:filepath, :size, :mtime, :hash)");
+    query.bindValue(":filepath", filepath);
+    query.bindValue(":size", stamp.size);
+    query.bindValue(":mtime", stamp.mtime);
+    query.bindValue(":hash", stamp.hash);
+    return query.exec();
+}
+
+
 bool
 TrainDB::rateWorkout
 (QString filepath, int rating)
@@ -1274,6 +1353,7 @@ TrainDB::createAllDataTables
     if (ret > 0) {
         ok &= createDefaultEntriesWorkout();
     }
+    ok &= createTable(TABLE_WORKOUT_SCAN, FIELDS_WORKOUT_SCAN) != -1;
     ok &= (ret = createTable(TABLE_VIDEO, FIELDS_VIDEO)) != -1;
     if (ret > 0) {
         ok &= createDefaultEntriesVideo();
@@ -1299,6 +1379,7 @@ TrainDB::dropAllDataTables
 () const
 {
     bool ok = dropTable(TABLE_WORKOUT);
+    ok &= dropTable(TABLE_WORKOUT_SCAN);
     ok &= dropTable(TABLE_VIDEO);
     ok &= dropTable(TABLE_VIDEOSYNC);
     ok &= dropTable(TABLE_TAGSTORE);
@@ -111,6 +111,16 @@ struct WorkoutUserInfo {
     qlonglong lastRun = 0;
 };
 
+// what the workout file looked like when it was last parsed, so
+// a rescan of the library can skip files that have not changed
+struct WorkoutFileStamp {
+    qint64 size = -1;
+    qlonglong mtime = 0;
+    QString hash;       // md5 of the content, empty if not computed
+
+    bool sameFile(const WorkoutFileStamp &other) const { return size == other.size && mtime == other.mtime; }
+};
+
 enum class ZoneContentType {
     percent,
     seconds
@@ -151,6 +161,11 @@ class TrainDB : public QObject, public TagStore
         bool lastWorkout(QString filepath);
         WorkoutUserInfo getWorkoutUserInfo(QString filepath) const;
 
+        // stamps of parsed workout files, see WorkoutFileStamp
+        static WorkoutFileStamp fileStamp(const QString &filepath, bool withHash = true);
+        QHash<QString, WorkoutFileStamp> getWorkoutStamps() const;
+        bool stampWorkout(QString filepath, const WorkoutFileStamp &stamp) const;
+
         bool importVideo(QString filepath, ImportMode importMode = ImportMode::insert) const;
         bool hasVideo(QString filepath) const;
         bool deleteVideo(QString filepath) const;
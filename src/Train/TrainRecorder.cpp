@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "TrainRecorder.h"
+
+#include <QElapsedTimer>
+
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#define WRITERATE 250   // writer wakes to drain the queue, in milliseconds
+#define SYNCRATE  5000  // fsync to disk, in milliseconds
+
+TrainRecorder::TrainRecorder(QObject *parent) : QThread(parent), queue(256), stopping(false), droppedRecords(0)
+{
+}
+
+TrainRecorder::~TrainRecorder()
+{
+    close();
+}
+
+bool
+TrainRecorder::open(QString filename, QDateTime startTime)
+{
+    close();
+
+    file.setFileName(filename);
+    if (!file.open(QFile::WriteOnly | QFile::Truncate)) return false;
+
+    TrainRecordHeader header;
+    header.magic = TRAINRECORD_MAGIC;
+    header.version = TRAINRECORD_VERSION;
+    header.recordSize = sizeof(TrainRecord);
+    header.reserved = 0;
+    header.startTime = startTime.toMSecsSinceEpoch();
+    if (file.write(reinterpret_cast<const char *>(&header), sizeof(header)) != sizeof(header)) {
+        file.close();
+        return false;
+    }
+    sync();
+
+    droppedRecords = 0;
+    stopping = false;
+    start();
+    return true;
+}
+
+void
+TrainRecorder::close()
+{
+    if (isRunning()) {
+        stopping = true;
+        wait();
+    }
+    if (file.isOpen()) {
+        drain();
+        sync();
+        file.close();
+    }
+}
+
+bool
+TrainRecorder::remove()
+{
+    close();
+    return file.remove();
+}
+
+bool
+TrainRecorder::append(const TrainRecord &record)
+{
+    TrainRecord sealed = record;
+    sealed.seal();
+    if (!queue.push(sealed)) {
+        droppedRecords++;
+        return false;
+    }
+    return true;
+}
+
+void
+TrainRecorder::run()
+{
+    QElapsedTimer synced;
+    synced.start();
+
+    while (!stopping) {
+        msleep(WRITERATE);
+
+        drain();
+        if (synced.elapsed() >= SYNCRATE) {
+            sync();
+            synced.restart();
+        }
+    }
+}
+
+void
+TrainRecorder::drain()
+{
+    TrainRecord record;
+    while (queue.pop(record)) {
+        file.write(reinterpret_cast<const char *>(&record), sizeof(record));
+    }
+}
+
+void
+TrainRecorder::sync()
+{
+    // push Qt's buffer to the OS and then the OS to the disk
+    file.flush();
+#ifdef Q_OS_WIN
+    _commit(file.handle());
+#else
+    fsync(file.handle());
+#endif
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _GC_TrainRecorder_h
+#define _GC_TrainRecorder_h 1
+
+#include "TrainRecord.h"
+#include "SpscQueue.h"
+
+#include <QThread>
+#include <QFile>
+#include <QDateTime>
+#include <atomic>
+
+//
+// Writes the Train mode recording (.gctr) from its own thread so the
+// realtime loop only ever copies a record into a lock-free queue.
+//
+// The writer wakes a few times a second to append whatever is queued and
+// syncs the file to disk every SYNCRATE so at most that much is lost if
+// the machine goes down. The last record may be torn, the reader drops it.
+//
+class TrainRecorder : public QThread
+{
+    Q_OBJECT
+
+    public:
+
+        TrainRecorder(QObject *parent = NULL);
+        ~TrainRecorder();
+
+        // create the file, write the header and start writing
+        bool open(QString filename, QDateTime startTime);
+
+        // stop, write anything still queued and close
+        void close();
+
+        // drops the record when the writer has fallen behind
+        // (over a minute at 4Hz), call from one thread only
+        bool append(const TrainRecord &record);
+
+        QString fileName() const { return file.fileName(); }
+        bool remove();
+
+        int dropped() const { return droppedRecords; }
+
+    protected:
+
+        void run();
+
+    private:
+
+        void drain();
+        void sync();
+
+        QFile file;
+        SpscQueue<TrainRecord> queue;
+        std::atomic<bool> stopping;
+        int droppedRecords;
+};
+
+#endif // _GC_TrainRecorder_h
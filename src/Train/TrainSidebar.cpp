@@ -17,6 +17,7 @@
  */
 
 #include "TrainSidebar.h"
+#include "RealtimeEngine.h"
 #include "MainWindow.h"
 #include "Context.h"
 #include "Athlete.h"
@@ -385,8 +386,10 @@ TrainSidebar::TrainSidebar(Context *context) : GcWindow(context), context(contex
     lap_elapsed_msec = 0;
     secs_to_start = 0;
 
-    rrFile = posFile = recordFile = vo2File = tcoreFile = NULL;
-    lastRecordSecs = 0;
+    rrFile = posFile = vo2File = tcoreFile = NULL;
+    recorder = new TrainRecorder(this);
+    engine = new RealtimeEngine(this);
+    lastRecordTick = 0;
     status = 0;
     setStatusFlags(RT_MODE_ERGO);         // ergo mode by default
     mode = ErgFileFormat::erg;
@@ -428,6 +431,9 @@ TrainSidebar::TrainSidebar(Context *context) : GcWindow(context), context(contex
 TrainSidebar::~TrainSidebar
 ()
 {
+    // stop polling before anything goes
+    engine->stop();
+
 #if !defined GC_VIDEO_NONE
     if (videoModel != nullptr) {
         delete videoModel;
@@ -970,14 +976,20 @@ TrainSidebar::workoutTreeWidgetSelectionChanged()
         clearStatusFlags(RT_MODE_SPIN);
 
         // update every active device
+        engine->setMode(RT_MODE_ERGO);
+        engine->deviceLock().lock();
         foreach(int dev, activeDevices) Devices[dev].controller->setMode(RT_MODE_ERGO);
+        engine->deviceLock().unlock();
 
     } else { // SLOPE MODE
         setStatusFlags(RT_MODE_SPIN);
         clearStatusFlags(RT_MODE_ERGO);
 
         // update every active device
+        engine->setMode(RT_MODE_SPIN);
+        engine->deviceLock().lock();
         foreach(int dev, activeDevices) Devices[dev].controller->setMode(RT_MODE_SPIN);
+        engine->deviceLock().unlock();
     }
 
     maintainLapDistanceState();
@@ -1297,6 +1309,8 @@ void TrainSidebar::Start()       // when start button is pressed
         session_time.start();
         lap_time.start();
         clearStatusFlags(RT_PAUSED);
+        engine->setErgTime(load_msecs);
+        engine->setRunning(true);
 
         // Reset speed simulation timer.
         bicycle.resettimer();
@@ -1329,6 +1343,7 @@ void TrainSidebar::Start()       // when start button is pressed
         session_elapsed_msec += session_time.elapsed();
         lap_elapsed_msec += lap_time.elapsed();
         setStatusFlags(RT_PAUSED);
+        engine->setRunning(false);
         //foreach(int dev, activeDevices) Devices[dev].controller->pause();
         //gui_timer->stop();
         if (status & RT_RECORDING) disk_timer->stop();
@@ -1395,11 +1410,17 @@ void TrainSidebar::Start()       // when start button is pressed
         if (mode == ErgFileFormat::erg || mode == ErgFileFormat::mrc) {
             setStatusFlags(RT_MODE_ERGO);
             clearStatusFlags(RT_MODE_SPIN);
+            engine->setMode(RT_MODE_ERGO);
+            engine->deviceLock().lock();
             foreach(int dev, activeDevices) Devices[dev].controller->setMode(RT_MODE_ERGO);
+            engine->deviceLock().unlock();
         } else { // SLOPE MODE
             setStatusFlags(RT_MODE_SPIN);
             clearStatusFlags(RT_MODE_ERGO);
+            engine->setMode(RT_MODE_SPIN);
+            engine->deviceLock().lock();
             foreach(int dev, activeDevices) Devices[dev].controller->setMode(RT_MODE_SPIN);
+            engine->deviceLock().unlock();
         }
 
         // tell the world
@@ -1417,7 +1438,14 @@ void TrainSidebar::Start()       // when start button is pressed
         lap_time.start();
         lap_elapsed_msec = 0;
         rtData = RealtimeDataSession(context, FTP, WPRIME, TAU);
-        
+
+        // the engine follows the workout and works out W'bal from here
+        engine->setSession(rtData);
+        engine->setWbal(FTP, WPRIME, TAU);
+        engine->setErgProfile(context->currentErgFile());
+        engine->setErgTime(load_msecs);
+        engine->setRunning(true);
+
         resetTextAudioEmitTracking();
 
         //reset all calibration data
@@ -1450,25 +1478,17 @@ void TrainSidebar::Start()       // when start button is pressed
             QDateTime now = QDateTime::currentDateTime();
 
             // setup file
-            QString filename = now.toString(QString("yyyy_MM_dd_hh_mm_ss")) + "_" + workoutName + QString(".csv");
+            QString filename = now.toString(QString("yyyy_MM_dd_hh_mm_ss")) + "_" + workoutName + QString(".gctr");
 
             if (!context->athlete->home->records().exists())
                 context->athlete->home->createAllSubdirs();
 
             QString fulltarget = context->athlete->home->records().canonicalPath() + "/" + filename;
 
-            if (recordFile) delete recordFile;
-            recordFile = new QFile(fulltarget);
-            lastRecordSecs = 0;
-            if (!recordFile->open(QFile::WriteOnly | QFile::Truncate)) {
+            lastRecordTick = 0;
+            if (!recorder->open(fulltarget, now)) {
                 clearStatusFlags(RT_RECORDING);
             } else {
-
-                // CSV File header
-
-                QTextStream recordFileStream(recordFile);
-                recordFileStream << "secs, cad, hr, km, kph, nm, watts, alt, lon, lat, headwind, slope, temp, interval, lrbalance, lte, rte, lps, rps, smo2, thb, o2hb, hhb, target, rppb, rppe, rpppb, rpppe, lppb, lppe, lpppb, lpppe\n";
-
                 disk_timer->start(SAMPLERATE);  // start screen
             }
         }
@@ -1490,7 +1510,11 @@ void TrainSidebar::Pause()        // pause capture to recalibrate
         session_time.start();
         lap_time.start();
         clearStatusFlags(RT_PAUSED);
+        engine->deviceLock().lock();
         foreach(int dev, activeDevices) Devices[dev].controller->restart();
+        engine->deviceLock().unlock();
+        engine->setErgTime(load_msecs);
+        engine->setRunning(true);
         gui_timer->start(REFRESHRATE);
         if (status & RT_RECORDING) disk_timer->start(SAMPLERATE);
         load_period.restart();
@@ -1509,7 +1533,10 @@ void TrainSidebar::Pause()        // pause capture to recalibrate
 
         session_elapsed_msec += session_time.elapsed();
         lap_elapsed_msec += lap_time.elapsed();
+        engine->setRunning(false);
+        engine->deviceLock().lock();
         foreach(int dev, activeDevices) Devices[dev].controller->pause();
+        engine->deviceLock().unlock();
         setStatusFlags(RT_PAUSED);
         gui_timer->stop();
         if (status & RT_RECORDING) disk_timer->stop();
@@ -1539,6 +1566,7 @@ void TrainSidebar::Stop(int deviceStatus)        // when stop button is pressed
 #endif
 
     clearStatusFlags(RT_RUNNING|RT_PAUSED);
+    engine->setRunning(false);
 
     // Stop users from selecting different devices
     // media or workouts whilst a workout is in progress
@@ -1568,12 +1596,13 @@ void TrainSidebar::Stop(int deviceStatus)        // when stop button is pressed
 
     load = 0;
     slope = 0.0;
+    engine->setHold(false);
 
     if (status & RT_RECORDING) {
         disk_timer->stop();
 
-        // close and reset File
-        recordFile->close();
+        // close and reset File, waits for the writer to finish
+        recorder->close();
 
         // Request mutual exclusion with ANT+/BTLE threads to change status and close rr/vo2 files
         rrMutex.lock();
@@ -1620,12 +1649,12 @@ void TrainSidebar::Stop(int deviceStatus)        // when stop button is pressed
 
         if(deviceStatus == DEVICE_ERROR)
         {
-            recordFile->remove();
+            recorder->remove();
         }
         else {
             // add to the view - using basename ONLY
             QString name;
-            name = recordFile->fileName();
+            name = recorder->fileName();
 
             QList<QString> list;
             list.append(name);
@@ -1765,6 +1794,22 @@ void TrainSidebar::Connect()
         Devices[dev].controller->resetCalibrationState();
         connect(Devices[dev].controller, &RealtimeController::setNotification, context, &Context::setNotification);
     }
+
+    // poll them from now on, the gui picks up what it has
+    engine->clearDevices();
+    foreach(int dev, activeDevices) {
+        int telemetry = (dev == bpmTelemetry ? RealtimeEngine::Hr : 0) |
+                        (dev == rpmTelemetry ? RealtimeEngine::Cadence : 0) |
+                        (dev == kphTelemetry ? RealtimeEngine::Speed : 0) |
+                        (dev == wattsTelemetry ? RealtimeEngine::Watts : 0);
+        engine->addDevice(Devices[dev].controller, Devices[dev].type, telemetry);
+    }
+    engine->setMode(status&RT_MODE_ERGO ? RT_MODE_ERGO : RT_MODE_SPIN);
+    engine->setLoad(load);
+    engine->setGradient(slope);
+    engine->setSession(rtData);
+    engine->begin();
+
     setStatusFlags(RT_CONNECTED);
     gui_timer->start(REFRESHRATE);
 
@@ -1784,6 +1829,9 @@ void TrainSidebar::Disconnect()
 
     qDebug() << "disconnecting..";
 
+    // stop polling before the devices go
+    engine->stop();
+
     foreach(int dev, activeDevices) {
         disconnect(Devices[dev].controller, &RealtimeController::setNotification, context, &Context::setNotification);
         Devices[dev].controller->stop();
@@ -1825,6 +1873,7 @@ void TrainSidebar::guiUpdate()           // refreshes the telemetry
 #endif
 
         if(calibrating) {
+            engine->deviceLock().lock();
             foreach(int dev, activeDevices) { // Do for selected device only
                 RealtimeData local = rtData;
 
@@ -1861,6 +1910,7 @@ void TrainSidebar::guiUpdate()           // refreshes the telemetry
 
                 }
             }
+            engine->deviceLock().unlock();
 
             // calibration has completed (or failed), toggle out of calibration state
             // - do this outside of dev loop in case of no valid/supported device
@@ -1881,80 +1931,17 @@ void TrainSidebar::guiUpdate()           // refreshes the telemetry
 
             double distanceTick = 0;
 
+            // the devices are polled by the engine on its own thread, take the
+            // latest it has, including the load and slope the trainer is using
+            RealtimeData polled;
+            if (engine->latest(polled)) {
+                RealtimeEngine::merge(rtData, polled, RealtimeEngine::All);
+                rtData.setWbal(polled.getWbal());
+            }
+
             // If any of the active devices is a footpod, simulated speed will not be used, as it is a treadmill
             bool deviceIsFootpod = false;
-            // fetch the right data from each device...
             foreach(int dev, activeDevices) {
-
-                RealtimeData local = rtData;
-                Devices[dev].controller->getRealtimeData(local);
-
-                // get spinscan data from a computrainer?
-                if (Devices[dev].type == DEV_CT) {
-                    memcpy((uint8_t*)rtData.spinScan, (uint8_t*)local.spinScan, 24);
-                    rtData.setLoad(local.getLoad()); // and get load in case it was adjusted
-                    rtData.setSlope(local.getSlope()); // and get slope in case it was adjusted
-                    // to within defined limits
-                }
-
-                if (Devices[dev].type == DEV_FORTIUS || Devices[dev].type == DEV_IMAGIC) {
-	                rtData.setLoad(local.getLoad()); // and get load in case it was adjusted
-                    rtData.setSlope(local.getSlope()); // and get slope in case it was adjusted
-					// to within defined limits
-				}
-
-                if (Devices[dev].type == DEV_ANTLOCAL || Devices[dev].type == DEV_NULL) {
-                    rtData.setHb(local.getSmO2(), local.gettHb()); //only moxy data from ant and robot devices right now
-                    rtData.setTemp(local.getTemp());
-                }
-
-                if (Devices[dev].type == DEV_NULL || Devices[dev].type == DEV_BT40) {
-                    // Only robot and BT40 devices provides VO2 metrics
-                    rtData.setRf(local.getRf());
-                    rtData.setRMV(local.getRMV());
-                    rtData.setVO2_VCO2(local.getVO2(), local.getVCO2());
-                    rtData.setTv(local.getTv());
-                    rtData.setFeO2(local.getFeO2());
-                }
-
-                rtData.setCoreTemp(local.getCoreTemp(),local.getSkinTemp(),local.getHeatStrain());
-                // what are we getting from this one?
-                if (dev == bpmTelemetry) rtData.setHr(local.getHr());
-                if (dev == rpmTelemetry) rtData.setCadence(local.getCadence());
-                if (dev == kphTelemetry) {
-                    rtData.setSpeed(local.getSpeed());
-                    rtData.setDistance(local.getDistance());
-                    rtData.setRouteDistance(local.getRouteDistance());
-                    rtData.setDistanceRemaining(local.getDistanceRemaining());
-                    rtData.setLapDistance(local.getLapDistance());
-                    rtData.setLapDistanceRemaining(local.getLapDistanceRemaining());
-                }
-                if (dev == wattsTelemetry) {
-                    rtData.setWatts(local.getWatts());
-                    rtData.setAltWatts(local.getAltWatts());
-                    rtData.setLRBalance(local.getLRBalance());
-                    rtData.setLTE(local.getLTE());
-                    rtData.setRTE(local.getRTE());
-                    rtData.setLPS(local.getLPS());
-                    rtData.setRPS(local.getRPS());
-                    rtData.setRppb(local.getRppb());
-                    rtData.setRppe(local.getRppe());
-                    rtData.setRpppb(local.getRpppb());
-                    rtData.setRpppe(local.getRpppe());
-                    rtData.setLppb(local.getLppb());
-                    rtData.setLppe(local.getLppe());
-                    rtData.setLpppb(local.getLpppb());
-                    rtData.setLpppe(local.getLpppe());
-                }
-                if (local.getTrainerStatusAvailable())
-                {
-                    rtData.setTrainerStatusAvailable(true);
-                    rtData.setTrainerReady(local.getTrainerReady());
-                    rtData.setTrainerRunning(local.getTrainerRunning());
-                    rtData.setTrainerCalibRequired(local.getTrainerCalibRequired());
-                    rtData.setTrainerConfigRequired(local.getTrainerConfigRequired());
-                    rtData.setTrainerBrakeFault(local.getTrainerBrakeFault());
-                }
                 if (Devices[dev].type == DEV_ANTLOCAL && Devices[dev].deviceProfile.contains("o")) {
                     deviceIsFootpod = true;
                 }
@@ -2175,6 +2162,9 @@ void TrainSidebar::guiUpdate()           // refreshes the telemetry
 
             // go update the displays...
             context->notifyTelemetryUpdate(rtData); // signal everyone to update telemetry
+
+            // and the devices get polled with it next time
+            engine->setSession(rtData);
         }
 
 #ifdef Q_OS_MAC
@@ -2230,88 +2220,56 @@ void TrainSidebar::warnnoConfig()
     QMessageBox::warning(this, tr("No Devices Configured"), tr("Please configure a device in Preferences."));
 }
 
-template<class T, typename T_GetMethod, typename T_SetMethod, typename T_arg>
-struct ScopedOp
-{
-    T* m_pt;
-    T_SetMethod m_setMethod;
-    T_arg m_argSave;
-
-    ScopedOp(T* pt, T_GetMethod getMethod, T_SetMethod setMethod, T_arg argNew) : m_pt(pt), m_setMethod(setMethod) {
-        m_argSave = (m_pt->*getMethod)();
-        (m_pt->*m_setMethod)(argNew);
-    }
-
-    virtual ~ScopedOp() { (m_pt->*m_setMethod)(m_argSave); }
-};
-
-struct ScopedPrecision : ScopedOp<QTextStream, int (QTextStream::*)() const, void (QTextStream::*)(int), int> {
-    ScopedPrecision(QTextStream* pc, int tempPrecision) : ScopedOp::ScopedOp(pc, &QTextStream::realNumberPrecision, &QTextStream::setRealNumberPrecision, tempPrecision) {}
-};
-
 //----------------------------------------------------------------------
 // DISK UPDATE FUNCTIONS
 //----------------------------------------------------------------------
 void TrainSidebar::diskUpdate()
 {
-    int  secs;
-
-    long torq = 0;
-    QTextStream recordFileStream(recordFile);
-
     if (calibrating) return;
 
-    // convert from milliseconds to secondes
+    // samples are on a SAMPLERATE grid
     total_msecs = session_elapsed_msec + session_time.elapsed();
-    secs = round(total_msecs / 1000.0);
-
-    if (secs <= lastRecordSecs) return; // Avoid duplicates
-    lastRecordSecs = secs;
-
-    // GoldenCheetah CVS Format "secs, cad, hr, km, kph, nm, watts, alt, lon, lat, headwind, slope, temp, interval, lrbalance, lte, rte, lps, rps, smo2, thb, o2hb, hhb, target, rppb, rppe, rpppb, rpppe, lppb, lppe, lpppb, lpppe\n";
-
-    recordFileStream    << secs
-                        << "," << displayCadence
-                        << "," << displayHeartRate
-                        << "," << displayDistance
-                        << "," << displaySpeed
-                        << "," << torq
-                        << "," << displayPower;
-
-    // QTextStream default precision is 6, location data needs much more than that.
-    // Avoid extra precision for other fields since it isn't needed and would grow
-    // the intermediate file for no reason.
-    {
-        ScopedPrecision tempPrecision(&recordFileStream, 20);
-
-        recordFileStream << "," << displayAltitude
-                         << "," << displayLongitude
-                         << "," << displayLatitude;
-    }
-
-    recordFileStream    << "," // headwind
-                        << "," << slope
-                        << "," << displayTemp
-                        << "," << displayWorkoutLap
-                        << "," << displayLRBalance
-                        << "," << displayLTE
-                        << "," << displayRTE
-                        << "," << displayLPS
-                        << "," << displayRPS
-                        << "," << displaySMO2
-                        << "," << displayTHB
-                        << "," << displayO2HB
-                        << "," << displayHHB
-                        << "," << load
-                        << "," << displayRppb
-                        << "," << displayRppe
-                        << "," << displayRpppb
-                        << "," << displayRpppe
-                        << "," << displayLppb
-                        << "," << displayLppe
-                        << "," << displayLpppb
-                        << "," << displayLpppe
-                        << "," << "\n";
+    long tick = round(total_msecs / double(SAMPLERATE));
+
+    if (tick <= lastRecordTick) return; // Avoid duplicates
+    lastRecordTick = tick;
+
+    // just copy the values, the recorder thread does the writing
+    TrainRecord record;
+    record.secs = tick * (SAMPLERATE / 1000.0);
+    record.cad = displayCadence;
+    record.hr = displayHeartRate;
+    record.km = displayDistance;
+    record.kph = displaySpeed;
+    record.nm = 0;
+    record.watts = displayPower;
+    record.alt = displayAltitude;
+    record.lon = displayLongitude;
+    record.lat = displayLatitude;
+    record.headwind = 0;
+    record.slope = slope;
+    record.temp = displayTemp;
+    record.interval = displayWorkoutLap;
+    record.lrbalance = displayLRBalance;
+    record.lte = displayLTE;
+    record.rte = displayRTE;
+    record.lps = displayLPS;
+    record.rps = displayRPS;
+    record.smo2 = displaySMO2;
+    record.thb = displayTHB;
+    record.o2hb = displayO2HB;
+    record.hhb = displayHHB;
+    record.target = load;
+    record.rppb = displayRppb;
+    record.rppe = displayRppe;
+    record.rpppb = displayRpppb;
+    record.rpppe = displayRpppe;
+    record.lppb = displayLppb;
+    record.lppe = displayLppe;
+    record.lpppb = displayLpppb;
+    record.lpppe = displayLpppe;
+
+    recorder->append(record);
 }
 
 //----------------------------------------------------------------------
@@ -2345,7 +2303,9 @@ void TrainSidebar::loadUpdate()
         if (load == -100) {
             Stop(DEVICE_OK);
         } else {
-            foreach(int dev, activeDevices) Devices[dev].controller->setLoad(load);
+            // the engine applies it, and follows the workout between updates
+            engine->setLoad(load);
+            engine->setErgTime(load_msecs);
             context->notifySetNow(load_msecs);
         }
     } else {
@@ -2365,10 +2325,8 @@ void TrainSidebar::loadUpdate()
         if (slope == -100) {
             Stop(DEVICE_OK);
         } else {
-            foreach(int dev, activeDevices) {
-                Devices[dev].controller->setGradient(slope);
-                Devices[dev].controller->setWindResistance(bicycle.WindResistance(displayAltitude));
-            }
+            engine->setGradient(slope);
+            engine->setWindResistance(bicycle.WindResistance(displayAltitude));
             context->notifySetNow(displayWorkoutDistance * 1000);
         }
     }
@@ -2400,6 +2358,7 @@ void TrainSidebar::toggleCalibration()
         context->notifyUnPause(); // get video started again, amongst other things
 
         // back to ergo/slope mode and restore load/gradient
+        engine->deviceLock().lock();
         if (status&RT_MODE_ERGO) {
 
             foreach(int dev, activeDevices) {
@@ -2419,6 +2378,12 @@ void TrainSidebar::toggleCalibration()
                 }
             }
         }
+        engine->deviceLock().unlock();
+
+        // and the engine can carry on with them
+        engine->setErgTime(load_msecs);
+        engine->setRunning(true);
+        engine->setHold(false);
 
     } else {
 
@@ -2434,6 +2399,11 @@ void TrainSidebar::toggleCalibration()
 
         context->notifyPause(); // get video started again, amongst other things
 
+        // the engine leaves the devices to us until we're done
+        engine->setRunning(false);
+        engine->setHold(true);
+        engine->deviceLock().lock();
+
         calibrationDeviceIndex = getCalibrationIndex();
 
         // only do this for the selected device
@@ -2452,6 +2422,7 @@ void TrainSidebar::toggleCalibration()
                 Devices[dev].controller->setCalibrationState(CALIBRATION_STATE_PENDING);
             }
         }
+        engine->deviceLock().unlock();
 
         if (calibrationDeviceIndex == -1)
             qDebug() << "No device(s) found with calibration support";
@@ -2889,9 +2860,9 @@ void TrainSidebar::Higher()
         if (slope >40) slope = 40;
 
         if (status&RT_MODE_ERGO)
-            foreach(int dev, activeDevices) Devices[dev].controller->setLoad(load);
+            engine->setLoad(load);
         else
-            foreach(int dev, activeDevices) Devices[dev].controller->setGradient(slope);
+            engine->setGradient(slope);
     }
 
     context->notifySetNotification(tr("Increasing intensity.."), 2);
@@ -2915,9 +2886,9 @@ void TrainSidebar::Lower()
         if (slope <-40) slope = -40;
 
         if (status&RT_MODE_ERGO)
-            foreach(int dev, activeDevices) Devices[dev].controller->setLoad(load);
+            engine->setLoad(load);
         else
-            foreach(int dev, activeDevices) Devices[dev].controller->setGradient(slope);
+            engine->setGradient(slope);
     }
 
     context->notifySetNotification(tr("Decreasing intensity.."), 2);
@@ -3026,6 +2997,7 @@ void TrainSidebar::adjustIntensity(int value)
     // Ergfile points have been edited so reset interpolation and
     // query state.
     ergFileQueryAdapter.resetQueryState();
+    engine->setErgProfile(ergFile);
 
     // unblock signals now we are done
     context->mainWindow->blockSignals(false);
@@ -3299,8 +3271,8 @@ void TrainSidebar::rrData(uint16_t  rrtime, uint8_t count, uint8_t bpm)
 
     QMutexLocker locker(&rrMutex);
 
-    if (status&RT_RECORDING && rrFile == NULL && recordFile != NULL) {
-        QString rrfile = recordFile->fileName().replace("csv", "rr");
+    if (status&RT_RECORDING && rrFile == NULL && recorder->isRunning()) {
+        QString rrfile = recorder->fileName().replace(".gctr", ".rr");
         //fprintf(stderr, "First r-r, need to open file %s\n", rrfile.toStdString().c_str()); fflush(stderr);
 
         // setup the rr file
@@ -3337,8 +3309,8 @@ void TrainSidebar::posData(uint8_t position)
     // convert from milliseconds to secondes
     double secs = double(session_elapsed_msec + session_time.elapsed()) / 1000.00;
 
-    if (status&RT_RECORDING && posFile == NULL && recordFile != NULL) {
-        QString posFilename = recordFile->fileName().replace(".csv", ".pos.csv");
+    if (status&RT_RECORDING && posFile == NULL && recorder->isRunning()) {
+        QString posFilename = recorder->fileName().replace(".gctr", ".pos.csv");
         //fprintf(stderr, "First cyclist position, need to open file %s\n", posFilename.toStdString().c_str()); fflush(stderr);
 
         // setup the pos.csv file
@@ -3370,8 +3342,8 @@ void TrainSidebar::posData(uint8_t position)
 // Coretemp data received
 void TrainSidebar::tcoreData(float  core, float skin, float hsi, int qual)
 {
-    if (status&RT_RECORDING && tcoreFile == NULL && recordFile != NULL) {
-        QString tcorefile = recordFile->fileName().replace("csv", "tcr");
+    if (status&RT_RECORDING && tcoreFile == NULL && recorder->isRunning()) {
+        QString tcorefile = recorder->fileName().replace(".gctr", ".tcr");
 
         // setup the rr file
         tcoreFile = new QFile(tcorefile);
@@ -3403,8 +3375,8 @@ void TrainSidebar::vo2Data(double rf, double rmv, double vo2, double vco2, doubl
 {
     QMutexLocker locker(&vo2Mutex);
 
-    if (status&RT_RECORDING && vo2File == NULL && recordFile != NULL) {
-        QString vo2filename = recordFile->fileName().replace("csv", "vo2");
+    if (status&RT_RECORDING && vo2File == NULL && recorder->isRunning()) {
+        QString vo2filename = recorder->fileName().replace(".gctr", ".vo2");
 
         // setup the rr file
         vo2File = new QFile(vo2filename);
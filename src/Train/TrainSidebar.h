@@ -34,6 +34,7 @@
 #include "PhysicsUtility.h"
 #include "MultiFilterProxyModel.h"
 #include "InfoWidget.h"
+#include "TrainRecorder.h"
 
 // standard stuff
 #include <QDir>
@@ -72,7 +73,7 @@
 // msecs constants for timers
 #define REFRESHRATE    200 // screen refresh in milliseconds
 #define STREAMRATE     200 // rate at which we stream updates to remote peer
-#define SAMPLERATE     1000 // disk update in milliseconds
+#define SAMPLERATE     1000 // disk update in milliseconds, can be less than a second
 #define LOADRATE       1000 // rate at which load is adjusted
 
 // device treeview node types
@@ -81,6 +82,7 @@
 #define WORKOUT_TYPE 4444
 
 class RealtimeController;
+class RealtimeEngine;
 class ComputrainerController;
 class ANTlocalController;
 class NullController;
@@ -201,7 +203,7 @@ class TrainSidebar : public GcWindow
 
         // Timed actions
         void guiUpdate();           // refreshes the telemetry
-        void diskUpdate();          // writes to CSV file
+        void diskUpdate();          // queues a record for the recorder
         void loadUpdate();          // sets Load on CT like devices
 
         // When no config has been setup
@@ -289,8 +291,9 @@ class TrainSidebar : public GcWindow
 
         QString codeWorkoutKey;     // traindb-key of the workout in the case of a code-workout; empty otherwise
         QString codeWorkoutTitle;   // title of the workout in the case of a code-workout; empty otherwise
-        QFile *recordFile;      // where we record!
-        int lastRecordSecs;     // to avoid duplicates
+        TrainRecorder *recorder; // where we record!
+        RealtimeEngine *engine; // polls the devices
+        long lastRecordTick;     // to avoid duplicates
         QMutex rrMutex;         // to coordinate async recording from ANT+ thread
         QFile *rrFile;          // r-r records, if any received.
         QMutex posMutex;        // to coordinate async recording from ANT+ thread
@@ -322,7 +325,7 @@ class TrainSidebar : public GcWindow
         QTimer      *gui_timer,     // refresh the gui
                     *load_timer,    // change the load on the device
                     *start_timer,   // delayed start
-                    *disk_timer;    // write to .CSV file
+                    *disk_timer;    // write to .gctr file
 
         bool autoConnect;
         bool pendingConfigChange;
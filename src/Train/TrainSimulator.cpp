@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "TrainSimulator.h"
+#include "DeviceTypes.h"
+#include "RideFile.h"
+
+#include <QElapsedTimer>
+#include <cmath>
+#include <cstring>
+
+TrainSimulator::TrainSimulator(Context *context, const ErgFile *ergFile, const RideFile *ride) :
+    ergFile(ergFile), device(ride), bicycle(context),
+    periodMsecs(REFRESHRATE), useSimulatedSpeed(true), replaying(ride != NULL),
+    CP(285), WPRIME(20000), TAU(300), // as TrainSidebar when there are no zones
+    load(0), slope(0), finished(false)
+{
+    ergFileQueryAdapter.setErgFile(ergFile);
+
+    // a workout with watts is ERG, anything else follows the slope
+    mode = (ergFile && ergFile->hasWatts()) ? RT_MODE_ERGO : RT_MODE_SLOPE;
+
+    // the replay is all there is, take everything from it
+    engine.addDevice(&device, DEV_NULL, RealtimeEngine::All);
+    engine.setMode(mode);
+
+    timing.ticks = 0;
+    timing.secs = 0;
+    timing.wallMsecs = 0;
+}
+
+void
+TrainSimulator::setWbal(double CP, double WPRIME, double TAU)
+{
+    this->CP = CP;
+    this->WPRIME = WPRIME;
+    this->TAU = TAU;
+}
+
+const TrainSimulator::Stats &
+TrainSimulator::run(double secs)
+{
+    // from the top, as TrainSidebar::Start
+    rtData = RealtimeData();
+    rtData.setWbal(WPRIME);
+    total_msecs = load_msecs = 0;
+    lastRecordTick = -1;
+    displayWorkoutLap = lapCount = 0;
+    displayDistance = displayWorkoutDistance = displayLapDistance = 0;
+    displaySpeed = displayAltitude = 0;
+    wbalMin = WPRIME;
+    finished = false;
+
+    // run to the end of what? it would never stop
+    bool ends = replaying || (ergFile && (ergFile->hasWatts() || ergFile->hasGradient()));
+    if (secs <= 0 && !ends) finished = true;
+
+    ergFileQueryAdapter.resetQueryState();
+    bicycle.clear();
+    device.start();
+
+    recorded.clear();
+    if (mode & RT_MODE_ERGO) recorded.reserve(ergFile->duration() / SAMPLERATE + 1);
+
+    engine.setWbal(CP, WPRIME, TAU);
+    engine.setErgProfile(mode & RT_MODE_ERGO ? ergFile : NULL);
+    engine.setErgTime(0);
+    engine.setLoad(load);
+    engine.setGradient(slope);
+    engine.setSession(rtData);
+    engine.setRunning(true);
+
+    timing.ticks = 0;
+    timing.secs = 0;
+
+    QElapsedTimer wall;
+    wall.start();
+
+    const double dt = periodMsecs / 1000.0;
+    long sinceLoad = LOADRATE;
+    while (!finished && (secs <= 0 || total_msecs < secs * 1000)) {
+
+        total_msecs += periodMsecs;
+        load_msecs += periodMsecs;
+
+        // the load timer
+        sinceLoad += periodMsecs;
+        if (sinceLoad >= LOADRATE) {
+            sinceLoad = 0;
+            loadUpdate();
+            if (finished) break;
+        }
+
+        // the engine polls the rider
+        device.setTime(total_msecs / 1000.0);
+        engine.setSession(rtData);
+        engine.step(dt);
+
+        // the refresh timer, then the disk timer
+        guiUpdate(dt);
+        diskUpdate();
+
+        if (device.finished()) finished = true;
+        timing.ticks++;
+    }
+
+    engine.setRunning(false);
+    timing.secs = total_msecs / 1000.0;
+    timing.wallMsecs = wall.elapsed();
+    return timing;
+}
+
+// as TrainSidebar::loadUpdate
+void
+TrainSimulator::loadUpdate()
+{
+    int curLap = 0;
+
+    if (mode & RT_MODE_ERGO) {
+
+        load = ergFileQueryAdapter.wattsAt(load_msecs, curLap);
+
+        // we got to the end!
+        if (load == -100) {
+            finished = true;
+            return;
+        }
+        engine.setLoad(load);
+        engine.setErgTime(load_msecs);
+
+    } else {
+
+        if (ergFile) {
+            // Call gradientAt to obtain current lap num.
+            ergFileQueryAdapter.gradientAt(displayWorkoutDistance * 1000., curLap);
+        }
+
+        // we got to the end!
+        if (slope == -100) {
+            finished = true;
+            return;
+        }
+        engine.setGradient(slope);
+        engine.setWindResistance(bicycle.WindResistance(displayAltitude));
+    }
+
+    if (ergFile) {
+        if (displayWorkoutLap != curLap) {
+            lapCount++;
+            displayLapDistance = 0;
+        }
+        displayWorkoutLap = curLap;
+    }
+}
+
+// as TrainSidebar::guiUpdate whilst running
+void
+TrainSimulator::guiUpdate(double secs)
+{
+    rtData.setLap(displayWorkoutLap);
+    rtData.mode = mode;
+    rtData.setLoad(load);
+    rtData.setSlope(slope);
+    rtData.setAltitude(displayAltitude);
+
+    RealtimeData polled;
+    if (engine.latest(polled)) {
+        RealtimeEngine::merge(rtData, polled, RealtimeEngine::All);
+        rtData.setWbal(polled.getWbal());
+    }
+
+    double distanceTick;
+    if (useSimulatedSpeed) {
+        BicycleSimState newState(rtData);
+        SpeedDistance ret = bicycle.SampleSpeed(newState, secs);
+        rtData.setSpeed(ret.v);
+        distanceTick = ret.d;
+    } else {
+        distanceTick = rtData.getSpeed() * secs / 3600.0;
+    }
+
+    displayDistance += distanceTick;
+    displayLapDistance += distanceTick;
+    displayWorkoutDistance += distanceTick;
+
+    rtData.setDistance(displayDistance);
+    rtData.setRouteDistance(displayWorkoutDistance);
+    rtData.setLapDistance(displayLapDistance);
+
+    // follow the course
+    if (ergFile && ergFile->hasGradient()) {
+        int curLap;
+        slope = ergFileQueryAdapter.gradientAt(displayWorkoutDistance * 1000, curLap);
+        if (slope != -100) displayAltitude = ergFileQueryAdapter.altitudeAt(displayWorkoutDistance * 1000, curLap);
+        rtData.setSlope(slope);
+        rtData.setAltitude(displayAltitude);
+
+    } else if (!(mode & RT_MODE_ERGO)) {
+        displayAltitude += slope * (10 * distanceTick);
+        rtData.setAltitude(displayAltitude);
+    }
+
+    rtData.setMsecs(total_msecs);
+
+    displaySpeed = rtData.getSpeed();
+    load = rtData.getLoad();
+    if (rtData.getWbal() < wbalMin) wbalMin = rtData.getWbal();
+}
+
+// as TrainSidebar::diskUpdate, but kept rather than written
+void
+TrainSimulator::diskUpdate()
+{
+    long tick = round(total_msecs / double(SAMPLERATE));
+    if (tick <= lastRecordTick) return;
+    lastRecordTick = tick;
+
+    TrainRecord record;
+    memset(&record, 0, sizeof(record));
+    record.secs = tick * (SAMPLERATE / 1000.0);
+    record.cad = rtData.getCadence();
+    record.hr = rtData.getHr();
+    record.km = displayDistance;
+    record.kph = displaySpeed;
+    record.watts = rtData.getWatts();
+    record.alt = displayAltitude;
+    record.slope = slope;
+    record.interval = displayWorkoutLap;
+    record.target = load;
+
+    recorded << record;
+}
+
+QString
+TrainSimulator::Stats::toString() const
+{
+    return QString("ticks=%1 simulated=%2s took=%3ms ticks/s=%4 speedup=%5x")
+           .arg(ticks).arg(secs, 0, 'f', 1).arg(wallMsecs)
+           .arg(ticksPerSec(), 0, 'f', 0).arg(speedup(), 0, 'f', 0);
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2026 GoldenCheetah
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 51
+ * Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _GC_TrainSimulator_h
+#define _GC_TrainSimulator_h 1
+#include "GoldenCheetah.h"
+
+#include "RealtimeEngine.h"
+#include "ReplayController.h"
+#include "RealtimeData.h"
+#include "ErgFile.h"
+#include "BicycleSim.h"
+#include "TrainRecordFile.h"
+
+#include <QVector>
+
+class Context;
+class RideFile;
+
+//
+// Runs a workout or course through Train mode with no devices and no GUI,
+// as fast as it will go rather than in real time.
+//
+// The rider is a ReplayController, replaying a ride or holding whatever the
+// trainer asks for, polled by a RealtimeEngine stepped by hand so the load,
+// gradient and W'bal are worked out just as when riding. Around it we do
+// what TrainSidebar does each refresh and load update: simulated speed and
+// distance from the Bicycle model, following the workout or course, laps,
+// and a record every SAMPLERATE as would be written to the .gctr.
+//
+// For checking what the trainer is asked to do against a workout, and for
+// timing the realtime path (ticks a second, allocations a tick when run
+// under a heap profiler).
+//
+class TrainSimulator
+{
+    public:
+
+        struct Stats {
+            quint64 ticks;
+            double secs;            // simulated
+            qint64 wallMsecs;       // it took
+
+            double ticksPerSec() const { return wallMsecs > 0 ? ticks * 1000.0 / wallMsecs : 0; }
+            double speedup() const { return wallMsecs > 0 ? secs * 1000.0 / wallMsecs : 0; }
+            QString toString() const;
+        };
+
+        // ERG when the workout has watts, otherwise SLOPE following the course
+        // if there is one; no ride and the rider holds the load asked for
+        TrainSimulator(Context *context, const ErgFile *ergFile, const RideFile *ride = NULL);
+
+        // simulated time between ticks, REFRESHRATE by default
+        void setPeriod(int msecs) { periodMsecs = qMax(1, msecs); }
+
+        // the defaults are the ones used when there are no zones
+        void setWbal(double CP, double WPRIME, double TAU);
+
+        // speed from the Bicycle model (the default) rather than the device
+        void setSimulatedSpeed(bool x) { useSimulatedSpeed = x; }
+
+        // with no workout, what to hold
+        void setLoad(double watts) { load = watts; }
+        void setGradient(double grade) { slope = grade; }
+
+        // the rider when not replaying a ride
+        void setRider(double cadence, double hr) { device.setRider(cadence, hr); }
+
+        // until the workout, course or ride ends, or secs have been
+        // simulated, whichever is first; 0 secs to run to the end, with
+        // no workout, course or ride to end it nothing is run
+        const Stats &run(double secs = 0);
+
+        // what we did
+        const QVector<TrainRecord> &records() const { return recorded; }
+        const RealtimeData &telemetry() const { return rtData; }
+        int laps() const { return lapCount; }
+        double distance() const { return displayDistance; }
+        double minWbal() const { return wbalMin; }
+        const Stats &stats() const { return timing; }
+
+    private:
+
+        void loadUpdate();
+        void guiUpdate(double secs);
+        void diskUpdate();
+
+        const ErgFile *ergFile;
+        ErgFileQueryAdapter ergFileQueryAdapter;
+        ReplayController device;
+        RealtimeEngine engine;
+        Bicycle bicycle;
+
+        int mode;
+        int periodMsecs;
+        bool useSimulatedSpeed;
+        bool replaying;
+        double CP, WPRIME, TAU;
+
+        // as TrainSidebar
+        RealtimeData rtData;
+        double load, slope;
+        long total_msecs, load_msecs, lastRecordTick;
+        int displayWorkoutLap, lapCount;
+        double displayDistance, displayWorkoutDistance, displayLapDistance;
+        double displaySpeed, displayAltitude;
+        double wbalMin;
+        bool finished;
+
+        QVector<TrainRecord> recorded;
+        Stats timing;
+};
+
+#endif // _GC_TrainSimulator_h
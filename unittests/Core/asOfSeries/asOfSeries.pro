@@ -0,0 +1,6 @@
+QT += testlib core
+
+SOURCES = testAsOfSeries.cpp
+GC_OBJS = AsOfSeries
+
+include(../../unittests.pri)
@@ -0,0 +1,129 @@
+#include "Core/AsOfSeries.h"
+
+#include <QTest>
+
+
+class TestAsOfSeries: public QObject
+{
+    Q_OBJECT
+
+private:
+
+    // a weight most days over years, with gaps and the odd day weighed twice
+    void readings(QVector<QDate> &dates, QVector<double> &values, int days = 3650) {
+        QDate start(2016, 1, 1);
+        for (int i=0; i<days; i++) {
+            if (i % 7 == 3) continue;
+            dates << start.addDays(i);
+            values << 70 + (i % 50) / 10.0 << i;
+            if (i % 11 == 0) {
+                dates << start.addDays(i);
+                values << 71 + (i % 50) / 10.0 << -i;
+            }
+        }
+    }
+
+    // what MeasuresGroup::getMeasure always did
+    int walk(const QVector<QDate> &dates, QDate date, bool asOf) {
+        int here = -1;
+        for (int i=0; i<dates.count(); i++) {
+            if (asOf && dates[i] < date) here = i;
+            if (dates[i] == date) here = i;
+            if (dates[i] > date) break;
+        }
+        return here;
+    }
+
+private slots:
+
+    void empty() {
+        AsOfSeries series;
+        series.build(QVector<QDate>(), QVector<double>(), 2);
+        QCOMPARE(series.indexAsOf(QDate(2020, 1, 1)), -1);
+        QCOMPARE(series.valueAsOf(QDate(2020, 1, 1), 0), 0.0);
+        QCOMPARE(series.valueOn(QDate(2020, 1, 1), 0), 0.0);
+    }
+
+    void edges() {
+        QVector<QDate> dates;
+        dates << QDate(2020, 1, 10) << QDate(2020, 1, 20);
+        QVector<double> values;
+        values << 80 << 79;
+        AsOfSeries series;
+        series.build(dates, values, 1);
+
+        QCOMPARE(series.valueAsOf(QDate(2020, 1, 9), 0), 0.0);
+        QCOMPARE(series.valueAsOf(QDate(2020, 1, 10), 0), 80.0);
+        QCOMPARE(series.valueAsOf(QDate(2020, 1, 19), 0), 80.0);
+        QCOMPARE(series.valueAsOf(QDate(2020, 1, 20), 0), 79.0);
+        QCOMPARE(series.valueAsOf(QDate(2025, 1, 1), 0), 79.0);
+
+        QCOMPARE(series.valueOn(QDate(2020, 1, 19), 0), 0.0);
+        QCOMPARE(series.valueOn(QDate(2020, 1, 20), 0), 79.0);
+        QCOMPARE(series.valueOn(QDate(2025, 1, 1), 0), 0.0);
+
+        QCOMPARE(series.valueAsOf(QDate(2020, 1, 10), 1), 0.0);
+        QCOMPARE(series.valueAsOf(QDate(), 0), 0.0);
+    }
+
+    void matchesWalk() {
+        QVector<QDate> dates;
+        QVector<double> values;
+        readings(dates, values, 400);
+        AsOfSeries series;
+        series.build(dates, values, 2);
+
+        for (QDate date = dates.first().addDays(-3); date <= dates.last().addDays(3); date = date.addDays(1)) {
+            int asOf = walk(dates, date, true);
+            int on = walk(dates, date, false);
+            QCOMPARE(series.indexAsOf(date), asOf);
+            QCOMPARE(series.indexOn(date), on);
+            for (int f=0; f<2; f++) {
+                QCOMPARE(series.valueAsOf(date, f), asOf >= 0 ? values[asOf * 2 + f] : 0.0);
+                QCOMPARE(series.valueOn(date, f), on >= 0 ? values[on * 2 + f] : 0.0);
+            }
+        }
+    }
+
+    // weight for each of 5000 rides over 10 years of daily readings
+    void benchmarkWalk() {
+        QVector<QDate> dates;
+        QVector<double> values;
+        readings(dates, values);
+        double total = 0;
+        QBENCHMARK {
+            for (int i=0; i<5000; i++) {
+                int here = walk(dates, dates.first().addDays(i % 3650), true);
+                if (here >= 0) total += values[here * 2];
+            }
+        }
+        QVERIFY(total > 0);
+    }
+
+    void benchmarkAsOf() {
+        QVector<QDate> dates;
+        QVector<double> values;
+        readings(dates, values);
+        AsOfSeries series;
+        series.build(dates, values, 2);
+        double total = 0;
+        QBENCHMARK {
+            for (int i=0; i<5000; i++) total += series.valueAsOf(dates.first().addDays(i % 3650), 0);
+        }
+        QVERIFY(total > 0);
+    }
+
+    void benchmarkBuild() {
+        QVector<QDate> dates;
+        QVector<double> values;
+        readings(dates, values);
+        AsOfSeries series;
+        QBENCHMARK {
+            series.build(dates, values, 2);
+        }
+    }
+};
+
+
+QTEST_MAIN(TestAsOfSeries)
+#include "testAsOfSeries.moc"
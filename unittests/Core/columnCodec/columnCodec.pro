@@ -0,0 +1,6 @@
+QT += testlib core
+
+SOURCES = testColumnCodec.cpp
+GC_OBJS = ColumnCodec
+
+include(../../unittests.pri)
@@ -0,0 +1,151 @@
+#include "Core/ColumnCodec.h"
+
+#include <QTest>
+#include <QDir>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QtMath>
+#include <cmath>
+#include <limits>
+
+
+// the json sample series, as in the GC .json ride files
+static const char *series[] = { "SECS", "KM", "WATTS", "NM", "CAD", "KPH", "HR", "ALT", "LAT", "LON",
+                                "HEADWIND", "SLOPE", "TEMP", "LRBALANCE", "SMO2", "THB" };
+static const int seriesCount = sizeof(series) / sizeof(series[0]);
+
+
+class TestColumnCodec: public QObject
+{
+    Q_OBJECT
+
+private:
+    QByteArray encode(const QVector<double> &values) {
+        QByteArray data;
+        QDataStream out(&data, QIODevice::WriteOnly);
+        ColumnCodec::write(out, values);
+        return data;
+    }
+
+    bool decode(const QByteArray &data, QVector<double> &values, int count) {
+        QDataStream in(data);
+        return ColumnCodec::read(in, values, count);
+    }
+
+    bool same(const QVector<double> &a, const QVector<double> &b) {
+        return a.count() == b.count() && memcmp(a.constData(), b.constData(), a.count() * sizeof(double)) == 0;
+    }
+
+    // the .json rides in test/rides, each stretched to an hour so there
+    // is something to measure, as json text and as columns
+    void rides(QList<QByteArray> &json, QList<QByteArray> &columns, QList<int> &counts) {
+        QDir dir(QFINDTESTDATA("../../../test/rides"));
+        foreach(QString name, dir.entryList(QStringList() << "*.json", QDir::Files)) {
+            QFile file(dir.absoluteFilePath(name));
+            QVERIFY(file.open(QFile::ReadOnly));
+            QByteArray text = file.readAll();
+            if (text.startsWith("\xEF\xBB\xBF")) text.remove(0, 3); // BOM
+            QJsonObject root = QJsonDocument::fromJson(text).object();
+            QJsonObject ride = root["RIDE"].toObject();
+            QJsonArray samples = ride["SAMPLES"].toArray();
+            QVERIFY(samples.count() > 0);
+
+            QJsonArray hour;
+            for (int i=0; hour.count() < 3600; i++) {
+                QJsonObject sample = samples[i % samples.count()].toObject();
+                sample["SECS"] = hour.count();
+                hour.append(sample);
+            }
+            ride["SAMPLES"] = hour;
+            root["RIDE"] = ride;
+            json << QJsonDocument(root).toJson();
+
+            QByteArray data;
+            QDataStream out(&data, QIODevice::WriteOnly);
+            QVector<double> column(hour.count());
+            for (int s=0; s<seriesCount; s++) {
+                for (int i=0; i<hour.count(); i++) column[i] = hour[i].toObject()[series[s]].toDouble();
+                ColumnCodec::write(out, column);
+            }
+            columns << data;
+            counts << hour.count();
+        }
+        QVERIFY(json.count() > 0);
+    }
+
+private slots:
+    void constantColumn() {
+        QVector<double> values(5000, 0.0), back;
+        QByteArray data = encode(values);
+        QVERIFY(data.size() < 16);
+        QVERIFY(decode(data, back, values.count()));
+        QVERIFY(same(values, back));
+    }
+
+    void emptyColumn() {
+        QVector<double> values, back;
+        QVERIFY(decode(encode(values), back, 0));
+        QCOMPARE(back.count(), 0);
+    }
+
+    void slowSeriesPacks() {
+        QVector<double> values(5000), back;
+        for (int i=0; i<values.count(); i++) values[i] = i;
+        QByteArray data = encode(values);
+        QVERIFY(data.size() < values.count() * int(sizeof(double)) / 2);
+        QVERIFY(decode(data, back, values.count()));
+        QVERIFY(same(values, back));
+    }
+
+    void noisySeriesIsLossless() {
+        QVector<double> values(5000), back;
+        for (int i=0; i<values.count(); i++) values[i] = qSin(i * 1.7) * 1e6 / (i + 1);
+        values[10] = std::numeric_limits<double>::quiet_NaN();
+        values[11] = -0.0;
+        values[12] = std::numeric_limits<double>::infinity();
+        QVERIFY(decode(encode(values), back, values.count()));
+        QVERIFY(same(values, back));
+    }
+
+    void truncatedColumnFails() {
+        QVector<double> values(1000), back;
+        for (int i=0; i<values.count(); i++) values[i] = qSin(i * 1.7);
+        QByteArray data = encode(values);
+        data.chop(9);
+        QVERIFY(!decode(data, back, values.count()));
+    }
+
+    // opening a ride, parsing the json vs reading the sidecar columns
+    void benchmarkJson() {
+        QList<QByteArray> json, columns;
+        QList<int> counts;
+        rides(json, columns, counts);
+        QBENCHMARK {
+            foreach(const QByteArray &text, json) {
+                QJsonArray samples = QJsonDocument::fromJson(text).object()["RIDE"].toObject()["SAMPLES"].toArray();
+                QVector<double> column(samples.count());
+                for (int s=0; s<seriesCount; s++)
+                    for (int i=0; i<samples.count(); i++) column[i] = samples[i].toObject()[series[s]].toDouble();
+            }
+        }
+    }
+
+    void benchmarkColumns() {
+        QList<QByteArray> json, columns;
+        QList<int> counts;
+        rides(json, columns, counts);
+        QBENCHMARK {
+            for (int r=0; r<columns.count(); r++) {
+                QDataStream in(columns[r]);
+                QVector<double> column;
+                for (int s=0; s<seriesCount; s++) QVERIFY(ColumnCodec::read(in, column, counts[r]));
+            }
+        }
+    }
+};
+
+
+QTEST_MAIN(TestColumnCodec)
+#include "testColumnCodec.moc"
@@ -0,0 +1,5 @@
+QT += testlib core
+
+SOURCES = testDateIndex.cpp
+
+include(../../unittests.pri)
@@ -0,0 +1,197 @@
+#include "Core/DateIndex.h"
+
+#include <QTest>
+
+
+class TestDateIndex: public QObject
+{
+    Q_OBJECT
+
+private:
+
+    struct Item {
+        QDateTime when;
+        QString fileName;
+        bool planned;
+        QString linked;
+    };
+
+    // ten years of a ride most days, the odd double day, and a plan
+    // for each week day linked to the ride done that day
+    void season(QVector<Item*> &items, int days = 3650) {
+        QDateTime start(QDate(2016, 1, 1), QTime(7, 0));
+        for (int i=0; i<days; i++) {
+            QDateTime when = start.addDays(i);
+            if (i % 7 != 6) {
+                Item *add = new Item;
+                add->when = when.addSecs(3600);
+                add->fileName = add->when.toString("yyyy_MM_dd_HH_mm_ss") + ".json";
+                add->planned = false;
+                items << add;
+
+                Item *plan = new Item;
+                plan->when = when;
+                plan->fileName = plan->when.toString("yyyy_MM_dd_HH_mm_ss") + ".json";
+                plan->planned = true;
+                plan->linked = add->fileName;
+                add->linked = plan->fileName;
+                items << plan;
+            }
+            if (i % 5 == 0) {
+                Item *add = new Item;
+                add->when = when.addSecs(11 * 3600);
+                add->fileName = add->when.toString("yyyy_MM_dd_HH_mm_ss") + ".json";
+                add->planned = false;
+                items << add;
+            }
+        }
+    }
+
+    void fill(DateIndex<Item*> &index, const QVector<Item*> &items) {
+        foreach(Item *item, items) index.insert(item, item->when, item->fileName, item->planned);
+    }
+
+    // what the calendar always did, walk everything looking for the days
+    // it shows and then walk everything again for each linked activity
+    QVector<Item*> walk(const QVector<Item*> &items, QDate from, QDate to, int &linked) {
+        QVector<Item*> returning;
+        foreach(Item *item, items) {
+            QDate date = item->when.date();
+            if (date < from || date > to) continue;
+            returning << item;
+            foreach(Item *other, items) {
+                if (other->planned != item->planned && other->fileName == item->linked) {
+                    linked++;
+                    break;
+                }
+            }
+        }
+        return returning;
+    }
+
+    QVector<Item*> lookup(const DateIndex<Item*> &index, QDate from, QDate to, int &linked) {
+        QVector<Item*> returning = index.between(from, to);
+        foreach(Item *item, returning)
+            if (index.find(item->linked, !item->planned)) linked++;
+        return returning;
+    }
+
+private slots:
+
+    void empty() {
+        DateIndex<Item*> index;
+        QCOMPARE(index.count(), 0);
+        QVERIFY(index.between(QDate(2020, 1, 1), QDate(2021, 1, 1)).isEmpty());
+        QVERIFY(index.find("2020_01_01_00_00_00.json") == NULL);
+    }
+
+    void order() {
+        Item a = { QDateTime(QDate(2020, 1, 2), QTime(18, 0)), "a", false, "" };
+        Item b = { QDateTime(QDate(2020, 1, 2), QTime(6, 0)), "b", true, "" };
+        Item c = { QDateTime(QDate(2020, 1, 1), QTime(12, 0)), "c", false, "" };
+        Item d = { QDateTime(QDate(2020, 1, 3), QTime(12, 0)), "d", true, "" };
+
+        DateIndex<Item*> index;
+        index.insert(&a, a.when, a.fileName, a.planned);
+        index.insert(&b, b.when, b.fileName, b.planned);
+        index.insert(&c, c.when, c.fileName, c.planned);
+        index.insert(&d, d.when, d.fileName, d.planned);
+
+        QVector<Item*> all = index.between(QDate(2020, 1, 1), QDate(2020, 1, 3));
+        QCOMPARE(all.count(), 4);
+        QVERIFY(all[0] == &c && all[1] == &b && all[2] == &a && all[3] == &d);
+
+        QVector<Item*> planned = index.between(QDate(2020, 1, 2), QDate(2020, 1, 2), true);
+        QCOMPARE(planned.count(), 1);
+        QVERIFY(planned[0] == &b);
+
+        QCOMPARE(index.daysBetween(QDate(2019, 1, 1), QDate(2021, 1, 1), false).count(), 2);
+        QVERIFY(index.find("b") == &b);
+        QVERIFY(index.find("b", false) == NULL);
+    }
+
+    void move() {
+        Item a = { QDateTime(QDate(2020, 1, 1), QTime(8, 0)), "a", true, "" };
+        DateIndex<Item*> index;
+        index.insert(&a, a.when, a.fileName, a.planned);
+
+        // as moveActivity, new time and name
+        a.when = a.when.addDays(7);
+        a.fileName = "a2";
+        index.insert(&a, a.when, a.fileName, a.planned);
+
+        QCOMPARE(index.count(), 1);
+        QVERIFY(index.between(QDate(2020, 1, 1), QDate(2020, 1, 1)).isEmpty());
+        QCOMPARE(index.between(QDate(2020, 1, 8), QDate(2020, 1, 8)).count(), 1);
+        QVERIFY(index.find("a") == NULL);
+        QVERIFY(index.find("a2") == &a);
+        QCOMPARE(index.daysBetween(QDate(2020, 1, 1), QDate(2020, 1, 31), true).count(), 1);
+
+        index.remove(&a);
+        index.remove(&a);
+        QCOMPARE(index.count(), 0);
+        QVERIFY(index.find("a2") == NULL);
+    }
+
+    void same() {
+        QVector<Item*> items;
+        season(items, 400);
+        DateIndex<Item*> index;
+        fill(index, items);
+        QCOMPARE(index.count(), items.count());
+
+        // each month as the calendar shows it, and some odd ranges
+        for (QDate from(2015, 12, 1); from < QDate(2017, 3, 1); from = from.addMonths(1)) {
+            int walked = 0, looked = 0;
+            QDate to = from.addMonths(1).addDays(-1);
+            QVector<Item*> want = walk(items, from, to, walked);
+            QVector<Item*> got = lookup(index, from, to, looked);
+            QCOMPARE(got.count(), want.count());
+            QCOMPARE(looked, walked);
+            for (int i=0; i<got.count(); i++) QVERIFY(got[i]->when.date() >= from && got[i]->when.date() <= to);
+            for (int i=1; i<got.count(); i++) QVERIFY(!(got[i]->when < got[i-1]->when));
+        }
+        QVERIFY(index.between(QDate(2016, 3, 1), QDate(2016, 2, 1)).isEmpty());
+
+        qDeleteAll(items);
+    }
+
+    // rendering every month of ten years
+    void benchmarkWalk() {
+        QVector<Item*> items;
+        season(items);
+        int linked = 0;
+        QBENCHMARK {
+            for (QDate from(2016, 1, 1); from < QDate(2026, 1, 1); from = from.addMonths(1))
+                walk(items, from, from.addMonths(1).addDays(-1), linked);
+        }
+        qDeleteAll(items);
+    }
+
+    void benchmarkIndex() {
+        QVector<Item*> items;
+        season(items);
+        DateIndex<Item*> index;
+        fill(index, items);
+        int linked = 0;
+        QBENCHMARK {
+            for (QDate from(2016, 1, 1); from < QDate(2026, 1, 1); from = from.addMonths(1))
+                lookup(index, from, from.addMonths(1).addDays(-1), linked);
+        }
+        qDeleteAll(items);
+    }
+
+    void benchmarkBuild() {
+        QVector<Item*> items;
+        season(items);
+        QBENCHMARK {
+            DateIndex<Item*> index;
+            fill(index, items);
+        }
+        qDeleteAll(items);
+    }
+};
+
+
+QTEST_MAIN(TestDateIndex)
+#include "testDateIndex.moc"
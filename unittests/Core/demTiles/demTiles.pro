@@ -0,0 +1,6 @@
+QT += testlib core
+
+SOURCES = testDemTiles.cpp
+GC_OBJS = DemTiles
+
+include(../../unittests.pri)
@@ -0,0 +1,136 @@
+#include "Core/DemTiles.h"
+
+#include <QTest>
+#include <QTemporaryDir>
+#include <QFile>
+#include <QtEndian>
+#include <cmath>
+
+
+class TestDemTiles: public QObject
+{
+    Q_OBJECT
+
+private:
+    QTemporaryDir dir;
+
+    // a plane, so bilinear is exact, lifted by 1000m per tile
+    static double height(int lat, int lon, double y, double x) {
+        return 1000 * ((lat - 45) * 2 + (lon - 6)) + 100 + y + 2 * x;
+    }
+
+    static double expected(double lat, double lon) {
+        int south = int(std::floor(lat)), west = int(std::floor(lon));
+        return height(south, west, (south + 1 - lat) * 1200, (lon - west) * 1200);
+    }
+
+    void writeTile(int lat, int lon, int voidRow = -1, int voidCol = -1) {
+        QVector<qint16> posts(1201 * 1201);
+        for (int r=0; r<1201; r++)
+            for (int c=0; c<1201; c++)
+                posts[r * 1201 + c] = qToBigEndian(qint16(r == voidRow && c == voidCol ? -32768 : height(lat, lon, r, c)));
+
+        QFile file(dir.filePath(DemTiles::tileName(lat, lon)));
+        QVERIFY(file.open(QFile::WriteOnly));
+        file.write(reinterpret_cast<const char*>(posts.constData()), posts.count() * sizeof(qint16));
+    }
+
+    // a wiggly track back and forth across the corner of four tiles
+    void track(QVector<double> &lat, QVector<double> &lon, int count) {
+        lat.resize(count);
+        lon.resize(count);
+        for (int i=0; i<count; i++) {
+            lat[i] = 46 + 0.4 * std::sin(i * 0.0013);
+            lon[i] = 7 + 0.4 * std::cos(i * 0.0007);
+        }
+    }
+
+private slots:
+    void initTestCase() {
+        QVERIFY(dir.isValid());
+        writeTile(45, 6, 600, 600);
+        writeTile(45, 7);
+        writeTile(46, 6);
+        writeTile(46, 7);
+    }
+
+    void tileNames() {
+        QCOMPARE(DemTiles::tileName(45, 6), QString("N45E006.hgt"));
+        QCOMPARE(DemTiles::tileName(-1, -71), QString("S01W071.hgt"));
+    }
+
+    void bilinearOnAPlane() {
+        DemTiles tiles;
+        tiles.setDirectory(dir.path());
+        QVERIFY(tiles.isValid());
+
+        QVector<double> lat, lon;
+        track(lat, lon, 5000);
+        QVector<double> elevation = tiles.elevation(lat, lon);
+        QCOMPARE(elevation.count(), lat.count());
+        for (int i=0; i<lat.count(); i++)
+            QVERIFY(qAbs(elevation[i] - expected(lat[i], lon[i])) < 1e-6);
+    }
+
+    void voidsAreSkipped() {
+        DemTiles tiles;
+        tiles.setDirectory(dir.path());
+
+        // on the void post we get what is around it, near enough the plane
+        double lat = 46 - 600.0/1200, lon = 6 + 600.0/1200;
+        double near = tiles.elevation(lat + 0.1/1200, lon + 0.1/1200);
+        QVERIFY(near != DemTiles::NoData);
+        QVERIFY(qAbs(near - expected(lat, lon)) < 3);
+    }
+
+    void missingTiles() {
+        DemTiles tiles;
+        tiles.setDirectory(dir.path());
+        QCOMPARE(tiles.elevation(10.5, 10.5), DemTiles::NoData);
+        QCOMPARE(tiles.elevation(91, 0), DemTiles::NoData);
+
+        DemTiles none;
+        QVERIFY(!none.isValid());
+        QCOMPARE(none.elevation(45.5, 6.5), DemTiles::NoData);
+    }
+
+    // fewer tiles mapped than the track crosses
+    void leastRecentlyUsed() {
+        DemTiles tiles(1);
+        tiles.setDirectory(dir.path());
+        for (int i=0; i<20; i++) {
+            double lat = 45.5 + (i % 2), lon = 6.5 + ((i / 2) % 2);
+            QVERIFY(qAbs(tiles.elevation(lat, lon) - expected(lat, lon)) < 1e-6);
+        }
+    }
+
+    // a long ride, 4 hours at 1s, sampled in one call
+    void benchmarkTrack() {
+        DemTiles tiles;
+        tiles.setDirectory(dir.path());
+        QVector<double> lat, lon;
+        track(lat, lon, 4 * 3600);
+        tiles.elevation(lat, lon); // map them
+
+        QBENCHMARK {
+            tiles.elevation(lat, lon);
+        }
+    }
+
+    // one point at a time, as per point lookups would
+    void benchmarkPointByPoint() {
+        DemTiles tiles;
+        tiles.setDirectory(dir.path());
+        QVector<double> lat, lon;
+        track(lat, lon, 4 * 3600);
+        tiles.elevation(lat, lon);
+
+        QBENCHMARK {
+            for (int i=0; i<lat.count(); i++) tiles.elevation(lat[i], lon[i]);
+        }
+    }
+};
+
+
+QTEST_MAIN(TestDemTiles)
+#include "testDemTiles.moc"
@@ -0,0 +1,6 @@
+QT += testlib core
+
+SOURCES = testHexBinner.cpp
+GC_OBJS = HexBinner MinMaxPyramid
+
+include(../../unittests.pri)
@@ -0,0 +1,95 @@
+#include "Core/HexBinner.h"
+#include "Core/MinMaxPyramid.h"
+
+#include <QTest>
+#include <QtMath>
+
+
+class TestHexBinner: public QObject
+{
+    Q_OBJECT
+
+private:
+    // power vs cadence for every sample of a season, a couple of million points
+    void season(QVector<double> &x, QVector<double> &y, int count=2000000) {
+        x.resize(count);
+        y.resize(count);
+        for (int i=0; i<count; i++) {
+            x[i] = 60 + ((i * 7919) % 61) + 10 * qSin(i / 97.0);   // cadence
+            y[i] = 100 + ((i * 104729) % 301) + 50 * qSin(i / 13.0); // watts
+        }
+    }
+
+private slots:
+    void emptySeries() {
+        QVector<double> x, y;
+        QCOMPARE(HexBinner::thin(x, y, QRectF(0, 0, 1, 1), QSizeF(100, 100), 2).count(), 0);
+    }
+
+    void sparsePointsAreKept() {
+        QVector<double> x, y;
+        for (int i=0; i<10; i++) {
+            x << i * 10;
+            y << i * 10;
+        }
+        QVector<int> keep = HexBinner::thin(x, y, QRectF(0, 0, 90, 90), QSizeF(900, 900), 2);
+        QCOMPARE(keep.count(), 10);
+        for (int i=0; i<10; i++) QCOMPARE(keep[i], i);
+    }
+
+    void densePointsCollapse() {
+        QVector<double> x, y;
+        for (int i=0; i<1000; i++) {
+            x << 50 + (i % 10) * 0.001;
+            y << 50 + (i / 10) * 0.001;
+        }
+        x << 0 << 100;
+        y << 0 << 100;
+        QVector<int> keep = HexBinner::thin(x, y, QRectF(0, 0, 100, 100), QSizeF(100, 100), 2);
+
+        // one for the cloud, and the two corners
+        QCOMPARE(keep.count(), 3);
+        QVERIFY(keep.contains(1000));
+        QVERIFY(keep.contains(1001));
+    }
+
+    void extremesAreKept() {
+        QVector<double> x, y;
+        season(x, y, 100000);
+        x[500] = -10;
+        y[700] = 5000;
+        QVector<int> keep = HexBinner::thin(x, y, QRectF(-10, 0, 200, 5000), QSizeF(1920, 1080), 1);
+        QVERIFY(keep.count() < x.count());
+        QVERIFY(keep.contains(500));
+        QVERIFY(keep.contains(700));
+        for (int i=1; i<keep.count(); i++) QVERIFY(keep[i] > keep[i-1]);
+    }
+
+    // what GenericPlot does to a big scatter and a big line before handing them to QtCharts
+    void benchmarkScatter() {
+        QVector<double> x, y;
+        season(x, y);
+        QBENCHMARK {
+            QVector<int> keep = HexBinner::thin(x, y, QRectF(40, 50, 100, 450), QSizeF(1920, 1080), 1.5);
+            QVector<QPointF> points;
+            points.reserve(keep.count());
+            foreach(int i, keep) points << QPointF(x[i], y[i]);
+        }
+    }
+
+    void benchmarkLine() {
+        QVector<double> x, y;
+        season(x, y);
+        for (int i=0; i<x.count(); i++) x[i] = i;
+        QBENCHMARK {
+            MinMaxPyramid pyramid;
+            pyramid.build(x.constData(), y.constData(), x.count());
+            QVector<QPointF> points;
+            pyramid.decimate(x.first(), x.last(), 1920, points);
+        }
+    }
+};
+
+
+QTEST_MAIN(TestHexBinner)
+#include "testHexBinner.moc"
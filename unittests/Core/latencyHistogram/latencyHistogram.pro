@@ -0,0 +1,5 @@
+QT += testlib core
+
+SOURCES = testLatencyHistogram.cpp
+
+include(../../unittests.pri)
@@ -0,0 +1,51 @@
+#include "Core/LatencyHistogram.h"
+
+#include <QTest>
+
+
+class TestLatencyHistogram: public QObject
+{
+    Q_OBJECT
+
+private slots:
+
+    void empty() {
+        LatencyHistogram hist;
+        QCOMPARE((int) hist.count(), 0);
+        QCOMPARE(hist.mean(), 0.0);
+        QCOMPARE((int) hist.percentile(50), 0);
+    }
+
+    void percentiles() {
+        LatencyHistogram hist(10, 100);
+        for (int i = 0; i < 1000; ++i) {
+            hist.add(i);
+        }
+        QCOMPARE((int) hist.count(), 1000);
+        QCOMPARE(hist.mean(), 499.5);
+        QCOMPARE((int) hist.max(), 999);
+        QCOMPARE((int) hist.percentile(50), 500);
+        QCOMPARE((int) hist.percentile(90), 900);
+        QCOMPARE((int) hist.percentile(100), 1000);
+        QCOMPARE((int) hist.overflow(), 0);
+    }
+
+    void overflow() {
+        LatencyHistogram hist(10, 10);
+        for (int i = 0; i < 99; ++i) {
+            hist.add(5);
+        }
+        hist.add(12345);
+        QCOMPARE((int) hist.overflow(), 1);
+        QCOMPARE((int) hist.percentile(50), 10);
+        QCOMPARE((int) hist.percentile(100), 12345);
+
+        hist.clear();
+        QCOMPARE((int) hist.count(), 0);
+        QCOMPARE((int) hist.overflow(), 0);
+    }
+};
+
+
+QTEST_MAIN(TestLatencyHistogram)
+#include "testLatencyHistogram.moc"
@@ -0,0 +1,6 @@
+QT += testlib core
+
+SOURCES = testMinMaxPyramid.cpp
+GC_OBJS = MinMaxPyramid
+
+include(../../unittests.pri)
@@ -0,0 +1,113 @@
+#include "Core/MinMaxPyramid.h"
+
+#include <QTest>
+#include <QtMath>
+
+
+class TestMinMaxPyramid: public QObject
+{
+    Q_OBJECT
+
+private:
+    // something that looks like an 8 hour ride recorded at 4Hz with sprints
+    void ride(QVector<double> &x, QVector<double> &y, int count=8*3600*4) {
+        x.resize(count);
+        y.resize(count);
+        for (int i=0; i<count; i++) {
+            x[i] = i / 240.0; // minutes, like AllPlot
+            y[i] = 200 + 50 * qSin(i / 400.0) + ((i * 7919) % 37);
+            if (i % 9973 == 0) y[i] = 1200; // sprint
+            if (i % 7717 == 0) y[i] = 0;    // freewheel
+        }
+    }
+
+    void minmax(const QVector<QPointF> &points, double from, double to, double &min, double &max) {
+        min = 1e9; max = -1e9;
+        foreach(QPointF p, points) {
+            if (p.x() < from || p.x() > to) continue;
+            if (p.y() < min) min = p.y();
+            if (p.y() > max) max = p.y();
+        }
+    }
+
+private slots:
+    void emptySeries() {
+        MinMaxPyramid pyramid;
+        pyramid.build(NULL, NULL, 0);
+        QVector<QPointF> points;
+        pyramid.decimate(0, 100, 1000, points);
+        QCOMPARE(points.count(), 0);
+    }
+
+    void fewPointsAreRaw() {
+        double x[] = { 0, 1, 2, 3, 4 };
+        double y[] = { 5, 1, 9, 3, 7 };
+        MinMaxPyramid pyramid;
+        pyramid.build(x, y, 5);
+        QVector<QPointF> points;
+        pyramid.decimate(0, 4, 1000, points);
+        QCOMPARE(points.count(), 5);
+        QCOMPARE(points[2], QPointF(2, 9));
+        QCOMPARE(pyramid.boundingRect(), QRectF(0, 1, 4, 8));
+    }
+
+    void peaksAreKept() {
+        QVector<double> x, y;
+        ride(x, y);
+        MinMaxPyramid pyramid;
+        pyramid.build(x.constData(), y.constData(), x.count());
+
+        QVector<QPointF> raw = pyramid.samples();
+        QVector<QPointF> points;
+        double ranges[][2] = { { 0, 480 }, { 10, 11 }, { 33.3, 190.7 }, { 470, 600 } };
+        for (int r=0; r<4; r++) {
+            pyramid.decimate(ranges[r][0], ranges[r][1], 800, points);
+
+            // about 2 points per pixel, in order
+            QVERIFY(points.count() <= 2 * 800 + 2 * 256);
+            for (int i=1; i<points.count(); i++) QVERIFY(points[i].x() > points[i-1].x());
+
+            double rmin, rmax, dmin, dmax;
+            minmax(raw, ranges[r][0], ranges[r][1], rmin, rmax);
+            minmax(points, ranges[r][0], ranges[r][1], dmin, dmax);
+            QCOMPARE(dmin, rmin);
+            QCOMPARE(dmax, rmax);
+        }
+    }
+
+    void gapsAreNotMerged() {
+        QVector<double> x, y;
+        ride(x, y, 10000);
+        MinMaxPyramid pyramid;
+        pyramid.build(x.constData(), y.constData(), x.count());
+
+        // blocks may not span more than 3 minutes
+        QVector<QPointF> points;
+        pyramid.decimate(0, 100, 10, points, 3);
+        for (int i=1; i<points.count(); i++) QVERIFY(points[i].x() - points[i-1].x() <= 3);
+    }
+
+    void benchmarkBuild() {
+        QVector<double> x, y;
+        ride(x, y);
+        MinMaxPyramid pyramid;
+        QBENCHMARK {
+            pyramid.build(x.constData(), y.constData(), x.count());
+        }
+    }
+
+    void benchmarkZoomAndScroll() {
+        QVector<double> x, y;
+        ride(x, y);
+        MinMaxPyramid pyramid;
+        pyramid.build(x.constData(), y.constData(), x.count());
+        QVector<QPointF> points;
+        QBENCHMARK {
+            for (int i=0; i<100; i++) pyramid.decimate(i, 480 - i, 1200, points);
+        }
+    }
+};
+
+
+QTEST_MAIN(TestMinMaxPyramid)
+#include "testMinMaxPyramid.moc"
@@ -0,0 +1,6 @@
+QT += testlib core
+
+SOURCES = testPrefixSeries.cpp
+GC_OBJS = PrefixSeries
+
+include(../../unittests.pri)
@@ -0,0 +1,71 @@
+#include "Core/PrefixSeries.h"
+
+#include <QTest>
+
+
+class TestPrefixSeries: public QObject
+{
+    Q_OBJECT
+
+private slots:
+
+    void empty() {
+        PrefixSeries series;
+        series.build(QVector<double>());
+        QCOMPARE(series.count(), 0);
+    }
+
+    void single() {
+        PrefixSeries series;
+        series.build(QVector<double>() << 250);
+        QCOMPARE(series.count(), 1);
+        QCOMPARE(series.sum(0, 0), 250.0);
+        QCOMPARE(series.positive(0, 0), 1);
+        QCOMPARE(series.max(0, 0), 250.0);
+        QCOMPARE(series.minPositive(0, 0), 250.0);
+    }
+
+    void zeroAndNegative() {
+        PrefixSeries series;
+        series.build(QVector<double>() << 0 << -1 << 0);
+        QCOMPARE(series.sum(0, 2), 0.0);
+        QCOMPARE(series.positive(0, 2), 0);
+        QCOMPARE(series.nonNegative(0, 2), 2);
+        QCOMPARE(series.max(0, 2), 0.0);
+        QCOMPARE(series.minPositive(0, 2), 0.0);
+    }
+
+    void everyRange() {
+        QVector<double> values;
+        for (int i = 0; i < 97; ++i) {
+            values << ((i * 37) % 23) - 3;
+        }
+        PrefixSeries series;
+        series.build(values);
+
+        for (int first = 0; first < values.count(); ++first) {
+            double sum = 0, max = values[first], min = 0;
+            int positive = 0, nonNegative = 0;
+            for (int last = first; last < values.count(); ++last) {
+                double v = values[last];
+                if (v > 0) {
+                    sum += v;
+                    ++positive;
+                    if (min == 0 || v < min) min = v;
+                }
+                if (v >= 0) ++nonNegative;
+                if (v > max) max = v;
+
+                QCOMPARE(series.sum(first, last), sum);
+                QCOMPARE(series.positive(first, last), positive);
+                QCOMPARE(series.nonNegative(first, last), nonNegative);
+                QCOMPARE(series.max(first, last), max);
+                QCOMPARE(series.minPositive(first, last), min);
+            }
+        }
+    }
+};
+
+
+QTEST_MAIN(TestPrefixSeries)
+#include "testPrefixSeries.moc"
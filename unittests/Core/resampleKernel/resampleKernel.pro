@@ -0,0 +1,6 @@
+QT += testlib core
+
+SOURCES = testResampleKernel.cpp
+GC_OBJS = ResampleKernel
+
+include(../../unittests.pri)
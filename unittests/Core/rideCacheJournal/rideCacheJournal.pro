@@ -0,0 +1,6 @@
+QT += testlib core concurrent
+
+SOURCES = testRideCacheJournal.cpp
+GC_OBJS = RideCacheJournal
+
+include(../../unittests.pri)
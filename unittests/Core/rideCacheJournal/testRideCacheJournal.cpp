@@ -0,0 +1,175 @@
+#include "Core/RideCacheJournal.h"
+
+#include <QTest>
+#include <QTemporaryDir>
+#include <QFile>
+#include <QDateTime>
+
+
+class TestRideCacheJournal: public QObject
+{
+    Q_OBJECT
+
+private:
+    void write(const QString &path, const QByteArray &data) {
+        QFile file(path);
+        QVERIFY(file.open(QFile::WriteOnly | QFile::Truncate));
+        file.write(data);
+        file.close();
+    }
+
+    // an athlete folder with activities and their .cpx
+    QVector<RideCacheJournal::Source> athlete(const QTemporaryDir &dir, int count) {
+        QVector<RideCacheJournal::Source> sources;
+        QByteArray ride(20000, 'r'), cpx(4000, 'c');
+        for (int i=0; i<count; i++) {
+            RideCacheJournal::Source source;
+            source.key = QString("2026_01_01_%1.json").arg(i, 6, 10, QChar('0'));
+            source.path = dir.path() + "/" + source.key;
+            source.cpx = dir.path() + "/" + source.key.left(source.key.length() - 5) + ".cpx";
+            write(source.path, ride);
+            write(source.cpx, cpx);
+            sources << source;
+        }
+        return sources;
+    }
+
+    // journal every ride as clean
+    void journalAll(RideCacheJournal &journal, const QVector<RideCacheJournal::Source> &sources) {
+        QVector<RideJournalEntry> now = RideCacheJournal::stat(sources);
+        for (int i=0; i<sources.count(); i++) {
+            RideJournalEntry e = now[i];
+            e.crc = i;
+            e.cpxversion = 25;
+            e.cpxweight = 75;
+            journal.record(sources[i].key, e);
+        }
+    }
+
+private slots:
+    void missingFilesNeverMatch() {
+        RideCacheJournal::Source source;
+        source.path = "/does/not/exist.json";
+        source.cpx = "/does/not/exist.cpx";
+        RideJournalEntry e = RideCacheJournal::stat(source);
+        QCOMPARE(e.size, qint64(-1));
+        QCOMPARE(e.cpxsize, qint64(-1));
+        QVERIFY(!e.sameFiles(e));
+    }
+
+    void roundTrip() {
+        QTemporaryDir dir;
+        QVector<RideCacheJournal::Source> sources = athlete(dir, 10);
+
+        RideCacheJournal journal;
+        journalAll(journal, sources);
+        QVERIFY(journal.save(dir.path() + "/rideDB.journal"));
+
+        RideCacheJournal loaded;
+        QVERIFY(loaded.load(dir.path() + "/rideDB.journal"));
+        QCOMPARE(loaded.count(), 10);
+
+        QVector<RideJournalEntry> now = RideCacheJournal::stat(sources);
+        for (int i=0; i<sources.count(); i++) {
+            RideJournalEntry e;
+            QVERIFY(loaded.find(sources[i].key, e));
+            QVERIFY(e.sameFiles(now[i]));
+            QCOMPARE(e.crc, quint32(i));
+            QCOMPARE(e.cpxversion, quint32(25));
+            QCOMPARE(e.cpxweight, 75.0);
+        }
+    }
+
+    void truncatedJournalIgnored() {
+        QTemporaryDir dir;
+        RideCacheJournal journal;
+        journalAll(journal, athlete(dir, 10));
+        QString filename = dir.path() + "/rideDB.journal";
+        QVERIFY(journal.save(filename));
+
+        QFile file(filename);
+        QVERIFY(file.open(QFile::ReadWrite));
+        QVERIFY(file.resize(file.size() - 7));
+        file.close();
+
+        RideCacheJournal loaded;
+        QVERIFY(!loaded.load(filename));
+        QCOMPARE(loaded.count(), 0);
+    }
+
+    void changesDetected() {
+        QTemporaryDir dir;
+        QVector<RideCacheJournal::Source> sources = athlete(dir, 3);
+        RideCacheJournal journal;
+        journalAll(journal, sources);
+
+        // edited activity, touched .cpx and one left alone
+        write(sources[0].path, QByteArray(20001, 'r'));
+        QFile cpx(sources[1].cpx);
+        QVERIFY(cpx.open(QFile::ReadWrite));
+        QVERIFY(cpx.setFileTime(QDateTime::currentDateTime().addSecs(60), QFileDevice::FileModificationTime));
+        cpx.close();
+
+        QVector<RideJournalEntry> now = RideCacheJournal::stat(sources);
+        RideJournalEntry e;
+        QVERIFY(journal.find(sources[0].key, e) && !e.sameFiles(now[0]));
+        QVERIFY(journal.find(sources[1].key, e) && !e.sameFiles(now[1]));
+        QVERIFY(journal.find(sources[2].key, e) && e.sameFiles(now[2]));
+    }
+
+    void retainDropsRemovedRides() {
+        QTemporaryDir dir;
+        QVector<RideCacheJournal::Source> sources = athlete(dir, 5);
+        RideCacheJournal journal;
+        journalAll(journal, sources);
+
+        QSet<QString> keys;
+        keys << sources[1].key << sources[3].key;
+        journal.retain(keys);
+
+        RideJournalEntry e;
+        QCOMPARE(journal.count(), 2);
+        QVERIFY(!journal.find(sources[0].key, e));
+        QVERIFY(journal.find(sources[3].key, e));
+    }
+
+    // startup with no journal, every activity and .cpx is opened and read
+    void benchmarkCold() {
+        QTemporaryDir dir;
+        QVector<RideCacheJournal::Source> sources = athlete(dir, 2000);
+        QBENCHMARK {
+            quint32 sum = 0;
+            foreach(const RideCacheJournal::Source &source, sources) {
+                QFile ride(source.path), cpx(source.cpx);
+                if (ride.open(QFile::ReadOnly)) sum += qChecksum(ride.readAll().constData(), ride.size());
+                if (cpx.open(QFile::ReadOnly)) sum += cpx.read(64).size();
+            }
+            Q_UNUSED(sum);
+        }
+    }
+
+    // startup with a journal, one parallel stat pass and a lookup per ride
+    void benchmarkWarm() {
+        QTemporaryDir dir;
+        QVector<RideCacheJournal::Source> sources = athlete(dir, 2000);
+        RideCacheJournal journal;
+        journalAll(journal, sources);
+        QVERIFY(journal.save(dir.path() + "/rideDB.journal"));
+
+        QBENCHMARK {
+            RideCacheJournal loaded;
+            loaded.load(dir.path() + "/rideDB.journal");
+            QVector<RideJournalEntry> now = RideCacheJournal::stat(sources);
+            int unchanged = 0;
+            for (int i=0; i<sources.count(); i++) {
+                RideJournalEntry e;
+                if (loaded.find(sources[i].key, e) && e.sameFiles(now[i])) unchanged++;
+            }
+            QCOMPARE(unchanged, sources.count());
+        }
+    }
+};
+
+
+QTEST_MAIN(TestRideCacheJournal)
+#include "testRideCacheJournal.moc"
@@ -0,0 +1,5 @@
+QT += testlib core
+
+SOURCES = testSnapshotBuffer.cpp
+
+include(../../unittests.pri)
@@ -0,0 +1,74 @@
+#include "Core/SnapshotBuffer.h"
+
+#include <QTest>
+#include <QThread>
+
+
+struct Sample {
+    int a, b, c;
+};
+
+
+class TestSnapshotBuffer: public QObject
+{
+    Q_OBJECT
+
+private slots:
+
+    void emptyUntilPublished() {
+        SnapshotBuffer<int> buffer;
+        int value = -1;
+        QVERIFY(! buffer.latest(value));
+        QCOMPARE(value, -1);
+    }
+
+    void latestOnly() {
+        SnapshotBuffer<int> buffer;
+        for (int i = 0; i < 10; ++i) {
+            buffer.publish(i);
+        }
+        int value = -1;
+        QVERIFY(buffer.latest(value));
+        QCOMPARE(value, 9);
+        QVERIFY(! buffer.latest(value));
+        QCOMPARE(value, 9);
+
+        buffer.publish(10);
+        QVERIFY(buffer.latest(value));
+        QCOMPARE(value, 10);
+    }
+
+    void acrossThreads() {
+        SnapshotBuffer<Sample> buffer;
+        const int count = 200000;
+
+        QThread *producer = QThread::create([&buffer, count]() {
+            for (int i = 1; i <= count; ++i) {
+                Sample s = { i, i * 2, i * 3 };
+                buffer.publish(s);
+            }
+        });
+        producer->start();
+
+        // never torn and never goes backwards
+        int last = 0;
+        Sample s;
+        while (last < count) {
+            if (buffer.latest(s)) {
+                QCOMPARE(s.b, s.a * 2);
+                QCOMPARE(s.c, s.a * 3);
+                QVERIFY(s.a > last);
+                last = s.a;
+            } else {
+                QThread::yieldCurrentThread();
+            }
+        }
+        producer->wait();
+        delete producer;
+        QVERIFY(! buffer.latest(s));
+    }
+};
+
+
+QTEST_MAIN(TestSnapshotBuffer)
+#include "testSnapshotBuffer.moc"
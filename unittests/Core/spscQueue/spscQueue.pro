@@ -0,0 +1,5 @@
+QT += testlib core
+
+SOURCES = testSpscQueue.cpp
+
+include(../../unittests.pri)
@@ -0,0 +1,87 @@
+#include "Core/SpscQueue.h"
+
+#include <QTest>
+#include <QThread>
+
+
+class TestSpscQueue: public QObject
+{
+    Q_OBJECT
+
+private slots:
+
+    void fifoOrder() {
+        SpscQueue<int> queue(8);
+        QCOMPARE((int) queue.capacity(), 8);
+        for (int i = 0; i < 5; ++i) {
+            QVERIFY(queue.push(i));
+        }
+        int value = -1;
+        for (int i = 0; i < 5; ++i) {
+            QVERIFY(queue.pop(value));
+            QCOMPARE(value, i);
+        }
+        QVERIFY(! queue.pop(value));
+        QVERIFY(queue.isEmpty());
+    }
+
+    void fullRejects() {
+        SpscQueue<int> queue(4);
+        for (int i = 0; i < 4; ++i) {
+            QVERIFY(queue.push(i));
+        }
+        QVERIFY(! queue.push(99));
+        int value = -1;
+        QVERIFY(queue.pop(value));
+        QCOMPARE(value, 0);
+        QVERIFY(queue.push(4));
+        for (int i = 1; i <= 4; ++i) {
+            QVERIFY(queue.pop(value));
+            QCOMPARE(value, i);
+        }
+    }
+
+    void wrapsAround() {
+        SpscQueue<int> queue(4);
+        int value = -1;
+        for (int i = 0; i < 1000; ++i) {
+            QVERIFY(queue.push(i));
+            QVERIFY(queue.push(i + 1));
+            QVERIFY(queue.pop(value));
+            QCOMPARE(value, i);
+            QVERIFY(queue.pop(value));
+            QCOMPARE(value, i + 1);
+        }
+        QVERIFY(queue.isEmpty());
+    }
+
+    void acrossThreads() {
+        SpscQueue<int> queue(64);
+        const int count = 100000;
+
+        QThread *producer = QThread::create([&queue, count]() {
+            for (int i = 0; i < count; ++i) {
+                while (! queue.push(i)) QThread::yieldCurrentThread();
+            }
+        });
+        producer->start();
+
+        int expected = 0;
+        int value = -1;
+        while (expected < count) {
+            if (queue.pop(value)) {
+                QCOMPARE(value, expected);
+                ++expected;
+            } else {
+                QThread::yieldCurrentThread();
+            }
+        }
+        producer->wait();
+        delete producer;
+        QVERIFY(queue.isEmpty());
+    }
+};
+
+
+QTEST_MAIN(TestSpscQueue)
+#include "testSpscQueue.moc"
@@ -0,0 +1,6 @@
+QT += testlib core
+
+SOURCES = testStreamingFilters.cpp
+GC_OBJS = StreamingFilters
+
+include(../../unittests.pri)
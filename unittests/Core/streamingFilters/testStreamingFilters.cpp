@@ -0,0 +1,124 @@
+#include "Core/StreamingFilters.h"
+
+#include <QTest>
+#include <QDir>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <algorithm>
+
+
+class TestStreamingFilters: public QObject
+{
+    Q_OBJECT
+
+private:
+    static double sortedMedian(QVector<double> v) {
+        std::sort(v.begin(), v.end());
+        int n = v.count();
+        return n % 2 ? v[n/2] : (v[n/2-1] + v[n/2]) / 2.0;
+    }
+
+    // power from the .json rides in test/rides, repeated out to an hour
+    // at 4Hz with a spike every so often, as FixSpikes sees on import
+    QVector<double> power() {
+        QVector<double> returning;
+        QDir dir(QFINDTESTDATA("../../../test/rides"));
+        foreach(QString name, dir.entryList(QStringList() << "*.json", QDir::Files)) {
+            QFile file(dir.absoluteFilePath(name));
+            if (!file.open(QFile::ReadOnly)) continue;
+            QByteArray text = file.readAll();
+            if (text.startsWith("\xEF\xBB\xBF")) text.remove(0, 3); // BOM
+            QJsonArray samples = QJsonDocument::fromJson(text).object()["RIDE"].toObject()["SAMPLES"].toArray();
+            for (int i=0; i<samples.count(); i++) returning << samples[i].toObject()["WATTS"].toDouble();
+        }
+        if (returning.isEmpty()) returning << 200;
+
+        const int n = returning.count();
+        for (int i=n; i<4*3600; i++) returning << returning[i % n] + (i % 7);
+        for (int i=0; i<returning.count(); i += 997) returning[i] = 2500;
+        return returning;
+    }
+
+private slots:
+    void medianAndMadMatchSorting() {
+        SortedWindow window;
+        QVector<double> values;
+        for (int i=0; i<41; i++) {
+            double v = (i * 37) % 11;
+            values << v;
+            window.insert(v);
+
+            QCOMPARE(window.median(), sortedMedian(values));
+            QVector<double> deviations;
+            double m = sortedMedian(values);
+            foreach(double x, values) deviations << qAbs(x - m);
+            QCOMPARE(window.mad(), sortedMedian(deviations));
+        }
+    }
+
+    void removeAndReplace() {
+        SortedWindow window;
+        window.insert(1); window.insert(5); window.insert(3);
+        QVERIFY(!window.remove(4));
+        QVERIFY(window.remove(5));
+        QCOMPARE(window.median(), 2.0);
+        window.replace(1, 9);
+        QCOMPARE(window.median(), 6.0);
+        QCOMPARE(window.count(), 2);
+    }
+
+    void slidingMedian() {
+        QVector<double> series = power();
+        series.resize(2000);
+        QVector<double> filtered = StreamingFilters::median(series, 13);
+        for (int i=0; i<series.count(); i++) {
+            QVector<double> window = series.mid(qMax(0, i-6), qMin(series.count(), i+7) - qMax(0, i-6));
+            QCOMPARE(filtered[i], sortedMedian(window));
+        }
+    }
+
+    void hampelRemovesSpikes() {
+        QVector<double> series(500, 200);
+        for (int i=0; i<series.count(); i++) series[i] += i % 5;
+        series[100] = 2000;
+        series[300] = 0;
+        QVector<int> changed = StreamingFilters::hampel(series, 11, 3);
+        QVERIFY(changed.contains(100));
+        QVERIFY(changed.contains(300));
+        QVERIFY(series[100] < 210);
+        QVERIFY(series[300] > 190);
+    }
+
+    // what FixSpikes used to do, copy and sort every window
+    void benchmarkSortEachWindow() {
+        QVector<double> series = power();
+        QBENCHMARK {
+            QVector<double> window(13);
+            for (int i=6; i<series.count()-6; i++) {
+                for (int j=0; j<13; j++) window[j] = series[i-6+j];
+                std::sort(window.begin(), window.end());
+            }
+        }
+    }
+
+    void benchmarkSortedWindow() {
+        QVector<double> series = power();
+        QBENCHMARK {
+            StreamingFilters::median(series, 13);
+        }
+    }
+
+    void benchmarkHampel() {
+        QVector<double> series = power();
+        QBENCHMARK {
+            QVector<double> copy = series;
+            StreamingFilters::hampel(copy, 13, 3);
+        }
+    }
+};
+
+
+QTEST_MAIN(TestStreamingFilters)
+#include "testStreamingFilters.moc"
@@ -0,0 +1,11 @@
+QT += testlib core concurrent
+
+SOURCES = testBackupEngine.cpp
+GC_OBJS = BackupEngine \
+          moc_BackupEngine \
+          zip
+
+include(../../unittests.pri)
+
+INCLUDEPATH += $${LIBZ_INCLUDE}
+LIBS += $${LIBZ_LIBS}
@@ -0,0 +1,198 @@
+#include "FileIO/BackupEngine.h"
+#include "../contrib/qzip/zipwriter.h"
+
+#include <QTest>
+#include <QTemporaryDir>
+#include <QFile>
+#include <QDateTime>
+#include <QCryptographicHash>
+
+
+class TestBackupEngine: public QObject
+{
+    Q_OBJECT
+
+private:
+    void write(const QString &path, const QByteArray &data) {
+        QFile file(path);
+        QVERIFY(file.open(QFile::WriteOnly | QFile::Truncate));
+        file.write(data);
+        file.close();
+    }
+
+    QByteArray read(const QString &path) {
+        QFile file(path);
+        if (!file.open(QFile::ReadOnly)) return QByteArray();
+        return file.readAll();
+    }
+
+    // an athlete with activities and a config folder
+    QList<QDir> athlete(const QTemporaryDir &dir, int count, int size) {
+        QDir root(dir.path());
+        root.mkpath("athlete/activities");
+        root.mkpath("athlete/config");
+        QList<QDir> folders;
+        folders << QDir(dir.path() + "/athlete/activities") << QDir(dir.path() + "/athlete/config");
+
+        for (int i=0; i<count; i++) {
+            QByteArray ride;
+            for (int j=0; ride.size() < size; j++) ride += QString("{ \"SECS\":%1, \"WATTS\":%2 },\n").arg(j).arg((i * j) % 400).toLatin1();
+            write(folders[0].absoluteFilePath(QString("2026_01_01_%1.json").arg(i, 6, 10, QChar('0'))), ride);
+        }
+        write(folders[1].absoluteFilePath("athlete-preferences.ini"), "[General]\nweight=75\n");
+        return folders;
+    }
+
+private slots:
+    void manifestRoundTrip() {
+        BackupManifest manifest;
+        manifest.created = QDateTime::currentDateTime();
+        manifest.chain = 3;
+        BackupManifest::Entry e;
+        e.size = 10;
+        e.mtime = 20;
+        e.hash = "0123456789abcdef0123";
+        manifest.files.insert("activities/a.json", e);
+
+        BackupManifest back;
+        QVERIFY(back.fromByteArray(manifest.toByteArray()));
+        QCOMPARE(back.chain, 3);
+        QCOMPARE(back.created, manifest.created);
+        QCOMPARE(back.files.count(), 1);
+        QCOMPARE(back.files["activities/a.json"].hash, e.hash);
+
+        // truncated or garbage, trust none of it
+        QVERIFY(!back.fromByteArray(manifest.toByteArray().left(30)));
+        QVERIFY(back.isEmpty());
+        QVERIFY(!back.fromByteArray("not a manifest"));
+    }
+
+    void fullThenIncremental() {
+        QTemporaryDir dir;
+        QList<QDir> folders = athlete(dir, 20, 5000);
+
+        // a small window so it takes a few
+        BackupEngine full;
+        full.setFolders(folders);
+        full.setWindow(20000);
+        QVERIFY(full.backup(dir.path() + "/full.zip"));
+        QCOMPARE(full.stats().files, 21);
+        QCOMPARE(full.stats().added, 21);
+        QVERIFY(full.stats().bytesOut < full.stats().bytesIn);
+        QVERIFY(full.stats().peak < 40000);
+        QCOMPARE(full.manifest().chain, 0);
+
+        // change one, touch another without changing it, add one
+        QTest::qSleep(1100);
+        QString changed = folders[0].absoluteFilePath("2026_01_01_000003.json");
+        QString touched = folders[0].absoluteFilePath("2026_01_01_000004.json");
+        write(changed, "changed");
+        write(touched, read(touched));
+        write(folders[0].absoluteFilePath("2026_02_01_000000.json"), "added");
+
+        BackupEngine incremental;
+        incremental.setFolders(folders);
+        incremental.setIncremental(full.manifest());
+        QVERIFY(incremental.backup(dir.path() + "/incremental.zip"));
+        QCOMPARE(incremental.stats().files, 22);
+        QCOMPARE(incremental.stats().added, 2);
+        QCOMPARE(incremental.stats().skipped, 20);
+        QCOMPARE(incremental.manifest().chain, 1);
+        QCOMPARE(incremental.manifest().files.count(), 22);
+
+        // restored as at the latest, whatever order they come in
+        BackupEngine restore;
+        QDir target(dir.path() + "/restored");
+        QVERIFY(restore.restore(QStringList() << dir.path() + "/incremental.zip" << dir.path() + "/full.zip", target));
+        QCOMPARE(restore.stats().added, 22);
+        QCOMPARE(read(target.absoluteFilePath("activities/2026_01_01_000003.json")), QByteArray("changed"));
+        QCOMPARE(read(target.absoluteFilePath("activities/2026_02_01_000000.json")), QByteArray("added"));
+        QCOMPARE(read(target.absoluteFilePath("activities/2026_01_01_000004.json")), read(touched));
+        QCOMPARE(read(target.absoluteFilePath("config/athlete-preferences.ini")), QByteArray("[General]\nweight=75\n"));
+
+        // the incremental alone isn't enough
+        BackupEngine partial;
+        QVERIFY(!partial.restore(QStringList() << dir.path() + "/incremental.zip", QDir(dir.path() + "/partial")));
+        QCOMPARE(partial.stats().skipped, 20);
+    }
+
+    void unsafePaths() {
+        QVERIFY(BackupManifest::isSafePath("activities/a.json"));
+        QVERIFY(BackupManifest::isSafePath("config/..ini"));
+        QVERIFY(!BackupManifest::isSafePath(""));
+        QVERIFY(!BackupManifest::isSafePath("/etc/passwd"));
+        QVERIFY(!BackupManifest::isSafePath("\\windows\\win.ini"));
+        QVERIFY(!BackupManifest::isSafePath("C:/autoexec.bat"));
+        QVERIFY(!BackupManifest::isSafePath("C:autoexec.bat"));
+        QVERIFY(!BackupManifest::isSafePath("../a.json"));
+        QVERIFY(!BackupManifest::isSafePath("activities/../../a.json"));
+        QVERIFY(!BackupManifest::isSafePath("activities\\..\\..\\a.json"));
+
+        // a crafted archive can't write outside the target
+        QTemporaryDir dir;
+        QByteArray contents("escaped");
+        BackupManifest manifest;
+        manifest.created = QDateTime::currentDateTime();
+        BackupManifest::Entry e;
+        e.size = contents.size();
+        e.hash = QCryptographicHash::hash(contents, QCryptographicHash::Sha1);
+        manifest.files.insert("activities/a.json", e);
+        manifest.files.insert("../escaped.json", e);
+        {
+            ZipWriter writer(dir.path() + "/crafted.zip");
+            writer.addFile("activities/a.json", contents);
+            writer.addFile("../escaped.json", contents);
+            writer.addFile("backup.manifest", manifest.toByteArray());
+        }
+
+        QDir root(dir.path());
+        root.mkpath("target");
+        BackupEngine engine;
+        QVERIFY(!engine.restore(QStringList() << dir.path() + "/crafted.zip", QDir(dir.path() + "/target")));
+        QCOMPARE(engine.stats().added, 1);
+        QCOMPARE(engine.stats().skipped, 1);
+        QCOMPARE(read(dir.path() + "/target/activities/a.json"), contents);
+        QVERIFY(!QFile::exists(dir.path() + "/escaped.json"));
+
+        // and without a manifest it's unpacked a file at a time, no links
+        {
+            ZipWriter writer(dir.path() + "/plain.zip");
+            writer.addFile("activities/b.json", contents);
+            writer.addFile("../escaped.json", contents);
+            writer.addSymLink("activities/link", dir.path());
+        }
+        root.mkpath("plain");
+        QVERIFY(!engine.restore(QStringList() << dir.path() + "/plain.zip", QDir(dir.path() + "/plain")));
+        QCOMPARE(engine.stats().added, 1);
+        QCOMPARE(engine.stats().skipped, 2);
+        QCOMPARE(read(dir.path() + "/plain/activities/b.json"), contents);
+        QVERIFY(!QFile::exists(dir.path() + "/escaped.json"));
+        QVERIFY(!QFileInfo(dir.path() + "/plain/activities/link").isSymLink());
+    }
+
+    void cancelled() {
+        QTemporaryDir dir;
+        QList<QDir> folders = athlete(dir, 5, 1000);
+
+        BackupEngine engine;
+        engine.setFolders(folders);
+        connect(&engine, &BackupEngine::progressed, &engine, &BackupEngine::cancel);
+        QVERIFY(!engine.backup(dir.path() + "/cancelled.zip"));
+        QVERIFY(!QFile::exists(dir.path() + "/cancelled.zip"));
+    }
+
+    void benchmarkBackup() {
+        QTemporaryDir dir;
+        QList<QDir> folders = athlete(dir, 500, 100000);
+
+        BackupEngine engine;
+        engine.setFolders(folders);
+        QBENCHMARK {
+            QVERIFY(engine.backup(dir.path() + "/bench.zip"));
+        }
+        qDebug() << engine.stats().toString();
+    }
+};
+
+QTEST_MAIN(TestBackupEngine)
+#include "testBackupEngine.moc"
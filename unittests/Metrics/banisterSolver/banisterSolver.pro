@@ -0,0 +1,6 @@
+QT += testlib core concurrent
+
+SOURCES = testBanisterSolver.cpp
+GC_OBJS = BanisterSolver
+
+include(../../unittests.pri)
@@ -0,0 +1,92 @@
+#include "Metrics/BanisterSolver.h"
+
+#include <QTest>
+#include <cmath>
+
+
+class TestBanisterSolver: public QObject
+{
+    Q_OBJECT
+
+private:
+    QVector<double> load, testDay, testScore;
+
+    // a decade of daily load with a rest day a week, and a test every
+    // 9 days scored by a known model, fitted as one window from day 0
+    void athlete(double t1, double t2, double k1, double k2, double p0, double noise) {
+        const int days = 3650;
+        load.resize(days);
+        for (int i=0; i<days; i++) load[i] = (i % 7 == 6) ? 0 : 50 + (i * 37) % 100;
+
+        testDay.clear();
+        testScore.clear();
+        double g = 0, h = 0;
+        for (int i=0; i<days; i++) {
+            if (i) {
+                g = g * exp(-1/t1) + load[i];
+                h = h * exp(-1/t2) + load[i];
+            }
+            if (i >= 10 && i % 9 == 0) {
+                testDay << i;
+                testScore << p0 + k1 * g - k2 * h + noise * ((i * 7919) % 200 - 100) / 100.0;
+            }
+        }
+    }
+
+private slots:
+    void exactForFixedDecays() {
+        athlete(42, 7, 0.1, 0.15, 80, 0);
+        BanisterSolver solver(load, testDay, testScore);
+        solver.addWindow(0, load.count(), 0, testDay.count());
+
+        BanisterSolver::Fit fit = solver.fit(0, 42, 7);
+        QVERIFY(fit.ok);
+        QCOMPARE(fit.n, testDay.count());
+        QVERIFY(qAbs(fit.k1 - 0.1) < 1e-6);
+        QVERIFY(qAbs(fit.k2 - 0.15) < 1e-6);
+        QVERIFY(qAbs(fit.p0 - 80) < 1e-3);
+        QVERIFY(fit.sse < 1e-6);
+    }
+
+    void tooFewTests() {
+        athlete(42, 7, 0.1, 0.15, 80, 0);
+        BanisterSolver solver(load, testDay, testScore);
+        solver.addWindow(0, 30, 0, testDay.count()); // only days 18 and 27
+        QVERIFY(!solver.fit(0, 42, 7).ok);
+
+        // same decay twice can't separate g and h
+        solver.addWindow(0, load.count(), 0, testDay.count());
+        QVERIFY(!solver.fit(1, 20, 20).ok);
+    }
+
+    void searchFindsDecays() {
+        athlete(42, 7, 0.1, 0.15, 80, 0.5);
+        BanisterSolver solver(load, testDay, testScore);
+        solver.addWindow(0, load.count(), 0, testDay.count());
+
+        double t1, t2;
+        QVERIFY(solver.search(t1, t2));
+        QVERIFY(qAbs(t1 - 42) < 2);
+        QVERIFY(qAbs(t2 - 7) < 1);
+
+        int n, m;
+        QVERIFY(solver.sse(t1, t2, n) <= solver.sse(42, 7, m) + 1e-9);
+        QCOMPARE(n, m);
+    }
+
+    void benchmarkSearch() {
+        athlete(42, 7, 0.1, 0.15, 80, 0.5);
+        BanisterSolver solver(load, testDay, testScore);
+        solver.addWindow(0, 1825, 0, testDay.count());
+        solver.addWindow(1825, load.count(), 0, testDay.count());
+
+        double t1, t2;
+        QBENCHMARK {
+            solver.search(t1, t2);
+        }
+    }
+};
+
+
+QTEST_MAIN(TestBanisterSolver)
+#include "testBanisterSolver.moc"
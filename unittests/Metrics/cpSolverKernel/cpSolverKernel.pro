@@ -0,0 +1,6 @@
+QT += testlib core concurrent
+
+SOURCES = testCPSolverKernel.cpp
+GC_OBJS = CPSolverKernel
+
+include(../../unittests.pri)
@@ -0,0 +1,158 @@
+#include "Metrics/CPSolverKernel.h"
+
+#include <QTest>
+#include <QtConcurrent>
+#include <QThread>
+#include <cmath>
+#include <vector>
+
+
+class TestCPSolverKernel: public QObject
+{
+    Q_OBJECT
+
+private:
+    // 2 minute blocks of riding around 180w with every third at 420w,
+    // up to the point of exhaustion after n seconds
+    QVector<int> exhaustion(int n, unsigned int seed) {
+        QVector<int> returning;
+        for (int i=0; i<n; i++) {
+            seed = seed * 1103515245 + 12345;
+            int base = (i / 120) % 3 == 2 ? 420 : 180;
+            returning << base + int((seed >> 16) % 60) - 30;
+        }
+        return returning;
+    }
+
+    // series that don't fill, just fill and spill over a block
+    void efforts(WbalKernel &kernel, QVector<QVector<int> > &data) {
+        const int lengths[] = { 1, 63, 64, 65, 900, 1805, 3600 };
+        for (int i=0; i<7; i++) {
+            data << exhaustion(lengths[i], i);
+            kernel.add(data.last());
+        }
+    }
+
+    double converge(int chains, int kmax) {
+        WbalKernel kernel;
+        QVector<QVector<int> > data;
+        efforts(kernel, data);
+
+        CPSolverConstraints constraints(100, 500, 5000, 50000, 300, 700);
+        std::vector<CPSolverChain> chain;
+        QVector<int> index;
+        for (int i=0; i<chains; i++) {
+            chain.push_back(CPSolverChain(&kernel, constraints, 42 + i, kmax));
+            index << i;
+        }
+        QtConcurrent::blockingMap(index, [&](int i) { chain[i].run(kmax); });
+
+        double returning = chain[0].bestCost();
+        for (int i=1; i<chains; i++) returning = qMin(returning, chain[i].bestCost());
+        return returning;
+    }
+
+private slots:
+    void matchesReference() {
+        WbalKernel integral(true), differential(false);
+        QVector<QVector<int> > data;
+        efforts(integral, data);
+        for (int i=0; i<data.count(); i++) differential.add(data[i]);
+
+        for (double CP=150; CP<=450; CP += 37) {
+            for (double TAU=300; TAU<=700; TAU += 97) {
+                WBParms p(CP, 20000, TAU);
+                WBParms r(CP, 20000, TAU / 10); // differential tau is R x 100
+                for (int i=0; i<data.count(); i++) {
+                    QVERIFY(qAbs(integral.wpbal(i, p) - WbalKernel::reference(data[i], p, true)) < 1e-6);
+                    QVERIFY(qAbs(differential.wpbal(i, r) - WbalKernel::reference(data[i], r, false)) < 1e-6);
+                }
+            }
+        }
+    }
+
+    void cost() {
+        WbalKernel kernel;
+        QVector<QVector<int> > data;
+        QCOMPARE(kernel.cost(WBParms(250, 20000, 500)), 0.0);
+        efforts(kernel, data);
+
+        WBParms p(250, 20000, 500);
+        double sumwb2 = 0;
+        foreach(const QVector<int> &ride, data) sumwb2 += pow(WbalKernel::reference(ride, p, true) - 500, 2);
+        double expect = (sumwb2 / data.count()) / 1000.0f;
+        QVERIFY(qAbs(kernel.cost(p) - expect) < 1e-9 * expect);
+    }
+
+    void chainIsRepeatable() {
+        WbalKernel kernel;
+        QVector<QVector<int> > data;
+        efforts(kernel, data);
+        CPSolverConstraints constraints(100, 500, 5000, 50000, 300, 700);
+
+        // same seed gets the same answer however the iterations are split
+        CPSolverChain one(&kernel, constraints, 1, 20000), two(&kernel, constraints, 1, 20000);
+        one.run(20000);
+        QVector<CPSolverChain::Step> tried;
+        two.run(7000, &tried);
+        two.run(50000);
+        QVERIFY(one.finished() && two.finished());
+        QCOMPARE(two.iteration(), 20000);
+        QCOMPARE(tried.count(), 7000);
+        QCOMPARE(tried.last().k, 7000);
+        QCOMPARE(one.bestCost(), two.bestCost());
+
+        // and stays inside the constraints
+        WBParms best = one.best();
+        QVERIFY(best.CP >= 100 && best.CP <= 500);
+        QVERIFY(best.W >= 5000 && best.W <= 50000);
+        QVERIFY(best.TAU >= 300 && best.TAU <= 700);
+        QVERIFY(one.bestCost() <= kernel.cost(WBParms(500, 50000, 700)));
+    }
+
+    void moreChainsNoWorse() {
+        QVERIFY(converge(4, 5000) <= converge(1, 5000));
+    }
+
+    void benchmarkReference() {
+        QVector<QVector<int> > data;
+        WbalKernel kernel;
+        efforts(kernel, data);
+        double sum = 0;
+        QBENCHMARK {
+            for (int i=0; i<data.count(); i++) sum += WbalKernel::reference(data[i], WBParms(250, 20000, 500), true);
+        }
+        QVERIFY(sum != 0);
+    }
+
+    void benchmarkKernel() {
+        QVector<QVector<int> > data;
+        WbalKernel kernel;
+        efforts(kernel, data);
+        double sum = 0;
+        QBENCHMARK {
+            sum += kernel.cost(WBParms(250, 20000, 500));
+        }
+        QVERIFY(sum != 0);
+    }
+
+    // time to converge, the best found is reported alongside
+    void benchmarkConverge_data() {
+        QTest::addColumn<int>("chains");
+        QTest::newRow("1 chain") << 1;
+        QTest::newRow("ideal thread count") << qMax(1, QThread::idealThreadCount());
+    }
+
+    void benchmarkConverge() {
+        QFETCH(int, chains);
+        double best = 0;
+        QBENCHMARK {
+            best = converge(chains, 100000);
+        }
+        qDebug() << chains << "chains best cost" << best;
+    }
+};
+
+
+QTEST_MAIN(TestCPSolverKernel)
+#include "testCPSolverKernel.moc"
@@ -0,0 +1,12 @@
+QT += testlib core bluetooth
+
+SOURCES = testBT40Decoder.cpp
+GC_OBJS = BT40Decoder \
+          moc_BT40Decoder \
+          Ftms \
+          KurtInRide \
+          KurtSmartControl
+
+include(../../unittests.pri)
+
+INCLUDEPATH += ../../../src/Core
@@ -0,0 +1,159 @@
+#include "Train/BT40Decoder.h"
+
+#include <QTest>
+#include <QTemporaryFile>
+#include <QTextStream>
+#include <cstring>
+
+
+static BT40Notification notification(int kind, const char *hex, int device = 0)
+{
+    QByteArray bytes = QByteArray::fromHex(hex);
+    BT40Notification n;
+    memset(&n, 0, sizeof(n));
+    n.device = device;
+    n.kind = kind;
+    n.size = bytes.size();
+    memcpy(n.data, bytes.constData(), bytes.size());
+    return n;
+}
+
+
+class TestBT40Decoder: public QObject
+{
+    Q_OBJECT
+
+private slots:
+
+    void heartRate() {
+        BT40Decoder decoder;
+        BT40Event out[BT40Decoder::MaxEvents];
+
+        // 8 bit
+        QCOMPARE(decoder.decode(notification(BT40Notification::HeartRate, "0048"), out), 1);
+        QCOMPARE((int) out[0].type, (int) BT40Event::Hr);
+        QCOMPARE(out[0].value[0], 72.0);
+
+        // 16 bit
+        QCOMPARE(decoder.decode(notification(BT40Notification::HeartRate, "012c01"), out), 1);
+        QCOMPARE(out[0].value[0], 300.0);
+    }
+
+    void powerAndCadence() {
+        BT40Decoder decoder;
+        BT40Event out[BT40Decoder::MaxEvents];
+
+        // first crank data only primes the counts
+        QCOMPARE(decoder.decode(notification(BT40Notification::CyclingPower, "2000fa000a000004"), out), 1);
+        QCOMPARE((int) out[0].type, (int) BT40Event::Watts);
+        QCOMPARE(out[0].value[0], 250.0);
+
+        // one rev in 1024/1024s
+        QCOMPARE(decoder.decode(notification(BT40Notification::CyclingPower, "2000fa000b000008"), out), 2);
+        QCOMPARE((int) out[1].type, (int) BT40Event::Cadence);
+        QCOMPARE(out[1].value[0], 60.0);
+
+        // no new crank event, keep the cadence a couple of times then zero
+        QCOMPARE(decoder.decode(notification(BT40Notification::CyclingPower, "2000fa000b000008"), out), 1);
+        QCOMPARE(decoder.decode(notification(BT40Notification::CyclingPower, "2000fa000b000008"), out), 1);
+        QCOMPARE(decoder.decode(notification(BT40Notification::CyclingPower, "2000fa000b000008"), out), 2);
+        QCOMPARE(out[1].value[0], 0.0);
+
+        // negative power
+        QCOMPARE(decoder.decode(notification(BT40Notification::CyclingPower, "0000f6ff"), out), 1);
+        QCOMPARE(out[0].value[0], -10.0);
+    }
+
+    void wheelSpeed() {
+        BT40Decoder decoder;
+        BT40Event out[BT40Decoder::MaxEvents];
+
+        QCOMPARE(decoder.decode(notification(BT40Notification::CSC, "01640000000004"), out), 1);
+        QCOMPARE((int) out[0].type, (int) BT40Event::WheelRpm);
+        QCOMPARE(out[0].value[0], 0.0);
+
+        // two revs in a second at 1/1024s
+        QCOMPARE(decoder.decode(notification(BT40Notification::CSC, "01660000000008"), out), 1);
+        QCOMPARE(out[0].value[0], 120.0);
+
+        // power meters count wheel time in 1/2048s
+        decoder.reset();
+        decoder.decode(notification(BT40Notification::CyclingPower, "1000c80064000000000004"), out);
+        QCOMPARE(decoder.decode(notification(BT40Notification::CyclingPower, "1000c80066000000000008"), out), 2);
+        QCOMPARE(out[1].value[0], 240.0);
+    }
+
+    void ftms() {
+        BT40Decoder decoder;
+        BT40Event out[BT40Decoder::MaxEvents];
+
+        // speed, cadence and power
+        QCOMPARE(decoder.decode(notification(BT40Notification::FtmsIndoorBike, "4400c409b400c800"), out), 3);
+        QCOMPARE(out[0].value[0], 200.0);
+        QCOMPARE(out[1].value[0], 90.0);
+        QCOMPARE(out[2].value[0], 25.0);
+    }
+
+    void ventilationOnly() {
+        BT40Decoder decoder;
+        BT40Event out[BT40Decoder::MaxEvents];
+
+        // FeO2 and VO2 of exactly 22 are ignored
+        QCOMPARE(decoder.decode(notification(BT40Notification::VO2GasExchange, "9808000016000000"), out), 0);
+        QCOMPARE(decoder.decode(notification(BT40Notification::VO2GasExchange, "a00700000e0b0009"), out), 1);
+        QCOMPARE((int) out[0].type, (int) BT40Event::GasExchange);
+        QCOMPARE(out[0].value[0], 2830.0);
+    }
+
+    void replay() {
+        QTemporaryFile file;
+        QVERIFY(file.open());
+        {
+            QTextStream out(&file);
+            out << "# power meter and hrm\n";
+            out << "power 2000fa000a000004\n";
+            out << "1 hr 0048\n";
+            out << "power 2000fa000b000008\n";
+        }
+        file.close();
+
+        QVector<BT40Notification> dump;
+        QString error;
+        QVERIFY(BT40Pipeline::parseDump(file.fileName(), dump, error));
+        QCOMPARE(dump.count(), 3);
+        QCOMPARE((int) dump[1].device, 1);
+        QCOMPARE((int) dump[1].kind, (int) BT40Notification::HeartRate);
+
+        QString rates = BT40Pipeline::replay(file.fileName(), 10);
+        QVERIFY(rates.startsWith("notifications=30 "));
+        QVERIFY(rates.contains(" dropped=0 "));
+    }
+
+    void acrossThreads() {
+        BT40Pipeline pipeline;
+        pipeline.begin();
+
+        const int count = 10000;
+        int received = 0;
+        BT40Event event;
+        for (int i = 0; i < count; ++i) {
+            while (! pipeline.notify(i % 3, BT40Notification::HeartRate, QByteArray::fromHex("0048"))) {
+                while (pipeline.next(event)) ++received;
+                QThread::yieldCurrentThread();
+            }
+            while (pipeline.next(event)) {
+                QCOMPARE(event.value[0], 72.0);
+                ++received;
+            }
+        }
+        pipeline.stop();
+        while (pipeline.next(event)) ++received;
+
+        QCOMPARE(received, count);
+        QCOMPARE(pipeline.dropped(), 0);
+    }
+};
+
+
+QTEST_MAIN(TestBT40Decoder)
+#include "testBT40Decoder.moc"
@@ -0,0 +1,145 @@
+#include "Train/TrainRecorder.h"
+
+#include <QTest>
+#include <QTemporaryDir>
+#include <QFile>
+#include <QFileInfo>
+#include <cstring>
+
+
+class TestTrainRecord: public QObject
+{
+    Q_OBJECT
+
+private:
+    TrainRecord sample(int i) {
+        TrainRecord r;
+        memset(&r, 0, sizeof(r));
+        r.secs = i * 0.25;
+        r.watts = 200 + i % 50;
+        r.hr = 120 + i % 30;
+        r.km = i * 0.002;
+        r.target = 250;
+        r.interval = i / 100;
+        return r;
+    }
+
+    // records using the recorder thread, waiting when its queue is full
+    bool record(const QString &filename, int count) {
+        TrainRecorder recorder;
+        if (!recorder.open(filename, QDateTime::fromMSecsSinceEpoch(1700000000000LL))) return false;
+        for (int i = 0; i < count; ++i) {
+            while (! recorder.append(sample(i))) QThread::msleep(10);
+        }
+        recorder.close();
+        return true;
+    }
+
+    QVector<TrainRecord> read(const QString &filename, TrainRecordReader::Status *status = NULL) {
+        QVector<TrainRecord> records;
+        QFile file(filename);
+        if (!file.open(QFile::ReadOnly)) return records;
+        TrainRecordReader reader(file);
+        if (status) *status = reader.status();
+        TrainRecord r;
+        while (reader.next(r)) records << r;
+        return records;
+    }
+
+    qint64 size(int records) {
+        return sizeof(TrainRecordHeader) + qint64(records) * sizeof(TrainRecord);
+    }
+
+private slots:
+
+    void roundTrip() {
+        QTemporaryDir dir;
+        QString filename = dir.filePath("ride.gctr");
+
+        // more than a block, and more than the queue holds
+        const int count = 3000;
+        QVERIFY(record(filename, count));
+        QCOMPARE(QFileInfo(filename).size(), size(count));
+
+        TrainRecordReader::Status status = TrainRecordReader::NotARecording;
+        QVector<TrainRecord> records = read(filename, &status);
+        QCOMPARE(status, TrainRecordReader::Ok);
+        QCOMPARE(records.count(), count);
+        for (int i = 0; i < count; ++i) {
+            TrainRecord expect = sample(i);
+            QCOMPARE(records[i].secs, expect.secs);
+            QCOMPARE(records[i].watts, expect.watts);
+            QCOMPARE(records[i].hr, expect.hr);
+            QCOMPARE(records[i].interval, expect.interval);
+        }
+
+        QFile file(filename);
+        QVERIFY(file.open(QFile::ReadOnly));
+        TrainRecordReader reader(file);
+        QCOMPARE(reader.header().startTime, 1700000000000LL);
+    }
+
+    void tornLastRecord() {
+        QTemporaryDir dir;
+        QString filename = dir.filePath("crash.gctr");
+        QVERIFY(record(filename, 100));
+
+        // the machine went down part way through the last write
+        QFile file(filename);
+        QVERIFY(file.resize(size(99) + sizeof(TrainRecord) / 2));
+        QCOMPARE(read(filename).count(), 99);
+
+        // or the bytes made it to disk but not all of them were right
+        QVERIFY(file.resize(size(99) + sizeof(TrainRecord)));
+        QVERIFY(file.open(QFile::ReadWrite));
+        file.seek(size(99) + 8);
+        file.write("garbage!", 8);
+        file.close();
+        QVector<TrainRecord> records = read(filename);
+        QCOMPARE(records.count(), 99);
+        QCOMPARE(records.last().secs, sample(98).secs);
+    }
+
+    void tornInTheMiddle() {
+        QTemporaryDir dir;
+        QString filename = dir.filePath("middle.gctr");
+        QVERIFY(record(filename, 2000));
+
+        // nothing after a bad record is trusted, even in a later block
+        QFile file(filename);
+        QVERIFY(file.open(QFile::ReadWrite));
+        file.seek(size(1500) + 16);
+        file.write("\xff\xff\xff\xff", 4);
+        file.close();
+        QCOMPARE(read(filename).count(), 1500);
+    }
+
+    void notARecording() {
+        QTemporaryDir dir;
+        QString filename = dir.filePath("other.gctr");
+        QFile file(filename);
+        QVERIFY(file.open(QFile::WriteOnly));
+        file.write("SECS,WATTS\n0,200\n1,210\n");
+        file.close();
+
+        TrainRecordReader::Status status = TrainRecordReader::Ok;
+        QCOMPARE(read(filename, &status).count(), 0);
+        QCOMPARE(status, TrainRecordReader::NotARecording);
+
+        // a recording from a later version
+        TrainRecordHeader header;
+        memset(&header, 0, sizeof(header));
+        header.magic = TRAINRECORD_MAGIC;
+        header.version = TRAINRECORD_VERSION + 1;
+        header.recordSize = sizeof(TrainRecord);
+        QVERIFY(file.open(QFile::WriteOnly | QFile::Truncate));
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.close();
+        QCOMPARE(read(filename, &status).count(), 0);
+        QCOMPARE(status, TrainRecordReader::Unsupported);
+    }
+};
+
+
+QTEST_MAIN(TestTrainRecord)
+#include "testTrainRecord.moc"
@@ -0,0 +1,10 @@
+QT += testlib core
+
+SOURCES = testTrainRecord.cpp
+GC_OBJS = TrainRecord \
+          TrainRecorder \
+          moc_TrainRecorder
+
+include(../../unittests.pri)
+
+INCLUDEPATH += ../../../src/Core ../../../src/FileIO
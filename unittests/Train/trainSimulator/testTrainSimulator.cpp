@@ -0,0 +1,120 @@
+#include "Train/TrainSimulator.h"
+#include "Train/ErgFile.h"
+
+#include <QTest>
+
+
+// 5 minutes at 100W, 5 at 300W and 5 at 150W, a lap at each change
+static const char *erg =
+    "[COURSE HEADER]\n"
+    "VERSION = 2\n"
+    "UNITS = ENGLISH\n"
+    "DESCRIPTION = simulator test\n"
+    "FILE NAME = simulator.erg\n"
+    "MINUTES WATTS\n"
+    "[END COURSE HEADER]\n"
+    "[COURSE DATA]\n"
+    "0.00\t100\n"
+    "5.00\t100\n"
+    "5.00\t300\n"
+    "10.00\t300\n"
+    "10.00\t150\n"
+    "15.00\t150\n"
+    "5.00\tLAP hard\n"
+    "10.00\tLAP easy\n"
+    "[END COURSE DATA]\n";
+
+class TestTrainSimulator: public QObject
+{
+    Q_OBJECT
+
+private:
+    ErgFile *workout() {
+        return ErgFile::fromContent(erg, NULL);
+    }
+
+    // the record at secs into the workout
+    const TrainRecord *at(const QVector<TrainRecord> &records, double secs) {
+        foreach(const TrainRecord &r, records) if (r.secs >= secs) return &r;
+        return NULL;
+    }
+
+private slots:
+
+    void replaysErg() {
+        QScopedPointer<ErgFile> ergFile(workout());
+        QVERIFY(ergFile->isValid());
+        QVERIFY(ergFile->hasWatts());
+
+        TrainSimulator sim(NULL, ergFile.data());
+        sim.setWbal(250, 20000, 300);
+        const TrainSimulator::Stats &stats = sim.run();
+
+        // runs to the end of the workout and no further
+        QVERIFY(stats.secs >= 900);
+        QVERIFY(stats.secs <= 902);
+        QVERIFY(qAbs(stats.ticks * REFRESHRATE / 1000.0 - stats.secs) <= 1);
+
+        // a record a second
+        const QVector<TrainRecord> &records = sim.records();
+        QVERIFY(records.count() >= 900);
+        QVERIFY(records.count() <= 902);
+        for (int i = 1; i < records.count(); ++i)
+            QCOMPARE(records[i].secs - records[i-1].secs, SAMPLERATE / 1000.0);
+
+        // the load follows the workout and the rider holds it
+        struct { double secs, watts; int lap; } expect[] = {
+            { 60, 100, 0 }, { 290, 100, 0 }, { 310, 300, 1 }, { 590, 300, 1 }, { 610, 150, 2 }, { 890, 150, 2 }
+        };
+        for (auto e : expect) {
+            const TrainRecord *r = at(records, e.secs);
+            QVERIFY(r != NULL);
+            QCOMPARE(r->target, e.watts);
+            QCOMPARE(r->watts, e.watts);
+            QCOMPARE(int(r->interval), e.lap);
+        }
+        QCOMPARE(sim.laps(), 2);
+
+        // 50W over CP for 300s, W'bal falls by 50 x TAU x (1 - e^-1), 9.5kJ
+        QVERIFY(sim.minWbal() > 10000);
+        QVERIFY(sim.minWbal() < 11000);
+        QVERIFY(sim.telemetry().getWbal() > sim.minWbal());
+
+        // and the bike went somewhere
+        QVERIFY(sim.distance() > 0);
+        QVERIFY(records.last().km > records.first().km);
+    }
+
+    void limited() {
+        QScopedPointer<ErgFile> ergFile(workout());
+
+        TrainSimulator sim(NULL, ergFile.data());
+        QCOMPARE(sim.run(60).secs, 60.0);
+        QCOMPARE(sim.records().count(), 61); // 0 to 60 inclusive
+        QCOMPARE(sim.laps(), 0);
+    }
+
+    void nothingToRun() {
+        // no workout and no ride would never end
+        TrainSimulator sim(NULL, NULL);
+        QCOMPARE(sim.run().ticks, quint64(0));
+        QCOMPARE(sim.records().count(), 0);
+
+        // unless told when to stop
+        QCOMPARE(sim.run(30).secs, 30.0);
+        QCOMPARE(sim.records().count(), 31);
+    }
+
+    void benchmarkTicks() {
+        QScopedPointer<ErgFile> ergFile(workout());
+
+        TrainSimulator sim(NULL, ergFile.data());
+        QBENCHMARK {
+            sim.run();
+        }
+        qDebug() << sim.stats().toString();
+    }
+};
+
+QTEST_MAIN(TestTrainSimulator)
+#include "testTrainSimulator.moc"
@@ -0,0 +1,27 @@
+QT += testlib core gui widgets xml
+
+SOURCES = testTrainSimulator.cpp
+GC_OBJS = TrainSimulator \
+          RealtimeEngine \
+          moc_RealtimeEngine \
+          ReplayController \
+          moc_ReplayController \
+          RealtimeController \
+          moc_RealtimeController \
+          RealtimeData \
+          ErgFile \
+          ErgFileBase \
+          ZwoParser \
+          TTSReader \
+          LocationInterpolation \
+          BicycleSim \
+          PhysicsUtility \
+          Zones \
+          Settings \
+          Units \
+          Utils
+
+include(../../unittests.pri)
+
+INCLUDEPATH += ../../../src/Core ../../../src/Train ../../../src/FileIO ../../../src/Metrics \
+               ../../../src/Gui ../../../src/Charts ../../../qwt/src
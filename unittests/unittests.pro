@@ -12,6 +12,25 @@ equals(GC_UNITTESTS, active) {
 			   Core/utils \
 			   Core/signalSafety \
 			   Core/splineCrash \
+			   Core/minMaxPyramid \
+			   Core/spscQueue \
+			   Core/hexBinner \
+			   Core/rideCacheJournal \
+			   Core/columnCodec \
+			   Core/streamingFilters \
+			   Core/demTiles \
+			   Core/snapshotBuffer \
+			   Core/latencyHistogram \
+			   Core/prefixSeries \
+			   Core/asOfSeries \
+			   Core/dateIndex \
+			   Core/resampleKernel \
+			   FileIO/backupEngine \
+			   Metrics/banisterSolver \
+			   Metrics/cpSolverKernel \
+			   Train/bt40Decoder \
+			   Train/trainRecord \
+			   Train/trainSimulator \
 			   Gui/calendarData
 	CONFIG += ordered
 } else {